@@ -257,7 +257,7 @@ class EmberMPIJob(Job):
         nic, slot_name = self.nic_configuration.build(nodeID,self._numCores // self._nicsPerNode)
 
         # Build NetworkInterface
-        logical_id = self._nid_map.index(nodeID)
+        logical_id = self.getLogicalNid(nodeID)
         networkif, port_name = self.network_interface.build(nic,slot_name,0,self.job_id,self.size,logical_id,False)
 
         # Store return value for later
@@ -317,7 +317,7 @@ class EmberMPIJob(Job):
 
 
             # Create the OS layer
-            self.os.build(ep,nicLink,loopLink,self.size,self._nicsPerNode,self.job_id,nodeID,self._nid_map.index(nodeID),x)
+            self.os.build(ep,nicLink,loopLink,self.size,self._nicsPerNode,self.job_id,nodeID,self.getLogicalNid(nodeID),x)
 
             """
             os = ep.setSubComponent( "OS", "firefly.hades" )
@@ -340,7 +340,7 @@ class EmberMPIJob(Job):
             os.addParams( {'numNodes': self.size} )
             os.addParams( {'netMapName': 'Ember' + str(self.job_id) } )
             os.addParams( {'netId': nodeID } )
-            os.addParams( {'netMapId': self._nid_map.index(nodeID) } )
+            os.addParams( {'netMapId': self.getLogicalNid(nodeID) } )
             os.addParams( {'netMapSize': self.size } )
             os.addParams( {'coreId': x } )
 
@@ -49,6 +49,11 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
     endpoint_locations(0),
     use_dense_map(false),
     dense_map(NULL),
+    event_driven(false),
+    wakeup_link(NULL),
+    next_wakeup(MAX_SIMTIME_T),
+    active_ports(0),
+    credit_wait(0),
     output(Simulation::getSimulation()->getSimulationOutput())
 {
     // Get the options for the router
@@ -94,10 +99,25 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
 
     route_y_first = params.find<bool>("route_y_first",false);
 
-    // Register the clock
-    my_clock_handler = new Clock::Handler<noc_mesh>(this,&noc_mesh::clock_handler);
-    clock_tc = registerClock( clock_freq, my_clock_handler);
-    clock_is_off = false;
+    event_driven = params.find<bool>("event_driven",false);
+    if ( event_driven && local_port_start + local_ports > 32 ) {
+        output.fatal(CALL_INFO, -1, "noc_mesh: event_driven supports at most %d local ports\n", 32 - local_port_start);
+    }
+
+    if ( event_driven ) {
+        // No clock, wakeups are scheduled on a self link in units of
+        // the clock period
+        my_clock_handler = NULL;
+        clock_tc = getTimeConverter(clock_freq);
+        wakeup_link = configureSelfLink("wakeup", clock_tc, new Event::Handler<noc_mesh>(this,&noc_mesh::handle_wakeup));
+        clock_is_off = true;
+    }
+    else {
+        // Register the clock
+        my_clock_handler = new Clock::Handler<noc_mesh>(this,&noc_mesh::clock_handler);
+        clock_tc = registerClock( clock_freq, my_clock_handler);
+        clock_is_off = false;
+    }
 
     // Configure the ports
     ports = new Link*[local_port_start + local_ports];
@@ -169,6 +189,15 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
     for ( int i = 0; i < local_port_start + local_ports; ++i ) {
         port_credits[i] = 0;
     }
+
+    port_free = new SimTime_t[local_port_start + local_ports];
+    head_wait_start = new SimTime_t[local_port_start + local_ports];
+    head_wait_credits = new bool[local_port_start + local_ports];
+    for ( int i = 0; i < local_port_start + local_ports; ++i ) {
+        port_free[i] = 0;
+        head_wait_start[i] = MAX_SIMTIME_T;
+        head_wait_credits[i] = false;
+    }
 }
 
 void
@@ -231,6 +260,7 @@ noc_mesh::handle_input_r2r(Event* ev, int port)
         port_credits[port] += credit_ret->credits;
         // output.output("(%d,%d): Got credit event for VN %d with %d credits\n",my_x,my_y,credit_ret->vn,credit_ret->credits);
         delete ev;
+        if ( event_driven ) credits_arrived(port);
         break;
     }
     case BaseNocEvent::INTERNAL:
@@ -241,7 +271,9 @@ noc_mesh::handle_input_r2r(Event* ev, int port)
 
         // Put the event into the proper queue
         port_queues[port].push(event);
-        if (clock_is_off)
+        if ( event_driven )
+            packet_arrived(port);
+        else if (clock_is_off)
             clock_wakeup();
         break;
     }
@@ -322,6 +354,7 @@ noc_mesh::handle_input_ep2r(Event* ev, int port)
         credit_event* credit_ret = static_cast<credit_event*>(ev);
         port_credits[port] += credit_ret->credits;
         delete ev;
+        if ( event_driven ) credits_arrived(port);
         break;
     }
     case BaseNocEvent::PACKET:
@@ -334,7 +367,9 @@ noc_mesh::handle_input_ep2r(Event* ev, int port)
 
         // Need to put the event into the proper queue
         port_queues[port].push(event);
-        if (clock_is_off)
+        if ( event_driven )
+            packet_arrived(port);
+        else if (clock_is_off)
             clock_wakeup();
         break;
     }
@@ -412,42 +447,7 @@ noc_mesh::clock_handler(Cycle_t cycle)
                 // that port
                 // output.output("(%d,%d): clock_handler(): port_credits[%d] = %d\n",my_x,my_y,port,port_credits[port]);
                 if ( port_credits[port] >= event->encap_ev->getSizeInFlits() ) {
-                    int trace_id = event->encap_ev->request->getTraceID();
-                    int vn = event->encap_ev->vn;
-                    SST::Interfaces::SimpleNetwork::nid_t src = event->encap_ev->request->src;
-                    SST::Interfaces::SimpleNetwork::nid_t dest = event->encap_ev->request->dest;
-                    SST::Interfaces::SimpleNetwork::Request::TraceType ttype = event->encap_ev->request->getTraceType();
-                    int flits = event->encap_ev->getSizeInFlits();
-
-                    // port_queues[local_port_start + i].pop();
-                    port_queues[lru_port].pop();
-                    port_credits[port] -= event->encap_ev->getSizeInFlits();
-                    port_busy[port] = event->encap_ev->getSizeInFlits();
-                    if ( edge_status & ( 1 << port) ) {
-                        ports[port]->send(event->encap_ev);
-                        send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
-                        event->encap_ev = NULL;
-                        delete event;
-                    }
-                    else {
-                        ports[port]->send(event);
-                        send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
-                    }
-                    if ( ttype == SimpleNetwork::Request::FULL ) {
-                        output.output("TRACE(%d): %" PRIu64 " ns: Sent an event to router from router: (%d,%d)"
-                                      " (%s) on VC %d from src %" PRIu64 " to dest %" PRIu64 ".\n",
-                                      trace_id,
-                                      getCurrentSimTimeNano(),
-                                      my_x, my_y,
-                                      getName().c_str(),
-                                      vn,
-                                      src,
-                                      dest);
-                    }
-                    // Need to send credit event back to last router
-                    credit_event* cr_ev = new credit_event(0, flits);
-                    // ports[local_port_start + i]->send(cr_ev);
-                    ports[lru_port]->send(cr_ev);
+                    send_head(lru_port);
                     lru.satisfied(true);
                 }
                 else {
@@ -470,6 +470,132 @@ noc_mesh::clock_handler(Cycle_t cycle)
     return !keepClockOn;
 }
 
+int
+noc_mesh::send_head(int in_port)
+{
+    noc_mesh_event* event = port_queues[in_port].front();
+    int port = event->next_port;
+
+    int trace_id = event->encap_ev->request->getTraceID();
+    int vn = event->encap_ev->vn;
+    SST::Interfaces::SimpleNetwork::nid_t src = event->encap_ev->request->src;
+    SST::Interfaces::SimpleNetwork::nid_t dest = event->encap_ev->request->dest;
+    SST::Interfaces::SimpleNetwork::Request::TraceType ttype = event->encap_ev->request->getTraceType();
+    int flits = event->encap_ev->getSizeInFlits();
+
+    port_queues[in_port].pop();
+    port_credits[port] -= flits;
+    port_busy[port] = flits;
+    if ( edge_status & ( 1 << port) ) {
+        ports[port]->send(event->encap_ev);
+        send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
+        event->encap_ev = NULL;
+        delete event;
+    }
+    else {
+        ports[port]->send(event);
+        send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
+    }
+    if ( ttype == SimpleNetwork::Request::FULL ) {
+        output.output("TRACE(%d): %" PRIu64 " ns: Sent an event to router from router: (%d,%d)"
+                      " (%s) on VC %d from src %" PRIu64 " to dest %" PRIu64 ".\n",
+                      trace_id,
+                      getCurrentSimTimeNano(),
+                      my_x, my_y,
+                      getName().c_str(),
+                      vn,
+                      src,
+                      dest);
+    }
+    // Need to send credit event back to last router
+    credit_event* cr_ev = new credit_event(0, flits);
+    ports[in_port]->send(cr_ev);
+    return flits;
+}
+
+void
+noc_mesh::schedule_wakeup(SimTime_t cycle)
+{
+    // An earlier (or same time) wakeup will recompute when to wake
+    // next, so only the earliest one needs to be sent
+    if ( cycle >= next_wakeup ) return;
+    next_wakeup = cycle;
+    wakeup_link->send(cycle - getCurrentSimTime(clock_tc), NULL);
+}
+
+void
+noc_mesh::packet_arrived(int port)
+{
+    // Only a new head packet can change what the router does
+    if ( port_queues[port].size() != 1 ) return;
+    active_ports |= 1u << port;
+    schedule_wakeup(getCurrentSimTime(clock_tc) + 1);
+}
+
+void
+noc_mesh::credits_arrived(int port)
+{
+    if ( credit_wait & (1u << port) ) {
+        schedule_wakeup(getCurrentSimTime(clock_tc) + 1);
+    }
+}
+
+void
+noc_mesh::handle_wakeup(Event* ev)
+{
+    SimTime_t now = getCurrentSimTime(clock_tc);
+    // Wakeups superseded by an earlier one have nothing to do
+    if ( now != next_wakeup ) return;
+    next_wakeup = MAX_SIMTIME_T;
+
+    // Same arbitration as clock_handler(), but only for input ports
+    // with packets.  Each head packet either advances or tells us
+    // when it can try again: when its output port is free, or (for
+    // credits) when a credit event arrives.
+    SimTime_t next = MAX_SIMTIME_T;
+    credit_wait = 0;
+    for ( unsigned int u = 0; u < lru_units.size(); u++ ) {
+        // A pass in which no port is satisfied leaves the lru order
+        // unchanged, so units with no packets can be skipped
+        if ( !(active_ports & lru_masks[u]) ) continue;
+        lru_unit<int>& lru = lru_units[u];
+        for ( unsigned int i = 0; i < lru.size(); i++ ) {
+            int lru_port = lru.top();
+            if ( !(active_ports & (1u << lru_port)) ) {
+                lru.satisfied(false);
+                continue;
+            }
+
+            noc_mesh_event* event = port_queues[lru_port].front();
+            int port = event->next_port;
+            bool busy = port_free[port] > now;
+            if ( busy || port_credits[port] < event->encap_ev->getSizeInFlits() ) {
+                if ( head_wait_start[lru_port] == MAX_SIMTIME_T ) {
+                    head_wait_start[lru_port] = now;
+                    head_wait_credits[lru_port] = !busy;
+                }
+                if ( busy ) next = std::min(next, port_free[port]);
+                else credit_wait |= 1u << port;
+                lru.satisfied(false);
+                continue;
+            }
+
+            if ( head_wait_start[lru_port] != MAX_SIMTIME_T ) {
+                Statistic<uint64_t>* stat = head_wait_credits[lru_port] ? output_port_stalls[port] : xbar_stalls[port];
+                stat->addData(now - head_wait_start[lru_port]);
+                head_wait_start[lru_port] = MAX_SIMTIME_T;
+            }
+
+            port_free[port] = now + send_head(lru_port);
+            lru.satisfied(true);
+            if ( port_queues[lru_port].empty() ) active_ports &= ~(1u << lru_port);
+            else next = std::min(next, now + 1);
+        }
+    }
+
+    if ( next != MAX_SIMTIME_T ) schedule_wakeup(next);
+}
+
 void noc_mesh::setup()
 {
     // if ( use_dense_map ) {
@@ -505,6 +631,15 @@ void noc_mesh::setup()
         }
     }
     lru_units.back().finalize();
+
+    // Masks of the ports in each lru unit for event driven mode
+    lru_masks.assign(lru_units.size(), 0);
+    for ( unsigned int u = 0; u < lru_units.size(); u++ ) {
+        for ( unsigned int i = 0; i < lru_units[u].size(); i++ ) {
+            lru_masks[u] |= 1u << lru_units[u].top();
+            lru_units[u].satisfied(false);
+        }
+    }
 }
 
 void noc_mesh::finish()
@@ -26,6 +26,7 @@
 
 #include <sst/core/statapi/stataccumulator.h>
 
+#include <cstdint>
 #include <queue>
 
 #include "sst/elements/kingsley/nocEvents.h"
@@ -59,6 +60,8 @@ public:
         {"port_priority_equal","Set to true to have all port have equal priority (usually endpoint ports have higher priority).","false"},
         {"route_y_first",      "Set to true to rout Y-dimension first.","false"},
         {"use_dense_map",      "Set to true to have a dense network id map instead of the sparse map normally used.","false"},
+        {"event_driven",       "Set to true to only wake the router when a packet at the head of an input queue can advance, based on when "
+         "the output port finishes its current packet and when credits return.  Avoids clocking lightly loaded routers every cycle.","false"},
         // {"network_inspectors", "Comma separated list of network inspectors to put on output ports.", ""},
     )
 
@@ -132,6 +135,30 @@ private:
     // lru_unit<int> mesh_lru;
 
     bool clock_handler(Cycle_t cycle);
+
+    // Event driven mode.  Instead of a clock, a self link wakes the
+    // router when a head packet can advance.  Times are in cycles of
+    // clock_tc.
+    bool event_driven;
+    Link* wakeup_link;
+    SimTime_t next_wakeup;
+    SimTime_t* port_free;       // Cycle each output port finishes its current packet
+    uint32_t active_ports;      // Input ports with packets queued
+    uint32_t credit_wait;       // Output ports a head packet is waiting on credits for
+    std::vector<uint32_t> lru_masks;
+    // Cycle each input port's head packet started waiting and whether
+    // it waited on credits (output_port_stalls) or a busy output
+    // (xbar_stalls)
+    SimTime_t* head_wait_start;
+    bool* head_wait_credits;
+
+    void handle_wakeup(Event* ev);
+    void schedule_wakeup(SimTime_t cycle);
+    void packet_arrived(int port);
+    void credits_arrived(int port);
+
+    // Sends the head packet of in_port and returns its size in flits
+    int send_head(int in_port);
     // Statistic<uint64_t>** xbar_stalls;
 
     Output& output;
@@ -0,0 +1,87 @@
+# 2x2 kingsley.noc_mesh with the routers in event driven mode.
+#
+# Every router has one local endpoint and the edge ports of the mesh
+# have endpoints as well, 12 in all.  Each endpoint sends num_messages
+# packets to every endpoint (itself included), so with X-first routing
+# the number of packets sent on each router port depends only on the
+# mesh, not on when the routers wake up.
+#
+# Only send_bit_count is enabled.  Those lines are compared against
+# refFiles/test_kingsley_noc_mesh_event_driven_test.out.
+import sst
+
+sst.setProgramOption("timebase", "1ps")
+
+x_size = 2
+y_size = 2
+
+num_peers = (x_size * y_size) + (2*x_size) + (2*y_size)
+num_messages = 10
+msg_size = "64B"
+link_bw = "32GB/s"
+flit_size = "32B"
+input_buf_size = "64B"
+
+links = dict()
+def getLink(name1, name2):
+    name = "link.%s:%s"%(name1, name2)
+    if name not in links:
+        links[name] = sst.Link(name)
+    return links[name]
+
+def addEndpoint(name, rtr_name):
+    ep = sst.Component(name, "merlin.test_nic")
+    ep.addParams({
+        "num_peers" : num_peers,
+        "message_size" : msg_size,
+        "num_messages" : num_messages
+    })
+    sub = ep.setSubComponent("networkIF","kingsley.linkcontrol")
+    sub.addParam("link_bw","1GB/s")
+    sub.addLink(getLink(rtr_name, name), "rtr_port", "800ps")
+
+for y in range(y_size):
+    for x in range(x_size):
+        name = "rtr.%d.%d"%(x,y)
+        rtr = sst.Component(name, "kingsley.noc_mesh")
+        rtr.addParams({
+            "local_ports" : 1,
+            "link_bw" : link_bw,
+            "input_buf_size" : input_buf_size,
+            "flit_size" : flit_size,
+            "use_dense_map" : "true",
+            "event_driven" : "true"
+        })
+        rtr.enableStatistics(["send_bit_count"], {"type":"sst.AccumulatorStatistic"})
+
+        # Mesh links, or endpoints on the edges
+        if y != y_size - 1:
+            rtr.addLink(getLink(name, "rtr.%d.%d"%(x,y+1)), "north", "800ps")
+        else:
+            rtr.addLink(getLink(name, "ep0.%d.%d"%(x,y+1)), "north", "800ps")
+            addEndpoint("ep0.%d.%d"%(x,y+1), name)
+
+        if y != 0:
+            rtr.addLink(getLink("rtr.%d.%d"%(x,y-1), name), "south", "800ps")
+        else:
+            rtr.addLink(getLink(name, "ep0.%d.%d"%(x,y-1)), "south", "800ps")
+            addEndpoint("ep0.%d.%d"%(x,y-1), name)
+
+        if x != x_size - 1:
+            rtr.addLink(getLink(name, "rtr.%d.%d"%(x+1,y)), "east", "800ps")
+        else:
+            rtr.addLink(getLink(name, "ep0.%d.%d"%(x+1,y)), "east", "800ps")
+            addEndpoint("ep0.%d.%d"%(x+1,y), name)
+
+        if x != 0:
+            rtr.addLink(getLink("rtr.%d.%d"%(x-1,y), name), "west", "800ps")
+        else:
+            rtr.addLink(getLink(name, "ep0.%d.%d"%(x-1,y)), "west", "800ps")
+            addEndpoint("ep0.%d.%d"%(x-1,y), name)
+
+        # Local endpoint
+        rtr.addLink(getLink(name, "ep0.%d.%d"%(x,y)), "local0", "800ps")
+        addEndpoint("ep0.%d.%d"%(x,y), name)
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
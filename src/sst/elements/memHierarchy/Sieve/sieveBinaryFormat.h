@@ -0,0 +1,74 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * File:   sieveBinaryFormat.h
+ *
+ * Binary allocation-tracking output shared by Sieve and sst-sieve-reader.
+ * No SST dependencies so the offline reader can include it.
+ *
+ * Layout (zlib-compressed when built with libz; gzread reads either):
+ *   File header:   "SIEVEBIN" (8 bytes), version (varint), flags (varint)
+ *   Records, appended as the simulation runs:
+ *     type      (1 byte)  RECORD_DUMP
+ *     sequence  (varint)  Dump number, matches the text file sequence number
+ *     marker    (varint)  Buoy marker + 1, or 0 if the dump was not triggered by a buoy
+ *     time      (varint)  Simulated time of the dump in ns
+ *     count     (varint)  Number of allocation entries
+ *     entries   count x { mallocID delta from previous entry (varint), reads (varint), writes (varint) }
+ *   Entries are sorted by mallocID and hold the same counts as the text file for that dump.
+ *   With FLAG_RESET (reset_stats_at_buoy) counts are the accesses since the previous record,
+ *   so the totals for a run are the sum over all records. Otherwise they are running totals
+ *   and the last record holds the totals for the run.
+ */
+
+#ifndef _SIEVEBINARYFORMAT_H_
+#define _SIEVEBINARYFORMAT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace SST { namespace MemHierarchy { namespace SieveBinary {
+
+static const char MAGIC[8] = { 'S', 'I', 'E', 'V', 'E', 'B', 'I', 'N' };
+static const uint64_t VERSION = 2;
+
+enum RecordType : uint8_t { RECORD_DUMP = 1 };
+enum Flags : uint64_t { FLAG_RESET = 1 };
+
+/* LEB128 unsigned varint */
+inline void putVarint(std::vector<uint8_t>& buf, uint64_t val) {
+    while (val >= 0x80) {
+        buf.push_back((uint8_t)(val | 0x80));
+        val >>= 7;
+    }
+    buf.push_back((uint8_t)val);
+}
+
+/* Returns bytes consumed or 0 if buf does not hold a complete varint */
+inline size_t getVarint(const uint8_t* buf, size_t len, uint64_t& val) {
+    val = 0;
+    for (size_t i = 0; i < len && i < 10; i++) {
+        val |= (uint64_t)(buf[i] & 0x7f) << (7 * i);
+        if (!(buf[i] & 0x80))
+            return i + 1;
+    }
+    return 0;
+}
+
+}}}
+
+#endif
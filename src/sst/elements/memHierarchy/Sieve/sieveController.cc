@@ -22,7 +22,10 @@
 //#include <sst/core/simulation.h>
 #include <sst/core/interfaces/stringEvent.h>
 
+#include <algorithm>
+
 #include "sieveController.h"
+#include "sieveBinaryFormat.h"
 #include "../memEvent.h"
 
 using namespace SST;
@@ -194,6 +197,11 @@ void Sieve::init(unsigned int phase) {
 }
 
 void Sieve::outputStats(int marker) {
+    if (binaryOutput_) {
+        writeBinaryRecord(marker);
+        return;
+    }
+
     // create name <outFileName> + <sequence> + marker (optional)
     stringstream fileName;
     fileName << outFileName << "-" << outCount;
@@ -238,8 +246,94 @@ void Sieve::outputStats(int marker) {
     delete output_file;
 }
 
+bool Sieve::intervalDump(Cycle_t cycle) {
+    outputStats(-1);
+    return false;
+}
+
+void Sieve::openBinaryOutput() {
+    std::string fileName = outFileName + ".sieve";
+#ifdef HAVE_LIBZ
+    binGzFile_ = gzopen(fileName.c_str(), "wb");
+    if (binGzFile_ == NULL)
+#else
+    binFile_ = fopen(fileName.c_str(), "wb");
+    if (binFile_ == NULL)
+#endif
+        output_->fatal(CALL_INFO, -1, "Unable to open binary output file '%s'\n", fileName.c_str());
+
+    std::vector<uint8_t> header(SieveBinary::MAGIC, SieveBinary::MAGIC + sizeof(SieveBinary::MAGIC));
+    SieveBinary::putVarint(header, SieveBinary::VERSION);
+    SieveBinary::putVarint(header, resetStatsOnOutput ? SieveBinary::FLAG_RESET : 0);
+    writeBinary(header);
+}
+
+/* Append one record and flush it so the file stays readable if the simulation stops early */
+void Sieve::writeBinary(const std::vector<uint8_t>& buf) {
+#ifdef HAVE_LIBZ
+    gzwrite(binGzFile_, buf.data(), buf.size());
+    gzflush(binGzFile_, Z_SYNC_FLUSH);
+#else
+    fwrite(buf.data(), 1, buf.size(), binFile_);
+    fflush(binFile_);
+#endif
+}
+
+/* Binary records hold the same counts as the text output, and clear them the same way */
+void Sieve::writeBinaryRecord(int marker) {
+    std::vector<std::pair<uint64_t, rwCount_t> > entries;
+    entries.reserve(allocMap.size());
+    for (allocCountMap_t::iterator i = allocMap.begin(); i != allocMap.end();) {
+        if (i->second.first == 0 && i->second.second == 0) {
+            i = allocMap.erase(i);
+            continue;
+        }
+        entries.push_back(*i);
+        i++;
+    }
+    std::sort(entries.begin(), entries.end());
+    if (resetStatsOnOutput)
+        allocMap.clear();
+
+    std::vector<uint8_t> buf;
+    buf.reserve(16 + entries.size() * 6);
+    buf.push_back(SieveBinary::RECORD_DUMP);
+    SieveBinary::putVarint(buf, outCount);
+    SieveBinary::putVarint(buf, (marker == -1) ? 0 : (uint64_t)marker + 1);
+    SieveBinary::putVarint(buf, getCurrentSimTimeNano());
+    SieveBinary::putVarint(buf, entries.size());
+    uint64_t prevID = 0;
+    for (std::vector<std::pair<uint64_t, rwCount_t> >::iterator i = entries.begin(); i != entries.end(); i++) {
+        SieveBinary::putVarint(buf, i->first - prevID);
+        SieveBinary::putVarint(buf, i->second.first);
+        SieveBinary::putVarint(buf, i->second.second);
+        prevID = i->first;
+    }
+    outCount++;
+    writeBinary(buf);
+}
+
+void Sieve::closeBinaryOutput() {
+#ifdef HAVE_LIBZ
+    gzclose(binGzFile_);
+#else
+    fclose(binFile_);
+#endif
+}
+
 void Sieve::finish(){
     outputStats(-1);
+
+    if (binaryOutput_) {
+        closeBinaryOutput();
+
+        // Profiler output stays in text form
+        if (listener_) {
+            Output* output_file = new Output("",0,0,SST::Output::FILE, outFileName + "-profiler.txt");
+            listener_->printStats(*output_file);
+            delete output_file;
+        }
+    }
 }
 
 
@@ -27,6 +27,10 @@
 #include <sst/core/output.h>
 
 #include <unordered_map>
+#include <cstdio>
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
 
 #include "sst/elements/memHierarchy/lineTypes.h"
 #include "sst/elements/memHierarchy/cacheArray.h"
@@ -55,7 +59,9 @@ public:
             {"debug",                   "(uint) Print debug information. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
             {"debug_level",             "(uint) Debugging/verbosity level. Between 0 and 10", "0"},
             {"output_file",             "(string) Name of file to output malloc information to. Will have sequence number (and optional marker number) and .txt appended to it. E.g. sieveMallocRank-3.txt", "sieveMallocRank"},
-            {"reset_stats_at_buoy",     "(bool) Whether to reset allocation hit/miss stats when a buoy is found (i.e., when a new output file is dumped). Any value other than 0 is true." "0"} )
+            {"reset_stats_at_buoy",     "(bool) Whether to reset allocation hit/miss stats when a buoy is found (i.e., when a new output file is dumped). Any value other than 0 is true." "0"},
+            {"output_format",           "(string) Format of allocation output. 'txt' - one text file per dump. 'binary' - a single append-only file, <output_file>.sieve, with one compressed record per dump holding the same counts as the text file would. Read it with sst-sieve-reader.", "txt"},
+            {"output_interval",         "(string) Also dump allocation counts periodically at this interval, with units (e.g., 100us). 0 disables periodic dumps.", "0s"} )
 
     SST_ELI_DOCUMENT_PORTS(
             {"cpu_link_%(port)d", "Ports connected to the CPUs", {"memHierarchy.MemEventBase"}},
@@ -131,6 +137,20 @@ private:
     void outputStats(int marker);
     bool resetStatsOnOutput;
 
+    /** Binary output */
+    bool binaryOutput_;
+#ifdef HAVE_LIBZ
+    gzFile binGzFile_;
+#endif
+    FILE* binFile_;
+    void openBinaryOutput();
+    void writeBinaryRecord(int marker);
+    void writeBinary(const std::vector<uint8_t>& buf);
+    void closeBinaryOutput();
+
+    /** Periodic dump handler */
+    bool intervalDump(Cycle_t cycle);
+
     CacheArray<SharedCacheLine>* cacheArray_;
     Output*             output_;
     vector<SST::Link*>  cpuLinks_;
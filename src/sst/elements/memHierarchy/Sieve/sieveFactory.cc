@@ -75,6 +75,27 @@ Sieve::Sieve(ComponentId_t id, Params &params) : Component(id) {
 
     resetStatsOnOutput = params.find<bool>("reset_stats_at_buoy", 0) != 0;
 
+    binFile_ = nullptr;
+#ifdef HAVE_LIBZ
+    binGzFile_ = nullptr;
+#endif
+    std::string format = params.find<std::string>("output_format", "txt");
+    if (format == "txt" || format == "text") {
+        binaryOutput_ = false;
+    } else if (format == "binary") {
+        binaryOutput_ = true;
+        openBinaryOutput();
+    } else {
+        output_->fatal(CALL_INFO, -1, "Invalid param: output_format - must be 'txt' or 'binary'. You specified '%s'\n", format.c_str());
+    }
+
+    UnitAlgebra interval(params.find<std::string>("output_interval", "0s"));
+    if (!interval.hasUnits("s"))
+        output_->fatal(CALL_INFO, -1, "Invalid param: output_interval - must have units of seconds (e.g., 100us). You specified '%s'\n", interval.toString().c_str());
+    if ((interval / UnitAlgebra("1ps")).getRoundedValue() > 0) {
+        registerClock(interval, new Clock::Handler<Sieve>(this, &Sieve::intervalDump));
+    }
+
     // optional link for allocation / free tracking
     configureLinks();
 
@@ -0,0 +1,101 @@
+#!/usr/bin/env python
+
+# Checks the output of sieve-binary-test.py
+#   usage: checkSieveBinary.py [path to sst-sieve-reader]
+# Run in the directory the test ran in. For each setting of reset_stats_at_buoy (N = 0, 1),
+# sieveBinN.sieve is read back with sst-sieve-reader and compared against the text dumps
+# sieveTxtN-*.txt from the same run: every record must hold the same entries as the text
+# file with the same sequence number and marker, and the reader's totals must match the
+# totals of the text dumps. Exits non-zero if a check fails.
+
+import glob
+import re
+import subprocess
+import sys
+
+reader = sys.argv[1] if len(sys.argv) > 1 else "sst-sieve-reader"
+
+entryPattern = re.compile('\A([0-9]+) ([0-9]+) ([0-9]+)\Z')
+dumpPattern = re.compile('\A# dump ([0-9]+), (no marker|marker ([0-9]+))\Z')
+textNamePattern = re.compile('sieveTxt[01]-([0-9]+)(-([0-9]+))?\.txt\Z')
+
+errors = 0
+def fail(msg):
+    global errors
+    sys.stderr.write("FAIL: %s\n" % msg)
+    errors = errors + 1
+
+def entry(line):
+    entryMatch = entryPattern.match(line)
+    if not entryMatch:
+        return None
+    return tuple(int(x) for x in entryMatch.groups())
+
+def runReader(args):
+    proc = subprocess.Popen([reader] + args, stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+    out, err = proc.communicate()
+    if proc.returncode != 0 or err:
+        fail("'%s %s' failed: %s" % (reader, " ".join(args), err.strip()))
+    return out.splitlines()
+
+# Text dumps: {sequence: (marker, [entries])}
+def readText(reset):
+    dumps = dict()
+    for name in glob.glob("sieveTxt%d-*.txt" % reset):
+        nameMatch = textNamePattern.search(name)
+        if not nameMatch:
+            continue
+        marker = int(nameMatch.group(3)) if nameMatch.group(3) else None
+        with open(name) as f:
+            entries = [e for e in (entry(line.strip()) for line in f) if e]
+        dumps[int(nameMatch.group(1))] = (marker, sorted(entries))
+    return dumps
+
+# Reader's per-record output: {sequence: (marker, [entries])}
+def readRecords(reset):
+    records = dict()
+    current = None
+    for line in runReader(["-r", "sieveBin%d.sieve" % reset]):
+        dumpMatch = dumpPattern.match(line)
+        if dumpMatch:
+            marker = int(dumpMatch.group(3)) if dumpMatch.group(3) else None
+            current = (marker, [])
+            records[int(dumpMatch.group(1))] = current
+        elif entry(line):
+            current[1].append(entry(line))
+    return records
+
+totals = []
+for reset in range(2):
+    text = readText(reset)
+    records = readRecords(reset)
+
+    if not text:
+        fail("no text dumps sieveTxt%d-*.txt" % reset)
+    if sorted(text.keys()) != sorted(records.keys()):
+        fail("sieveBin%d.sieve has records %s, the text dumps are %s" % (reset, sorted(records.keys()), sorted(text.keys())))
+    for seq in sorted(text.keys()):
+        if seq in records and records[seq] != text[seq]:
+            fail("sieveBin%d.sieve record %d is %s, the text dump is %s" % (reset, seq, records[seq], text[seq]))
+
+    # Running totals are in the last dump, otherwise the dumps add up to the totals
+    expected = dict()
+    for seq in sorted(text.keys()):
+        if not reset:
+            expected = dict()
+        for mallocID, reads, writes in text[seq][1]:
+            count = expected.get(mallocID, (0, 0))
+            expected[mallocID] = (count[0] + reads, count[1] + writes)
+    expected = sorted((mallocID, count[0], count[1]) for mallocID, count in expected.items())
+
+    readerTotals = [entry(line) for line in runReader(["sieveBin%d.sieve" % reset])]
+    if readerTotals != expected:
+        fail("sst-sieve-reader totals for sieveBin%d.sieve are %s, the text dumps add up to %s" % (reset, readerTotals, expected))
+    totals.append(readerTotals)
+
+if totals[0] != totals[1]:
+    fail("totals differ with and without reset_stats_at_buoy: %s and %s" % (totals[0], totals[1]))
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Checked %d allocations against the text dumps\n" % len(totals[0]))
@@ -0,0 +1,48 @@
+import sst
+
+# Sieve binary output round trip.
+#
+# Four Sieves, each driven by its own memHierarchy.sieveCPU running the
+# same script: text or binary output, with reset_stats_at_buoy off and
+# on.  The Sieve cache is 1KiB, 4-way with 64B lines and the script's
+# working sets are larger than that, so every access misses:
+#
+#   ALLOC 1 (0x100000, 4KiB), 2 (0x200000, 8KiB), 3 (0x300000, 2KiB)
+#   read all 64 lines of 1, write every other line of 2 (64 lines)
+#   BUOY 7
+#   read all of 1 again, write all 32 lines of 3, FREE 2
+#   BUOY 8
+#   read all of 3, read 0x900000 (no allocation)
+#   end, Sieve dumps once more at finish
+#
+# After the run, checkSieveBinary.py reads each binary file back with
+# sst-sieve-reader and compares it against the text dumps from the same
+# settings (sieveTxtN-0-7.txt, sieveTxtN-1-8.txt, sieveTxtN-2.txt for
+# N = 0 without reset and N = 1 with it): each record must hold the same
+# entries as its text file, and the reader's totals must match the
+# totals of the text dumps and be the same for both settings.
+#
+#   sst sieve-binary-test.py && python checkSieveBinary.py
+
+for reset in range(2):
+    for fmt, name in (("txt", "sieveTxt%d"%reset), ("binary", "sieveBin%d"%reset)):
+        cpu = sst.Component("cpu_%s"%name, "memHierarchy.sieveCPU")
+        cpu.addParams({
+            "clock" : "1GHz",
+            "lineSize" : 64,
+        })
+
+        sieve = sst.Component(name, "memHierarchy.Sieve")
+        sieve.addParams({
+            "cache_size" : "1KiB",
+            "associativity" : 4,
+            "cache_line_size" : 64,
+            "output_file" : name,
+            "output_format" : fmt,
+            "reset_stats_at_buoy" : reset,
+        })
+
+        link = sst.Link("link_cpu_%s"%name)
+        link.connect( (cpu, "mem_link", "1ns"), (sieve, "cpu_link_0", "1ns") )
+        link = sst.Link("link_alloc_%s"%name)
+        link.connect( (cpu, "alloc_link", "1ns"), (sieve, "alloc_link_0", "1ns") )
@@ -0,0 +1,258 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * sst-sieve-reader: convert a Sieve binary allocation file (<output_file>.sieve)
+ * back to text. By default prints the per-allocation totals over the run in the
+ * same "mallocID reads writes" form as Sieve's text output. Records are read one
+ * at a time, so only the current record (and the totals) are held in memory.
+ */
+
+#include <sst_config.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include <map>
+#include <vector>
+#include <utility>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#include "../../sieveBinaryFormat.h"
+
+using namespace SST::MemHierarchy;
+
+/* Buffered byte reader over the (possibly compressed) file */
+class SieveFileReader {
+public:
+    SieveFileReader() : in(NULL), pos(0), len(0) { }
+
+    ~SieveFileReader() {
+        if (in != NULL) {
+#ifdef HAVE_LIBZ
+            gzclose(in);
+#else
+            fclose(in);
+#endif
+        }
+    }
+
+    bool open(const char* name) {
+#ifdef HAVE_LIBZ
+        in = gzopen(name, "rb");
+#else
+        in = fopen(name, "rb");
+#endif
+        return in != NULL;
+    }
+
+    /* Returns false at the end of the file */
+    bool getByte(uint8_t& byte) {
+        if (pos == len && !fill())
+            return false;
+        byte = buffer[pos++];
+        return true;
+    }
+
+    bool getVarint(uint64_t& val) {
+        val = 0;
+        uint8_t byte;
+        for (int i = 0; i < 10; i++) {
+            if (!getByte(byte))
+                return false;
+            val |= (uint64_t)(byte & 0x7f) << (7 * i);
+            if (!(byte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+private:
+    bool fill() {
+#ifdef HAVE_LIBZ
+        int n = gzread(in, buffer, sizeof(buffer));
+        if (n <= 0) return false;
+#else
+        size_t n = fread(buffer, 1, sizeof(buffer), in);
+        if (n == 0) return false;
+#endif
+        pos = 0;
+        len = n;
+        return true;
+    }
+
+#ifdef HAVE_LIBZ
+    gzFile in;
+#else
+    FILE* in;
+#endif
+    uint8_t buffer[65536];
+    size_t pos;
+    size_t len;
+};
+
+struct SieveEntry {
+    uint64_t id;
+    uint64_t reads;
+    uint64_t writes;
+};
+
+void printOptions() {
+    printf("SST Sieve Binary Reader\n");
+    printf("============================================================\n\n");
+    printf("sst-sieve-reader [options] <file.sieve>\n\n");
+    printf("-r                 Print each record instead of run totals\n");
+    printf("-c                 Comma-separated output\n");
+    printf("-o <file>          Write to <file> instead of stdout\n");
+    printf("-h                 Print options\n");
+}
+
+int main(int argc, char* argv[]) {
+    bool perRecord = false;
+    bool csv = false;
+    const char* inName = NULL;
+    const char* outName = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0) {
+            perRecord = true;
+        } else if (strcmp(argv[i], "-c") == 0) {
+            csv = true;
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outName = argv[++i];
+        } else if (strcmp(argv[i], "-h") == 0) {
+            printOptions();
+            return 0;
+        } else if (argv[i][0] != '-' && inName == NULL) {
+            inName = argv[i];
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            printOptions();
+            return 1;
+        }
+    }
+
+    if (inName == NULL) {
+        printOptions();
+        return 1;
+    }
+
+    SieveFileReader in;
+    if (!in.open(inName)) {
+        fprintf(stderr, "Error: unable to read %s\n", inName);
+        return 1;
+    }
+
+    for (size_t i = 0; i < sizeof(SieveBinary::MAGIC); i++) {
+        uint8_t byte;
+        if (!in.getByte(byte) || byte != (uint8_t)SieveBinary::MAGIC[i]) {
+            fprintf(stderr, "Error: %s is not a Sieve binary file\n", inName);
+            return 1;
+        }
+    }
+
+    uint64_t version, flags;
+    if (!in.getVarint(version) || version != SieveBinary::VERSION || !in.getVarint(flags)) {
+        fprintf(stderr, "Error: unsupported Sieve binary version in %s\n", inName);
+        return 1;
+    }
+    bool reset = (flags & SieveBinary::FLAG_RESET) != 0;
+
+    FILE* out = stdout;
+    if (outName != NULL) {
+        out = fopen(outName, "wt");
+        if (out == NULL) {
+            fprintf(stderr, "Error: unable to open %s\n", outName);
+            return 1;
+        }
+    }
+
+    const char* sep = csv ? "," : " ";
+    if (perRecord && csv)
+        fprintf(out, "sequence,marker,time_ns,mallocID,reads,writes\n");
+
+    // Run totals. Records hold running totals unless the counts were reset at each one.
+    std::map<uint64_t, std::pair<uint64_t, uint64_t> > totals;
+    std::vector<SieveEntry> entries;
+    uint8_t type;
+
+    while (in.getByte(type)) {
+        if (type != SieveBinary::RECORD_DUMP) {
+            fprintf(stderr, "Error: unknown record type %u\n", type);
+            break;
+        }
+
+        uint64_t header[4]; // sequence, marker, time, count
+        bool complete = true;
+        for (int h = 0; h < 4 && complete; h++)
+            complete = in.getVarint(header[h]);
+
+        entries.clear();
+        uint64_t id = 0;
+        for (uint64_t e = 0; complete && e < header[3]; e++) {
+            SieveEntry entry;
+            complete = in.getVarint(entry.id) && in.getVarint(entry.reads) && in.getVarint(entry.writes);
+            id += entry.id;
+            entry.id = id;
+            entries.push_back(entry);
+        }
+        if (!complete) {
+            // Sieve flushes after every record, so a partial record means the run stopped mid-write
+            fprintf(stderr, "Warning: %s ends with a partial record, ignoring it\n", inName);
+            break;
+        }
+
+        if (perRecord && !csv) {
+            if (header[1] == 0)
+                fprintf(out, "# dump %" PRIu64 ", no marker\n", header[0]);
+            else
+                fprintf(out, "# dump %" PRIu64 ", marker %" PRIu64 "\n", header[0], header[1] - 1);
+            fprintf(out, "# time %" PRIu64 " ns\n", header[2]);
+        }
+
+        if (!reset)
+            totals.clear();
+
+        for (std::vector<SieveEntry>::iterator it = entries.begin(); it != entries.end(); it++) {
+            if (perRecord && csv) {
+                fprintf(out, "%" PRIu64 ",", header[0]);
+                if (header[1] != 0)
+                    fprintf(out, "%" PRIu64, header[1] - 1);
+                fprintf(out, ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n", header[2], it->id, it->reads, it->writes);
+            } else if (perRecord) {
+                fprintf(out, "%" PRIu64 " %" PRIu64 " %" PRIu64 "\n", it->id, it->reads, it->writes);
+            } else {
+                std::pair<uint64_t, uint64_t>& t = totals[it->id];
+                t.first += it->reads;
+                t.second += it->writes;
+            }
+        }
+    }
+
+    if (!perRecord) {
+        for (std::map<uint64_t, std::pair<uint64_t, uint64_t> >::iterator it = totals.begin(); it != totals.end(); it++)
+            fprintf(out, "%" PRIu64 "%s%" PRIu64 "%s%" PRIu64 "\n", it->first, sep, it->second.first, sep, it->second.second);
+    }
+
+    if (out != stdout)
+        fclose(out);
+
+    return 0;
+}
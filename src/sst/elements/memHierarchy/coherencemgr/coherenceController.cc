@@ -319,7 +319,7 @@ bool CoherenceController::sendOutgoingEvents() {
 
     // Check for ready events in outgoing 'down' queue
     uint64_t bytesLeft = maxBytesDown;
-    while (!outgoingEventQueue_.empty() && outgoingEventQueue_.front().deliveryTime <= timestamp_) {
+    while (outgoingEventQueue_.ready(timestamp_)) {
         MemEventBase *outgoingEvent = outgoingEventQueue_.front().event;
         if (maxBytesDown != 0) {
             if (bytesLeft == 0) break;
@@ -338,14 +338,15 @@ bool CoherenceController::sendOutgoingEvents() {
                     Simulation::getSimulation()->getCurrentSimCycle(), timestamp_, cachename_.c_str(), outgoingEvent->getBriefString().c_str());
         }
 
+        removeOutgoing(outgoingAddrs_, outgoingEvent->getRoutingAddress());
         linkDown_->send(outgoingEvent);
-        outgoingEventQueue_.pop_front();
+        outgoingEventQueue_.pop();
 
     }
 
     // Check for ready events in outgoing 'up' queue
     bytesLeft = maxBytesUp;
-    while (!outgoingEventQueueUp_.empty() && outgoingEventQueueUp_.front().deliveryTime <= timestamp_) {
+    while (outgoingEventQueueUp_.ready(timestamp_)) {
         MemEventBase * outgoingEvent = outgoingEventQueueUp_.front().event;
         if (maxBytesUp != 0) {
             if (bytesLeft == 0) break;
@@ -368,8 +369,9 @@ bool CoherenceController::sendOutgoingEvents() {
             startTimes_.erase(outgoingEvent->getResponseToID());
         }
 
+        removeOutgoing(outgoingAddrsUp_, outgoingEvent->getRoutingAddress());
         linkUp_->send(outgoingEvent);
-        outgoingEventQueueUp_.pop_front();
+        outgoingEventQueueUp_.pop();
     }
 
     // Return whether it's ok for the cache to turn off the clock - we need it on to be able to send waiting events
@@ -665,15 +667,15 @@ void CoherenceController::printDebugAlloc(bool alloc, Addr addr, std::string not
 void CoherenceController::printStatus(Output& out) {
     out.output("  Begin MemHierarchy::CoherenceController %s\n", getName().c_str());
 
+    auto printResponse = [&out](uint64_t time, const Response& resp) {
+        out.output("      Time: %" PRIu64 ", Event: %s\n", time, resp.event->getVerboseString().c_str());
+    };
+
     out.output("    Events waiting in outgoingEventQueue: %zu\n", outgoingEventQueue_.size());
-    for (list<Response>::iterator it = outgoingEventQueue_.begin(); it!= outgoingEventQueue_.end(); it++) {
-        out.output("      Time: %" PRIu64 ", Event: %s\n", (*it).deliveryTime, (*it).event->getVerboseString().c_str());
-    }
+    outgoingEventQueue_.forEach(printResponse);
 
     out.output("    Events waiting in outgoingEventQueueUp_: %zu\n", outgoingEventQueueUp_.size());
-    for (list<Response>::iterator it = outgoingEventQueueUp_.begin(); it!= outgoingEventQueueUp_.end(); it++) {
-        out.output("      Time: %" PRIu64 ", Event: %s\n", (*it).deliveryTime, (*it).event->getVerboseString().c_str());
-    }
+    outgoingEventQueueUp_.forEach(printResponse);
 
     out.output("  End MemHierarchy::CoherenceController\n");
 }
@@ -690,24 +692,32 @@ void CoherenceController::printStatus(Output& out) {
  * a block and then re-request it, the requests can get inverted.
  */
 void CoherenceController::addToOutgoingQueue(Response& resp) {
-    list<Response>::reverse_iterator rit;
-    for (rit = outgoingEventQueue_.rbegin(); rit!= outgoingEventQueue_.rend(); rit++) {
-        if (resp.deliveryTime >= (*rit).deliveryTime) break;
-        if (resp.event->getRoutingAddress() == (*rit).event->getRoutingAddress()) break;
-    }
-    outgoingEventQueue_.insert(rit.base(), resp);
+    insertOutgoing(outgoingEventQueue_, outgoingAddrs_, resp);
 }
 
 /* Add a new event to the outgoing queue up (towards memory)
  * Again, to do not reorder events to the same address
  */
 void CoherenceController::addToOutgoingQueueUp(Response& resp) {
-    list<Response>::reverse_iterator rit;
-    for (rit = outgoingEventQueueUp_.rbegin(); rit != outgoingEventQueueUp_.rend(); rit++) {
-        if (resp.deliveryTime >= (*rit).deliveryTime) break;
-        if (resp.event->getRoutingAddress() == (*rit).event->getRoutingAddress()) break;
-    }
-    outgoingEventQueueUp_.insert(rit.base(), resp);
+    insertOutgoing(outgoingEventQueueUp_, outgoingAddrsUp_, resp);
+}
+
+/* An event is never sent ahead of an event to the same address that is already queued,
+ * so its delivery time is pushed out to the latest queued delivery time for that address
+ */
+void CoherenceController::insertOutgoing(TimingWheel<Response>& queue, OutgoingAddrMap& addrs, Response& resp) {
+    std::pair<uint64_t, uint32_t>& last = addrs[resp.event->getRoutingAddress()];
+    if (last.second != 0 && last.first > resp.deliveryTime)
+        resp.deliveryTime = last.first;
+    last.first = resp.deliveryTime;
+    last.second++;
+    queue.insert(resp.deliveryTime, resp);
+}
+
+void CoherenceController::removeOutgoing(OutgoingAddrMap& addrs, Addr addr) {
+    OutgoingAddrMap::iterator it = addrs.find(addr);
+    if (it != addrs.end() && --(it->second.second) == 0)
+        addrs.erase(it);
 }
 
 
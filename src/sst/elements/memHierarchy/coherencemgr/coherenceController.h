@@ -17,6 +17,7 @@
 #define MEMHIERARCHY_COHERENCECONTROLLER_H
 
 #include <array>
+#include <unordered_map>
 
 #include <sst/core/sst_config.h>
 #include <sst/core/subcomponent.h>
@@ -32,6 +33,7 @@
 #include "sst/elements/memHierarchy/memLinkBase.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
 #include "sst/elements/memHierarchy/hash.h"
+#include "sst/elements/memHierarchy/timingWheel.h"
 
 namespace SST { namespace MemHierarchy {
 using namespace std;
@@ -316,8 +318,16 @@ protected:
 
 private:
     /* Outgoing event queues - events are stalled here to account for access latencies */
-    list<Response> outgoingEventQueue_;
-    list<Response> outgoingEventQueueUp_;
+    TimingWheel<Response> outgoingEventQueue_;
+    TimingWheel<Response> outgoingEventQueueUp_;
+
+    /* Latest queued delivery time & number of queued events per address, used to avoid reordering events to the same address */
+    typedef std::unordered_map<Addr, std::pair<uint64_t, uint32_t> > OutgoingAddrMap;
+    OutgoingAddrMap outgoingAddrs_;
+    OutgoingAddrMap outgoingAddrsUp_;
+
+    void insertOutgoing(TimingWheel<Response>& queue, OutgoingAddrMap& addrs, Response& resp);
+    void removeOutgoing(OutgoingAddrMap& addrs, Addr addr);
 
     MemLinkBase * linkUp_;
     MemLinkBase * linkDown_;
@@ -107,8 +107,8 @@ bool CoherentMemController::clock(Cycle_t cycle) {
     timestamp_++;
 
     bool debug = false;
-    while (!msgQueue_.empty() && msgQueue_.begin()->first < timestamp_) {
-        MemEventBase * sendEv = msgQueue_.begin()->second;
+    while (msgQueue_.ready(timestamp_ - 1)) {
+        MemEventBase * sendEv = msgQueue_.front();
 
         if (is_debug_event(sendEv)) {
             if (!debug) dbg.debug(_L4_, "\n");
@@ -117,7 +117,7 @@ bool CoherentMemController::clock(Cycle_t cycle) {
         }
 
         link_->send(sendEv);
-        msgQueue_.erase(msgQueue_.begin());
+        msgQueue_.pop();
     }
 
     /* Unclock if nothing is in clocked queues anywhere (link, backend, here) */
@@ -431,7 +431,7 @@ void CoherentMemController::handleNack(MemEvent * ev) {
         uint64_t backoff = (0x1 << retries);
         nackedEvent->incrementRetries();
 
-        msgQueue_.insert(std::make_pair(timestamp_ + backoff, nackedEvent));
+        msgQueue_.insert(timestamp_ + backoff, nackedEvent);
     } else {
         delete nackedEvent;
     }
@@ -486,7 +486,7 @@ bool CoherentMemController::doShootdown(Addr addr, MemEventBase * ev) {
         inv->setRqstr(ev->getRqstr());
         inv->setDst(ev->getSrc());
 
-        msgQueue_.insert(std::make_pair(timestamp_, inv)); /* Send on next clock. TODO timing needed? */
+        msgQueue_.insert(timestamp_, inv); /* Send on next clock. TODO timing needed? */
         return true;
     }
     return false;
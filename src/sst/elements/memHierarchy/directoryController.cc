@@ -327,6 +327,11 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     /* Get latencies */
     accessLatency   = params.find<uint64_t>("access_latency_cycles", 0);
     mshrLatency     = params.find<uint64_t>("mshr_latency_cycles", 0);
+
+    /* Size outgoing queues to cover the longest fixed latency so inserts never overflow */
+    uint64_t maxLatency = (accessLatency > mshrLatency ? accessLatency : mshrLatency) + 2;
+    cpuMsgQueue.setSpan(maxLatency);
+    memMsgQueue.setSpan(maxLatency);
 }
 
 
@@ -1905,7 +1910,7 @@ bool DirectoryController::handleNACK(MemEvent* event, bool inMSHR) {
                     getName().c_str(), StateString[state], nackedEvent->getVerboseString().c_str(), getCurrentSimTimeNano());
     }
     // Resend nack'd event
-    cpuMsgQueue.insert(std::make_pair(timestamp + mshrLatency, nackedEvent)); // Resend after MSHR lookup (assuming we store info about responses there)
+    cpuMsgQueue.insert(timestamp + mshrLatency, nackedEvent); // Resend after MSHR lookup (assuming we store info about responses there)
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
@@ -1964,7 +1969,7 @@ bool DirectoryController::retrieveDirEntry(DirEntry* entry, MemEvent* event, boo
 
     uint64_t deliveryTime = timestamp + accessLatency;
 
-    memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(me, true)));
+    memMsgQueue.insert(deliveryTime, MemMsg(me, true));
 
     return true;
 }
@@ -2070,7 +2075,7 @@ void DirectoryController::sendEntryToMemory(DirEntry *entry) {
         me->setDst(memLink->findTargetDestination(0));
     else
         me->setDst(memoryName);
-    memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(me, true)));
+    memMsgQueue.insert(deliveryTime, MemMsg(me, true));
 }
 
 /****************************
@@ -2087,7 +2092,7 @@ void DirectoryController::issueMemoryRequest(MemEvent* event, DirEntry* entry) {
     memReqs[reqEvent->getID()] = event->getBaseAddr();
     uint64_t deliveryTime = timestamp + accessLatency;
 
-    memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(reqEvent, false)));
+    memMsgQueue.insert(deliveryTime, MemMsg(reqEvent, false));
 
     mshr->setInProgress(entry->getBaseAddr());
 }
@@ -2114,7 +2119,7 @@ void DirectoryController::issueFlush(MemEvent* event) {
     mshr->setInProgress(addr);
 
     uint64_t deliveryTime = timestamp + accessLatency;
-    memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(flush, false)));
+    memMsgQueue.insert(deliveryTime, MemMsg(flush, false));
 }
 
 void DirectoryController::issueFetch(MemEvent* event, DirEntry* entry, Command cmd) {
@@ -2132,7 +2137,7 @@ void DirectoryController::issueFetch(MemEvent* event, DirEntry* entry, Command c
 
     mshr->incrementAcksNeeded(addr);
 
-    cpuMsgQueue.insert(std::make_pair(timestamp+accessLatency, fetch));
+    cpuMsgQueue.insert(timestamp+accessLatency, fetch);
 }
 
 void DirectoryController::issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd) {
@@ -2166,7 +2171,7 @@ void DirectoryController::issueInvalidation(std::string dst, MemEvent* event, Di
     }
 
     uint64_t deliveryTime = timestamp + accessLatency;
-    cpuMsgQueue.insert(std::make_pair(deliveryTime, inv));
+    cpuMsgQueue.insert(deliveryTime, inv);
 }
 
 void DirectoryController::sendDataResponse(MemEvent* event, DirEntry* entry, std::vector<uint8_t>& data, Command cmd, uint32_t flags) {
@@ -2174,7 +2179,7 @@ void DirectoryController::sendDataResponse(MemEvent* event, DirEntry* entry, std
     respEv->setSize(lineSize);
     respEv->setPayload(data);
     respEv->setMemFlags(flags);
-    cpuMsgQueue.insert(std::make_pair(timestamp+mshrLatency, respEv));
+    cpuMsgQueue.insert(timestamp+mshrLatency, respEv);
 }
 
 void DirectoryController::sendResponse(MemEvent* event, uint32_t flags, uint32_t memflags) {
@@ -2182,7 +2187,7 @@ void DirectoryController::sendResponse(MemEvent* event, uint32_t flags, uint32_t
     respEv->setSize(lineSize);
     respEv->setMemFlags(memflags);
     respEv->setFlags(flags);
-    cpuMsgQueue.insert(std::make_pair(timestamp + mshrLatency, respEv));
+    cpuMsgQueue.insert(timestamp + mshrLatency, respEv);
 }
 
 void DirectoryController::writebackData(MemEvent* event) {
@@ -2198,7 +2203,7 @@ void DirectoryController::writebackData(MemEvent* event) {
         mshr->insertWriteback(event->getBaseAddr(), false);
 
     uint64_t deliveryTime = timestamp + accessLatency;
-    memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(wb, false)));
+    memMsgQueue.insert(deliveryTime, MemMsg(wb, false));
 }
 
 void DirectoryController::writebackDataFromMSHR(Addr addr) {
@@ -2214,7 +2219,7 @@ void DirectoryController::writebackDataFromMSHR(Addr addr) {
         mshr->insertWriteback(addr, false);
 
     uint64_t deliveryTime = timestamp + mshrLatency;
-    memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(wb, false)));
+    memMsgQueue.insert(deliveryTime, MemMsg(wb, false));
 }
 
 void DirectoryController::sendFetchResponse(MemEvent * event) {
@@ -2230,7 +2235,7 @@ void DirectoryController::sendFetchResponse(MemEvent * event) {
 
     mshr->clearData(addr);
 
-    memMsgQueue.insert(std::make_pair(timestamp + accessLatency, MemMsg(ack, false)));
+    memMsgQueue.insert(timestamp + accessLatency, MemMsg(ack, false));
 }
 
 void DirectoryController::sendAckInv(MemEvent * event) {
@@ -2244,14 +2249,14 @@ void DirectoryController::sendAckInv(MemEvent * event) {
     if (mshr->hasData(addr))
         mshr->clearData(addr);
 
-    memMsgQueue.insert(std::make_pair(timestamp + accessLatency, MemMsg(ack, false)));
+    memMsgQueue.insert(timestamp + accessLatency, MemMsg(ack, false));
 }
 
 void DirectoryController::sendAckPut(MemEvent * event) {
     Addr addr = event->getBaseAddr();
     MemEvent * ack = event->makeResponse(Command::AckPut);
 
-    cpuMsgQueue.insert(std::make_pair(timestamp + accessLatency, ack));
+    cpuMsgQueue.insert(timestamp + accessLatency, ack);
 }
 
 void DirectoryController::sendNACK(MemEvent * event) {
@@ -2259,7 +2264,7 @@ void DirectoryController::sendNACK(MemEvent * event) {
 
     uint64_t deliveryTime = timestamp + accessLatency;
 
-    cpuMsgQueue.insert(std::make_pair(deliveryTime, nack));
+    cpuMsgQueue.insert(deliveryTime, nack);
 }
 
 
@@ -2267,8 +2272,8 @@ void DirectoryController::sendNACK(MemEvent * event) {
 void DirectoryController::sendOutgoingEvents() {
 
     bool debugLine = false;
-    while (!cpuMsgQueue.empty() && cpuMsgQueue.begin()->first <= timestamp) {
-        MemEventBase * ev = cpuMsgQueue.begin()->second;
+    while (cpuMsgQueue.ready(timestamp)) {
+        MemEventBase * ev = cpuMsgQueue.front();
 
         if (is_debug_event(ev)) {
             dbg.debug(_L4_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:Send    (%s)\n",
@@ -2283,18 +2288,18 @@ void DirectoryController::sendOutgoingEvents() {
         }
         stat_eventSent[(int)ev->getCmd()]->addData(1);
         cpuLink->send(ev);
-        cpuMsgQueue.erase(cpuMsgQueue.begin());
+        cpuMsgQueue.pop();
     }
 
-    while (!memMsgQueue.empty() && memMsgQueue.begin()->first <= timestamp) {
-        MemEventBase * ev = memMsgQueue.begin()->second.event;
+    while (memMsgQueue.ready(timestamp)) {
+        MemEventBase * ev = memMsgQueue.front().event;
 
         if (is_debug_event(ev)) {
             dbg.debug(_L4_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:Send    (%s)\n",
                     Simulation::getSimulation()->getCurrentSimCycle(), timestamp, getName().c_str(), ev->getBriefString().c_str());
         }
 
-        if (memMsgQueue.begin()->second.dirAccess) {
+        if (memMsgQueue.front().dirAccess) {
             if (ev->getCmd() == Command::GetS)
                 stat_dirEntryReads->addData(1);
             else
@@ -2303,17 +2308,17 @@ void DirectoryController::sendOutgoingEvents() {
             stat_eventSent[(int)ev->getCmd()]->addData(1);
         }
         memLink->send(ev);
-        memMsgQueue.erase(memMsgQueue.begin());
+        memMsgQueue.pop();
     }
 
 }
 
 void DirectoryController::forwardTowardsMem(MemEventBase* ev) {
-    memMsgQueue.insert(std::make_pair(timestamp+1, MemMsg(ev, false)));
+    memMsgQueue.insert(timestamp+1, MemMsg(ev, false));
 }
 
 void DirectoryController::forwardTowardsCPU(MemEventBase* ev) {
-    cpuMsgQueue.insert(std::make_pair(timestamp+1, ev));
+    cpuMsgQueue.insert(timestamp+1, ev);
 }
 
 void DirectoryController::recordStartLatency(MemEventBase* ev) {
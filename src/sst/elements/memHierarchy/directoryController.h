@@ -37,6 +37,7 @@
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/mshr.h"
+#include "sst/elements/memHierarchy/timingWheel.h"
 
 using namespace std;
 
@@ -396,8 +397,8 @@ private:
         }
     };
 
-    std::multimap<uint64_t,MemEventBase*>   cpuMsgQueue;
-    std::multimap<uint64_t,MemMsg>   memMsgQueue;
+    TimingWheel<MemEventBase*>  cpuMsgQueue;
+    TimingWheel<MemMsg>         memMsgQueue;
 
     uint64_t    entryCacheMaxSize;
     uint64_t    entryCacheSize;
@@ -19,6 +19,8 @@
 #include <sst/core/component.h>
 #include <sst/core/params.h>
 
+#include <algorithm>
+
 using namespace SST;
 using namespace SST::MemHierarchy;
 
@@ -27,7 +29,7 @@ uint64_t DMACommand::main_id = 0;
 DMAEngine::DMAEngine(ComponentId_t id, Params &params) :
     Component(id)
 {
-    dbg.init("@t:DMAEngine::@p():@l " + getName() + ": ", 0, 0,
+    dbg.init("@t:DMAEngine::@p():@l " + getName() + ": ", params.find<int>("debug_level", 0), 0,
             (Output::output_location_t)params.find<int>("debug", 0));
     statsOutputTarget = (Output::output_location_t)params.find<int>("printStats", 0);
 
@@ -36,58 +38,65 @@ DMAEngine::DMAEngine(ComponentId_t id, Params &params) :
     commandLink = configureLink("cmdLink", tc, NULL);
     if ( NULL == commandLink ) dbg.fatal(CALL_INFO, 1, "Missing cmdLink\n");
 
-    if ( !isPortConnected("netLink") ) dbg.fatal(CALL_INFO, 1, "Missing netLink\n");
-/*
-    MemNIC::ComponentInfo myInfo;
-    myInfo.link_port = "netLink";
-    myInfo.link_bandwidth = "1GiB/s";
-	myInfo.num_vcs = params.find<int>("network_num_vc", 1);
-    myInfo.name = getName();
-    myInfo.type = MemNIC::TypeDMAEngine;
-    networkLink = new MemNIC(this, &dbg, -1, myInfo);
-*/
+    networkLink = loadUserSubComponent<MemLinkBase>("memlink");
+    if ( NULL == networkLink ) dbg.fatal(CALL_INFO, 1, "No link manager loaded into 'memlink' subcomponent slot\n");
+    networkLink->setRecvHandler(new Event::Handler<DMAEngine>(this, &DMAEngine::handleEvent));
+    networkLink->setName(getName());
+
+    transferSize = params.find<uint64_t>("transfer_size", 64);
+    maxOutstanding = params.find<uint64_t>("max_outstanding", 16);
+    maxIssuePerCycle = params.find<uint64_t>("max_issue_per_cycle", 1);
+    maxActiveCommands = params.find<uint64_t>("max_active_commands", 0);
+    if ( 0 == transferSize ) dbg.fatal(CALL_INFO, 1, "Invalid param: transfer_size must be greater than 0\n");
+    if ( 0 == maxOutstanding ) dbg.fatal(CALL_INFO, 1, "Invalid param: max_outstanding must be greater than 0\n");
+    if ( 0 == maxIssuePerCycle ) dbg.fatal(CALL_INFO, 1, "Invalid param: max_issue_per_cycle must be greater than 0\n");
+
     blocksize = 0;
+    outstanding = 0;
+    numTransfers = 0;
+    bytesTransferred = 0;
+    numMemRequests = 0;
 }
 
 
 void DMAEngine::init(unsigned int phase)
 {
     networkLink->init(phase);
+
+    if ( !phase ) {
+        networkLink->sendInitData(new MemEventInitCoherence(getName(), Endpoint::CPU, false, false, 0, false));
+    }
+
+    /* Learn line size from the memory system so requests don't cross lines */
+    while ( MemEventInit *ev = networkLink->recvInitData() ) {
+        if ( ev->getInitCmd() == MemEventInit::InitCommand::Coherence ) {
+            MemEventInitCoherence *evC = static_cast<MemEventInitCoherence*>(ev);
+            if ( 0 == blocksize && evC->getLineSize() != 0 )
+                blocksize = evC->getLineSize();
+        }
+        delete ev;
+    }
 }
 
 
 void DMAEngine::setup(void)
 {
     networkLink->setup();
-    bool blocksizeSet = false;
-
-/*    const std::vector<MemNIC::PeerInfo_t> &peers = networkLink->getPeerInfo();
-    for ( std::vector<MemNIC::PeerInfo_t>::const_iterator i = peers.begin() ; i != peers.end() ; ++i ) {
-        switch (i->first.type) {
-        case MemNIC::TypeDirectoryCtrl:
-            break;
-        case MemNIC::TypeCache:
-            if ( !blocksizeSet ) {
-                blocksize = i->second.blocksize;
-                blocksizeSet = true;
-            }
-        default:
-            ;
-        }
-    }
-
-    networkLink->clearPeerInfo();*/
 }
 
 
 void DMAEngine::finish(void)
 {
+    networkLink->finish();
+
     Output out("", 0, 0, statsOutputTarget);
     out.output("DMA Controller %s stats:\n"
             "\t # Transfers:        %" PRIu64 "\n"
+            "\t # Memory Requests:  %" PRIu64 "\n"
             "\t Bytes Transferred:  %" PRIu64 "\n",
             getName().c_str(),
             numTransfers,
+            numMemRequests,
             bytesTransferred);
 }
 
@@ -97,39 +106,35 @@ bool DMAEngine::clock(Cycle_t cycle)
     /* Process Network
      * Check Command link
      * If new command, check overlap, and delay if needed, otherwise process
+     * Issue memory requests for active commands
      */
+    if ( networkLink->isClocked() )
+        networkLink->clock();
 
-    //networkLink->clock();
-
-    MemEventBase *me = NULL;
     SST::Event *se = NULL;
 
-//    while ( NULL != (me = networkLink->recv()) ) {
-        /* Process network packet */
-/*        Request* req = findRequest(me->getResponseToID());
-#ifdef __SST_DEBUG_OUTPUT__
-        if ( NULL == req ) {
-            dbg.debug(_L10_, "Received Packet for which we have no response ID waiting.  ID received: (%" PRIx64 ", %d)\n", me->getResponseToID().first, me->getResponseToID().second);
-        }
-#endif
-        processPacket(req, me);
-    }
-*/
-
     while ( NULL != (se = commandLink->recv()) ) {
         /* Process new commands */
         DMACommand* cmd = static_cast<DMACommand*>(se);
         commandQueue.push_back(cmd);
     }
 
-    /* See if we can process the next command */
-    if ( !commandQueue.empty() ) {
+    /* Start commands in order until one conflicts with an in-flight command */
+    while ( !commandQueue.empty() && (0 == maxActiveCommands || activeRequests.size() < maxActiveCommands) ) {
         DMACommand *cmd = commandQueue.front();
-        if ( isIssuable(cmd) ) {
-            commandQueue.pop_front();
-            Request *req = new Request(cmd);
-            startRequest(req);
-        }
+        if ( !isIssuable(cmd) )
+            break;
+        commandQueue.pop_front();
+        startRequest(new Request(cmd));
+    }
+
+    /* Issue memory requests, oldest command first */
+    uint64_t issued = 0;
+    for ( std::deque<Request*>::iterator it = activeRequests.begin(); it != activeRequests.end() && issued < maxIssuePerCycle; ++it ) {
+        while ( issued < maxIssuePerCycle && outstanding < maxOutstanding && issueNext(*it) )
+            issued++;
+        if ( outstanding == maxOutstanding )
+            break;
     }
 
     return false;
@@ -138,100 +143,219 @@ bool DMAEngine::clock(Cycle_t cycle)
 
 bool DMAEngine::isIssuable(DMACommand *cmd) const
 {
-    bool isOK = true;
-    /* Cycle through current requests.  If any overlap, then we should wait. */
-    for ( std::set<Request*>::iterator i = activeRequests.begin() ; isOK && i != activeRequests.end() ; ++i ) {
-        Request *req = (*i);
-        isOK = !findOverlap(req->command, cmd);
+    /* Check this command's ranges against the in-flight ranges.
+     * Reads may overlap other reads; anything else must wait. */
+    for ( std::vector<DMADescriptor>::const_iterator it = cmd->descriptors.begin(); it != cmd->descriptors.end(); ++it ) {
+        if ( writeRanges.overlaps(it->src, it->srcEnd()) )
+            return false;
+        if ( writeRanges.overlaps(it->dst, it->dstEnd()) || readRanges.overlaps(it->dst, it->dstEnd()) )
+            return false;
     }
-
-    return isOK;
+    return true;
 }
 
 
 void DMAEngine::startRequest(Request *req)
 {
-    assert(0);
-    /*  Needs to be updated with current MemHierarchy Commands/States, MemHierarchyInterface
-    dbg.debug(_L10_, "Received request to transfer from %#" PRIx64 " to 0x%" PRIx64 "\n",
-            req->getSrc(), req->getDst());
+    dbg.debug(_L10_, "Received request to transfer from %#" PRIx64 " to 0x%" PRIx64 ", %zu descriptors\n",
+            req->command->src, req->command->dst, req->command->descriptors.size());
     ++numTransfers;
-    Addr ptr = req->getSrc();
-    while ( ptr < (req->getSrc() + req->getSize()) ) {
-        MemEvent *ev = new MemEvent(this, ptr, ptr, GetS);
-        ev->setSize(blocksize);
-        ev->setFlag(MemEvent::F_NONCACHEABLE);
-        ev->setDst(networkLink->findTargetDestination(ptr));
-        req->loadKeys.insert(ev->getID());
-        networkLink->send(ev);
-        ptr += blocksize;
+
+    req->bytesLeft = 0;
+    for ( std::vector<DMADescriptor>::const_iterator it = req->command->descriptors.begin(); it != req->command->descriptors.end(); ++it )
+        req->bytesLeft += it->size * it->count;
+
+    if ( 0 == req->bytesLeft ) {
+        commandLink->send(req->command);
+        delete req;
+        return;
     }
-    activeRequests.insert(req);
-    */
+
+    updateRanges(req->command, true);
+    activeRequests.push_back(req);
 }
 
 
-void DMAEngine::processPacket(Request *req, MemEventBase *ev)
+/* Issue the next read for a request. Returns false if the request has nothing left to issue */
+bool DMAEngine::issueNext(Request *req)
 {
-    assert(0);
-    /*  Needs to be updated with current MemHierarchy Commands/States, MemHierarchyInterface
-    if ( ev->getCmd() == GetSResp) {
-        if ( !req->loadKeys.count(ev->getResponseToID()) ) {
-            dbg.fatal(CALL_INFO, 1, "Received GetSResp, but we don't have a corresponding request in loadKeys!\n");
-        }
-        size_t offset = ev->getAddr() - req->getSrc();
-        req->loadKeys.erase(ev->getResponseToID());
-        MemEvent *storeEV = new MemEvent(this, (req->getDst() + offset), (req->getDst() + offset), GetX);
+    std::vector<DMADescriptor>& descs = req->command->descriptors;
+    while ( !req->issueDone() && (0 == descs[req->descriptor].size || req->block == descs[req->descriptor].count) ) {
+        req->descriptor++;
+        req->block = 0;
+        req->offset = 0;
+    }
+    if ( req->issueDone() )
+        return false;
+
+    DMADescriptor &desc = descs[req->descriptor];
+    Addr src = desc.src + req->block * desc.srcStride + req->offset;
+    Addr dst = desc.dst + req->block * desc.dstStride + req->offset;
+
+    /* Don't cross a line on either side */
+    uint64_t bytes = std::min((uint64_t)(desc.size - req->offset), transferSize);
+    if ( 0 != blocksize ) {
+        bytes = std::min(bytes, blocksize - (src % blocksize));
+        bytes = std::min(bytes, blocksize - (dst % blocksize));
+    }
+
+    Addr baseAddr = (0 != blocksize) ? src - (src % blocksize) : src;
+    MemEvent *ev = new MemEvent(getName(), src, baseAddr, Command::GetS, bytes);
+    ev->setFlag(MemEvent::F_NONCACHEABLE);
+    ev->setDst(networkLink->findTargetDestination(src));
+
+    Transfer xfer;
+    xfer.req = req;
+    xfer.dst = dst;
+    xfer.bytes = bytes;
+    transfers.insert(std::make_pair(ev->getID(), xfer));
+    networkLink->send(ev);
+    outstanding++;
+    numMemRequests++;
+
+    req->offset += bytes;
+    if ( req->offset == desc.size ) {
+        req->offset = 0;
+        req->block++;
+    }
+    return true;
+}
+
+
+void DMAEngine::handleEvent(SST::Event *se)
+{
+    MemEvent *ev = static_cast<MemEvent*>(se);
+    std::map<SST::Event::id_type, Transfer>::iterator it = transfers.find(ev->getResponseToID());
+    if ( it == transfers.end() ) {
+        dbg.fatal(CALL_INFO, 1, "Received Packet for which we have no response ID waiting.  ID received: (%" PRIu64 ", %d)\n",
+                ev->getResponseToID().first, ev->getResponseToID().second);
+    }
+    Transfer xfer = it->second;
+    transfers.erase(it);
+    processPacket(xfer, ev);
+    delete ev;
+}
+
+
+void DMAEngine::processPacket(Transfer &xfer, MemEvent *ev)
+{
+    Request *req = xfer.req;
+    if ( ev->getCmd() == Command::GetSResp ) {
+        /* Read done, write the data to the destination. Keeps its outstanding slot. */
+        Addr baseAddr = (0 != blocksize) ? xfer.dst - (xfer.dst % blocksize) : xfer.dst;
+        MemEvent *storeEV = new MemEvent(getName(), xfer.dst, baseAddr, Command::GetX, ev->getPayload());
         storeEV->setFlag(MemEvent::F_NONCACHEABLE);
-        storeEV->setPayload(ev->getPayload());
-        storeEV->setDst(networkLink->findTargetDestination(req->getDst() + offset));
-        req->storeKeys.insert(storeEV->getID());
+        storeEV->setDst(networkLink->findTargetDestination(xfer.dst));
+        transfers.insert(std::make_pair(storeEV->getID(), xfer));
         networkLink->send(storeEV);
-    } else if ( ev->getCmd() == GetXResp ) {
-        bytesTransferred += ev->getSize();
-        req->storeKeys.erase(ev->getResponseToID());
-        if ( req->storeKeys.empty() ) {
-            // Done with this request.
-            activeRequests.erase(req);
-            commandLink->send(req->command);
-            dbg.debug(_L10_, "Request to transfer 0x%" PRIx64 " to 0x%" PRIx64 " is complete.\n", req->getSrc(), req->getDst());
-            delete req;
-        }
+        numMemRequests++;
+    } else if ( ev->getCmd() == Command::GetXResp ) {
+        outstanding--;
+        bytesTransferred += xfer.bytes;
+        req->bytesLeft -= xfer.bytes;
+        if ( 0 == req->bytesLeft )
+            finishRequest(req);
     } else {
-	dbg.fatal(CALL_INFO, 1, "Received unexpected message %s 0x%" PRIx64 " from %s\n", CommandString[ev->getCmd()], ev->getAddr(), ev->getSrc().c_str());
+        dbg.fatal(CALL_INFO, 1, "Received unexpected message %s 0x%" PRIx64 " from %s\n", CommandString[(int)ev->getCmd()], ev->getAddr(), ev->getSrc().c_str());
+    }
+}
+
+
+void DMAEngine::finishRequest(Request *req)
+{
+    for ( std::deque<Request*>::iterator it = activeRequests.begin(); it != activeRequests.end(); ++it ) {
+        if ( *it == req ) {
+            activeRequests.erase(it);
+            break;
+        }
     }
-    */
+    updateRanges(req->command, false);
+    commandLink->send(req->command);
+    dbg.debug(_L10_, "Request to transfer 0x%" PRIx64 " to 0x%" PRIx64 " is complete.\n", req->command->src, req->command->dst);
+    delete req;
 }
 
 
-/* Returns true if there is overlap */
-bool DMAEngine::findOverlap(DMACommand *c1, DMACommand *c2) const
+void DMAEngine::updateRanges(DMACommand *cmd, bool add)
 {
-    return (findOverlap(c1->src, c1->size, c2->src, c2->size) ||
-            findOverlap(c1->src, c1->size, c2->dst, c2->size) ||
-            findOverlap(c1->dst, c1->size, c2->src, c2->size) ||
-            findOverlap(c1->dst, c1->size, c2->dst, c2->size));
+    for ( std::vector<DMADescriptor>::const_iterator it = cmd->descriptors.begin(); it != cmd->descriptors.end(); ++it ) {
+        if ( 0 == it->size || 0 == it->count ) continue;
+        if ( add ) {
+            readRanges.insert(it->src, it->srcEnd());
+            writeRanges.insert(it->dst, it->dstEnd());
+        } else {
+            readRanges.remove(it->src, it->srcEnd());
+            writeRanges.remove(it->dst, it->dstEnd());
+        }
+    }
 }
 
 
-/* Returns true if there is overlap */
-bool DMAEngine::findOverlap(Addr a1, size_t s1, Addr a2, size_t s2) const
+/* Make sure an interval starts at addr and return it */
+std::map<Addr, uint32_t>::iterator DMARangeIndex::split(Addr addr)
 {
-    Addr end1 = a1 + s1;
-    Addr end2 = a2 + s2;
+    std::map<Addr, uint32_t>::iterator it = ranges.lower_bound(addr);
+    if ( it != ranges.end() && it->first == addr )
+        return it;
+    uint32_t count = 0;
+    if ( it != ranges.begin() ) {
+        std::map<Addr, uint32_t>::iterator prev = it;
+        --prev;
+        count = prev->second;
+    }
+    return ranges.insert(it, std::make_pair(addr, count));
+}
+
 
-    return (( a1 <= end2 ) || ( a2 <= end1 ));
+void DMARangeIndex::insert(Addr start, Addr end)
+{
+    if ( start >= end ) return;
+    std::map<Addr, uint32_t>::iterator last = split(end);
+    for ( std::map<Addr, uint32_t>::iterator it = split(start); it != last; ++it )
+        it->second++;
 }
 
 
-DMAEngine::Request* DMAEngine::findRequest(SST::Event::id_type id)
+void DMARangeIndex::remove(Addr start, Addr end)
 {
-    for ( std::set<Request*>::iterator i = activeRequests.begin() ; i != activeRequests.end() ; ++i ) {
-        Request *req = (*i);
-        if ( req->loadKeys.count(id) || req->storeKeys.count(id) )
-            return req;
+    if ( start >= end ) return;
+    std::map<Addr, uint32_t>::iterator last = split(end);
+    std::map<Addr, uint32_t>::iterator it = split(start);
+    for ( ; it != last; ++it )
+        it->second--;
+
+    /* Merge intervals that no longer differ, from the interval before 'start' through 'end' */
+    it = ranges.find(start);
+    if ( it != ranges.begin() ) --it;
+    while ( it != ranges.end() && it->first <= end ) {
+        std::map<Addr, uint32_t>::iterator next = it;
+        ++next;
+        if ( it == ranges.begin() && 0 == it->second ) {
+            ranges.erase(it);
+        } else if ( it != ranges.begin() ) {
+            std::map<Addr, uint32_t>::iterator prev = it;
+            --prev;
+            if ( prev->second == it->second )
+                ranges.erase(it);
+        }
+        it = next;
     }
-    return NULL;
 }
 
 
+/* Returns true if [start, end) overlaps any range in the index */
+bool DMARangeIndex::overlaps(Addr start, Addr end) const
+{
+    if ( start >= end || ranges.empty() ) return false;
+    std::map<Addr, uint32_t>::const_iterator it = ranges.upper_bound(start);
+    if ( it != ranges.begin() ) --it;
+    for ( ; it != ranges.end() && it->first < end; ++it ) {
+        if ( 0 != it->second ) {
+            std::map<Addr, uint32_t>::const_iterator next = it;
+            ++next;
+            if ( next == ranges.end() || next->first > start )
+                return true;
+        }
+    }
+    return false;
+}
@@ -19,6 +19,8 @@
 
 
 #include <vector>
+#include <deque>
+#include <map>
 
 #include <sst/core/event.h>
 #include <sst/core/component.h>
@@ -26,13 +28,38 @@
 #include <sst/core/output.h>
 
 #include "sst/elements/memHierarchy/memEvent.h"
-#include "sst/elements/memHierarchy/memNIC.h"
+#include "sst/elements/memHierarchy/memLinkBase.h"
 
 
 namespace SST {
 namespace MemHierarchy {
 
-/* Send this to the DMAEngine to cause a DMA.  Returned when complete. */
+/*
+ * One descriptor in a DMA command.
+ * Moves 'count' blocks of 'size' bytes. Block i is read from src + i*srcStride and written to dst + i*dstStride.
+ * A contiguous copy is a single block; a scatter/gather list is a sequence of single-block descriptors.
+ */
+struct DMADescriptor {
+    Addr src;
+    Addr dst;
+    size_t size;
+    uint64_t count;
+    Addr srcStride;
+    Addr dstStride;
+
+    DMADescriptor(Addr d, Addr s, size_t sz) : src(s), dst(d), size(sz), count(1), srcStride(sz), dstStride(sz) { }
+    DMADescriptor(Addr d, Addr s, size_t sz, uint64_t cnt, Addr dStride, Addr sStride) :
+        src(s), dst(d), size(sz), count(cnt), srcStride(sStride), dstStride(dStride) { }
+
+    /* Bounding ranges [start, end) touched on each side */
+    Addr srcEnd() const { return count == 0 ? src : src + (count - 1) * srcStride + size; }
+    Addr dstEnd() const { return count == 0 ? dst : dst + (count - 1) * dstStride + size; }
+};
+
+/* Send this to the DMAEngine to cause a DMA.  Returned when complete.
+ * A command is a chain of descriptors that completes (and is returned) as a unit.
+ * Descriptors in a chain are issued in order and may be in flight together, so they should not overlap one another.
+ */
 class DMACommand : public Event {
 private:
     static uint64_t main_id;
@@ -40,19 +67,77 @@ private:
 public:
     Addr dst;
     Addr src;
-    size_t size;
+    size_t size;    // Total bytes moved by the command
+    std::vector<DMADescriptor> descriptors;
+
     DMACommand(const Component *origin, Addr dst, Addr src, size_t size) :
         Event(), dst(dst), src(src), size(size)
+    {
+      event_id = std::make_pair(main_id++, origin->getId());
+      descriptors.push_back(DMADescriptor(dst, src, size));
+    }
+
+    /* Empty command, build the chain with the add* functions */
+    DMACommand(const Component *origin) :
+        Event(), dst(0), src(0), size(0)
     {
       event_id = std::make_pair(main_id++, origin->getId());
     }
+
     SST::Event::id_type getID(void) const { return event_id; }
 
+    void addContiguous(Addr d, Addr s, size_t sz) {
+        addStrided(d, s, sz, 1, sz, sz);
+    }
+
+    void addStrided(Addr d, Addr s, size_t sz, uint64_t count, Addr dStride, Addr sStride) {
+        if (descriptors.empty()) {
+            dst = d;
+            src = s;
+        }
+        descriptors.push_back(DMADescriptor(d, s, sz, count, dStride, sStride));
+        size += sz * count;
+    }
+
+    /* Gather: src blocks to a contiguous dst region */
+    void addGather(Addr d, const std::vector<std::pair<Addr,size_t> >& srcList) {
+        for (std::vector<std::pair<Addr,size_t> >::const_iterator it = srcList.begin(); it != srcList.end(); it++) {
+            addContiguous(d, it->first, it->second);
+            d += it->second;
+        }
+    }
+
+    /* Scatter: contiguous src region to dst blocks */
+    void addScatter(const std::vector<std::pair<Addr,size_t> >& dstList, Addr s) {
+        for (std::vector<std::pair<Addr,size_t> >::const_iterator it = dstList.begin(); it != dstList.end(); it++) {
+            addContiguous(it->first, s, it->second);
+            s += it->second;
+        }
+    }
+
 private:
     DMACommand() {} // For serialization
 };
 
 
+/*
+ * Set of address ranges with reference counts, kept as disjoint intervals so that
+ * overlap checks cost O(log n) in the number of in-flight ranges instead of a scan of every command
+ */
+class DMARangeIndex {
+public:
+    void insert(Addr start, Addr end);
+    void remove(Addr start, Addr end);
+    bool overlaps(Addr start, Addr end) const;
+    bool empty() const { return ranges.empty(); }
+
+private:
+    /* Key is the start of an interval that extends to the next key; value is how many ranges cover it */
+    std::map<Addr, uint32_t> ranges;
+    std::map<Addr, uint32_t>::iterator split(Addr addr);
+};
+
+
 class DMAEngine : public Component {
 public:
 /* Element Library Info */
@@ -63,40 +148,62 @@ public:
             {"debug",           "0 (default): No debugging, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},
             {"debug_level",     "Debugging level: 0 to 10", "0"},
             {"clockRate",       "Clock Rate for processing DMAs.", "1GHz"},
-            {"netAddr",         "Network address of component.", NULL},
-            {"network_num_vc",  "DEPRECATED. Number of virtual channels (VCs) on the on-chip network. memHierarchy only uses one VC.", "1"},
+            {"transfer_size",   "Maximum bytes per memory request. Requests are also split at cache line boundaries.", "64"},
+            {"max_outstanding", "Maximum number of memory requests (reads and writes) in flight.", "16"},
+            {"max_issue_per_cycle", "Maximum number of memory requests issued per cycle.", "1"},
+            {"max_active_commands", "Maximum number of commands being processed at once. 0 is unlimited.", "0"},
             {"printStats",      "0 (default): Don't print, 1: STDOUT, 2: STDERR, 3: FILE.", "0"} )
 
-    SST_ELI_DOCUMENT_PORTS( {"netLink", "Network Link", {"memHierarchy.MemRtrEvent"} } )
+    SST_ELI_DOCUMENT_PORTS( {"cmdLink", "Link to the component issuing DMACommands", {"memHierarchy.DMACommand"} } )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( {"memlink", "Link manager to memory (e.g., MemNIC or MemLink)", "SST::MemHierarchy::MemLinkBase"} )
 
 /* Begin class definition */
 private:
     struct Request {
         DMACommand *command;
-        std::set<SST::Event::id_type> loadKeys;
-        std::set<SST::Event::id_type> storeKeys;
+        size_t descriptor;      // Next descriptor to issue
+        uint64_t block;         // Next block in descriptor
+        size_t offset;          // Next byte in block
+        size_t bytesLeft;       // Bytes not yet written
 
-        Addr getDst() const { return command->dst; }
-        Addr getSrc() const { return command->src; }
-        size_t getSize() const { return command->size; }
+        bool issueDone() const { return descriptor == command->descriptors.size(); }
 
         Request(DMACommand *cmd) :
-            command(cmd)
+            command(cmd), descriptor(0), block(0), offset(0), bytesLeft(cmd->size)
         { }
     };
 
+    /* One read/write pair in flight */
+    struct Transfer {
+        Request *req;
+        Addr dst;
+        size_t bytes;
+    };
+
     std::deque<DMACommand*> commandQueue;
-    std::set<Request*> activeRequests;
+    std::deque<Request*> activeRequests;
+    std::map<SST::Event::id_type, Transfer> transfers;
+
+    /* In-flight ranges. A new command waits if it writes a range being read or written, or reads a range being written */
+    DMARangeIndex readRanges;
+    DMARangeIndex writeRanges;
 
     Output dbg;
     uint64_t blocksize;
+    uint64_t transferSize;
+    uint64_t maxOutstanding;
+    uint64_t maxIssuePerCycle;
+    uint64_t maxActiveCommands;
+    uint64_t outstanding;
     Output::output_location_t statsOutputTarget;
     uint64_t numTransfers;
     uint64_t bytesTransferred;
+    uint64_t numMemRequests;
 
 
     Link *commandLink;
-    MemNIC *networkLink;
+    MemLinkBase *networkLink;
 
 public:
     DMAEngine(ComponentId_t id, Params& params);
@@ -109,15 +216,15 @@ private:
     DMAEngine() {}; // For serialization
 
     bool clock(Cycle_t cycle);
+    void handleEvent(SST::Event *ev);
 
     bool isIssuable(DMACommand *cmd) const;
     void startRequest(Request *req);
-    void processPacket(Request *req, MemEventBase *ev);
+    bool issueNext(Request *req);
+    void processPacket(Transfer &xfer, MemEvent *ev);
+    void finishRequest(Request *req);
 
-    bool findOverlap(DMACommand *c1, DMACommand *c2) const;
-    bool findOverlap(Addr a1, size_t s1, Addr a2, size_t s2) const;
-    Request* findRequest(SST::Event::id_type id);
-    //std::string findTargetDirectory(Addr addr); Moved to MemNIC
+    void updateRanges(DMACommand *cmd, bool add);
 };
 
 }
@@ -79,7 +79,13 @@ SimpleNetwork::Request* MemNetBridge::initTranslate(SimpleNetwork::Request *req,
 
 SimpleNetwork::Request* MemNetBridge::translate(SimpleNetwork::Request *req, uint8_t fromNet)
 {
-    Net_t &inNet = networks[fromNet];
+    translateInPlace(req, fromNet);
+    return req;
+}
+
+/* Only the header changes, so the request and MemRtrEvent are forwarded as is */
+bool MemNetBridge::translateInPlace(SimpleNetwork::Request *req, uint8_t fromNet)
+{
     Net_t &outNet = networks[fromNet^1];
 
     MemNIC::MemRtrEvent *mre = static_cast<MemNIC::MemRtrEvent*>(req->inspectPayload());
@@ -98,7 +104,7 @@ SimpleNetwork::Request* MemNetBridge::translate(SimpleNetwork::Request *req, uin
     req->dest = tgt;
     req->vn = 0;
 
-    return req;
+    return true;
 }
 
 SimpleNetwork::nid_t MemNetBridge::getAddrFor(Net_t &net, const std::string &tgt)
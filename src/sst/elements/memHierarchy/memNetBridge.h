@@ -55,6 +55,8 @@ public:
     void finish(void);
 
     SimpleNetwork::Request* translate(SimpleNetwork::Request* req, uint8_t fromNetwork);
+    bool canTranslateInPlace() const { return true; }
+    bool translateInPlace(SimpleNetwork::Request* req, uint8_t fromNetwork);
     SimpleNetwork::Request* initTranslate(SimpleNetwork::Request* req, uint8_t fromNetwork);
 
 private:
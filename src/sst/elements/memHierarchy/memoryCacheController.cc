@@ -191,13 +191,48 @@ MemCacheController::MemCacheController(ComponentId_t id, Params &params) : Compo
     if (memSize_ % lineSize_ != 0)
         out.fatal(CALL_INFO, -1, "%s, Error - memory size must be a multiple of line size. Memory size is %zu bytes and line size is %" PRIu64 " bytes\n",
                 getName().c_str(), memSize_, lineSize_);
-    cache_.resize(cachesize, CacheState(0,I));
+
+    associativity_ = params.find<uint32_t>("associativity", 1);
+    if (associativity_ == 0)
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: associativity. Must be at least 1.\n", getName().c_str());
+
+    blockSize_ = params.find<uint64_t>("block_size", lineSize_);
+    if (blockSize_ < lineSize_ || blockSize_ % lineSize_ != 0 || !isPowerOfTwo(blockSize_ / lineSize_) || blockSize_ / lineSize_ > 64)
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: block_size. Must be a power-of-2 multiple of cache_line_size and at most 64 lines. You specified %" PRIu64 "\n",
+                getName().c_str(), blockSize_);
+    linesPerBlock_ = blockSize_ / lineSize_;
+
+    if (cachesize % (linesPerBlock_ * associativity_) != 0)
+        out.fatal(CALL_INFO, -1, "%s, Error - memory size (%zu bytes) must be a multiple of block_size * associativity (%" PRIu64 " bytes)\n",
+                getName().c_str(), memSize_, blockSize_ * associativity_);
+    numSets_ = cachesize / (linesPerBlock_ * associativity_);
+    cache_.resize(numSets_ * associativity_, CacheState(0,I));
+
+    std::string tagLocation = params.find<std::string>("tag_location", "dram");
+    if (tagLocation == "sram") tagsInSRAM_ = true;
+    else if (tagLocation == "dram") tagsInSRAM_ = false;
+    else out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: tag_location. Must be 'dram' or 'sram'. You specified '%s'\n", getName().c_str(), tagLocation.c_str());
+    tagLatency_ = params.find<uint64_t>("tag_latency_cycles", 1);
+    tagQueue_.setSpan(tagLatency_ + 2);
+    timestamp_ = 0;
+
+    mshrSize_ = params.find<int>("mshr_num_entries", -1);
+    if (mshrSize_ == 0)
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: mshr_num_entries. Must be at least 1 or else negative to indicate an unlimited size MSHR\n", getName().c_str());
+    if (mshrSize_ > 0) {
+        mshrEntries_.resize(mshrSize_);
+        for (int i = mshrSize_ - 1; i >= 0; i--)
+            mshrFree_.push_back(i);
+    }
 
     /* Statistics */
     statReadHit = registerStatistic<uint64_t>("CacheHits_Read");
     statReadMiss = registerStatistic<uint64_t>("CacheMisses_Read");
     statWriteHit = registerStatistic<uint64_t>("CacheHits_Write");
     statWriteMiss = registerStatistic<uint64_t>("CacheMisses_Write");
+    statSectorMiss = registerStatistic<uint64_t>("SectorMisses");
+    statWriteback = registerStatistic<uint64_t>("Writebacks");
+    statMSHRFull = registerStatistic<uint64_t>("MSHRFull");
 
 }
 
@@ -228,17 +263,12 @@ void MemCacheController::handleEvent(SST::Event* event) {
     switch (cmd) {
         case Command::GetS:
         case Command::GetSX:
-            handleRead(ev, false);
-            break;
         case Command::GetX:
-            if (ev->queryFlag(MemEvent::F_NONCACHEABLE))
-                handleWrite(ev, false);
-            else
-                handleRead(ev, false);
+            handleAccess(ev, false);
             break;
         case Command::PutM:
             ev->setFlag(MemEvent::F_NORESPONSE);
-            handleWrite(ev, false);
+            handleAccess(ev, false);
             break;
         case Command::FlushLine:
         case Command::FlushLineInv:
@@ -258,98 +288,236 @@ void MemCacheController::handleEvent(SST::Event* event) {
 }
 
 
-void MemCacheController::handleRead(MemEvent* event, bool replay) {
-    Addr cacheIndex = toLocalAddr(event->getBaseAddr());
-    if (cacheIndex >= cache_.size())
-        out.fatal(CALL_INFO, -1, "%s, Error: cache index exceeds cache size, try again!\n", getName().c_str());
-    Addr blockAddr = cache_[cacheIndex].addr;
-    State blockState = cache_[cacheIndex].state;
+/* Reads and writes share one path; whether the access is a write is decided by the command */
+static bool isWrite(MemEvent* ev) {
+    return ev->getCmd() == Command::PutM || (ev->getCmd() == Command::GetX && ev->queryFlag(MemEvent::F_NONCACHEABLE));
+}
+
+void MemCacheController::handleAccess(MemEvent* event, bool replay) {
+    Addr set, blockAddr;
+    uint32_t sector;
+    decodeAddr(event->getBaseAddr(), set, blockAddr, sector);
 
     if (is_debug_event(event)) {
-        Debug(_L3_, "%" PRIu64 " (%s) handleRead, Line: %" PRIu64 ", 0x%" PRIx64 ", %s\n",
-                getCurrentSimTimeNano(),
-                getName().c_str(),
-                cacheIndex,
-                blockAddr,
-                StateString[blockState]);
+        Debug(_L3_, "%" PRIu64 " (%s) handleAccess, Set: %" PRIu64 ", Block: 0x%" PRIx64 ", Line: %" PRIu32 "\n",
+                getCurrentSimTimeNano(), getName().c_str(), set, blockAddr, sector);
     }
 
     if (!replay) {
+        if (mshrIndex_.find(set) == mshrIndex_.end() && mshrSize_ > 0 && mshrFree_.empty()) {
+            statMSHRFull->addData(1);
+            mshrWait_.push_back(event);
+            if (is_debug_event(event))
+                Debug(_L3_, "%" PRIu64 " (%s) MSHR full, waiting %" PRIu64 "\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
+            return;
+        }
         MemAccessRecord rec;
         rec.event = event;
         outstandingEvents_.insert(std::make_pair(event->getID(), rec));
-        mshr_[cacheIndex].push(event->getID());
+        allocateMSHR(event, set);
     }
     std::map<SST::Event::id_type, MemAccessRecord>::iterator it = outstandingEvents_.find(event->getID());
 
-    if (mshr_.find(cacheIndex)->second.front() != event->getID()) {         // Transition
+    if (mshrFront(set) != event->getID()) {         // Transition
         it->second.status = AccessStatus::STALL;
         if (is_debug_event(event))
             Debug(_L3_, "%" PRIu64 " (%s) StateTransition %" PRIu64 ", STALL\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
         return;
-    } else if (blockState == I || blockAddr != event->getBaseAddr()) {      // MISS
-        it->second.status = (blockState == M) ? AccessStatus::MISS_WB : AccessStatus::MISS;
-        statReadMiss->addData(1);
+    }
+
+    if (tagsInSRAM_) {
+        it->second.status = AccessStatus::TAG;
+        tagQueue_.insert(timestamp_ + tagLatency_, event->getID());
         if (is_debug_event(event))
-            Debug(_L3_, "%" PRIu64 " (%s) StateTransition %" PRIu64 ", %s\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first, (blockState == M) ? "MISS_WB" : "MISS");
-    } else {                                                                // HIT
-        statReadHit->addData(1);
+            Debug(_L3_, "%" PRIu64 " (%s) StateTransition %" PRIu64 ", TAG\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
+        return;
+    }
+
+    /* Tags are in DRAM: the lookup outcome is known now but costs an access to the cache.
+     * A direct-mapped cache reads tag and data together; a set-associative one needs a second access for data. */
+    bool write = isWrite(event);
+    LookupResult result = lookup(it->second);
+    const char * statusStr;
+    if (result == LookupResult::HIT) {
+        write ? statWriteHit->addData(1) : statReadHit->addData(1);
+        it->second.status = (write || associativity_ > 1) ? AccessStatus::HIT_TAG : AccessStatus::HIT;
+        statusStr = (write || associativity_ > 1) ? "HIT_TAG" : "HIT";
+    } else {
+        write ? statWriteMiss->addData(1) : statReadMiss->addData(1);
+        if (result == LookupResult::SECTOR_MISS || block(it->second).dirty == 0) {
+            if (result == LookupResult::SECTOR_MISS) statSectorMiss->addData(1);
+            it->second.status = AccessStatus::MISS;
+            statusStr = "MISS";
+        } else {
+            it->second.status = (associativity_ > 1) ? AccessStatus::VICTIM : AccessStatus::MISS_WB;
+            statusStr = (associativity_ > 1) ? "VICTIM" : "MISS_WB";
+        }
+    }
+    if (is_debug_event(event))
+        Debug(_L3_, "%" PRIu64 " (%s) StateTransition %" PRIu64 ", %s\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first, statusStr);
+
+    issueLocal(it->second, Command::GetS);
+}
+
+/* SRAM tag lookup finished */
+void MemCacheController::finishLookup(std::map<SST::Event::id_type, MemAccessRecord>::iterator it) {
+    MemEvent * event = it->second.event;
+    bool write = isWrite(event);
+    LookupResult result = lookup(it->second);
+
+    if (result == LookupResult::HIT) {
+        write ? statWriteHit->addData(1) : statReadHit->addData(1);
         it->second.status = AccessStatus::HIT;
+        if (write) {
+            block(it->second).dirty |= (1ULL << it->second.sector);
+            block(it->second).state = M;
+        }
         if (is_debug_event(event))
             Debug(_L3_, "%" PRIu64 " (%s) StateTransition %" PRIu64 ", HIT\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
+        issueLocal(it->second, write ? Command::PutM : Command::GetS);
+        return;
     }
 
-    it->second.reqev = new MemEvent(*event);
-    it->second.reqev->setBaseAddr(cacheIndex);
-    it->second.reqev->setAddr(event->getAddr() - event->getBaseAddr() + cacheIndex);
-    it->second.reqev->setCmd(Command::GetS);
+    write ? statWriteMiss->addData(1) : statReadMiss->addData(1);
+    if (result == LookupResult::SECTOR_MISS || block(it->second).dirty == 0) {
+        if (result == LookupResult::SECTOR_MISS) statSectorMiss->addData(1);
+        sendRemoteRead(it->second);
+    } else { /* Read the victim's data before writing it back */
+        it->second.status = AccessStatus::MISS_WB;
+        if (is_debug_event(event))
+            Debug(_L3_, "%" PRIu64 " (%s) StateTransition %" PRIu64 ", MISS_WB\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
+        issueLocal(it->second, Command::GetS);
+    }
+}
 
-    memBackendConvertor_->handleMemEvent(it->second.reqev);
+/* Find the block for the event's address. On a miss, rec.way is the LRU (or an invalid) way */
+MemCacheController::LookupResult MemCacheController::lookup(MemAccessRecord& rec) {
+    Addr blockAddr;
+    decodeAddr(rec.event->getBaseAddr(), rec.set, blockAddr, rec.sector);
+
+    CacheState * ways = &cache_[rec.set * associativity_];
+    uint32_t victim = 0;
+    for (uint32_t way = 0; way < associativity_; way++) {
+        if (ways[way].state != I && ways[way].addr == blockAddr) {
+            rec.way = way;
+            ways[way].lastUse = timestamp_;
+            return ((ways[way].valid >> rec.sector) & 1) ? LookupResult::HIT : LookupResult::SECTOR_MISS;
+        }
+        if (ways[victim].state != I && (ways[way].state == I || ways[way].lastUse < ways[victim].lastUse))
+            victim = way;
+    }
+    rec.way = victim;
+    return LookupResult::MISS;
 }
 
-void MemCacheController::handleWrite(MemEvent* event, bool replay) {
-    Addr cacheIndex = toLocalAddr(event->getBaseAddr());
-    Addr blockAddr = cache_[cacheIndex].addr;
-    State blockState = cache_[cacheIndex].state;
+/* Access the memory cache at the frame for rec's set/way/line */
+void MemCacheController::issueLocal(MemAccessRecord& rec, Command cmd) {
+    Addr frame = frameIndex(rec);
+    rec.reqev = new MemEvent(*rec.event);
+    rec.reqev->setBaseAddr(frame);
+    rec.reqev->setAddr(rec.event->getAddr() - rec.event->getBaseAddr() + frame);
+    rec.reqev->setCmd(cmd);
 
-    if (is_debug_event(event))
-        Debug(_L3_, "\n%" PRIu64 " (%s) handleWrite, Line: %" PRIu64 ", 0x%" PRIx64 ", %s\n", getCurrentSimTimeNano(), getName().c_str(), cacheIndex, blockAddr, StateString[blockState]);
+    memBackendConvertor_->handleMemEvent(rec.reqev);
+}
 
-    if (!replay) {
-        MemAccessRecord rec;
-        rec.event = event;
-        outstandingEvents_.insert(std::make_pair(event->getID(), rec));
-        mshr_[cacheIndex].push(event->getID());
-    }
-    std::map<SST::Event::id_type, MemAccessRecord>::iterator it = outstandingEvents_.find(event->getID());
+/* Write dirty lines of the victim block back to remote memory */
+void MemCacheController::sendWriteback(MemAccessRecord& rec) {
+    CacheState& blk = block(rec);
+    Addr frameBase = (rec.set * associativity_ + rec.way) * linesPerBlock_;
+    for (uint32_t line = 0; line < linesPerBlock_; line++) {
+        if (!((blk.dirty >> line) & 1)) continue;
+        Addr lineAddr = blk.addr + (line << lineOffset_);
+        MemEvent * remoteWr = new MemEvent(getName(), lineAddr, lineAddr, Command::PutM, lineSize_);
+        readData(remoteWr, frameBase + line);
+        remoteWr->setFlag(MemEvent::F_NORESPONSE); // Don't send a response to this
+        remoteWr->setDst(link_->findTargetDestination(remoteWr->getBaseAddr()));
+        link_->send(remoteWr);
+        statWriteback->addData(1);
+    }
+    blk.dirty = 0;
+}
 
-    if (mshr_.find(cacheIndex)->second.front() != event->getID()) {         // Transition
-        it->second.status = AccessStatus::STALL;
-        if (is_debug_event(event))
-            Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", STALL\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
+/* Request the line from remote memory, allocating the block if it is not present */
+void MemCacheController::sendRemoteRead(MemAccessRecord& rec) {
+    MemEvent * ev = rec.event;
+    Addr set, blockAddr;
+    uint32_t sector;
+    decodeAddr(ev->getBaseAddr(), set, blockAddr, sector);
+
+    CacheState& blk = block(rec);
+    if (blk.state == I || blk.addr != blockAddr) {
+        blk.addr = blockAddr;
+        blk.valid = 0;
+        blk.dirty = 0;
+    }
+    blk.state = IM;
+    blk.lastUse = timestamp_;
+
+    MemEvent * remoteRd = new MemEvent(*ev);
+    remoteRd->setCmd(Command::GetS);
+    remoteRd->setSrc(getName());
+    remoteRd->setDst(link_->findTargetDestination(remoteRd->getBaseAddr()));
+    if (remoteRd->queryFlag(MemEvent::F_NORESPONSE))
+        remoteRd->clearFlag(MemEvent::F_NORESPONSE);
+    rec.reqev = remoteRd;
+    link_->send(remoteRd);
+    rec.status = AccessStatus::DATA; // We've request data, waiting for response
+    if (is_debug_event(ev))
+        Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", DATA\n", getCurrentSimTimeNano(), getName().c_str(), ev->getID().first);
+}
+
+/* MSHR management */
+void MemCacheController::allocateMSHR(MemEvent* ev, Addr set) {
+    std::unordered_map<Addr, size_t>::iterator it = mshrIndex_.find(set);
+    if (it != mshrIndex_.end()) {
+        mshrEntries_[it->second].queue.push_back(ev->getID());
         return;
-    } else if (blockState == I || blockAddr != event->getBaseAddr()) {      // MISS
-        // Do a read to time the state lookup
-        statWriteMiss->addData(1);
-        it->second.status = (blockState == M ) ? AccessStatus::MISS_WB : AccessStatus::MISS;
-        if (is_debug_event(event))
-            Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", %s\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first, (blockState == M) ? "MISS_WB" : "MISS");
-    } else {                                                                // HIT
-        statWriteHit->addData(1);
-        it->second.status = AccessStatus::HIT_TAG;
-        if (is_debug_event(event))
-            Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", HIT\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
     }
 
-    /* Lookup tag data -> required whether or not this is a hit */
-    it->second.reqev = new MemEvent(*event);
-    it->second.reqev->setBaseAddr(cacheIndex);
-    it->second.reqev->setAddr(event->getAddr() - event->getBaseAddr() + cacheIndex);
-    it->second.reqev->setCmd(Command::GetS);
+    size_t index;
+    if (!mshrFree_.empty()) {
+        index = mshrFree_.back();
+        mshrFree_.pop_back();
+    } else { // Unlimited MSHR, grow the pool
+        index = mshrEntries_.size();
+        mshrEntries_.resize(index + 1);
+    }
+    mshrEntries_[index].set = set;
+    mshrEntries_[index].queue.push_back(ev->getID());
+    mshrIndex_.insert(std::make_pair(set, index));
+}
 
-    memBackendConvertor_->handleMemEvent(it->second.reqev);
+SST::Event::id_type MemCacheController::mshrFront(Addr set) {
+    MSHREntry& entry = mshrEntries_[mshrIndex_.find(set)->second];
+    return entry.queue[entry.head];
 }
 
+bool MemCacheController::popMSHR(Addr set) {
+    std::unordered_map<Addr, size_t>::iterator it = mshrIndex_.find(set);
+    MSHREntry& entry = mshrEntries_[it->second];
+    entry.head++;
+    if (entry.head != entry.queue.size())
+        return true;
+
+    entry.queue.clear();
+    entry.head = 0;
+    mshrFree_.push_back(it->second);
+    mshrIndex_.erase(it);
+
+    /* Admit requests that were waiting for an entry */
+    while (!mshrWait_.empty()) {
+        Addr waitSet, blockAddr;
+        uint32_t sector;
+        decodeAddr(mshrWait_.front()->getBaseAddr(), waitSet, blockAddr, sector);
+        if (mshrFree_.empty() && mshrIndex_.find(waitSet) == mshrIndex_.end())
+            break;
+        MemEvent * ev = mshrWait_.front();
+        mshrWait_.pop_front();
+        handleAccess(ev, false);
+    }
+    return false;
+}
 
 
 void MemCacheController::handleFlush(MemEvent* event) {
@@ -360,43 +528,43 @@ void MemCacheController::handleFlush(MemEvent* event) {
 /* Response from remote memory */
 void MemCacheController::handleDataResponse(MemEvent* event) {
     std::map<SST::Event::id_type,MemAccessRecord>::iterator it = outstandingEvents_.find(event->getID());
-    Addr cacheIndex = toLocalAddr(event->getBaseAddr());
-    Addr blockAddr = cache_[cacheIndex].addr;
-    State blockState = cache_[cacheIndex].state;
+    MemAccessRecord& rec = it->second;
+    CacheState& blk = block(rec);
+    Addr frame = frameIndex(rec);
 
     if (is_debug_event(event))
-        Debug(_L3_, "\n%" PRIu64 " (%s) handleDataResponse, Line: %" PRIu64 ", 0x%" PRIx64 ", %s\n",
-                getCurrentSimTimeNano(), getName().c_str(), cacheIndex, blockAddr, StateString[blockState]);
+        Debug(_L3_, "\n%" PRIu64 " (%s) handleDataResponse, Set: %" PRIu64 ", Way: %" PRIu32 ", 0x%" PRIx64 ", %s\n",
+                getCurrentSimTimeNano(), getName().c_str(), rec.set, rec.way, blk.addr, StateString[blk.state]);
 
     // update the backing store from the remote memory response
     if (backing_)
-        writeData(event);
+        writeData(event, frame);
 
     // Update local memory
-    it->second.reqev = new MemEvent(*it->second.event);
-    it->second.reqev->setAddr(cacheIndex);
-    it->second.reqev->setBaseAddr(cacheIndex);
-    it->second.reqev->setCmd(Command::PutM);
-    it->second.reqev->setPayload(event->getPayload());
-    it->second.reqev->clearFlag();
-    it->second.reqev->setFlag(MemEvent::F_NORESPONSE);
-    it->second.status = AccessStatus::FIN;
+    rec.reqev = new MemEvent(*rec.event);
+    rec.reqev->setAddr(frame);
+    rec.reqev->setBaseAddr(frame);
+    rec.reqev->setCmd(Command::PutM);
+    rec.reqev->setPayload(event->getPayload());
+    rec.reqev->clearFlag();
+    rec.reqev->setFlag(MemEvent::F_NORESPONSE);
+    rec.status = AccessStatus::FIN;
     if (is_debug_event(event))
-        Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", FIN\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
-    memBackendConvertor_->handleMemEvent(it->second.reqev);
+        Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", FIN\n", getCurrentSimTimeNano(), getName().c_str(), rec.event->getID().first);
+    memBackendConvertor_->handleMemEvent(rec.reqev);
 
     // Update backing store from the request that missed if it was a write
-    if (it->second.event->getCmd() == Command::PutM || (it->second.event->getCmd() == Command::GetX && it->second.event->queryFlag(MemEvent::F_NONCACHEABLE))) {
-        cache_[cacheIndex].state = M;
+    blk.valid |= (1ULL << rec.sector);
+    if (isWrite(rec.event)) {
+        blk.dirty |= (1ULL << rec.sector);
         if (backing_)
-            writeData(it->second.event);
-    } else {
-        cache_[cacheIndex].state = E;
+            writeData(rec.event, frame);
     }
+    blk.state = (blk.dirty != 0) ? M : E;
 
     // Respond to requestor
-    if (!(it->second.event->queryFlag(MemEvent::F_NORESPONSE))) {
-        sendResponse(it->second.event, 0);
+    if (!(rec.event->queryFlag(MemEvent::F_NORESPONSE))) {
+        sendResponse(rec.event, 0, frame);
     }
     delete event;
 }
@@ -408,6 +576,7 @@ void MemCacheController::handleLocalMemResponse( Event::id_type id, uint32_t fla
         out.fatal(CALL_INFO, -1, "%s, MemoryCache received unrecognized response ID: %" PRIu64 ", %" PRIu32 "", getName().c_str(), id.first, id.second);
 
     delete it->second.reqev;
+    it->second.reqev = nullptr;
     MemEventBase * evb = it->second.event;
 
     if (is_debug_event(evb)) {
@@ -424,69 +593,55 @@ void MemCacheController::handleLocalMemResponse( Event::id_type id, uint32_t fla
     }
 
     MemEvent * ev = static_cast<MemEvent*>(evb);
-
-    bool noncacheable  = ev->queryFlag(MemEvent::F_NONCACHEABLE);
-
-    Addr cacheIndex = toLocalAddr(ev->getBaseAddr());
-    Addr blockAddr = cache_[cacheIndex].addr;
-    State blockState = cache_[cacheIndex].state;
+    MemAccessRecord& rec = it->second;
+    CacheState& blk = block(rec);
+    Addr set = rec.set;
 
     if (is_debug_event(ev))
-        Debug(_L3_, "\n%" PRIu64 " (%s) handleLocalResponse, Line: %" PRIu64 ", 0x%" PRIx64 ", %s\n",
-                getCurrentSimTimeNano(), getName().c_str(), cacheIndex, blockAddr, StateString[blockState]);
-
-    MemEvent * remoteRd, *remoteWr;
-    Addr localIndex;
-    switch (it->second.status) {
+        Debug(_L3_, "\n%" PRIu64 " (%s) handleLocalResponse, Set: %" PRIu64 ", Way: %" PRIu32 ", 0x%" PRIx64 ", %s\n",
+                getCurrentSimTimeNano(), getName().c_str(), rec.set, rec.way, blk.addr, StateString[blk.state]);
+
+    switch (rec.status) {
+        case AccessStatus::VICTIM: // Tag access done, read the dirty victim
+            rec.status = AccessStatus::MISS_WB;
+            if (is_debug_event(ev))
+                Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", MISS_WB\n", getCurrentSimTimeNano(), getName().c_str(), ev->getID().first);
+            issueLocal(rec, Command::GetS);
+            break;
         case AccessStatus::MISS_WB:
             /* Write back data to memory */
-            remoteWr = new MemEvent(getName(), blockAddr, blockAddr, Command::PutM, lineSize_);
-            readData(remoteWr);
-            remoteWr->setFlag(MemEvent::F_NORESPONSE); // Don't send a response to this
-            remoteWr->setDst(link_->findTargetDestination(remoteWr->getBaseAddr()));
-            link_->send(remoteWr);
+            sendWriteback(rec);
         case AccessStatus::MISS:
             /* Read new data from memory */
-            remoteRd = new MemEvent(*ev);
-            remoteRd->setCmd(Command::GetS);
-            remoteRd->setSrc(getName());
-            remoteRd->setDst(link_->findTargetDestination(remoteRd->getBaseAddr()));
-            if (remoteRd->queryFlag(MemEvent::F_NORESPONSE))
-                remoteRd->clearFlag(MemEvent::F_NORESPONSE);
-            it->second.reqev = remoteRd;
-            link_->send(remoteRd);
-            it->second.status = AccessStatus::DATA; // We've request data, waiting for response
-            if (is_debug_event(it->second.event))
-                Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", DATA\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
-            cache_[cacheIndex].addr = ev->getBaseAddr();
-            cache_[cacheIndex].state = IM;
+            sendRemoteRead(rec);
             break;
-        case AccessStatus::HIT_TAG: // tag hit, issue write
-            it->second.reqev = new MemEvent(*ev);
-            it->second.status = AccessStatus::HIT;
-            if (is_debug_event(it->second.event))
-                Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", HIT\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
-            memBackendConvertor_->handleMemEvent(ev);
-            cache_[cacheIndex].state = M;
+        case AccessStatus::HIT_TAG: // tag hit, issue data access
+            rec.status = AccessStatus::HIT;
+            if (is_debug_event(ev))
+                Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", HIT\n", getCurrentSimTimeNano(), getName().c_str(), ev->getID().first);
+            if (isWrite(ev)) {
+                blk.dirty |= (1ULL << rec.sector);
+                blk.state = M;
+                issueLocal(rec, Command::PutM);
+            } else {
+                issueLocal(rec, Command::GetS);
+            }
             break;
         case AccessStatus::HIT:
             /* Write data. Here instead of receive to try to match backing access order to backend execute order */
-            if (backing_ && (ev->getCmd() == Command::PutM || (ev->getCmd() == Command::GetX && noncacheable)))
-                writeData(ev);
+            if (backing_ && isWrite(ev))
+                writeData(ev, frameIndex(rec));
 
             if (!ev->queryFlag(MemEvent::F_NORESPONSE)) {
-                sendResponse(ev, flags);
+                sendResponse(ev, flags, frameIndex(rec));
             }
         case AccessStatus::FIN: // Just finished updating the cache, ready for new requests now
-            if (is_debug_event(it->second.event))
-                Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", ERASE\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
+            if (is_debug_event(ev))
+                Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", ERASE\n", getCurrentSimTimeNano(), getName().c_str(), ev->getID().first);
             delete ev;
-            mshr_[cacheIndex].pop();
             outstandingEvents_.erase(it);
-            if (mshr_[cacheIndex].empty())
-                mshr_.erase(cacheIndex);
-            else
-                retry(cacheIndex);
+            if (popMSHR(set))
+                retry(set);
             break;
         default:
             out.fatal(CALL_INFO, -1, "%s, MemoryCache encountered unhandled record status. Event is %s\n",
@@ -494,8 +649,8 @@ void MemCacheController::handleLocalMemResponse( Event::id_type id, uint32_t fla
     }
 }
 
-void MemCacheController::retry(uint64_t cacheIndex) {
-    MemEvent* ev = outstandingEvents_.find(mshr_[cacheIndex].front())->second.event;
+void MemCacheController::retry(Addr set) {
+    MemEvent* ev = outstandingEvents_.find(mshrFront(set))->second.event;
 
     if (is_debug_event(ev)) {
         Debug(_L3_, "\n%" PRIu64 " (%s) Retrying: %s\n", getCurrentSimTimeNano(), getName().c_str(), ev->getVerboseString().c_str());
@@ -503,31 +658,23 @@ void MemCacheController::retry(uint64_t cacheIndex) {
     switch (ev->getCmd()) {
         case Command::GetS:
         case Command::GetSX:
-            handleRead(ev, true);
-            break;
         case Command::GetX:
-            if (ev->queryFlag(MemEvent::F_NONCACHEABLE)) {
-                handleWrite(ev, true);
-            } else {
-                handleRead(ev, true);
-            }
-            break;
         case Command::PutM:
-
-            handleWrite(ev, true);
+            handleAccess(ev, true);
             break;
         default:
             break;
     }
 }
 
-void MemCacheController::sendResponse(MemEvent* ev, uint32_t flags) {
+
+void MemCacheController::sendResponse(MemEvent* ev, uint32_t flags, Addr frame) {
     MemEvent * resp = ev->makeResponse();
 
     bool noncacheable = ev->queryFlag(MemEvent::F_NONCACHEABLE);
     /* Read order matches execute order so that mis-ordering at backend can result in bad data */
     if (resp->getCmd() == Command::GetSResp || (resp->getCmd() == Command::GetXResp && !noncacheable)) {
-        readData(resp);
+        readData(resp, frame);
         if (!noncacheable) resp->setCmd(Command::GetXResp);
     }
 
@@ -537,6 +684,14 @@ void MemCacheController::sendResponse(MemEvent* ev, uint32_t flags) {
 
 
 bool MemCacheController::clock(Cycle_t cycle) {
+    timestamp_++;
+
+    while (tagQueue_.ready(timestamp_)) {
+        std::map<SST::Event::id_type, MemAccessRecord>::iterator it = outstandingEvents_.find(tagQueue_.front());
+        tagQueue_.pop();
+        finishLookup(it);
+    }
+
     bool unclockLink = true;
     if (clockLink_) {
         unclockLink = link_->clock();
@@ -544,7 +699,7 @@ bool MemCacheController::clock(Cycle_t cycle) {
 
     bool unclockBack = memBackendConvertor_->clock( cycle );
 
-    if (unclockLink && unclockBack) {
+    if (unclockLink && unclockBack && tagQueue_.empty()) {
         memBackendConvertor_->turnClockOff();
         clockOn_ = false;
         return true;
@@ -596,14 +751,13 @@ void MemCacheController::finish(void) {
     link_->finish();
 }
 
-void MemCacheController::writeData(MemEvent* event) {
+/* Backing store is indexed by cache frame (line in the memory cache), not by global address */
+void MemCacheController::writeData(MemEvent* event, Addr frame) {
     /* Noncacheable events occur on byte addresses, others on line addresses */
     bool noncacheable = event->queryFlag(MemEvent::F_NONCACHEABLE);
-    Addr addr = noncacheable ? event->getAddr() : event->getBaseAddr();
+    Addr addr = (frame << lineOffset_) + (noncacheable ? event->getAddr() - event->getBaseAddr() : 0);
 
-    addr = toLocalAddr(addr);
-
-    if (event->getCmd() == Command::PutM) { /* Write request to memory */
+    if (event->getCmd() == Command::PutM || event->getCmd() == Command::GetSResp || event->getCmd() == Command::GetXResp) { /* Write request or fill */
         if (is_debug_event(event)) { Debug(_L4_, "\tUpdate backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); }
 
         backing_->set(addr, event->getSize(), event->getPayload());
@@ -622,11 +776,9 @@ void MemCacheController::writeData(MemEvent* event) {
 }
 
 
-void MemCacheController::readData(MemEvent* event) {
+void MemCacheController::readData(MemEvent* event, Addr frame) {
     bool noncacheable = event->queryFlag(MemEvent::F_NONCACHEABLE);
-    Addr localAddr = noncacheable ? event->getAddr() : event->getBaseAddr();
-
-    localAddr = toLocalAddr(localAddr);
+    Addr localAddr = (frame << lineOffset_) + (noncacheable ? event->getAddr() - event->getBaseAddr() : 0);
 
     vector<uint8_t> payload;
     payload.resize(event->getSize(), 0);
@@ -664,12 +816,19 @@ Addr MemCacheController::toLocalAddr(Addr addr) {
     //Addr step = shift / region_.interleaveStep;
     //Addr offset = shift % region_.interleaveStep;
     //Addr rAddr = (step * region_.interleaveSize) + offset;
-    rAddr = rAddr % cache_.size();
 
-    if (is_debug_addr(addr)) { Debug(_L10_,"\tConverting global address 0x%" PRIx64 " to local index %" PRIu64 "\n", addr, rAddr); }
+    if (is_debug_addr(addr)) { Debug(_L10_,"\tConverting global address 0x%" PRIx64 " to local line %" PRIu64 "\n", addr, rAddr); }
     return rAddr;
 }
 
+/* Split an address into set, block base address, and line within the block */
+void MemCacheController::decodeAddr(Addr addr, Addr &set, Addr &blockAddr, uint32_t &sector) {
+    Addr line = toLocalAddr(addr);
+    sector = line % linesPerBlock_;
+    set = (line / linesPerBlock_) % numSets_;
+    blockAddr = ((addr >> lineOffset_) - sector) << lineOffset_;
+}
+
 
 
 void MemCacheController::processInitEvent( MemEventInit* me ) {
@@ -16,6 +16,9 @@
 #ifndef MEMHIERARCHY_MEMORYCACHECONTROLLER_H
 #define MEMHIERARCHY_MEMORYCACHECONTROLLER_H
 
+#include <list>
+#include <unordered_map>
+
 #include <sst/core/sst_types.h>
 
 #include <sst/core/component.h>
@@ -26,6 +29,7 @@
 #include "sst/elements/memHierarchy/memLinkBase.h"
 #include "sst/elements/memHierarchy/membackend/backing.h"
 #include "sst/elements/memHierarchy/customcmd/customCmdMemory.h"
+#include "sst/elements/memHierarchy/timingWheel.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -42,6 +46,11 @@ public:
             {"num_caches",          "(uint) Total number of memory caches", "1"},\
             {"cache_num",           "(uint) Index of this cache between 0 and num_caches-1", "0"}, \
             {"cache_line_size",     "(uint) Cache line size in bytes", "64"}, \
+            {"associativity",       "(uint) Number of ways per set in the memory cache. 1 is direct-mapped", "1"}, \
+            {"block_size",          "(uint) Bytes covered by one tag. Must be a power-of-2 multiple of cache_line_size, at most 64 lines. Lines within a block are filled and written back individually (sectored/footprint cache)", "cache_line_size"}, \
+            {"tag_location",        "(string) Where tags are stored. 'dram' - every lookup is a memory access to the cache; 'sram' - lookups take tag_latency_cycles and only hits and dirty victims access the cache", "dram"}, \
+            {"tag_latency_cycles",  "(uint) Tag lookup latency in cycles when tag_location is 'sram'", "1"}, \
+            {"mshr_num_entries",    "(int) Number of sets that can have requests outstanding at once. -1 is unlimited", "-1"}, \
             {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
@@ -57,6 +66,9 @@ public:
             {"CacheHits_Write",  "Number of write hits", "count", 1},
             {"CacheMisses_Read",  "Number of read misses", "count", 1},
             {"CacheMisses_Write",  "Number of write misses", "count", 1},
+            {"SectorMisses",  "Number of misses to a block that was present but did not have the requested line", "count", 1},
+            {"Writebacks",  "Number of dirty lines written back to remote memory on eviction", "count", 1},
+            {"MSHRFull",  "Number of requests that waited for a free MSHR entry", "count", 1},
             )
 
 #define MEMCACHE_ELI_SUBCOMPONENTSLOTS {"backend", "Memory controller and/or memory timing model.", "SST::MemHierarchy::MemBackend"},\
@@ -93,31 +105,68 @@ protected:
      *  MISS_WB: The lookup will be a miss and require a writeback; the current access is to check the tag
      *  STALL: Another access for the same line is outstanding, stall until it finishes -> may not actually be how MCDRAM works...
      *  DATA: Sent a request for data to the remote memroy
+     *  TAG: Waiting for an SRAM tag lookup
+     *  VICTIM: The lookup will be a miss and the victim has dirty lines; the current access checks the tag, the victim is read next
      */
-    enum class AccessStatus { HIT, HIT_TAG, MISS, MISS_WB, DATA, STALL, FIN };
+    enum class AccessStatus { HIT, HIT_TAG, MISS, MISS_WB, DATA, STALL, FIN, TAG, VICTIM };
 
     struct MemAccessRecord {
         MemEvent* event;
         AccessStatus status;
         MemEvent* reqev;
+        Addr set;           // Set accessed
+        uint32_t way;       // Way hit or victim way
+        uint32_t sector;    // Line within the block
 
-        MemAccessRecord() : event(nullptr), status(AccessStatus::MISS), reqev(nullptr) { }
-        MemAccessRecord(MemEvent* ev, AccessStatus stat) : event(ev), status(stat), reqev(nullptr) { }
+        MemAccessRecord() : event(nullptr), status(AccessStatus::MISS), reqev(nullptr), set(0), way(0), sector(0) { }
+        MemAccessRecord(MemEvent* ev, AccessStatus stat) : event(ev), status(stat), reqev(nullptr), set(0), way(0), sector(0) { }
     };
 
     std::map<SST::Event::id_type, MemAccessRecord> outstandingEvents_;
 
-    std::map<uint64_t, std::queue<SST::Event::id_type> > mshr_;
+    /*
+     * Flat MSHR. Requests to the same set are serialized in one entry.
+     * Entries are allocated from a fixed pool; requests to a new set wait in mshrWait_ when the pool is empty.
+     */
+    struct MSHREntry {
+        Addr set;
+        std::vector<SST::Event::id_type> queue;
+        size_t head;
+        MSHREntry() : set(0), head(0) { }
+    };
+
+    std::vector<MSHREntry> mshrEntries_;
+    std::vector<size_t> mshrFree_;
+    std::unordered_map<Addr, size_t> mshrIndex_;
+    std::list<MemEvent*> mshrWait_;
+    int mshrSize_;
+
+    void allocateMSHR(MemEvent* ev, Addr set);
+    SST::Event::id_type mshrFront(Addr set);
+    bool popMSHR(Addr set);                      // Returns whether more requests are waiting on the set
 
+    /* Tag and per-line (sector) state for one cache block */
     struct CacheState {
-        Addr addr;
+        Addr addr;          // Base address of the block
         State state;
-        CacheState(Addr a, State s) : addr(a), state(s) { }
+        uint64_t valid;     // Valid lines in the block
+        uint64_t dirty;     // Dirty lines in the block
+        uint64_t lastUse;   // For LRU replacement
+        CacheState(Addr a, State s) : addr(a), state(s), valid(0), dirty(0), lastUse(0) { }
     };
 
-    std::vector<CacheState> cache_;
+    std::vector<CacheState> cache_;     // numSets_ x associativity_ blocks
     Addr lineSize_;
     Addr lineOffset_;
+    Addr blockSize_;
+    uint32_t linesPerBlock_;
+    uint32_t associativity_;
+    uint64_t numSets_;
+    bool tagsInSRAM_;
+    uint64_t tagLatency_;
+    uint64_t timestamp_;
+
+    TimingWheel<SST::Event::id_type> tagQueue_; // SRAM tag lookups in progress
 
     void notifyListeners( MemEvent* ev ) {
         if (  ! listeners_.empty()) {
@@ -136,13 +185,22 @@ protected:
 
     virtual bool clock( SST::Cycle_t );
 
-    void handleRead(MemEvent* ev, bool replay);
-    void handleWrite(MemEvent* ev, bool replay);
+    void handleAccess(MemEvent* ev, bool replay);
     void handleFlush(MemEvent* ev);
     void handleDataResponse(MemEvent* ev);
-    void retry(Addr cacheIndex);
+    void retry(Addr set);
+
+    void finishLookup(std::map<SST::Event::id_type, MemAccessRecord>::iterator it);
+    enum class LookupResult { HIT, SECTOR_MISS, MISS };
+    LookupResult lookup(MemAccessRecord& rec);  // Fills in rec.set/way/sector
+    void issueLocal(MemAccessRecord& rec, Command cmd);
+    void sendWriteback(MemAccessRecord& rec);
+    void sendRemoteRead(MemAccessRecord& rec);
+    void decodeAddr(Addr addr, Addr &set, Addr &blockAddr, uint32_t &sector);
+    Addr frameIndex(const MemAccessRecord& rec) { return ((rec.set * associativity_ + rec.way) * linesPerBlock_) + rec.sector; }
+    CacheState& block(const MemAccessRecord& rec) { return cache_[rec.set * associativity_ + rec.way]; }
 
-    void sendResponse(MemEvent* ev, uint32_t flags);
+    void sendResponse(MemEvent* ev, uint32_t flags, Addr frame);
 
     Output out;
     Output dbg;
@@ -160,15 +218,15 @@ protected:
         return region_.contains(addr);
     }
 
-    void writeData( MemEvent* );
-    void readData( MemEvent* );
+    void writeData( MemEvent*, Addr frame );
+    void readData( MemEvent*, Addr frame );
 
     size_t memSize_;
 
     bool clockOn_;
 
     MemRegion region_; // Which address region we are, for translating to local addresses
-    Addr toLocalAddr(Addr addr);
+    Addr toLocalAddr(Addr addr);    // Local line number of a global address
 
     Clock::Handler<MemCacheController>* clockHandler_;
     TimeConverter* clockTimeBase_;
@@ -183,6 +241,9 @@ protected:
     Statistic<uint64_t>* statReadMiss;
     Statistic<uint64_t>* statWriteHit;
     Statistic<uint64_t>* statWriteMiss;
+    Statistic<uint64_t>* statSectorMiss;
+    Statistic<uint64_t>* statWriteback;
+    Statistic<uint64_t>* statMSHRFull;
 
 private:
     void handleCustomEvent(MemEventBase* ev);
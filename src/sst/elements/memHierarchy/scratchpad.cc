@@ -423,8 +423,8 @@ bool Scratchpad::clock(Cycle_t cycle) {
 
     // issue ready events
     uint32_t responseThisCycle = (responsesPerCycle_ == 0) ? 1 : 0;
-    while (!procMsgQueue_.empty() && procMsgQueue_.begin()->first < timestamp_) {
-        MemEventBase * sendEv = procMsgQueue_.begin()->second;
+    while (procMsgQueue_.ready(timestamp_ - 1)) {
+        MemEventBase * sendEv = procMsgQueue_.front();
 
         if (is_debug_event(sendEv)) {
             debug = true;
@@ -433,13 +433,13 @@ bool Scratchpad::clock(Cycle_t cycle) {
         }
 
         linkUp_->send(sendEv);
-        procMsgQueue_.erase(procMsgQueue_.begin());
+        procMsgQueue_.pop();
         responseThisCycle++;
         if (responseThisCycle == responsesPerCycle_) break;
     }
 
-    while (!memMsgQueue_.empty() && memMsgQueue_.begin()->first < timestamp_) {
-        MemEvent * sendEv = memMsgQueue_.begin()->second;
+    while (memMsgQueue_.ready(timestamp_ - 1)) {
+        MemEvent * sendEv = memMsgQueue_.front();
         sendEv->setDst(linkDown_->findTargetDestination(sendEv->getBaseAddr()));
 
         if (is_debug_event(sendEv)) {
@@ -450,7 +450,7 @@ bool Scratchpad::clock(Cycle_t cycle) {
 
         linkDown_->send(sendEv);
 
-        memMsgQueue_.erase(memMsgQueue_.begin());
+        memMsgQueue_.pop();
     }
 
     linkDown_->clock();
@@ -687,7 +687,7 @@ void Scratchpad::handleScratchGet(MemEventBase * event) {
                 Simulation::getSimulation()->getCurrentSimCycle(), timestamp_, getName().c_str(), saddr, daddr, remoteRead->getID().first, remoteRead->getID().second, remoteRead->getBaseAddr());
     }
 
-    memMsgQueue_.insert(std::make_pair(timestamp_, remoteRead));
+    memMsgQueue_.insert(timestamp_, remoteRead);
 
     // Insert into mshr and send inv if needed
     // start base addr -> end base addr
@@ -952,7 +952,7 @@ void Scratchpad::handleNack(MemEventBase * event) {
         uint64_t backoff = (0x1 << retries);
         nackedEvent->incrementRetries();
 
-        procMsgQueue_.insert(std::make_pair(timestamp_ + backoff, nackedEvent));
+        procMsgQueue_.insert(timestamp_ + backoff, nackedEvent);
 
     } else {
         delete nackedEvent;
@@ -980,7 +980,7 @@ void Scratchpad::handleRemoteRead(MemEvent * event) {
     outstandingEventList_.insert(std::make_pair(event->getID(), OutstandingEvent(event, response)));
     responseIDMap_.insert(std::make_pair(request->getID(), event->getID()));
 
-    memMsgQueue_.insert(std::make_pair(timestamp_, request));
+    memMsgQueue_.insert(timestamp_, request);
 }
 
 
@@ -1001,11 +1001,11 @@ void Scratchpad::handleRemoteWrite(MemEvent * event) {
     request->setVirtualAddress(event->getVirtualAddress());
     request->setInstructionPointer(event->getInstructionPointer());
 
-    memMsgQueue_.insert(std::make_pair(timestamp_, request));
+    memMsgQueue_.insert(timestamp_, request);
 
     MemEvent * response = event->makeResponse();
 
-    procMsgQueue_.insert(std::make_pair(timestamp_, response));
+    procMsgQueue_.insert(timestamp_, response);
 
     delete event;
 }
@@ -1183,7 +1183,7 @@ void Scratchpad::doScratchWrite(MemEvent * event) {
 }
 
 void Scratchpad::sendResponse(MemEventBase * event) {
-    procMsgQueue_.insert(std::make_pair(timestamp_, event));
+    procMsgQueue_.insert(timestamp_, event);
 }
 
 
@@ -1200,7 +1200,7 @@ bool Scratchpad::startGet(Addr baseAddr, MoveEvent * get) {
         inv->setInstructionPointer(get->getInstructionPointer());
         dbg.debug(_L10_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Get            0x%-16" PRIx64 " 0x%-16" PRIx64 " Inv         (<%" PRIu64 ", %" PRIu32 ">, 0x%" PRIx64 ")\n",
                 Simulation::getSimulation()->getCurrentSimCycle(), timestamp_, getName().c_str(), get->getSrcBaseAddr(), get->getDstBaseAddr(), inv->getID().first, inv->getID().second, inv->getBaseAddr());
-        procMsgQueue_.insert(std::make_pair(timestamp_, inv));
+        procMsgQueue_.insert(timestamp_, inv);
         return true;
     }
     return false;
@@ -1220,7 +1220,7 @@ bool Scratchpad::startPut(Addr baseAddr, MoveEvent * put) {
         inv->setInstructionPointer(put->getInstructionPointer());
         dbg.debug(_L10_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Put            0x%-16" PRIx64 " 0x%-16" PRIx64 " Inv         (<%" PRIu64 ", %" PRIu32 ">, 0x%" PRIx64 ")\n",
                 Simulation::getSimulation()->getCurrentSimCycle(), timestamp_, getName().c_str(), put->getSrcBaseAddr(), put->getDstBaseAddr(), inv->getID().first, inv->getID().second, inv->getBaseAddr());
-        procMsgQueue_.insert(std::make_pair(timestamp_, inv));
+        procMsgQueue_.insert(timestamp_, inv);
         return true;
     } else {
         // Derive addr and size from baseAddr and the put request
@@ -1261,7 +1261,7 @@ void Scratchpad::updatePut(SST::Event::id_type putID) {
                 outstandingEventList_.find(putID)->second.remoteWrite->getBaseAddr());
 //        dbg.debug(_L5_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Finish        0x%-16" PRIx64 " <%" PRIu64 ", %" PRIu32 ">\n",
 //                Simulation::getSimulation()->getCurrentSimCycle(), timestamp_, getName().c_str(), outstandingEventList_.find(putID)->second.remoteWrite->getBaseAddr(), baseAddr, responseID.first, responseID.second);
-        memMsgQueue_.insert(std::make_pair(timestamp_, outstandingEventList_.find(putID)->second.remoteWrite));
+        memMsgQueue_.insert(timestamp_, outstandingEventList_.find(putID)->second.remoteWrite);
         sendResponse(outstandingEventList_.find(putID)->second.response);
         delete outstandingEventList_.find(putID)->second.request;
         outstandingEventList_.erase(putID);
@@ -29,6 +29,7 @@
 #include "sst/elements/memHierarchy/moveEvent.h"
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
+#include "sst/elements/memHierarchy/timingWheel.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -229,8 +230,8 @@ private:
 
 
     // Outgoing message queues - map send timestamp to event
-    std::multimap<uint64_t, MemEventBase*> procMsgQueue_;
-    std::multimap<uint64_t, MemEvent*> memMsgQueue_;
+    TimingWheel<MemEventBase*> procMsgQueue_;
+    TimingWheel<MemEvent*> memMsgQueue_;
 
     // Throughput limits
     uint32_t responsesPerCycle_;
@@ -0,0 +1,245 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include "testcpu/dmaCPU.h"
+
+#include <sst/core/params.h>
+#include <sst/core/simulation.h>
+
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+/* Source data lives in [0, srcEnd) and is written during init. Everything else starts out zero. */
+static const Addr srcEnd = 0x4000;
+
+
+dmaCPU::dmaCPU(ComponentId_t id, Params& params) :
+    Component(id)
+{
+    uint32_t outputLevel = params.find<uint32_t>("verbose", 0);
+    out.init("DmaCPU:@p:@l: ", outputLevel, 0, Output::STDOUT);
+
+    lineSize = params.find<uint64_t>("lineSize", 64);
+    if (lineSize == 0 || (srcEnd % lineSize) != 0) {
+        out.fatal(CALL_INFO, -1, "Invalid param: lineSize must be a non-zero divisor of %" PRIu64 "\n", (uint64_t)srcEnd);
+    }
+
+    // tell the simulator not to end without us
+    registerAsPrimaryComponent();
+    primaryComponentDoNotEndSim();
+
+    //set our clock
+    std::string clockFreq = params.find<std::string>("clock", "1GHz");
+    clockHandler = new Clock::Handler<dmaCPU>(this, &dmaCPU::clockTic);
+    clockTC = registerClock(clockFreq, clockHandler);
+
+    dmaLink = configureLink("dma_link", new Event::Handler<dmaCPU>(this, &dmaCPU::handleDMA));
+    if (!dmaLink) {
+        out.fatal(CALL_INFO, -1, "Missing dma_link\n");
+    }
+
+    memory = loadUserSubComponent<Interfaces::SimpleMem>("memory", ComponentInfo::SHARE_NONE, clockTC, new Interfaces::SimpleMem::Handler<dmaCPU>(this, &dmaCPU::handleEvent));
+
+    if (!memory) {
+        Params interfaceParams;
+        interfaceParams.insert("port", "mem_link");
+        memory = loadAnonymousSubComponent<Interfaces::SimpleMem>("memHierarchy.memInterface", "memory", 0, ComponentInfo::SHARE_PORTS | ComponentInfo::INSERT_STATS,
+                interfaceParams, clockTC, new Interfaces::SimpleMem::Handler<dmaCPU>(this, &dmaCPU::handleEvent));
+    }
+
+    commandsCompleted = 0;
+    commandsSent = false;
+
+    /* Contiguous copy */
+    addCommand(new DMACommand(this, 0x10000, 0x0, 256), "contiguous");
+
+    /* Pack 16B out of every 64B */
+    DMACommand * cmd = new DMACommand(this);
+    cmd->addStrided(0x11000, 0x1000, 16, 8, 16, 64);
+    addCommand(cmd, "strided");
+
+    /* Gather, the last block crosses a line on both sides */
+    std::vector<std::pair<Addr,size_t> > blocks;
+    blocks.push_back(std::make_pair(0x2000, 32));
+    blocks.push_back(std::make_pair(0x2100, 48));
+    blocks.push_back(std::make_pair(0x2230, 40));
+    cmd = new DMACommand(this);
+    cmd->addGather(0x12000, blocks);
+    addCommand(cmd, "gather");
+
+    /* Scatter */
+    blocks.clear();
+    blocks.push_back(std::make_pair(0x13000, 64));
+    blocks.push_back(std::make_pair(0x13100, 8));
+    blocks.push_back(std::make_pair(0x13208, 56));
+    cmd = new DMACommand(this);
+    cmd->addScatter(blocks, 0x3000);
+    addCommand(cmd, "scatter");
+
+    /* Reads the first command's destination, so it has to wait for that command to finish */
+    addCommand(new DMACommand(this, 0x14000, 0x10000, 256), "dependent copy");
+}
+
+dmaCPU::dmaCPU() :
+    Component(-1)
+{
+    // for serialization only
+}
+
+
+/* Record a command and apply it to the expected memory image */
+void dmaCPU::addCommand(DMACommand * cmd, const std::string& kind)
+{
+    size_t index = commands.size();
+    commands.push_back(cmd);
+    commandKinds.push_back(kind);
+    commandIndex.insert(std::make_pair(cmd->getID(), index));
+    commandDone.push_back(false);
+    bytesChecked.push_back(0);
+    mismatches.push_back(0);
+
+    for (std::vector<DMADescriptor>::const_iterator it = cmd->descriptors.begin(); it != cmd->descriptors.end(); it++) {
+        for (uint64_t block = 0; block < it->count; block++) {
+            for (size_t i = 0; i < it->size; i++) {
+                Addr src = it->src + block * it->srcStride + i;
+                Addr dst = it->dst + block * it->dstStride + i;
+                std::map<Addr, std::pair<uint8_t, size_t> >::iterator data = expected.find(src);
+                uint8_t value = (data == expected.end()) ? expectedSource(src) : data->second.first;
+                expected[dst] = std::make_pair(value, index);
+                checkLines.insert(dst - (dst % lineSize));
+            }
+        }
+    }
+}
+
+
+uint8_t dmaCPU::expectedSource(Addr addr) const
+{
+    if (addr >= srcEnd)
+        return 0;
+    return 1 + ((addr ^ (addr >> 8)) % 255);
+}
+
+
+void dmaCPU::init(unsigned int phase)
+{
+    memory->init(phase);
+
+    if (!phase) {
+        for (Addr line = 0; line < srcEnd; line += lineSize) {
+            std::vector<uint8_t> data(lineSize);
+            for (uint64_t i = 0; i < lineSize; i++)
+                data[i] = expectedSource(line + i);
+            Interfaces::SimpleMem::Request *req = new Interfaces::SimpleMem::Request(Interfaces::SimpleMem::Request::Write, line, lineSize, data);
+            memory->sendInitData(req);
+            delete req;
+        }
+    }
+}
+
+
+void dmaCPU::handleDMA(SST::Event * ev)
+{
+    DMACommand * cmd = static_cast<DMACommand*>(ev);
+    std::map<SST::Event::id_type, size_t>::iterator it = commandIndex.find(cmd->getID());
+    if (it == commandIndex.end() || commandDone[it->second]) {
+        out.fatal(CALL_INFO, -1, "Received an unknown or duplicate DMA command (%" PRIu64 ", %d)\n", cmd->getID().first, cmd->getID().second);
+    }
+
+    out.verbose(CALL_INFO, 1, 0, "Command %zu (%s) completed.\n", it->second, commandKinds[it->second].c_str());
+    commandDone[it->second] = true;
+    commandsCompleted++;
+    delete cmd;
+}
+
+
+// incoming events are scanned and deleted
+void dmaCPU::handleEvent(Interfaces::SimpleMem::Request * req)
+{
+    std::set<uint64_t>::iterator i = requests.find(req->id);
+    if (i == requests.end()) {
+        out.fatal(CALL_INFO, -1, "Request ID (%" PRIx64 ") not found in outstanding requests!\n", req->id);
+    }
+    requests.erase(i);
+
+    for (size_t j = 0; j < req->data.size(); j++) {
+        std::map<Addr, std::pair<uint8_t, size_t> >::iterator data = expected.find(req->addr + j);
+        if (data == expected.end())
+            continue;
+        bytesChecked[data->second.second]++;
+        if (req->data[j] != data->second.first) {
+            mismatches[data->second.second]++;
+            out.verbose(CALL_INFO, 1, 0, "Mismatch at 0x%" PRIx64 ": expected %" PRIu8 ", read %" PRIu8 "\n",
+                    data->first, data->second.first, req->data[j]);
+        }
+    }
+    delete req;
+}
+
+
+bool dmaCPU::clockTic( Cycle_t )
+{
+    if (!commandsSent) {
+        for (std::vector<DMACommand*>::iterator it = commands.begin(); it != commands.end(); it++)
+            dmaLink->send(*it);
+        commands.clear();
+        commandsSent = true;
+        return false;
+    }
+
+    if (commandsCompleted < commandDone.size())
+        return false;
+
+    // One read per cycle until every destination line has been checked
+    if (!checkLines.empty()) {
+        Addr line = *checkLines.begin();
+        checkLines.erase(checkLines.begin());
+        Interfaces::SimpleMem::Request *req = new Interfaces::SimpleMem::Request(Interfaces::SimpleMem::Request::Read, line, lineSize);
+        requests.insert(req->id);
+        memory->sendRequest(req);
+        return false;
+    }
+
+    if (requests.empty()) {
+        primaryComponentOKToEndSim();
+        return true;
+    }
+
+    return false;
+}
+
+
+void dmaCPU::finish()
+{
+    std::vector<uint64_t> bytesExpected(commandDone.size(), 0);
+    for (std::map<Addr, std::pair<uint8_t, size_t> >::iterator it = expected.begin(); it != expected.end(); it++)
+        bytesExpected[it->second.second]++;
+
+    bool pass = true;
+    for (size_t i = 0; i < commandDone.size(); i++) {
+        out.output("%s: command %zu (%s) %s, %" PRIu64 " bytes checked, %" PRIu64 " mismatches\n",
+                getName().c_str(), i, commandKinds[i].c_str(), commandDone[i] ? "completed" : "not completed",
+                bytesChecked[i], mismatches[i]);
+        if (!commandDone[i] || mismatches[i] != 0 || bytesChecked[i] != bytesExpected[i])
+            pass = false;
+    }
+
+    if (!pass) {
+        out.fatal(CALL_INFO, -1, "%s: DMA test failed, every command must complete and all %zu destination bytes must be read back and match\n",
+                getName().c_str(), expected.size());
+    }
+}
@@ -0,0 +1,111 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _dmaCPU_H
+#define _dmaCPU_H
+
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+#include <inttypes.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+#include <sst/core/output.h>
+
+#include <sst/core/interfaces/simpleMem.h>
+#include "dmaEngine.h"
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Test driver for the DMAEngine.
+ * Fills a source region with a known pattern during init, sends a fixed set of
+ * contiguous, strided, gather and scatter DMACommands, and once they have all
+ * completed reads the destinations back through the memory interface and checks them.
+ * Exits with an error from finish() if any command did not complete or any byte does not match.
+ */
+class dmaCPU : public SST::Component {
+public:
+/* Element Library Info */
+    SST_ELI_REGISTER_COMPONENT(dmaCPU, "memHierarchy", "dmaCPU", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Simple test CPU for the DMAEngine. Issues contiguous, strided, gather and scatter DMAs and checks the copied data", COMPONENT_CATEGORY_PROCESSOR)
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"verbose",                 "(uint) Determine how verbose the output from the CPU is", "0"},
+            {"clock",                   "(string) Clock frequency", "1GHz"},
+            {"lineSize",                "(uint) Size of a cache line, reads used to check the data do not cross lines", "64"} )
+
+    SST_ELI_DOCUMENT_PORTS(
+            {"mem_link", "Connection to cache", { "memHierarchy.MemEventBase" } },
+            {"dma_link", "Connection to the DMAEngine's cmdLink", { "memHierarchy.DMACommand" } } )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( {"memory", "Interface to memory (e.g., caches)", "SST::Interfaces::SimpleMem"} )
+
+/* Begin class definiton */
+    dmaCPU(SST::ComponentId_t id, SST::Params& params);
+    void init(unsigned int phase);
+    void finish();
+
+private:
+    dmaCPU();  // for serialization only
+    dmaCPU(const dmaCPU&); // do not implement
+    void operator=(const dmaCPU&); // do not implement
+
+    void handleEvent( SST::Interfaces::SimpleMem::Request * req );
+    void handleDMA( SST::Event * ev );
+    virtual bool clockTic( SST::Cycle_t );
+
+    void addCommand(DMACommand * cmd, const std::string& kind);
+    uint8_t expectedSource(Addr addr) const;
+
+    Output out;
+    uint64_t lineSize;
+
+    std::vector<DMACommand*> commands;
+    std::vector<std::string> commandKinds;
+    std::map<SST::Event::id_type, size_t> commandIndex;
+    std::vector<bool> commandDone;
+    size_t commandsCompleted;
+    bool commandsSent;
+
+    // Expected value of every destination byte and the command that writes it
+    std::map<Addr, std::pair<uint8_t, size_t> > expected;
+    std::vector<uint64_t> bytesChecked;
+    std::vector<uint64_t> mismatches;
+
+    // Lines left to read back, and reads in flight
+    std::set<Addr> checkLines;
+    std::set<uint64_t> requests;
+
+    Interfaces::SimpleMem * memory;
+    Link * dmaLink;
+
+    TimeConverter *clockTC;
+    Clock::HandlerBase *clockHandler;
+};
+
+}
+}
+#endif /* _dmaCPU_H */
@@ -0,0 +1,158 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include "testcpu/sieveCPU.h"
+
+#include <sst/core/params.h>
+
+#include "memEvent.h"
+#include "Sieve/alloctrackev.h"
+
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+
+sieveCPU::sieveCPU(ComponentId_t id, Params& params) :
+    Component(id)
+{
+    uint32_t outputLevel = params.find<uint32_t>("verbose", 0);
+    out.init("SieveCPU:@p:@l: ", outputLevel, 0, Output::STDOUT);
+
+    lineSize = params.find<uint64_t>("lineSize", 64);
+    if (lineSize == 0 || (lineSize & (lineSize - 1)) != 0) {
+        out.fatal(CALL_INFO, -1, "Invalid param: lineSize must be a power of two\n");
+    }
+
+    // tell the simulator not to end without us
+    registerAsPrimaryComponent();
+    primaryComponentDoNotEndSim();
+
+    //set our clock
+    std::string clockFreq = params.find<std::string>("clock", "1GHz");
+    clockHandler = new Clock::Handler<sieveCPU>(this, &sieveCPU::clockTic);
+    clockTC = registerClock(clockFreq, clockHandler);
+
+    memLink = configureLink("mem_link", new Event::Handler<sieveCPU>(this, &sieveCPU::handleEvent));
+    allocLink = configureLink("alloc_link");
+    if (!memLink || !allocLink) {
+        out.fatal(CALL_INFO, -1, "Both mem_link and alloc_link must be connected\n");
+    }
+
+    nextOp = 0;
+    outstanding = 0;
+    reads = writes = allocEvents = 0;
+
+    /* Three allocations */
+    addOp(ALLOC, 0x100000, 4096, 1);
+    addOp(ALLOC, 0x200000, 8192, 2);
+    addOp(ALLOC, 0x300000, 2048, 3);
+
+    /* Read all of 1, write every other line of 2 */
+    addAccesses(READ, 0x100000, 4096 / lineSize, lineSize);
+    addAccesses(WRITE, 0x200000, 64, 2 * lineSize);
+    addOp(BUOY, 0, 0, 7);
+
+    /* Read 1 again, write 3, then free 2 */
+    addAccesses(READ, 0x100000, 4096 / lineSize, lineSize);
+    addAccesses(WRITE, 0x300000, 2048 / lineSize, lineSize);
+    addOp(FREE, 0x200000);
+    addOp(BUOY, 0, 0, 8);
+
+    /* Read 3, and one address outside every allocation. The last dump is Sieve's own at finish. */
+    addAccesses(READ, 0x300000, 2048 / lineSize, lineSize);
+    addOp(READ, 0x900000);
+}
+
+sieveCPU::sieveCPU() :
+    Component(-1)
+{
+    // for serialization only
+}
+
+
+void sieveCPU::addOp(OpType type, Addr addr, uint64_t size, uint64_t id)
+{
+    Op op = { type, addr, size, id };
+    ops.push_back(op);
+}
+
+void sieveCPU::addAccesses(OpType type, Addr start, uint64_t count, uint64_t stride)
+{
+    for (uint64_t i = 0; i < count; i++)
+        addOp(type, start + i * stride);
+}
+
+
+void sieveCPU::init(unsigned int phase)
+{
+    // Sieve announces its event type during init, nothing to do with it
+    while (SST::Event * ev = memLink->recvInitData())
+        delete ev;
+}
+
+
+// responses are counted and deleted
+void sieveCPU::handleEvent(SST::Event * ev)
+{
+    if (outstanding == 0) {
+        out.fatal(CALL_INFO, -1, "Received a response with no requests outstanding\n");
+    }
+    outstanding--;
+    delete ev;
+}
+
+
+bool sieveCPU::clockTic( Cycle_t )
+{
+    if (nextOp == ops.size()) {
+        if (outstanding == 0) {
+            primaryComponentOKToEndSim();
+            return true;
+        }
+        return false;
+    }
+
+    Op& op = ops[nextOp];
+
+    if (op.type == READ || op.type == WRITE) {
+        MemEvent * ev = new MemEvent(getName(), op.addr, op.addr & ~(lineSize - 1), op.type == READ ? Command::GetS : Command::GetX, 8);
+        ev->setVirtualAddress(op.addr);
+        memLink->send(ev);
+        outstanding++;
+        if (op.type == READ) reads++;
+        else writes++;
+    } else {
+        // Counts at a buoy must include every access before it
+        if (outstanding != 0)
+            return false;
+
+        AllocTrackEvent::AllocTrackType type = (op.type == ALLOC) ? AllocTrackEvent::ALLOC :
+            (op.type == FREE) ? AllocTrackEvent::FREE : AllocTrackEvent::BUOY;
+        allocLink->send(new AllocTrackEvent(type, op.addr, op.size, 0, op.id));
+        allocEvents++;
+    }
+
+    nextOp++;
+    return false;
+}
+
+
+void sieveCPU::finish()
+{
+    out.output("%s: %" PRIu64 " reads, %" PRIu64 " writes, %" PRIu64 " allocation events\n",
+            getName().c_str(), reads, writes, allocEvents);
+}
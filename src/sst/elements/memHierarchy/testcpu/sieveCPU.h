@@ -0,0 +1,102 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _sieveCPU_H
+#define _sieveCPU_H
+
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+#include <inttypes.h>
+
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+#include <sst/core/output.h>
+
+#include "util.h"
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Test driver for Sieve.
+ * Runs a fixed script of allocations, frees, buoys, reads and writes, one per cycle,
+ * so that the allocation counts Sieve dumps at each buoy are known in advance.
+ * Allocation events wait until all memory requests before them have returned.
+ */
+class sieveCPU : public SST::Component {
+public:
+/* Element Library Info */
+    SST_ELI_REGISTER_COMPONENT(sieveCPU, "memHierarchy", "sieveCPU", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Simple test CPU for Sieve. Issues a fixed sequence of allocations, buoys and accesses", COMPONENT_CATEGORY_PROCESSOR)
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"verbose",                 "(uint) Determine how verbose the output from the CPU is", "0"},
+            {"clock",                   "(string) Clock frequency", "1GHz"},
+            {"lineSize",                "(uint) Size of a cache line, each access touches one line", "64"} )
+
+    SST_ELI_DOCUMENT_PORTS(
+            {"mem_link", "Connection to Sieve's cpu_link", { "memHierarchy.MemEventBase" } },
+            {"alloc_link", "Connection to Sieve's alloc_link", { "memHierarchy.AllocTrackEvent" } } )
+
+/* Begin class definiton */
+    sieveCPU(SST::ComponentId_t id, SST::Params& params);
+    void init(unsigned int phase);
+    void finish();
+
+private:
+    sieveCPU();  // for serialization only
+    sieveCPU(const sieveCPU&); // do not implement
+    void operator=(const sieveCPU&); // do not implement
+
+    enum OpType { READ, WRITE, ALLOC, FREE, BUOY };
+    struct Op {
+        OpType type;
+        Addr addr;
+        uint64_t size;  // ALLOC only
+        uint64_t id;    // mallocID for ALLOC, marker for BUOY
+    };
+
+    void addOp(OpType type, Addr addr, uint64_t size = 0, uint64_t id = 0);
+    void addAccesses(OpType type, Addr start, uint64_t count, uint64_t stride);
+
+    void handleEvent( SST::Event * ev );
+    virtual bool clockTic( SST::Cycle_t );
+
+    Output out;
+    uint64_t lineSize;
+
+    std::vector<Op> ops;
+    size_t nextOp;
+    uint64_t outstanding;
+    uint64_t reads;
+    uint64_t writes;
+    uint64_t allocEvents;
+
+    Link * memLink;
+    Link * allocLink;
+
+    TimeConverter *clockTC;
+    Clock::HandlerBase *clockHandler;
+};
+
+}
+}
+#endif /* _sieveCPU_H */
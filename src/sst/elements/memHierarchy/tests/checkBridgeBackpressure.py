@@ -0,0 +1,39 @@
+#!/usr/bin/env python
+
+# Checks the bridge statistics printed by testBridgeBackpressure.py
+#   usage: checkBridgeBackpressure.py <sst output> <lines>
+# Every line is one request from net0 to net1 and one response back, so
+# the bridge must receive and send exactly <lines> packets on each side.
+# A lost or duplicated packet while responses wait in the bridge's send
+# queue shows up as a mismatch.  Exits non-zero if a check fails.
+
+import re
+import sys
+
+statPattern = re.compile('\A bridge\.(pkts_(received|sent)_net[01]) : Accumulator : Sum.u64 = ([0-9]+);')
+
+if len(sys.argv) != 3:
+    sys.stderr.write("usage: %s <sst output> <lines>\n" % sys.argv[0])
+    sys.exit(2)
+
+lines = int(sys.argv[2])
+
+stats = dict()
+with open(sys.argv[1]) as f:
+    for line in f:
+        statMatch = statPattern.match(line)
+        if statMatch:
+            stats[statMatch.group(1)] = int(statMatch.group(3))
+
+errors = 0
+for name in ("pkts_received_net0", "pkts_sent_net1", "pkts_received_net1", "pkts_sent_net0"):
+    if name not in stats:
+        sys.stderr.write("FAIL: statistic bridge.%s is missing from %s\n" % (name, sys.argv[1]))
+        errors = errors + 1
+    elif stats[name] != lines:
+        sys.stderr.write("FAIL: bridge.%s is %d, expected %d\n" % (name, stats[name], lines))
+        errors = errors + 1
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Checked %d requests and responses through the bridge\n" % lines)
@@ -0,0 +1,55 @@
+#!/usr/bin/env python
+
+# Checks the statistics printed by the testMemoryCache-*.py tests
+#   usage: checkMemoryCache.py <sst output> [statistic ...]
+# Every miss in 'memcache' must read one line from 'memory' and every writeback must write one,
+# and each statistic named on the command line must be non-zero.
+# Exits non-zero if a check fails.
+
+import re
+import sys
+
+statPattern = re.compile('\A ([^ .]+)\.([^ ]+) : Accumulator : Sum.u64 = ([0-9]+);')
+
+if len(sys.argv) < 2:
+    sys.stderr.write("usage: %s <sst output> [statistic ...]\n" % sys.argv[0])
+    sys.exit(2)
+
+stats = dict()
+with open(sys.argv[1]) as f:
+    for line in f:
+        statMatch = statPattern.match(line)
+        if statMatch:
+            stats[(statMatch.group(1), statMatch.group(2))] = int(statMatch.group(3))
+
+def stat(comp, name):
+    if (comp, name) not in stats:
+        sys.stderr.write("FAIL: statistic %s.%s is missing from %s\n" % (comp, name, sys.argv[1]))
+        sys.exit(1)
+    return stats[(comp, name)]
+
+errors = 0
+def check(cond, msg):
+    global errors
+    if not cond:
+        sys.stderr.write("FAIL: %s\n" % msg)
+        errors = errors + 1
+
+hits = stat("memcache", "CacheHits_Read") + stat("memcache", "CacheHits_Write")
+misses = stat("memcache", "CacheMisses_Read") + stat("memcache", "CacheMisses_Write")
+writebacks = stat("memcache", "Writebacks")
+remoteReads = stat("memory", "requests_received_GetS")
+remoteWrites = stat("memory", "requests_received_PutM")
+
+check(hits > 0, "memcache had no hits")
+check(misses > 0, "memcache had no misses")
+check(remoteReads == misses, "memory received %d reads for %d memcache misses" % (remoteReads, misses))
+check(remoteWrites == writebacks, "memory received %d writes for %d memcache writebacks" % (remoteWrites, writebacks))
+check(stat("memcache", "SectorMisses") <= misses, "memcache has more sector misses than misses")
+
+for name in sys.argv[2:]:
+    check(stat("memcache", name) > 0, "memcache.%s is 0" % name)
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Checked %d hits, %d misses, %d writebacks\n" % (hits, misses, writebacks))
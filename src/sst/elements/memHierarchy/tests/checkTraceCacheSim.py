@@ -0,0 +1,64 @@
+#!/usr/bin/env python
+
+# Compares the statistics of testTraceCacheSim.py against testTraceCacheSimReference.py
+#   usage: checkTraceCacheSim.py <TraceCacheSim output> <reference output>
+# Each level's Hits and Misses from TraceCacheSim must equal the sum of the GetS/GetX Hit and
+# Miss statistics of the matching memHierarchy cache. Whether a reference access counts as
+# Arrival or Blocked depends on timing, so only the sums are compared.
+# Exits non-zero if a check fails.
+
+import re
+import sys
+
+statPattern = re.compile('\A ([^ .]+)\.([^ ]+) : Accumulator : Sum.u64 = ([0-9]+);')
+
+if len(sys.argv) != 3:
+    sys.stderr.write("usage: %s <TraceCacheSim output> <reference output>\n" % sys.argv[0])
+    sys.exit(2)
+
+def readStats(fileName):
+    stats = dict()
+    with open(fileName) as f:
+        for line in f:
+            statMatch = statPattern.match(line)
+            if statMatch:
+                stats[statMatch.group(1) + "." + statMatch.group(2)] = int(statMatch.group(3))
+    return stats
+
+tcs = readStats(sys.argv[1])
+ref = readStats(sys.argv[2])
+
+errors = 0
+def stat(stats, name, fileName):
+    global errors
+    if name not in stats:
+        sys.stderr.write("FAIL: statistic %s is missing from %s\n" % (name, fileName))
+        errors = errors + 1
+        return 0
+    return stats[name]
+
+def refSum(cache, kind):
+    return sum(stat(ref, "%s.%s%s_%s" % (cache, cmd, kind, when), sys.argv[2])
+               for cmd in ("GetS", "GetX") for when in ("Arrival", "Blocked"))
+
+for level, cache in (("L1", "l1"), ("L2", "l2")):
+    for tcsName, kind in (("Hits", "Hit"), ("Misses", "Miss")):
+        tcsCount = stat(tcs, "tcs.%s.%s" % (tcsName, level), sys.argv[1])
+        refCount = refSum(cache, kind)
+        if tcsCount != refCount:
+            sys.stderr.write("FAIL: TraceCacheSim has %d %s %s, %s has %d\n" % (tcsCount, level, tcsName, cache, refCount))
+            errors = errors + 1
+
+# Every record in this trace is an aligned 8B access, so each is one L1 access
+records = stat(tcs, "tcs.TraceReads", sys.argv[1]) + stat(tcs, "tcs.TraceWrites", sys.argv[1])
+l1Accesses = stat(tcs, "tcs.Hits.L1", sys.argv[1]) + stat(tcs, "tcs.Misses.L1", sys.argv[1])
+if records != l1Accesses:
+    sys.stderr.write("FAIL: %d trace records but %d L1 accesses\n" % (records, l1Accesses))
+    errors = errors + 1
+if stat(tcs, "tcs.BackInvalidations.L2", sys.argv[1]) == 0:
+    sys.stderr.write("FAIL: the L2 never back-invalidated the L1\n")
+    errors = errors + 1
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Checked %d trace records, L1 and L2 hits and misses match\n" % records)
@@ -107,15 +107,22 @@ echo "Misc..."
 sst testCustomCmdGoblin-1.py > refFiles/test_memHA_CustomCmdGoblin_1.out &   
 sst testCustomCmdGoblin-2.py > refFiles/test_memHA_CustomCmdGoblin_2.out &   
 sst testCustomCmdGoblin-3.py > refFiles/test_memHA_CustomCmdGoblin_3.out &   
+sst testDMAEngine.py > refFiles/test_memHA_DMAEngine.out &
 sst testDistributedCaches.py > refFiles/test_memHA_DistributedCaches.out &
 sst testFlushes.py > refFiles/test_memHA_Flushes.out &      
 sst testFlushes-2.py > refFiles/test_memHA_Flushes_2.out &
 sst testHashXor.py > refFiles/test_memHA_HashXor.out &    
 sst testIncoherent.py > refFiles/test_memHA_Incoherent.out &
+sst testMemoryCache-1.py > refFiles/test_memHA_MemoryCache_1.out &
+sst testMemoryCache-2.py > refFiles/test_memHA_MemoryCache_2.out &
+sst testMemoryCache-3.py > refFiles/test_memHA_MemoryCache_3.out &
+sst testMemoryCache-4.py > refFiles/test_memHA_MemoryCache_4.out &
 sst testNoninclusive-1.py > refFiles/test_memHA_Noninclusive_1.out &   
 sst testNoninclusive-2.py > refFiles/test_memHA_Noninclusive_2.out &   
 sst testPrefetchParams.py > refFiles/test_memHA_PrefetchParams.out &
 sst testThroughputThrottling.py > refFiles/test_memHA_ThroughputThrottling.out &  
+sst testTraceCacheSim.py > refFiles/test_memHA_TraceCacheSim.out &
+sst testTraceCacheSimReference.py > refFiles/test_memHA_TraceCacheSimReference.out &
 wait
 
 # Misc multithread
@@ -134,5 +141,13 @@ sst -n2 testPrefetchParams.py > refFiles/test_memHA_PrefetchParams_MC.out &
 sst -n2 testThroughputThrottling.py > refFiles/test_memHA_ThroughputThrottling_MC.out &
 wait
 
+# Checks on the new reference files
+echo "Checking..."
+python checkMemoryCache.py refFiles/test_memHA_MemoryCache_1.out Writebacks
+python checkMemoryCache.py refFiles/test_memHA_MemoryCache_2.out SectorMisses
+python checkMemoryCache.py refFiles/test_memHA_MemoryCache_3.out Writebacks
+python checkMemoryCache.py refFiles/test_memHA_MemoryCache_4.out MSHRFull
+python checkTraceCacheSim.py refFiles/test_memHA_TraceCacheSim.out refFiles/test_memHA_TraceCacheSimReference.out
+
 echo "Done!"
 
@@ -0,0 +1,120 @@
+import sst
+from mhlib import componentlist
+
+# Fills the bridge's output buffer so that requests have to wait in the
+# bridge's send queue.
+#
+# CPU -> L1 -> Net0 (slow) -> Bridge -> Net1 (fast) -> Mem
+#
+# Net0 runs at a fraction of Net1's bandwidth and the bridge output
+# buffers only hold one data packet, so read responses coming back from
+# memory pile up in the bridge.  The CPU streams through memory with no
+# writes and never touches a line twice, and the L1 is incoherent
+# (clean lines are evicted silently), so every line is exactly one
+# request and one response across the bridge.  The simulation only
+# ends once every response has made it back to the CPU.
+#
+# Only the bridge statistics are enabled.  Check them with:
+#   sst testBridgeBackpressure.py > out
+#   python checkBridgeBackpressure.py out 512
+
+num_loadstore = 4096    # 8B stride, so 512 lines
+mem_size = 1024 * 1024
+debug = 0
+debug_level = 0
+
+slowBW = "1GiB/s"
+fastBW = "80GiB/s"
+
+
+def buildRouter(name, bw, buf_size, num_ports):
+    rtr = sst.Component("rtr_%s"%name, "merlin.hr_router")
+    rtr.addParams({
+        "id": 0,
+        "num_ports" : num_ports,
+        "link_bw" : bw,
+        "xbar_bw" : bw,
+        "flit_size" : "8B",
+        "input_latency" : "10ns",
+        "output_latency" : "10ns",
+        "input_buf_size" : buf_size,
+        "output_buf_size" : buf_size,
+        })
+    rtr.setSubComponent("topology","merlin.singlerouter")
+    return rtr
+
+
+net0 = buildRouter("net0", slowBW, "128B", 2)
+net1 = buildRouter("net1", fastBW, "1KiB", 2)
+
+cpu = sst.Component("cpu", "memHierarchy.streamCPU")
+cpu.addParams({
+    "commFreq" : 1,
+    "do_write" : 0,
+    "memSize" : mem_size,
+    "num_loadstore" : num_loadstore,
+    "maxOutstanding" : 256,
+    })
+iface = cpu.setSubComponent("memory", "memHierarchy.memInterface")
+
+l1 = sst.Component("l1", "memHierarchy.Cache")
+l1.addParams({
+    "debug" : debug,
+    "debug_level" : debug_level,
+    "cache_frequency" : "1GHz",
+    "cache_size" : "2KiB",
+    "access_latency_cycles" : 2,
+    "associativity" : 4,
+    "cache_line_size" : 64,
+    "coherence_protocol" : "none",
+    "L1" : 1,
+    })
+l1cpu = l1.setSubComponent("cpulink", "memHierarchy.MemLink")
+l1nic = l1.setSubComponent("memlink", "memHierarchy.MemNIC")
+l1nic.addParams({
+    "group" : 1,
+    "network_bw" : slowBW,
+    })
+
+mem = sst.Component("mem", "memHierarchy.MemController")
+mem.addParams({
+    "debug" : debug,
+    "debug_level" : debug_level,
+    "clock" : "1GHz",
+    "addr_range_start" : 0,
+    "addr_range_end" : mem_size - 1,
+    "memNIC.group" : 2,
+    "memNIC.network_bw" : fastBW,
+    })
+memback = mem.setSubComponent("backend", "memHierarchy.simpleMem")
+memback.addParams({
+    "mem_size" : "1MiB",
+    "access_time" : "10ns",
+    })
+
+bridge = sst.Component("bridge", "merlin.Bridge")
+bridge.addParams({
+    "translator" : "memHierarchy.MemNetBridge",
+    "debug" : debug,
+    "debug_level" : debug_level,
+    "network_bw" : fastBW,
+    "network_input_buffer_size" : "128B",
+    "network_output_buffer_size" : "128B",
+    })
+
+link = sst.Link("cpu_l1")
+link.connect( (iface, "port", "500ps"), (l1cpu, "port", "500ps") )
+link = sst.Link("l1_net0")
+link.connect( (l1nic, "port", "500ps"), (net0, "port0", "500ps") )
+link = sst.Link("bridge_net0")
+link.connect( (bridge, "network0", "500ps"), (net0, "port1", "500ps") )
+link = sst.Link("bridge_net1")
+link.connect( (bridge, "network1", "500ps"), (net1, "port0", "500ps") )
+link = sst.Link("mem_net1")
+link.connect( (mem, "network", "500ps"), (net1, "port1", "500ps") )
+
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
+bridge.enableStatistics(["pkts_received_net0", "pkts_sent_net0", "pkts_received_net1", "pkts_sent_net1"],
+                        {"type": "sst.AccumulatorStatistic"})
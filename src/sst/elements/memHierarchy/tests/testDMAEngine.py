@@ -0,0 +1,86 @@
+import sst
+from mhlib import componentlist
+
+# DMA descriptor chains.
+#
+# CPU -> L1 -> Bus -> Mem
+#        DMA ----^
+#
+# The CPU fills 0x0-0x3fff with a known pattern during init and then
+# sends five commands to the DMA engine at once: a contiguous copy, a
+# strided copy (16B out of every 64B), a gather, a scatter and a copy
+# that reads the first command's destination.  The gather and scatter
+# blocks are not line aligned, so some of them are split.  The last
+# command overlaps the first one and has to wait for it.  Once every
+# command has come back, the CPU reads each destination through the L1
+# and checks every byte.
+#
+# The CPU ends the simulation with an error if a command did not complete
+# or a byte does not match.  Its per-command results and the DMA engine's
+# stats are recorded in refFiles/test_memHA_DMAEngine.out by genRefs.sh.
+
+debug = 0
+debug_level = 0
+
+cpu = sst.Component("cpu", "memHierarchy.dmaCPU")
+cpu.addParams({
+    "clock" : "1GHz",
+    "lineSize" : 64,
+    })
+iface = cpu.setSubComponent("memory", "memHierarchy.memInterface")
+
+dma = sst.Component("dma", "memHierarchy.DMAEngine")
+dma.addParams({
+    "debug" : debug,
+    "debug_level" : debug_level,
+    "clockRate" : "1GHz",
+    "transfer_size" : 64,
+    "max_outstanding" : 4,
+    "max_issue_per_cycle" : 2,
+    "printStats" : 1,
+    })
+dmalink = dma.setSubComponent("memlink", "memHierarchy.MemLink")
+
+l1 = sst.Component("l1", "memHierarchy.Cache")
+l1.addParams({
+    "debug" : debug,
+    "debug_level" : debug_level,
+    "cache_frequency" : "1GHz",
+    "cache_size" : "2KiB",
+    "access_latency_cycles" : 2,
+    "associativity" : 4,
+    "cache_line_size" : 64,
+    "coherence_protocol" : "none",
+    "L1" : 1,
+    })
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({
+    "bus_frequency" : "1GHz",
+    })
+
+mem = sst.Component("mem", "memHierarchy.MemController")
+mem.addParams({
+    "debug" : debug,
+    "debug_level" : debug_level,
+    "clock" : "1GHz",
+    "addr_range_start" : 0,
+    "addr_range_end" : 1024 * 1024 - 1,
+    "backing" : "malloc",
+    })
+memback = mem.setSubComponent("backend", "memHierarchy.simpleMem")
+memback.addParams({
+    "mem_size" : "1MiB",
+    "access_time" : "50ns",
+    })
+
+link = sst.Link("cpu_l1")
+link.connect( (iface, "port", "500ps"), (l1, "high_network_0", "500ps") )
+link = sst.Link("cpu_dma")
+link.connect( (cpu, "dma_link", "500ps"), (dma, "cmdLink", "500ps") )
+link = sst.Link("l1_bus")
+link.connect( (l1, "low_network_0", "500ps"), (bus, "high_network_0", "500ps") )
+link = sst.Link("dma_bus")
+link.connect( (dmalink, "port", "500ps"), (bus, "high_network_1", "500ps") )
+link = sst.Link("bus_mem")
+link.connect( (bus, "low_network_0", "500ps"), (mem, "direct_link", "500ps") )
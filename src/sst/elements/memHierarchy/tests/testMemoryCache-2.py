@@ -0,0 +1,152 @@
+# Automatically generated SST Python input
+import sst
+
+# Test MemCacheController with 256B blocks (4 lines per tag), each line filled and written back on its own
+# Four cores share a directory; the directory's memory is a small memory cache in front of a larger memory
+# Check the output with: python checkMemoryCache.py <sst output> SectorMisses
+
+cores = 4
+coreclock = "2.4GHz"
+uncoreclock = "1.4GHz"
+network_bw = "60GB/s"
+
+DEBUG_L1 = 0
+DEBUG_DIR = 0
+DEBUG_MEMCACHE = 0
+DEBUG_MEM = 0
+
+# Create merlin network - this is just simple single router
+comp_network = sst.Component("network", "merlin.hr_router")
+comp_network.addParams({
+      "xbar_bw" : network_bw,
+      "link_bw" : network_bw,
+      "input_buf_size" : "2KiB",
+      "num_ports" : cores + 3,
+      "flit_size" : "36B",
+      "output_buf_size" : "2KiB",
+      "id" : "0",
+      "topology" : "merlin.singlerouter"
+})
+comp_network.setSubComponent("topology","merlin.singlerouter")
+
+for x in range(cores):
+    comp_cpu = sst.Component("cpu" + str(x), "memHierarchy.trivialCPU")
+    comp_cpu.addParams({
+        "clock" : coreclock,
+        "commFreq" : 4, # issue request every 4th cycle
+        "rngseed" : 20+x,
+        "do_write" : 1,
+        "num_loadstore" : 1500,
+        "memSize" : 128*1024,   # Twice the memory cache
+    })
+    iface = comp_cpu.setSubComponent("memory", "memHierarchy.memInterface")
+
+    l1cache = sst.Component("l1cache" + str(x), "memHierarchy.Cache")
+    l1cache.addParams({
+        "cache_frequency" : coreclock,
+        "access_latency_cycles" : 3,
+        "replacement_policy" : "lru",
+        "coherence_protocol" : "MESI",
+        "cache_size" : "2KiB",  # super tiny for lots of traffic
+        "associativity" : 2,
+        "L1" : 1,
+        # Debug parameters
+        "debug" : DEBUG_L1,
+        "debug_level" : 10,
+    })
+    l1toC = l1cache.setSubComponent("cpulink", "memHierarchy.MemLink")
+    l1NIC = l1cache.setSubComponent("memlink", "memHierarchy.MemNIC")
+    l1NIC.addParams({
+        "group" : 1,
+        "network_bw" : network_bw,
+    })
+
+    cpu_l1_link = sst.Link("link_cpu_cache_" + str(x))
+    cpu_l1_link.connect ( (iface, "port", "500ps"), (l1toC, "port", "500ps") )
+
+    l1_network_link = sst.Link("link_l1_network_" + str(x))
+    l1_network_link.connect( (l1NIC, "port", "100ps"), (comp_network, "port" + str(x), "100ps") )
+
+dirctrl = sst.Component("directory", "memHierarchy.DirectoryController")
+dirctrl.addParams({
+    "clock" : uncoreclock,
+    "coherence_protocol" : "MESI",
+    "entry_cache_size" : 32768,
+    "addr_range_start" : 0,
+    "addr_range_end" : 128*1024 - 1,
+    # Debug parameters
+    "debug" : DEBUG_DIR,
+    "debug_level" : 10,
+})
+dirNIC = dirctrl.setSubComponent("cpulink", "memHierarchy.MemNIC")
+dirNIC.addParams({
+    "group" : 2,
+    "network_bw" : network_bw,
+    "network_input_buffer_size" : "2KiB",
+    "network_output_buffer_size" : "2KiB",
+})
+
+memcache = sst.Component("memcache", "memHierarchy.MemCacheController")
+memcache.addParams({
+    "clock" : uncoreclock,
+    "backing" : "none",
+    "block_size" : "256",
+    # Debug parameters
+    "debug" : DEBUG_MEMCACHE,
+    "debug_level" : 10,
+})
+memcacheNIC = memcache.setSubComponent("cpulink", "memHierarchy.MemNIC")
+memcacheNIC.addParams({
+    "group" : 3,
+    "network_bw" : network_bw,
+    "network_input_buffer_size" : "2KiB",
+    "network_output_buffer_size" : "2KiB",
+})
+memcacheBackend = memcache.setSubComponent("backend", "memHierarchy.simpleMem")
+memcacheBackend.addParams({
+    "mem_size" : "64KiB",   # Size of the memory cache
+    "access_time" : "20ns",
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "500MHz",
+    "backing" : "none",
+    # Debug parameters
+    "debug" : DEBUG_MEM,
+    "debug_level" : 10,
+})
+memNIC = memctrl.setSubComponent("cpulink", "memHierarchy.MemNIC")
+memNIC.addParams({
+    "group" : 4,
+    "network_bw" : network_bw,
+    "network_input_buffer_size" : "2KiB",
+    "network_output_buffer_size" : "2KiB",
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleDRAM")
+memory.addParams({
+    "mem_size" : "512MiB",
+    "tCAS" : 2,
+    "tRCD" : 2,
+    "tRP" : 3,
+    "cycle_time" : "3ns",
+    "row_size" : "4KiB",
+    "row_policy" : "closed",
+    "max_requests_per_cycle" : 2,
+})
+
+link_directory_network = sst.Link("link_directory_network")
+link_directory_network.connect( (dirNIC, "port", "100ps"), (comp_network, "port" + str(cores), "100ps") )
+
+link_memcache_network = sst.Link("link_memcache_network")
+link_memcache_network.connect( (memcacheNIC, "port", "100ps"), (comp_network, "port" + str(cores + 1), "100ps") )
+
+link_memory_network = sst.Link("link_memory_network")
+link_memory_network.connect( (memNIC, "port", "100ps"), (comp_network, "port" + str(cores + 2), "100ps") )
+
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+sst.enableAllStatisticsForComponentType("memHierarchy.MemCacheController")
+sst.enableAllStatisticsForComponentType("memHierarchy.MemController")
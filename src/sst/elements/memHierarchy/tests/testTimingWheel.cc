@@ -0,0 +1,173 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Checks TimingWheel against the std::multimap send queues it replaced.
+ * Run by 'make check'. Exits non-zero on the first difference.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "../timingWheel.h"
+
+using namespace SST::MemHierarchy;
+
+typedef std::pair<uint64_t, int> Item; // delivery time, insertion number
+
+/* Drain both queues up to 'now' and compare what comes out */
+static bool drain(TimingWheel<Item>& wheel, std::multimap<uint64_t, Item>& ref, uint64_t now, const char* test) {
+    while (wheel.ready(now)) {
+        if (ref.empty() || ref.begin()->first > now) {
+            fprintf(stderr, "%s: wheel has an item ready at %" PRIu64 " that should not be\n", test, now);
+            return false;
+        }
+        Item expected = ref.begin()->second;
+        if (wheel.front() != expected || wheel.frontTime() != ref.begin()->first) {
+            fprintf(stderr, "%s: at %" PRIu64 " wheel returned item %d (time %" PRIu64 "), expected item %d (time %" PRIu64 ")\n",
+                    test, now, wheel.front().second, wheel.frontTime(), expected.second, ref.begin()->first);
+            return false;
+        }
+        wheel.pop();
+        ref.erase(ref.begin());
+    }
+    if (!ref.empty() && ref.begin()->first <= now) {
+        fprintf(stderr, "%s: item %d due at %" PRIu64 " not ready at %" PRIu64 "\n", test, ref.begin()->second.second, ref.begin()->first, now);
+        return false;
+    }
+    if (wheel.size() != ref.size()) {
+        fprintf(stderr, "%s: wheel holds %zu items, expected %zu\n", test, wheel.size(), ref.size());
+        return false;
+    }
+    return true;
+}
+
+static bool checkForEach(TimingWheel<Item>& wheel, std::multimap<uint64_t, Item>& ref, const char* test) {
+    std::vector<std::pair<uint64_t, Item> > seen;
+    wheel.forEach([&seen](uint64_t time, const Item& item) { seen.push_back(std::make_pair(time, item)); });
+    std::vector<std::pair<uint64_t, Item> > expected(ref.begin(), ref.end());
+    if (seen != expected) {
+        fprintf(stderr, "%s: forEach visited %zu items, not the %zu waiting items in drain order\n", test, seen.size(), expected.size());
+        return false;
+    }
+    return true;
+}
+
+static void insert(TimingWheel<Item>& wheel, std::multimap<uint64_t, Item>& ref, uint64_t time, int& count) {
+    Item item(time, count++);
+    wheel.insert(time, item);
+    ref.insert(std::make_pair(time, item));
+}
+
+/* Items at the end of the span, one past it (overflow) and well past it, with ties on each side */
+static bool testBoundaries() {
+    const char* test = "boundaries";
+    TimingWheel<Item> wheel(16);
+    std::multimap<uint64_t, Item> ref;
+    int count = 0;
+
+    uint64_t times[] = { 0, 15, 16, 17, 16, 15, 40, 100, 100, 31, 32, 33 };
+    for (size_t i = 0; i < sizeof(times) / sizeof(times[0]); i++)
+        insert(wheel, ref, times[i], count);
+    if (!checkForEach(wheel, ref, test)) return false;
+
+    for (uint64_t now = 0; now <= 101; now++) {
+        if (!drain(wheel, ref, now, test)) return false;
+        if (now == 20) { // Wheel has moved, 36 and 37 now straddle the span
+            insert(wheel, ref, 36, count);
+            insert(wheel, ref, 37, count);
+            insert(wheel, ref, 40, count);
+            if (!checkForEach(wheel, ref, test)) return false;
+        }
+    }
+    return wheel.empty();
+}
+
+/* Items inserted behind the wheel drain before the items already due, in time order */
+static bool testLate() {
+    const char* test = "late";
+    TimingWheel<Item> wheel(8);
+    std::multimap<uint64_t, Item> ref;
+    int count = 0;
+
+    insert(wheel, ref, 10, count);
+    if (!drain(wheel, ref, 5, test)) return false; // Cursor is now at 5
+    insert(wheel, ref, 5, count);
+    insert(wheel, ref, 3, count);
+    insert(wheel, ref, 4, count);
+    insert(wheel, ref, 3, count);
+    if (!checkForEach(wheel, ref, test)) return false;
+    if (!drain(wheel, ref, 5, test)) return false;
+    return drain(wheel, ref, 10, test) && wheel.empty();
+}
+
+/* Only overflow items waiting, so ready() has to jump over the empty stretch */
+static bool testSkip() {
+    const char* test = "skip";
+    TimingWheel<Item> wheel(4);
+    std::multimap<uint64_t, Item> ref;
+    int count = 0;
+
+    insert(wheel, ref, 1000, count);
+    insert(wheel, ref, 1002, count);
+    insert(wheel, ref, 1000000, count);
+    uint64_t steps[] = { 0, 999, 1000, 1001, 1003, 999999, 1000000 };
+    for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        if (!drain(wheel, ref, steps[i], test)) return false;
+    }
+    return wheel.empty();
+}
+
+/* Random delays around the span, polled with random gaps, compared to the multimap throughout */
+static bool testRandom(uint64_t span, unsigned seed) {
+    const char* test = "random";
+    TimingWheel<Item> wheel(span);
+    std::multimap<uint64_t, Item> ref;
+    int count = 0;
+    srand(seed);
+
+    uint64_t now = 0;
+    for (int step = 0; step < 20000; step++) {
+        int inserts = rand() % 4;
+        for (int i = 0; i < inserts; i++) {
+            uint64_t delay = rand() % (3 * wheel.getSpan());
+            uint64_t time = now + delay;
+            if (rand() % 16 == 0 && now > 8) time = now - rand() % 8; // Behind the cursor
+            insert(wheel, ref, time, count);
+        }
+        if (step % 1000 == 0 && !checkForEach(wheel, ref, test)) return false;
+        now += rand() % 3;
+        if (!drain(wheel, ref, now, test)) return false;
+    }
+    return drain(wheel, ref, now + 3 * wheel.getSpan(), test) && wheel.empty();
+}
+
+int main() {
+    bool pass = testBoundaries() && testLate() && testSkip();
+    for (unsigned seed = 1; pass && seed <= 4; seed++)
+        pass = testRandom(seed * 10, seed);
+
+    if (!pass) {
+        fprintf(stderr, "TimingWheel test FAILED\n");
+        return 1;
+    }
+    printf("TimingWheel test passed\n");
+    return 0;
+}
@@ -0,0 +1,42 @@
+import sst
+
+# Functional trace replay with TraceCacheSim.
+#
+# Replays traceCacheSim-0.trace (Prospero text format) through a 1KiB
+# 2-way L1 and an inclusive 4KiB 4-way L2, split across two threads.
+# The trace first writes one word in every line of 0x1000-0x4fff, in
+# order, so Prospero's first-touch page mapping is the identity.  Then
+# it makes random reads and writes over that region, mostly to its
+# first 1.5KiB, and finally keeps one line hot in the L1 while lines in
+# the same L2 set stream past it, so the L2 has to back-invalidate the
+# L1.
+#
+# testTraceCacheSimReference.py runs the same trace and caches through
+# Prospero and memHierarchy.  Each level's Hits and Misses here equal
+# the sum of the GetS/GetX Hit and Miss statistics of the matching
+# cache in that test:
+#
+#   sst testTraceCacheSim.py > tcs.out
+#   sst testTraceCacheSimReference.py > ref.out
+#   python checkTraceCacheSim.py tcs.out ref.out
+#
+# The two worker threads are only used when sst runs with one thread.
+
+tcs = sst.Component("tcs", "memHierarchy.TraceCacheSim")
+tcs.addParams({
+    "verbose" : 0,
+    "trace_file" : "traceCacheSim-0.trace",
+    "trace_format" : "text",
+    "cache_line_size" : 64,
+    "levels" : 2,
+    "threads" : 2,
+    "level1.cache_size" : "1KiB",
+    "level1.associativity" : 2,
+    "level2.cache_size" : "4KiB",
+    "level2.associativity" : 4,
+    "level2.inclusive" : True,
+    })
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
+tcs.enableAllStatistics({"type": "sst.AccumulatorStatistic"})
@@ -0,0 +1,76 @@
+import sst
+
+# Timed reference run for testTraceCacheSim.py.
+#
+# Replays traceCacheSim-0.trace with Prospero through the same caches:
+# a 1KiB 2-way MESI L1 and an inclusive 4KiB 4-way MESI L2, both LRU.
+# Prospero only has one request in flight, so every access finishes
+# before the next one starts and the caches see the trace in order.
+# An L2 miss that has to back-invalidate its victim from the L1 waits
+# for the invalidation and is counted as Blocked.
+#
+# For each cache, the GetS/GetX Hit and Miss statistics (Arrival plus
+# Blocked) add up to that level's Hits and Misses from TraceCacheSim.
+# How they split between Arrival and Blocked depends on timing, so
+# checkTraceCacheSim.py only compares the sums.
+
+cpu = sst.Component("cpu", "prospero.prosperoCPU")
+cpu.addParams({
+    "verbose" : 0,
+    "reader" : "prospero.ProsperoTextTraceReader",
+    "readerParams.file" : "traceCacheSim-0.trace",
+    "pagesize" : 4096,
+    "cache_line_size" : 64,
+    "max_outstanding" : 1,
+    "max_issue_per_cycle" : 1,
+    })
+
+l1 = sst.Component("l1", "memHierarchy.Cache")
+l1.addParams({
+    "cache_frequency" : "2GHz",
+    "cache_size" : "1KiB",
+    "associativity" : 2,
+    "access_latency_cycles" : 1,
+    "cache_line_size" : 64,
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "L1" : 1,
+    })
+
+l2 = sst.Component("l2", "memHierarchy.Cache")
+l2.addParams({
+    "cache_frequency" : "2GHz",
+    "cache_size" : "4KiB",
+    "associativity" : 4,
+    "access_latency_cycles" : 4,
+    "cache_line_size" : 64,
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "cache_type" : "inclusive",
+    })
+
+mem = sst.Component("mem", "memHierarchy.MemController")
+mem.addParams({
+    "clock" : "1GHz",
+    "addr_range_start" : 0,
+    "backing" : "none",
+    })
+memback = mem.setSubComponent("backend", "memHierarchy.simpleMem")
+memback.addParams({
+    "mem_size" : "1MiB",
+    "access_time" : "50ns",
+    })
+
+link = sst.Link("cpu_l1")
+link.connect( (cpu, "cache_link", "500ps"), (l1, "high_network_0", "500ps") )
+link = sst.Link("l1_l2")
+link.connect( (l1, "low_network_0", "500ps"), (l2, "high_network_0", "500ps") )
+link = sst.Link("l2_mem")
+link.connect( (l2, "low_network_0", "500ps"), (mem, "direct_link", "500ps") )
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
+for cache in [l1, l2]:
+    cache.enableStatistics(["GetSHit_Arrival", "GetXHit_Arrival", "GetSHit_Blocked", "GetXHit_Blocked",
+                            "GetSMiss_Arrival", "GetXMiss_Arrival", "GetSMiss_Blocked", "GetXMiss_Blocked"],
+                           {"type": "sst.AccumulatorStatistic"})
@@ -0,0 +1,161 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_TIMINGWHEEL_H
+#define MEMHIERARCHY_TIMINGWHEEL_H
+
+#include <map>
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Bounded timing wheel used to delay outgoing events by a (mostly fixed) latency.
+ *
+ * Replaces std::multimap<uint64_t, T> send queues. Items are bucketed by delivery
+ * time modulo the wheel span so insert and pop are O(1) and bucket storage is reused
+ * across revolutions (no allocation per message once the wheel is warm).
+ * Ordering matches the multimap it replaces: items drain in delivery time order and
+ * items with equal delivery times drain in insertion order.
+ *
+ * Delivery times beyond the span are parked in an overflow map and moved onto the
+ * wheel as it advances. Delivery times earlier than the wheel's current position
+ * are kept in a separate map and drain first, still in delivery time order.
+ *
+ * Usage:
+ *   while (queue.ready(now)) { send(queue.front()); queue.pop(); }
+ */
+template<typename T>
+class TimingWheel {
+public:
+    TimingWheel(uint64_t span = 64) : cursor_(0), size_(0), wheelSize_(0) { setSpan(span); }
+
+    /* Resize the wheel. Span is rounded up to a power of two. Only valid while empty. */
+    void setSpan(uint64_t span) {
+        if (size_ != 0) return;
+        uint64_t buckets = 1;
+        while (buckets < span) buckets <<= 1;
+        mask_ = buckets - 1;
+        buckets_.clear();
+        buckets_.resize(buckets);
+    }
+
+    uint64_t getSpan() const { return mask_ + 1; }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    /* Add an item to be delivered at 'time' */
+    void insert(uint64_t time, const T& item) {
+        size_++;
+        if (time < cursor_) {
+            late_.insert(std::make_pair(time, item));
+        } else if (time - cursor_ > mask_) {
+            overflow_.insert(std::make_pair(time, item));
+        } else {
+            buckets_[time & mask_].push(item);
+            wheelSize_++;
+        }
+    }
+
+    /* Whether an item with delivery time <= now is waiting. Advances the wheel over empty buckets up to 'now'. */
+    bool ready(uint64_t now) {
+        if (size_ == 0) return false;
+        if (!late_.empty()) return true;
+        while (buckets_[cursor_ & mask_].empty()) {
+            if (cursor_ >= now) return false;
+            if (wheelSize_ == 0) { // Only overflow items left, skip the empty stretch
+                uint64_t next = overflow_.begin()->first;
+                cursor_ = (next < now ? next : now) - 1;
+            }
+            advance();
+        }
+        return cursor_ <= now;
+    }
+
+    /* Earliest item. Only valid after ready() returned true */
+    T& front() { return late_.empty() ? buckets_[cursor_ & mask_].front() : late_.begin()->second; }
+
+    /* Delivery time of front() */
+    uint64_t frontTime() const { return late_.empty() ? cursor_ : late_.begin()->first; }
+
+    /* Remove front() */
+    void pop() {
+        size_--;
+        if (!late_.empty()) {
+            late_.erase(late_.begin());
+            return;
+        }
+        buckets_[cursor_ & mask_].pop();
+        wheelSize_--;
+    }
+
+    /* Call f(time, item) for every waiting item in drain order, e.g., to print queue contents */
+    template<typename F>
+    void forEach(F f) const {
+        for (typename std::multimap<uint64_t, T>::const_iterator it = late_.begin(); it != late_.end(); it++)
+            f(it->first, it->second);
+        for (uint64_t time = cursor_; time <= cursor_ + mask_; time++) {
+            const Bucket& bucket = buckets_[time & mask_];
+            for (size_t i = bucket.head; i < bucket.items.size(); i++)
+                f(time, bucket.items[i]);
+        }
+        for (typename std::multimap<uint64_t, T>::const_iterator it = overflow_.begin(); it != overflow_.end(); it++)
+            f(it->first, it->second);
+    }
+
+private:
+    /* Bucket is a FIFO over a vector that keeps its capacity when drained */
+    struct Bucket {
+        std::vector<T> items;
+        size_t head;
+
+        Bucket() : head(0) { }
+        bool empty() const { return head == items.size(); }
+        void push(const T& item) { items.push_back(item); }
+        T& front() { return items[head]; }
+        void pop() {
+            head++;
+            if (head == items.size()) {
+                items.clear();
+                head = 0;
+            }
+        }
+    };
+
+    /* Move to the next bucket and pull any overflow items that are now within the span */
+    void advance() {
+        cursor_++;
+        while (!overflow_.empty() && overflow_.begin()->first - cursor_ <= mask_) {
+            buckets_[overflow_.begin()->first & mask_].push(overflow_.begin()->second);
+            overflow_.erase(overflow_.begin());
+            wheelSize_++;
+        }
+    }
+
+    std::vector<Bucket> buckets_;
+    std::multimap<uint64_t, T> overflow_;
+    std::multimap<uint64_t, T> late_;   // Inserted behind the cursor
+    uint64_t mask_;
+    uint64_t cursor_;   // Delivery time of the current bucket
+    size_t size_;       // Items on the wheel, in overflow and late
+    size_t wheelSize_;  // Items on the wheel
+};
+
+}}
+
+#endif
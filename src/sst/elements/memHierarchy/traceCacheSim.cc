@@ -0,0 +1,339 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+#include <sst/core/simulation.h>
+
+#include "traceCacheSim.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+TraceCacheSim::TraceCacheSim(ComponentId_t id, Params &params) : Component(id) {
+    out_.init("TraceCacheSim[@f:@l:@p] ", params.find<int>("verbose", 1), 0, Output::STDOUT);
+
+    lineSize_ = params.find<uint64_t>("cache_line_size", 64);
+    if (lineSize_ == 0 || !isPowerOfTwo(lineSize_))
+        out_.fatal(CALL_INFO, -1, "%s, Invalid param: cache_line_size - must be a power of two. You specified %" PRIu64 "\n", getName().c_str(), lineSize_);
+    lineOffset_ = log2Of(lineSize_);
+
+    numLevels_ = params.find<unsigned int>("levels", 1);
+    numShards_ = params.find<unsigned int>("threads", 1);
+    if (numLevels_ == 0)
+        out_.fatal(CALL_INFO, -1, "%s, Invalid param: levels - must be at least 1\n", getName().c_str());
+    if (numShards_ == 0)
+        out_.fatal(CALL_INFO, -1, "%s, Invalid param: threads - must be at least 1\n", getName().c_str());
+
+    /* Worker threads would compete with SST's own threads, so only start them when SST runs with one thread */
+    workerThreads_ = numShards_ > 1 && Simulation::getSimulation()->getNumRanks().thread == 1;
+    if (numShards_ > 1 && !workerThreads_)
+        out_.verbose(CALL_INFO, 1, 0, "%s, SST is running with more than one thread, replaying the %u shards on one thread\n", getName().c_str(), numShards_);
+
+    chunkSize_ = params.find<size_t>("chunk_size", 1048576);
+    if (chunkSize_ == 0) chunkSize_ = 1;
+    maxRecords_ = params.find<uint64_t>("max_records", 0);
+
+    /* Build each level, split into one CacheArray per shard */
+    shards_.resize(numShards_);
+    for (unsigned int level = 0; level < numLevels_; level++) {
+        std::stringstream prefix;
+        prefix << "level" << level + 1 << ".";
+        Params levelParams = params.find_prefix_params(prefix.str());
+
+        std::string sizeStr = levelParams.find<std::string>("cache_size", "");
+        if (sizeStr.empty())
+            out_.fatal(CALL_INFO, -1, "%s, Param not specified: %scache_size\n", getName().c_str(), prefix.str().c_str());
+        fixByteUnits(sizeStr);
+        UnitAlgebra size(sizeStr);
+        if (!size.hasUnits("B"))
+            out_.fatal(CALL_INFO, -1, "%s, Invalid param: %scache_size - must have units of bytes (e.g., B, KiB, etc.)\n", getName().c_str(), prefix.str().c_str());
+
+        uint64_t lines = size.getRoundedValue() / lineSize_;
+        uint64_t associativity = levelParams.find<uint64_t>("associativity", 8);
+        if (associativity == 0 || lines % associativity != 0)
+            out_.fatal(CALL_INFO, -1, "%s, Invalid param: %sassociativity - number of lines (%" PRIu64 ") must be a multiple of associativity (%" PRIu64 ")\n",
+                    getName().c_str(), prefix.str().c_str(), lines, associativity);
+        uint64_t sets = lines / associativity;
+        if (sets % numShards_ != 0)
+            out_.fatal(CALL_INFO, -1, "%s, Invalid param: threads - number of sets at level %u (%" PRIu64 ") must be a multiple of the number of threads (%u)\n",
+                    getName().c_str(), level + 1, sets, numShards_);
+
+        std::string hashName = levelParams.find<std::string>("hash", "memHierarchy.hash.none");
+        std::string replName = levelParams.find<std::string>("replacement", "memHierarchy.replacement.lru");
+        if (numShards_ > 1 && hashName != "memHierarchy.hash.none")
+            out_.output("%s, Warning: level %u uses hash '%s' with %u threads. Each thread hashes within its own sets so results may differ from a single-threaded run.\n",
+                    getName().c_str(), level + 1, hashName.c_str(), numShards_);
+
+        inclusive_.push_back(levelParams.find<bool>("inclusive", true));
+
+        uint64_t shardLines = lines / numShards_;
+        for (unsigned int s = 0; s < numShards_; s++) {
+            int slot = level * numShards_ + s;
+            HashFunction* hash = loadAnonymousSubComponent<HashFunction>(hashName, "hash", slot, ComponentInfo::SHARE_NONE, levelParams);
+            if (!hash)
+                out_.fatal(CALL_INFO, -1, "%s, Error: unable to load hash '%s' for level %u\n", getName().c_str(), hashName.c_str(), level + 1);
+            ReplacementPolicy* repl = loadAnonymousSubComponent<ReplacementPolicy>(replName, "replacement", slot, ComponentInfo::SHARE_NONE, levelParams, shardLines, associativity);
+            if (!repl)
+                out_.fatal(CALL_INFO, -1, "%s, Error: unable to load replacement policy '%s' for level %u\n", getName().c_str(), replName.c_str(), level + 1);
+            shards_[s].levels.push_back(new CacheArray<SharedCacheLine>(&out_, shardLines, associativity, lineSize_, repl, hash));
+            shards_[s].counts.push_back(LevelCounts());
+        }
+
+        std::stringstream subid;
+        subid << "L" << level + 1;
+        statHits_.push_back(registerStatistic<uint64_t>("Hits", subid.str()));
+        statMisses_.push_back(registerStatistic<uint64_t>("Misses", subid.str()));
+        statEvictions_.push_back(registerStatistic<uint64_t>("Evictions", subid.str()));
+        statWritebacks_.push_back(registerStatistic<uint64_t>("Writebacks", subid.str()));
+        statBackInvalidations_.push_back(registerStatistic<uint64_t>("BackInvalidations", subid.str()));
+    }
+    statTraceReads_ = registerStatistic<uint64_t>("TraceReads");
+    statTraceWrites_ = registerStatistic<uint64_t>("TraceWrites");
+
+    /* Open the trace */
+    std::string traceName = params.find<std::string>("trace_file", "");
+    if (traceName.empty())
+        out_.fatal(CALL_INFO, -1, "%s, Param not specified: trace_file\n", getName().c_str());
+
+    std::string format = params.find<std::string>("trace_format", "binary");
+    if (format != "text" && format != "binary")
+        out_.fatal(CALL_INFO, -1, "%s, Invalid param: trace_format - must be 'text' or 'binary'. You specified '%s'\n", getName().c_str(), format.c_str());
+    textTrace_ = (format == "text");
+
+    traceFile_ = nullptr;
+#ifdef HAVE_LIBZ
+    traceGzFile_ = nullptr;
+    if (!textTrace_) {
+        traceGzFile_ = gzopen(traceName.c_str(), "rb");
+        if (traceGzFile_ == nullptr)
+            out_.fatal(CALL_INFO, -1, "%s, Error: unable to open trace file '%s'\n", getName().c_str(), traceName.c_str());
+    } else
+#endif
+    {
+        traceFile_ = fopen(traceName.c_str(), textTrace_ ? "rt" : "rb");
+        if (traceFile_ == nullptr)
+            out_.fatal(CALL_INFO, -1, "%s, Error: unable to open trace file '%s'\n", getName().c_str(), traceName.c_str());
+    }
+
+    records_ = 0;
+    reads_ = 0;
+    writes_ = 0;
+}
+
+TraceCacheSim::~TraceCacheSim() {
+    for (unsigned int s = 0; s < shards_.size(); s++) {
+        for (unsigned int level = 0; level < shards_[s].levels.size(); level++)
+            delete shards_[s].levels[level];
+    }
+    if (traceFile_ != nullptr) fclose(traceFile_);
+#ifdef HAVE_LIBZ
+    if (traceGzFile_ != nullptr) gzclose(traceGzFile_);
+#endif
+}
+
+/*
+ * Replay the trace. The next batch is read and split across shards on this thread
+ * while the workers replay the current one. Without workers the shards are replayed in turn.
+ */
+void TraceCacheSim::setup() {
+    size_t pending = readBatch();
+    while (pending != 0) {
+        for (unsigned int s = 0; s < numShards_; s++) {
+            shards_[s].batch.swap(shards_[s].pending);
+            shards_[s].pending.clear();
+        }
+
+        if (!workerThreads_) {
+            for (unsigned int s = 0; s < numShards_; s++)
+                runShard(s);
+            pending = readBatch();
+        } else {
+            std::vector<std::thread> workers;
+            for (unsigned int s = 0; s < numShards_; s++)
+                workers.push_back(std::thread(&TraceCacheSim::runShard, this, s));
+            pending = readBatch();
+            for (unsigned int s = 0; s < numShards_; s++)
+                workers[s].join();
+        }
+    }
+}
+
+void TraceCacheSim::finish() {
+    statTraceReads_->addDataNTimes(reads_, 1);
+    statTraceWrites_->addDataNTimes(writes_, 1);
+
+    out_.verbose(CALL_INFO, 1, 0, "%s: replayed %" PRIu64 " records (%" PRIu64 " reads, %" PRIu64 " writes)\n",
+            getName().c_str(), records_, reads_, writes_);
+
+    for (unsigned int level = 0; level < numLevels_; level++) {
+        LevelCounts total;
+        for (unsigned int s = 0; s < numShards_; s++) {
+            LevelCounts& counts = shards_[s].counts[level];
+            total.hits += counts.hits;
+            total.misses += counts.misses;
+            total.evictions += counts.evictions;
+            total.writebacks += counts.writebacks;
+            total.backInvalidations += counts.backInvalidations;
+        }
+        statHits_[level]->addDataNTimes(total.hits, 1);
+        statMisses_[level]->addDataNTimes(total.misses, 1);
+        statEvictions_[level]->addDataNTimes(total.evictions, 1);
+        statWritebacks_[level]->addDataNTimes(total.writebacks, 1);
+        statBackInvalidations_[level]->addDataNTimes(total.backInvalidations, 1);
+
+        uint64_t accesses = total.hits + total.misses;
+        out_.verbose(CALL_INFO, 1, 0, "  L%u: %" PRIu64 " accesses, %" PRIu64 " hits, %" PRIu64 " misses (%.2f%%), %" PRIu64 " evictions, %" PRIu64 " writebacks\n",
+                level + 1, accesses, total.hits, total.misses, accesses ? 100.0 * total.misses / accesses : 0.0,
+                total.evictions, total.writebacks);
+    }
+}
+
+/* Read one <time> <R|W> <address> <size> record in the format written by Prospero's tracer and Ariel's trace generators */
+bool TraceCacheSim::readRecord(uint64_t& addr, uint32_t& size, bool& write) {
+    uint64_t time;
+    char op;
+    if (textTrace_) {
+        if (4 != fscanf(traceFile_, "%" PRIu64 " %c %" PRIu64 " %" PRIu32 "", &time, &op, &addr, &size))
+            return false;
+    } else {
+        const size_t recordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
+        char buffer[recordLength];
+#ifdef HAVE_LIBZ
+        if (gzread(traceGzFile_, buffer, recordLength) != (int) recordLength)
+            return false;
+#else
+        if (1 != fread(buffer, recordLength, 1, traceFile_))
+            return false;
+#endif
+        memcpy(&time, buffer, sizeof(uint64_t));
+        memcpy(&op, buffer + sizeof(uint64_t), sizeof(char));
+        memcpy(&addr, buffer + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+        memcpy(&size, buffer + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+    }
+    write = !(op == 'R' || op == 'r');
+    return true;
+}
+
+/*
+ * Read up to chunk_size records into each shard's pending batch. Records are split at line
+ * boundaries the way Prospero issues them. Each line is assigned to shard (line % threads)
+ * and renumbered within the shard (line / threads) so a shard's CacheArray maps it to the
+ * same set it would occupy in the full-size cache.
+ */
+size_t TraceCacheSim::readBatch() {
+    size_t count = 0;
+    uint64_t addr;
+    uint32_t size;
+    bool write;
+
+    while (count < chunkSize_ && (maxRecords_ == 0 || records_ < maxRecords_) && readRecord(addr, size, write)) {
+        count++;
+        records_++;
+        if (write) writes_++;
+        else reads_++;
+
+        uint64_t length = std::min((uint64_t) size, lineSize_);
+        Addr firstLine = addr >> lineOffset_;
+        Addr lastLine = (addr + (length ? length - 1 : 0)) >> lineOffset_;
+        for (Addr line = firstLine; line <= lastLine; line++) {
+            Access acc;
+            acc.lineAddr = (line / numShards_) << lineOffset_;
+            acc.write = write;
+            shards_[line % numShards_].pending.push_back(acc);
+        }
+    }
+    return count;
+}
+
+void TraceCacheSim::runShard(unsigned int s) {
+    Shard& shard = shards_[s];
+    for (std::vector<Access>::iterator it = shard.batch.begin(); it != shard.batch.end(); it++)
+        access(shard, it->lineAddr, it->write);
+}
+
+/*
+ * Look up each level in turn. As in memHierarchy's caches, a level that misses allocates the line
+ * (evicting a victim, whose writeback reaches the next level first) before the request moves on.
+ */
+void TraceCacheSim::access(Shard& shard, Addr addr, bool write) {
+    for (unsigned int level = 0; level < numLevels_; level++) {
+        SharedCacheLine* line = shard.levels[level]->lookup(addr, true);
+        if (line && line->getState() != I) {
+            shard.counts[level].hits++;
+            if (write && level == 0)
+                line->setState(M);
+            return;
+        }
+        shard.counts[level].misses++;
+        fill(shard, level, addr, (write && level == 0) ? M : E);
+    }
+}
+
+void TraceCacheSim::fill(Shard& shard, unsigned int level, Addr addr, State state) {
+    CacheArray<SharedCacheLine>* cache = shard.levels[level];
+    SharedCacheLine* victim = cache->findReplacementCandidate(addr);
+    if (victim->getState() != I)
+        evict(shard, level, victim);
+    cache->replace(addr, victim);
+    victim->setState(state);
+}
+
+/*
+ * Remove a valid line. Inclusive levels first invalidate any copies above them; dirty data,
+ * including a dirty upper copy, is written back to the next level (or memory). Clean lines are dropped.
+ */
+void TraceCacheSim::evict(Shard& shard, unsigned int level, SharedCacheLine* victim) {
+    Addr addr = victim->getAddr();
+    bool dirty = (victim->getState() == M);
+    shard.counts[level].evictions++;
+
+    if (level > 0 && inclusive_[level]) {
+        for (unsigned int upper = 0; upper < level; upper++) {
+            SharedCacheLine* line = shard.levels[upper]->lookup(addr, false);
+            if (line && line->getState() != I) {
+                if (line->getState() == M)
+                    dirty = true;
+                shard.levels[upper]->deallocate(line);
+                line->setState(I);
+                shard.counts[level].backInvalidations++;
+            }
+        }
+    }
+
+    shard.levels[level]->deallocate(victim);
+    victim->setState(I);
+
+    if (dirty) {
+        shard.counts[level].writebacks++;
+        if (level + 1 < numLevels_)
+            writeback(shard, level + 1, addr);
+    }
+}
+
+/* Dirty data arriving from the level above. Allocates if the line is not present (non-inclusive levels). */
+void TraceCacheSim::writeback(Shard& shard, unsigned int level, Addr addr) {
+    SharedCacheLine* line = shard.levels[level]->lookup(addr, false);
+    if (line && line->getState() != I) {
+        line->setState(M);
+        return;
+    }
+    fill(shard, level, addr, M);
+}
@@ -0,0 +1,151 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _MEMHIERARCHY_TRACECACHESIM_H_
+#define _MEMHIERARCHY_TRACECACHESIM_H_
+
+#include <cstdio>
+#include <vector>
+
+#include <sst/core/component.h>
+#include <sst/core/output.h>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#include "sst/elements/memHierarchy/cacheArray.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Functional trace-driven cache hierarchy model.
+ *
+ * Replays a Prospero or Ariel memory trace through a chain of cache levels built from
+ * CacheArray, ReplacementPolicy and HashFunction without using the event engine:
+ * no links, no clocks and no timing. The whole trace is consumed during setup() and
+ * results are reported as statistics, so a run takes a fraction of the time of the
+ * equivalent timed simulation while producing the same hit/miss counts as single core
+ * MESI memHierarchy caches with one request in flight (tests/testTraceCacheSim*.py).
+ *
+ * Sets are sharded across worker threads by the low bits of the line address. Every
+ * line maps to exactly one shard at every level, so shards never interact and the
+ * results do not depend on the thread count as long as the hash is 'memHierarchy.hash.none'.
+ * The worker threads are started by setup() outside SST's threading model, so they are only
+ * used when SST itself runs with one thread (sst -n 1). Otherwise the shards are replayed in
+ * turn on the thread that calls setup(), with the same results.
+ */
+class TraceCacheSim : public SST::Component {
+public:
+/* Element Library Info */
+    SST_ELI_REGISTER_COMPONENT(TraceCacheSim, "memHierarchy", "TraceCacheSim", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Functional trace-driven cache hierarchy model. Replays a Prospero/Ariel trace through CacheArray-based caches without the event engine. Replays on its own worker threads during setup() when 'threads' > 1 and SST runs with one thread (-n 1).", COMPONENT_CATEGORY_MEMORY)
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"verbose",                 "(uint) Output verbosity. 1 prints a summary at the end of simulation.", "1"},
+            {"trace_file",              "(string) Trace to replay. Records are <time> <R|W> <address> <size> as written by Prospero's tracer or Ariel's trace generators."},
+            {"trace_format",            "(string) Trace format. 'text' or 'binary'. Binary traces are read through zlib when available so compressed (.gz) traces are accepted as well.", "binary"},
+            {"cache_line_size",         "(uint) Line size in bytes, shared by all levels", "64"},
+            {"levels",                  "(uint) Number of cache levels. Each level N (starting at 1) is configured with 'levelN.' prefixed parameters below.", "1"},
+            {"levelN.cache_size",       "(string) Size of level N with units (e.g., 32KiB)."},
+            {"levelN.associativity",    "(uint) Associativity of level N", "8"},
+            {"levelN.replacement",      "(string) Replacement policy element for level N", "memHierarchy.replacement.lru"},
+            {"levelN.hash",             "(string) Set hash element for level N", "memHierarchy.hash.none"},
+            {"levelN.inclusive",        "(bool) Whether level N back-invalidates lines it evicts from the levels above it. Ignored for level 1.", "true"},
+            {"threads",                 "(uint) Number of worker threads. Sets are sharded across threads; the number of sets at each level must be a multiple of this. The threads are only started when SST runs with one thread (-n 1); otherwise the shards are replayed one after another on SST's thread.", "1"},
+            {"chunk_size",              "(uint) Number of trace records read per batch. The next batch is read while the workers process the current one.", "1048576"},
+            {"max_records",             "(uint) Stop after this many trace records. 0 replays the whole trace.", "0"} )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+            {"Hits",            "Accesses that hit at a level (subid is the level, e.g., L1)", "count", 1},
+            {"Misses",          "Accesses that missed at a level (subid is the level)", "count", 1},
+            {"Evictions",       "Valid lines replaced at a level (subid is the level)", "count", 1},
+            {"Writebacks",      "Dirty lines written back from a level to the next level or memory (subid is the level)", "count", 1},
+            {"BackInvalidations", "Lines invalidated in upper levels by an inclusive level's eviction (subid is the level)", "count", 1},
+            {"TraceReads",      "Read records replayed", "count", 1},
+            {"TraceWrites",     "Write records replayed", "count", 1} )
+
+/* Begin class definition */
+    TraceCacheSim(ComponentId_t id, Params &params);
+    ~TraceCacheSim();
+
+    void setup();
+    void finish();
+
+private:
+    /* One line-sized access after splitting a trace record */
+    struct Access {
+        Addr lineAddr;
+        bool write;
+    };
+
+    struct LevelCounts {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        uint64_t writebacks;
+        uint64_t backInvalidations;
+        LevelCounts() : hits(0), misses(0), evictions(0), writebacks(0), backInvalidations(0) { }
+    };
+
+    /* The part of the hierarchy that holds the sets owned by one worker thread */
+    struct Shard {
+        std::vector<CacheArray<SharedCacheLine>*> levels;
+        std::vector<LevelCounts> counts;
+        std::vector<Access> batch;      // Being replayed
+        std::vector<Access> pending;    // Being read from the trace
+    };
+
+    bool readRecord(uint64_t& addr, uint32_t& size, bool& write);
+    size_t readBatch();
+    void runShard(unsigned int shard);
+    void access(Shard& shard, Addr addr, bool write);
+    void fill(Shard& shard, unsigned int level, Addr addr, State state);
+    void evict(Shard& shard, unsigned int level, SharedCacheLine* victim);
+    void writeback(Shard& shard, unsigned int level, Addr addr);
+
+    Output out_;
+
+    std::vector<Shard> shards_;
+    std::vector<bool> inclusive_;
+    unsigned int numLevels_;
+    unsigned int numShards_;
+    bool workerThreads_;        // Replay shards on their own threads
+    uint64_t lineSize_;
+    unsigned int lineOffset_;
+
+    bool textTrace_;
+    FILE* traceFile_;
+#ifdef HAVE_LIBZ
+    gzFile traceGzFile_;
+#endif
+    size_t chunkSize_;
+    uint64_t maxRecords_;
+    uint64_t records_;
+    uint64_t reads_;
+    uint64_t writes_;
+
+    std::vector<Statistic<uint64_t>*> statHits_;
+    std::vector<Statistic<uint64_t>*> statMisses_;
+    std::vector<Statistic<uint64_t>*> statEvictions_;
+    std::vector<Statistic<uint64_t>*> statWritebacks_;
+    std::vector<Statistic<uint64_t>*> statBackInvalidations_;
+    Statistic<uint64_t>* statTraceReads_;
+    Statistic<uint64_t>* statTraceWrites_;
+};
+
+}}
+
+#endif
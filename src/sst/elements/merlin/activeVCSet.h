@@ -0,0 +1,94 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+// 
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_ACTIVEVCSET_H
+#define COMPONENTS_MERLIN_ACTIVEVCSET_H
+
+#include <vector>
+#include <stdint.h>
+
+namespace SST {
+namespace Merlin {
+
+// Bitmap of router input VCs that have an event at their head.  Kept
+// up to date by the ports as events arrive and leave so that the
+// router and crossbar arbiters only need to visit occupied VCs.
+// Each port uses a whole number of 64-bit words.
+class ActiveVCSet {
+private:
+    std::vector<uint64_t> bits;
+    int num_vcs;
+    int words_per_port;
+
+public:
+    ActiveVCSet() : num_vcs(0), words_per_port(0) {}
+
+    void init(int num_ports, int vcs) {
+        num_vcs = vcs;
+        words_per_port = (vcs + 63) / 64;
+        bits.assign(num_ports * words_per_port, 0);
+    }
+
+    inline void set(int port, int vc) {
+        bits[port * words_per_port + (vc >> 6)] |= (uint64_t)1 << (vc & 63);
+    }
+
+    inline void clear(int port, int vc) {
+        bits[port * words_per_port + (vc >> 6)] &= ~((uint64_t)1 << (vc & 63));
+    }
+
+    // Returns the first active VC >= vc on the port, or -1 if there
+    // isn't one.  vc may be num_vcs.
+    inline int nextInPort(int port, int vc) const {
+        if ( vc >= num_vcs ) return -1;
+        int word = vc >> 6;
+        const uint64_t* port_bits = &bits[port * words_per_port];
+        uint64_t w = port_bits[word] & (~(uint64_t)0 << (vc & 63));
+        while ( w == 0 ) {
+            if ( ++word == words_per_port ) return -1;
+            w = port_bits[word];
+        }
+        return (word << 6) + __builtin_ctzll(w);
+    }
+
+    // Returns the first active VC >= vc on the port, wrapping around to
+    // VC 0, or -1 if the port has no active VCs.  vc may be num_vcs.
+    inline int nextInPortWrap(int port, int vc) const {
+        int next = nextInPort(port, vc);
+        if ( next == -1 && vc != 0 ) next = nextInPort(port, 0);
+        return next;
+    }
+
+    // Calls func(port, vc) for each active VC, in port then VC order
+    template <typename F>
+    inline void forEach(F func) const {
+        for ( size_t i = 0; i < bits.size(); i++ ) {
+            uint64_t w = bits[i];
+            while ( w != 0 ) {
+                int bit = __builtin_ctzll(w);
+                w &= w - 1;
+                func(i / words_per_port, (i % words_per_port) * 64 + bit);
+            }
+        }
+    }
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_ACTIVEVCSET_H
@@ -0,0 +1,444 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+#include <sst_config.h>
+#include "analytic_router/analytic_router.h"
+
+#include <sst/core/params.h>
+#include <sst/core/simulation.h>
+
+#include <string>
+
+#include "merlin.h"
+
+using namespace SST::Merlin;
+using namespace SST::Interfaces;
+
+// Converts sizes and bandwidths specified in bytes to bits
+static UnitAlgebra toBits(const std::string& value)
+{
+    UnitAlgebra ua(value);
+    if ( ua.hasUnits("B") || ua.hasUnits("B/s") ) {
+        ua *= UnitAlgebra("8b/B");
+    }
+    return ua;
+}
+
+static SimTime_t toPicoseconds(const UnitAlgebra& time)
+{
+    return (time / UnitAlgebra("1ps")).getRoundedValue();
+}
+
+
+analytic_router::~analytic_router()
+{
+    delete [] output_credits;
+    delete [] output_queue_lengths;
+    delete topo;
+}
+
+analytic_router::analytic_router(ComponentId_t cid, Params& params) :
+    Router(cid),
+    output(Simulation::getSimulation()->getSimulationOutput())
+{
+    id = params.find<int>("id",-1);
+    if ( id == -1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "analytic_router requires id to be specified\n");
+    }
+
+    num_ports = params.find<int>("num_ports",-1);
+    if ( num_ports == -1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "analytic_router requires num_ports to be specified\n");
+    }
+
+    topo = loadUserSubComponent<SST::Merlin::Topology>
+        ("topology", ComponentInfo::SHARE_NONE, num_ports, id);
+
+    if ( !topo ) {
+        merlin_abort.fatal(CALL_INFO_LONG, 1, "analytic_router requires topology to be specified in input file\n");
+    }
+
+    num_vns = params.find<int>("num_vns",2);
+    num_vcs = topo->computeNumVCs(num_vns);
+
+    std::string flit_size_s = params.find<std::string>("flit_size");
+    if ( flit_size_s == "" ) {
+        merlin_abort.fatal(CALL_INFO, -1, "analytic_router requires flit_size to be specified\n");
+    }
+    flit_size = toBits(flit_size_s);
+
+    std::string hop_latency_s = params.find<std::string>("hop_latency","");
+    if ( hop_latency_s == "" ) {
+        UnitAlgebra lat(params.find<std::string>("input_latency","0ns"));
+        lat += UnitAlgebra(params.find<std::string>("output_latency","0ns"));
+        hop_latency = toPicoseconds(lat);
+    }
+    else {
+        hop_latency = toPicoseconds(UnitAlgebra(hop_latency_s));
+    }
+
+    window = toPicoseconds(UnitAlgebra(params.find<std::string>("utilization_window","1us")));
+    if ( window == 0 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "analytic_router: utilization_window must be greater than zero\n");
+    }
+    max_utilization = params.find<double>("max_utilization",0.95);
+    if ( max_utilization < 0.0 || max_utilization >= 1.0 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "analytic_router: max_utilization must be in [0,1)\n");
+    }
+
+    UnitAlgebra input_buf_size = toBits(params.find<std::string>("input_buf_size","1KiB"));
+    endpoint_credits = (input_buf_size / flit_size).getRoundedValue();
+
+    ps_tc = getTimeConverter("1ps");
+
+    ports.resize(num_ports);
+    for ( int i = 0; i < num_ports; i++ ) {
+        port_state_t& port = ports[i];
+        std::string port_name = "port" + std::to_string(i);
+
+        // link_bw can be overwritten using logical groups
+        std::string link_bw_s = params.find<std::string>("link_bw:" + topo->getPortLogicalGroup(i));
+        if ( link_bw_s == "" ) link_bw_s = params.find<std::string>("link_bw");
+        if ( link_bw_s == "" ) {
+            merlin_abort.fatal(CALL_INFO, -1, "analytic_router requires link_bw to be specified\n");
+        }
+        port.link_bw = toBits(link_bw_s);
+        port.flit_time = flitTime(port.link_bw);
+
+        port.host_port = topo->isHostPort(i);
+        port.window_start = 0;
+        port.busy_in_window = 0;
+        port.utilization = 0.0;
+        port.last_departure = 0;
+
+        // All delays are computed in ps
+        port.link = configureLink(port_name, "1ps",
+                                  new Event::Handler<analytic_router,int>(this,&analytic_router::handle_input,i));
+
+        port.send_bit_count = registerStatistic<uint64_t>("send_bit_count", port_name);
+        port.send_packet_count = registerStatistic<uint64_t>("send_packet_count", port_name);
+        port.queueing_delay = registerStatistic<uint64_t>("queueing_delay", port_name);
+    }
+
+    output_credits = new int[num_ports * num_vcs];
+    output_queue_lengths = new int[num_ports * num_vcs];
+    for ( int i = 0; i < num_ports * num_vcs; i++ ) {
+        output_credits[i] = endpoint_credits;
+        output_queue_lengths[i] = 0;
+    }
+    topo->setOutputBufferCreditArray(output_credits, num_vcs);
+    topo->setOutputQueueLengthsArray(output_queue_lengths, num_vcs);
+}
+
+
+SimTime_t
+analytic_router::flitTime(const UnitAlgebra& bw)
+{
+    SimTime_t time = toPicoseconds(flit_size / bw);
+    return time == 0 ? 1 : time;
+}
+
+
+void
+analytic_router::handle_input(Event* ev, int port)
+{
+    BaseRtrEvent* base_event = static_cast<BaseRtrEvent*>(ev);
+
+    switch (base_event->getType()) {
+    case BaseRtrEvent::CREDIT:
+        // Nothing is buffered, so credits are not tracked
+        delete ev;
+        break;
+    case BaseRtrEvent::PACKET:
+    {
+        RtrEvent* event = static_cast<RtrEvent*>(ev);
+        // Packet leaves the input immediately, so return the
+        // endpoint's credits right away
+        ports[port].link->send(new credit_event(event->getRouteVN(), event->getSizeInFlits()));
+
+        internal_router_event* rtr_event = topo->process_input(event);
+        forward(rtr_event, port);
+    }
+    break;
+    case BaseRtrEvent::INTERNAL:
+        forward(static_cast<internal_router_event*>(ev), port);
+        break;
+    case BaseRtrEvent::TOPOLOGY:
+        recvTopologyEvent(port, static_cast<TopologyEvent*>(ev));
+        break;
+    default:
+        break;
+    }
+}
+
+
+void
+analytic_router::forward(internal_router_event* ev, int in_port)
+{
+    topo->route(in_port, ev->getVC(), ev);
+    topo->reroute(in_port, ev->getVC(), ev);
+
+    int out_port = ev->getNextPort();
+    port_state_t& port = ports[out_port];
+
+    SimTime_t queueing;
+    SimTime_t delay = computeDelay(port, ev->getFlitCount(), queueing);
+
+    port.send_bit_count->addData(ev->getEncapsulatedEvent()->getSizeInBits());
+    port.send_packet_count->addData(1);
+    port.queueing_delay->addData(queueing);
+
+    if ( ev->getTraceType() == SimpleNetwork::Request::FULL ) {
+        output.output("TRACE(%d): %" PRIu64 " ns: Forwarding event (src = %d, dest = %d) "
+                      "in router %d (%s) from port %d to port %d with delay %" PRIu64 " ps.\n",
+                      ev->getTraceID(),
+                      getCurrentSimTimeNano(),
+                      ev->getSrc(),
+                      ev->getDest(),
+                      id,
+                      getName().c_str(),
+                      in_port,
+                      out_port,
+                      delay);
+    }
+
+    if ( port.host_port ) {
+        port.link->send(delay, ev->getEncapsulatedEvent());
+        ev->setEncapsulatedEvent(NULL);
+        delete ev;
+    }
+    else {
+        port.link->send(delay, ev);
+    }
+}
+
+
+SimTime_t
+analytic_router::computeDelay(port_state_t& port, int flits, SimTime_t& queueing)
+{
+    SimTime_t now = getCurrentSimTime(ps_tc);
+
+    // Roll the utilization window forward.  The utilization used for
+    // the queueing term is the one measured over the last full
+    // window; if a whole window went by without traffic, the link is
+    // idle.
+    if ( now >= port.window_start + window ) {
+        SimTime_t elapsed = (now - port.window_start) / window;
+        if ( elapsed == 1 ) {
+            port.utilization = (double)port.busy_in_window / (double)window;
+            if ( port.utilization > max_utilization ) port.utilization = max_utilization;
+        }
+        else {
+            port.utilization = 0.0;
+        }
+        port.window_start += elapsed * window;
+        port.busy_in_window = 0;
+    }
+
+    SimTime_t service = flits * port.flit_time;
+    port.busy_in_window += service;
+
+    // M/D/1 mean waiting time
+    double rho = port.utilization;
+    queueing = (SimTime_t)(rho * (double)service / (2.0 * (1.0 - rho)));
+
+    // Keep packets leaving the port in order
+    SimTime_t departure = now + hop_latency + queueing + service;
+    if ( departure < port.last_departure ) departure = port.last_departure;
+    port.last_departure = departure;
+
+    return departure - now;
+}
+
+
+void
+analytic_router::initPort(int port_num, unsigned int phase)
+{
+    port_state_t& port = ports[port_num];
+    if ( port.link == NULL ) return;
+
+    Event* ev;
+    RtrInitEvent* init_ev;
+
+    // Mirrors the PortControl side of the LinkControl handshake
+    switch ( phase ) {
+    case 0:
+        init_ev = new RtrInitEvent();
+        init_ev->command = RtrInitEvent::REPORT_BW;
+        init_ev->ua_value = port.link_bw;
+        port.link->sendInitData(init_ev);
+
+        if ( port.host_port ) {
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REPORT_FLIT_SIZE;
+            init_ev->ua_value = flit_size;
+            port.link->sendInitData(init_ev);
+
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REPORT_ID;
+            init_ev->int_value = topo->getEndpointID(port_num);
+            port.link->sendInitData(init_ev);
+        }
+        else {
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REPORT_ID;
+            init_ev->int_value = id;
+            port.link->sendInitData(init_ev);
+
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REPORT_PORT;
+            init_ev->int_value = port_num;
+            port.link->sendInitData(init_ev);
+        }
+        break;
+    case 1:
+    {
+        // Link speed is the minimum of the two sides
+        ev = port.link->recvInitData();
+        init_ev = static_cast<RtrInitEvent*>(ev);
+        if ( port.link_bw > init_ev->ua_value ) {
+            port.link_bw = init_ev->ua_value;
+            port.flit_time = flitTime(port.link_bw);
+        }
+        delete ev;
+
+        if ( port.host_port ) {
+            ev = port.link->recvInitData();
+            init_ev = static_cast<RtrInitEvent*>(ev);
+            int req_vns = init_ev->int_value;
+            delete ev;
+
+            // Report the number of VNs, then the (identity) VN map
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REQUEST_VNS;
+            init_ev->int_value = num_vns;
+            port.link->sendInitData(init_ev);
+
+            for ( int i = 0; i < req_vns; ++i ) {
+                init_ev = new RtrInitEvent();
+                init_ev->command = RtrInitEvent::REQUEST_VNS;
+                init_ev->int_value = i;
+                port.link->sendInitData(init_ev);
+            }
+        }
+        else {
+            // Remote router id and port number aren't needed
+            delete port.link->recvInitData();
+            delete port.link->recvInitData();
+        }
+    }
+    break;
+    default:
+        // Endpoint is ready for its injection credits
+        if ( phase == 2 && port.host_port ) {
+            for ( int i = 0; i < num_vns; ++i ) {
+                port.link->sendInitData(new credit_event(i, endpoint_credits));
+            }
+        }
+
+        while ( ( ev = port.link->recvInitData() ) != NULL ) {
+            BaseRtrEvent* bev = static_cast<BaseRtrEvent*>(ev);
+            if ( bev->getType() == BaseRtrEvent::CREDIT || bev->getType() == BaseRtrEvent::INITIALIZATION ) {
+                delete ev;
+            }
+            else {
+                port.init_events.push_back(ev);
+            }
+        }
+        break;
+    }
+}
+
+
+void
+analytic_router::routeUntimedData()
+{
+    for ( int i = 0; i < num_ports; i++ ) {
+        std::deque<Event*>& init_events = ports[i].init_events;
+        while ( !init_events.empty() ) {
+            Event* ev = init_events.front();
+            init_events.pop_front();
+
+            internal_router_event *ire = dynamic_cast<internal_router_event*>(ev);
+            if ( ire == NULL ) {
+                ire = topo->process_InitData_input(static_cast<RtrEvent*>(ev));
+            }
+            std::vector<int> outPorts;
+            topo->routeInitData(i, ire, outPorts);
+            for ( std::vector<int>::iterator j = outPorts.begin() ; j != outPorts.end() ; ++j ) {
+                if ( ports[*j].link == NULL ) continue;
+                // Need to clone both the event, and the encapsulated event.
+                switch ( topo->getPortState(*j) ) {
+                case Topology::R2N:
+                    ports[*j].link->sendInitData(ire->getEncapsulatedEvent()->clone());
+                    break;
+                case Topology::R2R: {
+                    internal_router_event *new_ire = ire->clone();
+                    new_ire->setEncapsulatedEvent(ire->getEncapsulatedEvent()->clone());
+                    ports[*j].link->sendInitData(new_ire);
+                    break;
+                }
+                default:
+                    break;
+                }
+            }
+            delete ire;
+        }
+    }
+}
+
+
+void
+analytic_router::init(unsigned int phase)
+{
+    for ( int i = 0; i < num_ports; i++ ) {
+        initPort(i, phase);
+    }
+    routeUntimedData();
+}
+
+void
+analytic_router::complete(unsigned int phase)
+{
+    for ( int i = 0; i < num_ports; i++ ) {
+        if ( ports[i].link == NULL ) continue;
+        Event* ev;
+        while ( ( ev = ports[i].link->recvInitData() ) != NULL ) {
+            ports[i].init_events.push_back(ev);
+        }
+    }
+    routeUntimedData();
+}
+
+void
+analytic_router::setup()
+{
+}
+
+void
+analytic_router::finish()
+{
+}
+
+void
+analytic_router::sendTopologyEvent(int port, TopologyEvent* ev)
+{
+    if ( ports[port].link ) ports[port].link->send(ev);
+}
+
+void
+analytic_router::recvTopologyEvent(int port, TopologyEvent* ev)
+{
+    topo->recvTopologyEvent(port,ev);
+}
@@ -0,0 +1,172 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_ANALYTIC_ROUTER_ANALYTIC_ROUTER_H
+#define COMPONENTS_MERLIN_ANALYTIC_ROUTER_ANALYTIC_ROUTER_H
+
+#include <sst/core/component.h>
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/output.h>
+#include <sst/core/timeConverter.h>
+#include <sst/core/unitAlgebra.h>
+
+#include <deque>
+#include <vector>
+
+#include "sst/elements/merlin/router.h"
+
+using namespace SST;
+
+namespace SST {
+namespace Merlin {
+
+/*
+ * Packet level analytical router.
+ *
+ * Drop-in replacement for hr_router for large scale studies where
+ * flit level accuracy is not needed.  Whole packets are forwarded as
+ * soon as they arrive; there are no input/output buffers, no credits
+ * between routers and no VC arbitration.  The time a packet spends in
+ * the router is modeled as:
+ *
+ *   hop_latency + serialization + queueing
+ *
+ * where serialization is the packet size over the output link
+ * bandwidth and queueing is the M/D/1 waiting time for the output link
+ * utilization measured over the previous utilization_window.  Packets
+ * leaving an output port are kept in order.
+ *
+ * Host ports speak the same protocol as PortControl, so endpoints use
+ * the unmodified LinkControl.  Credits for packets injected by an
+ * endpoint are returned as soon as the packet arrives, so only the
+ * endpoint link bandwidth limits injection.  All routers in a network
+ * need to be analytic_routers.
+ */
+class analytic_router : public Router {
+
+public:
+
+    SST_ELI_REGISTER_COMPONENT(
+        analytic_router,
+        "merlin",
+        "analytic_router",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Packet level analytical router model.  Uses the same topologies and endpoints as hr_router.",
+        COMPONENT_CATEGORY_NETWORK)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"id",                 "ID of the router."},
+        {"num_ports",          "Number of ports that the router has"},
+        {"topology",           "Name of the topology subcomponent that should be loaded to control routing."},
+        {"link_bw",            "Bandwidth of the links specified in either b/s or B/s (can include SI prefix).  Can be set per logical port group using link_bw:<group>."},
+        {"flit_size",          "Flit size specified in either b or B (can include SI prefix)."},
+        {"hop_latency",        "Fixed latency added at each router.  If not specified, input_latency + output_latency is used so hr_router parameter sets can be reused.", ""},
+        {"input_latency",      "Used to compute hop_latency if it is not specified.", "0ns"},
+        {"output_latency",     "Used to compute hop_latency if it is not specified.", "0ns"},
+        {"input_buf_size",     "Credits given to each endpoint for injection, specified in b or B (can include SI prefix).", "1KiB"},
+        {"utilization_window", "Period over which output link utilization is measured for the queueing term.", "1us"},
+        {"max_utilization",    "Upper bound on the utilization used to compute the queueing term.", "0.95"},
+        {"num_vns",            "Number of VNs.","2"},
+        {"debug",              "Turn on debugging for router. Set to 1 for on, 0 for off.", "0"}
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "send_bit_count",     "Count number of bits sent on link", "bits", 1},
+        { "send_packet_count",  "Count number of packets sent on link", "packets", 1},
+        { "queueing_delay",     "Modeled queueing delay of packets sent on link", "ps", 1}
+    )
+
+    SST_ELI_DOCUMENT_PORTS(
+        {"port%(num_ports)d",  "Ports which connect to endpoints or other routers.", { "merlin.RtrEvent", "merlin.internal_router_event", "merlin.topologyevent", "merlin.credit_event" } }
+    )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        {"topology", "Topology object to control routing", "SST::Merlin::Topology" }
+    )
+
+private:
+
+    struct port_state_t {
+        Link* link;
+        bool host_port;
+        UnitAlgebra link_bw;
+        // Time to send one flit, in ps
+        SimTime_t flit_time;
+
+        // Utilization tracking
+        SimTime_t window_start;
+        SimTime_t busy_in_window;
+        double utilization;
+        // Time the last packet finishes leaving this port.  Used to
+        // keep packets in order
+        SimTime_t last_departure;
+
+        std::deque<Event*> init_events;
+
+        Statistic<uint64_t>* send_bit_count;
+        Statistic<uint64_t>* send_packet_count;
+        Statistic<uint64_t>* queueing_delay;
+    };
+
+    int id;
+    int num_ports;
+    int num_vns;
+    int num_vcs;
+
+    Topology* topo;
+    std::vector<port_state_t> ports;
+
+    UnitAlgebra flit_size;
+    SimTime_t hop_latency;
+    SimTime_t window;
+    double max_utilization;
+    int endpoint_credits;
+
+    // Handed to the topology for adaptive decisions.  Nothing is ever
+    // buffered, so all credits are always available.
+    int* output_credits;
+    int* output_queue_lengths;
+
+    TimeConverter* ps_tc;
+    Output& output;
+
+    void handle_input(Event* ev, int port);
+    void forward(internal_router_event* ev, int in_port);
+    SimTime_t computeDelay(port_state_t& port, int flits, SimTime_t& queueing);
+    SimTime_t flitTime(const UnitAlgebra& bw);
+    void initPort(int port, unsigned int phase);
+    void routeUntimedData();
+
+public:
+    analytic_router(ComponentId_t cid, Params& params);
+    ~analytic_router();
+
+    void init(unsigned int phase);
+    void complete(unsigned int phase);
+    void setup();
+    void finish();
+
+    int const* getOutputBufferCredits() {return output_credits;}
+
+    void sendTopologyEvent(int port, TopologyEvent* ev);
+    void recvTopologyEvent(int port, TopologyEvent* ev);
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_ANALYTIC_ROUTER_ANALYTIC_ROUTER_H
@@ -20,6 +20,8 @@
 #include <sst/core/simulation.h>
 #include <sst/core/timeLord.h>
 
+#include <map>
+
 using namespace SST::Merlin;
 using namespace SST::Interfaces;
 
@@ -39,6 +41,17 @@ BackgroundTraffic::BackgroundTraffic(ComponentId_t cid, Params& params) :
         Simulation::getSimulationOutput().fatal(CALL_INFO, -1, "BackgroundTraffic: num_peers must be set!\n");
     }
 
+    std::string mode = params.find<std::string>("mode","packet");
+    if ( mode == "packet" ) flow_mode = false;
+    else if ( mode == "flow" ) flow_mode = true;
+    else {
+        Simulation::getSimulationOutput().fatal(CALL_INFO, -1, "BackgroundTraffic: unknown mode: %s\n", mode.c_str());
+    }
+    flow_samples = params.find<int>("flow_samples",16);
+    if ( flow_samples < 1 ) {
+        Simulation::getSimulationOutput().fatal(CALL_INFO, -1, "BackgroundTraffic: flow_samples must be at least 1\n");
+    }
+
     UnitAlgebra pkt_size = params.find<UnitAlgebra>("message_size","64b");
     if ( pkt_size.hasUnits("B") ) pkt_size  *= UnitAlgebra("8b/B");
     packet_size = pkt_size.getRoundedValue();
@@ -83,7 +96,7 @@ BackgroundTraffic::BackgroundTraffic(ComponentId_t cid, Params& params) :
 
     pattern_params = new Params();
     // packetDestGen = static_cast<TargetGenerator*>(loadSubComponent(pattern, this, params));
-    pattern_params->insert(params.find_prefix_params("pattern"));
+    pattern_params->insert(params.find_prefix_params("pattern:"));
     pattern_params->insert("pattern_gen",pattern);
 
     registerAsPrimaryComponent();
@@ -118,8 +131,9 @@ void BackgroundTraffic::setup()
     // transfer.
     // link_bw = (link_bw * UnitAlgebra("1ps")).invert();
 
-    // kick things off
-    timing_link->send(0,NULL);
+    // kick things off.  In flow mode the load was reserved in the
+    // routers during init, so there is nothing to send.
+    if ( !flow_mode ) timing_link->send(0,NULL);
 }
 
 void
@@ -143,8 +157,39 @@ BackgroundTraffic::init(unsigned int phase) {
         serialization_time = ((serialization_time /*pkt_size*/ / link_bw) / UnitAlgebra("1ps"));
         UnitAlgebra interval = serialization_time / offered_load;
         send_interval = interval.getRoundedValue();
+
+        if ( flow_mode ) send_flows();
     }
 
+    // Drain flow requests sent to us by other endpoints
+    while ( SimpleNetwork::Request* req = link_if->recvUntimedData() ) {
+        delete req;
+    }
+}
+
+void
+BackgroundTraffic::send_flows()
+{
+    // Estimate the pattern's destination distribution by sampling it,
+    // then send one untimed request per destination.  The routers
+    // reserve the flow's share of offered_load on every port along
+    // the route the request takes.
+    std::map<int,int> samples;
+    for ( int i = 0; i < flow_samples; i++ ) {
+        int dest = packetDestGen->getNextValue();
+        if ( dest != id ) samples[dest]++;
+    }
+
+    UnitAlgebra link_bw = link_if->getLinkBW();
+    if ( link_bw.hasUnits("B/s") ) link_bw *= UnitAlgebra("8b/B");
+    UnitAlgebra sample_bw = link_bw / flow_samples;
+    for ( auto& sample : samples ) {
+        UnitAlgebra bw = sample_bw;
+        bw *= (offered_load * sample.second);
+        SimpleNetwork::Request* req = new SimpleNetwork::Request(sample.first, id, packet_size, true, true,
+                                                                 new BackgroundFlowEvent(bw));
+        link_if->sendUntimedData(req);
+    }
 }
 
 void
@@ -34,6 +34,7 @@
 #include <sst/core/output.h>
 #include "sst/core/interfaces/simpleNetwork.h"
 
+#include "sst/elements/merlin/router.h"
 #include "sst/elements/merlin/target_generator/target_generator.h"
 
 namespace SST {
@@ -75,6 +76,10 @@ public:
         {"packet_size",      "Packet size specified in either b or B (can include SI prefix).","32B"},
         {"pattern",          "Traffic pattern to use.","merlin.targetgen.uniform"},
         {"offered_load",     "Load to be offered to network.  Valid range: 0 < offered_load <= 1.0."},
+        {"mode",             "packet to inject background packets, or flow to only reserve offered_load of the bandwidth "
+                             "on the links along the routes to the targets.  Flow mode requires merlin.hr_router.","packet"},
+        {"flow_samples",     "Number of destinations drawn from the pattern in flow mode.  Bandwidth is split evenly "
+                             "between the samples.","16"},
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -92,6 +97,10 @@ private:
     double offered_load;
     UnitAlgebra link_bw;
 
+    // Flow mode only reserves bandwidth in the routers during init
+    bool flow_mode;
+    int flow_samples;
+
     Params* pattern_params;
 
     UnitAlgebra serialization_time;
@@ -133,6 +142,7 @@ private:
 
     void output_timing(Event* ev);
     void progress_messages(SimTime_t current_time);
+    void send_flows();
 
 };
 
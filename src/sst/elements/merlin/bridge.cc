@@ -34,6 +34,9 @@ Bridge::Bridge(SST::ComponentId_t id, SST::Params &params) :
     translator = loadAnonymousSubComponent<Translator>(params.find<std::string>("translator"),"translator",0,
                                                        ComponentInfo::SHARE_NONE, transParams, this);
     if ( !translator ) dbg.fatal(CALL_INFO, 1, "Must specify a 'translator' subcomponent.");
+    inPlace = translator->canTranslateInPlace();
+
+    stat_copied = registerStatistic<uint64_t>("pkts_copied");
 
     configureNIC(0, params);
     configureNIC(1, params);
@@ -43,7 +46,18 @@ Bridge::Bridge(SST::ComponentId_t id, SST::Params &params) :
 Bridge::~Bridge()
 {
     for ( int i = 0 ; i < 2 ; i++ ) {
-        delete interfaces[i].nic;
+        Nic_t &nic = interfaces[i];
+        /* The NIC may still hold sendHandler if requests were left in
+         * the queue.  SimpleNetwork implementations do not own their
+         * notify functors, so clear the registration before the
+         * handler is deleted. */
+        nic.nic->setNotifyOnSend(NULL);
+        delete nic.nic;
+        delete nic.sendHandler;
+        while ( !nic.sendQueue.empty() ) {
+            delete nic.sendQueue.front();
+            nic.sendQueue.pop_front();
+        }
     }
     delete translator;
 }
@@ -74,10 +88,11 @@ void Bridge::configureNIC(uint8_t id, SST::Params &params)
     //         params.find<SST::UnitAlgebra>("network_output_buffer_size", SST::UnitAlgebra("1KiB")));
 
     nic.nic->setNotifyOnReceive(new SimpleNetwork::Handler<Bridge, uint8_t>(this, &Bridge::handleIncoming, id));
-    nic.nic->setNotifyOnSend(new SimpleNetwork::Handler<Bridge, uint8_t>(this, &Bridge::spaceAvailable, id));
+    nic.sendHandler = new SimpleNetwork::Handler<Bridge, uint8_t>(this, &Bridge::spaceAvailable, id);
 
     nic.stat_recv = registerStatistic<uint64_t>("pkts_received_net" + std::to_string(id));
     nic.stat_send = registerStatistic<uint64_t>("pkts_sent_net" + std::to_string(id));
+    nic.stat_bytes = registerStatistic<uint64_t>("bytes_sent_net" + std::to_string(id));
 }
 
 
@@ -145,32 +160,64 @@ bool Bridge::handleIncoming(int vn, uint8_t id)
 
     dbg.debug(CALL_INFO, 5, 0, "Received event on interface %u\n", id);
 
-    SimpleNetwork::Request *res = translator->translate(req, id);
-    if ( res ) {
-        if ( outNIC.nic->send(res, 0) ) {
-            outNIC.stat_send->addData(1);
+    SimpleNetwork::Request *res;
+    if ( inPlace ) {
+        /* Forward the original request and payload with a new header */
+        if ( translator->translateInPlace(req, id) ) {
+            res = req;
         } else {
-            /* We failed to send. */
-            outNIC.sendQueue.push_back(res);
+            delete req;
+            res = NULL;
+        }
+    } else {
+        res = translator->translate(req, id);
+        if ( res && res != req ) stat_copied->addData(1);
+    }
+
+    if ( res ) {
+        /* Keep requests in order behind anything already queued */
+        if ( !outNIC.sendQueue.empty() || !send(outNIC, res) ) {
+            enqueue(outNIC, res);
         }
     }
     return true;
 }
 
 
+bool Bridge::send(Nic_t &nic, SimpleNetwork::Request *req)
+{
+    /* size_in_bits is read first since the NIC owns req once sent */
+    uint64_t bytes = req->size_in_bits / 8;
+    if ( !nic.nic->send(req, 0) ) return false;
+
+    nic.stat_send->addData(1);
+    nic.stat_bytes->addData(bytes);
+    return true;
+}
+
+
+void Bridge::enqueue(Nic_t &nic, SimpleNetwork::Request *req)
+{
+    /* The NIC drops the send handler once spaceAvailable() returns
+     * false, so ask to be notified again when the queue starts to fill */
+    if ( nic.sendQueue.empty() ) nic.nic->setNotifyOnSend(nic.sendHandler);
+    nic.sendQueue.push_back(req);
+}
+
+
 bool Bridge::spaceAvailable(int vn, uint8_t id)
 {
     Nic_t &nic = interfaces[id];
     while ( !nic.sendQueue.empty() ) {
-        if ( nic.nic->send(nic.sendQueue.front(), 0) ) {
-            nic.stat_send->addData(1);
+        if ( send(nic, nic.sendQueue.front()) ) {
             nic.sendQueue.pop_front();
         } else {
             /* Not enough room yet.  */
             break;
         }
     }
-    return false;
+    /* Stay registered until everything queued has been sent */
+    return !nic.sendQueue.empty();
 }
 
 
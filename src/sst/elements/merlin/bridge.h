@@ -56,6 +56,9 @@ public:
         {"pkts_received_net1",           "Total number of packets recived on NIC1", "count", 1},
         {"pkts_sent_net0",           "Total number of packets sent on NIC0", "count", 1},
         {"pkts_sent_net1",           "Total number of packets sent on NIC1", "count", 1},
+        {"bytes_sent_net0",          "Total number of bytes bridged onto NIC0", "bytes", 1},
+        {"bytes_sent_net1",          "Total number of bytes bridged onto NIC1", "bytes", 1},
+        {"pkts_copied",              "Number of packets the translator replaced with a new request instead of forwarding the original", "count", 1},
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -96,6 +99,23 @@ public:
          */
         virtual SimpleNetwork::Request* translate(SimpleNetwork::Request* req, uint8_t fromNetwork) = 0;
 
+        /**
+         * Return true if the translator implements translateInPlace().
+         * The bridge will then call it instead of translate().
+         */
+        virtual bool canTranslateInPlace() const { return false; }
+
+        /**
+         * Called when a network request is recieved, if
+         * canTranslateInPlace() returns true.  Should rewrite the header
+         * (src, dest and vn) of req for the opposite network.  The
+         * bridge then forwards req and its payload as is.
+         *
+         * Return false if the packet should not be forwarded, in which
+         * case the bridge deletes req.
+         */
+        virtual bool translateInPlace(SimpleNetwork::Request* req, uint8_t fromNetwork) { return false; }
+
 
         /**
          * Called when a network request is recieved during INIT.  Should return the corresponding
@@ -118,9 +138,13 @@ private:
     struct Nic_t {
         SimpleNetwork *nic;
         std::deque<SimpleNetwork::Request*> sendQueue;
+        /* Registered with the NIC while sendQueue is not empty.  Owned
+         * by the Bridge, the NIC never deletes it. */
+        SimpleNetwork::HandlerBase *sendHandler;
 
         Statistic<uint64_t> *stat_recv;
         Statistic<uint64_t> *stat_send;
+        Statistic<uint64_t> *stat_bytes;
 
         SimpleNetwork::nid_t getAddr() const { return nic->getEndpointID(); }
     };
@@ -128,8 +152,13 @@ private:
     Nic_t interfaces[2];
 
     Translator *translator;
+    bool inPlace;
+
+    Statistic<uint64_t> *stat_copied;
 
     void configureNIC(uint8_t nic, SST::Params &params);
+    bool send(Nic_t &nic, SimpleNetwork::Request *req);
+    void enqueue(Nic_t &nic, SimpleNetwork::Request *req);
     bool handleIncoming(int vn, uint8_t nic);
     bool spaceAvailable(int vn, uint8_t nic);
 
@@ -27,6 +27,8 @@
 #include <signal.h>
 
 #include "merlin.h"
+#include "hr_router/stat_summary.h"
+#include "hr_router/tree_saturation.h"
 
 using namespace SST::Merlin;
 using namespace SST::Interfaces;
@@ -117,11 +119,14 @@ hr_router::~hr_router()
 
     delete topo;
     delete arb;
+    delete tree_sat;
 }
 
 hr_router::hr_router(ComponentId_t cid, Params& params) :
     Router(cid),
     num_vcs(-1),
+    xbar_stall_count(0),
+    tree_sat(NULL),
     output(Simulation::getSimulation()->getSimulationOutput())
 {
 
@@ -239,10 +244,15 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     Params pc_params = params.find_prefix_params("portcontrol:");
 
     pc_params.insert("flit_size", flit_size.toStringBestSI());
-    if (pc_params.contains("network_inspectors")) pc_params.insert("network_inspectors", params.find<std::string>("network_inspectors", ""));
+    if (params.contains("network_inspectors")) pc_params.insert("network_inspectors", params.find<std::string>("network_inspectors", ""));
     pc_params.insert("oql_track_port", params.find<std::string>("oql_track_port","false"));
     pc_params.insert("oql_track_remote", params.find<std::string>("oql_track_remote","false"));
 
+    stat_summary = params.find<bool>("stats_summary", false);
+    stat_summary_file = params.find<std::string>("stats_summary_file", "");
+    pc_params.insert("stats_summary", stat_summary ? "true" : "false");
+    if ( stat_summary ) RouterStatSummary::addRouter();
+
     for ( int i = 0; i < num_ports; i++ ) {
         in_port_busy[i] = 0;
         out_port_busy[i] = 0;
@@ -296,6 +306,19 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     xbar_tc = registerClock( xbar_clock, my_clock_handler);
     num_routers++;
 
+    if ( params.find<bool>("tree_saturation", false) ) {
+        UnitAlgebra window(params.find<std::string>("tree_saturation_window", "1us"));
+        if ( !window.hasUnits("s") ) {
+            merlin_abort.fatal(CALL_INFO, -1, "hr_router: tree_saturation_window must be specified in s (can include SI prefix)\n");
+        }
+        double threshold = params.find<double>("tree_saturation_threshold", 1.0);
+        int min_routers = params.find<int>("tree_saturation_min_routers", 2);
+        tree_sat_file = params.find<std::string>("tree_saturation_file", "");
+
+        tree_sat = new TreeSaturationDetector(id, (window * xbar_clock).getRoundedValue(), threshold);
+        TreeSaturationDetector::addRouter((window / UnitAlgebra("1ns")).getRoundedValue(), threshold, min_routers);
+    }
+
 #if VERIFY_DECLOCKING
     clocking = true;
 #endif
@@ -316,6 +339,9 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
         port_name = port_name + std::to_string(i);
         xbar_stalls[i] = registerStatistic<uint64_t>("xbar_stalls",port_name);
     }
+    event_pool_alloc = registerStatistic<uint64_t>("event_pool_alloc");
+    event_pool_reuse = registerStatistic<uint64_t>("event_pool_reuse");
+    event_pool_max_free = registerStatistic<uint64_t>("event_pool_max_free");
 
     init_vcs();
 }
@@ -410,17 +436,11 @@ hr_router::clock_handler(Cycle_t cycle)
 
 #endif
     }
-    // Loop through all the events at the heads of the queues and call
-    // route
-    int index = 0;
-    for ( int i = 0; i < num_ports; i++ ) {
-        for ( int j = 0; j < num_vcs; j++ ) {
-            if ( vc_heads[index] != NULL ) {
-                topo->reroute(i,j,vc_heads[index]);
-            }
-            index++;
-        }
-    }
+    // Loop through the events at the heads of the occupied VCs and
+    // call route
+    active_vcs.forEach([this](int port, int vc) {
+            topo->reroute(port,vc,vc_heads[port*num_vcs+vc]);
+        });
 
     // All we need to do is arbitrate the crossbar
 #if VERIFY_DECLOCKING
@@ -429,6 +449,20 @@ hr_router::clock_handler(Cycle_t cycle)
     arb->arbitrate(ports,in_port_busy,out_port_busy,progress_vcs);
 #endif
 
+    // Count the flits at the heads of VCs that are stuck because the
+    // output VC they want is full
+    if ( tree_sat ) {
+        tree_sat->tick(cycle);
+        active_vcs.forEach([this](int port, int vc) {
+                if ( progress_vcs[port] == vc ) return;
+                internal_router_event* ev = vc_heads[port*num_vcs+vc];
+                int next_port = ev->getNextPort();
+                if ( !ports[next_port]->spaceToSend(ev->getVC(), ev->getFlitCount()) ) {
+                    tree_sat->addBlocked(ev->getDest(), ev->getFlitCount(), topo->isHostPort(next_port));
+                }
+            });
+    }
+
     // Move the events and decrement the busy values
     for ( int i = 0; i < num_ports; i++ ) {
         // if ( progress_vcs[i] != -1 ) {
@@ -457,6 +491,7 @@ hr_router::clock_handler(Cycle_t cycle)
         }
         else if ( progress_vcs[i] == -2 ) {
                 xbar_stalls[i]->addData(1);
+                if ( stat_summary ) xbar_stall_count++;
         }
 
         // Should stop at zero, need to find a clean way to do this
@@ -481,6 +516,24 @@ void hr_router::finish()
     	ports[i]->finish();
     }
 
+    // The event pool is per thread, so only report it once per thread
+    static thread_local bool pool_reported = false;
+    if ( !pool_reported ) {
+        event_pool_alloc->addData(RtrEventPool::getAllocCount());
+        event_pool_reuse->addData(RtrEventPool::getReuseCount());
+        event_pool_max_free->addData(RtrEventPool::getMaxHeldCount());
+        pool_reported = true;
+    }
+
+    if ( stat_summary ) {
+        RouterStatSummary::addXbarStalls(xbar_stall_count);
+        RouterStatSummary::routerFinished(stat_summary_file);
+    }
+
+    if ( tree_sat ) {
+        tree_sat->finish(getCurrentSimTime(xbar_tc));
+        TreeSaturationDetector::routerFinished(tree_sat_file);
+    }
 }
 
 void
@@ -497,6 +550,16 @@ hr_router::init(unsigned int phase)
             }
             std::vector<int> outPorts;
             topo->routeInitData(i, ire, outPorts);
+
+            // Background flows reserve bandwidth on every port along
+            // their route
+            BackgroundFlowEvent* flow = dynamic_cast<BackgroundFlowEvent*>(ire->inspectRequest()->inspectPayload());
+            if ( flow != NULL ) {
+                for ( std::vector<int>::iterator j = outPorts.begin() ; j != outPorts.end() ; ++j ) {
+                    ports[*j]->reserveBandwidth(flow->bw);
+                }
+            }
+
             for ( std::vector<int>::iterator j = outPorts.begin() ; j != outPorts.end() ; ++j ) {
                 /* Little tricky here.  Need to clone both the event, and the
                  * encapsulated event.
@@ -611,7 +674,9 @@ hr_router::init_vcs()
 
     // Now that we have the number of VCs we can finish initializing
     // arbitration logic
+    active_vcs.init(num_ports,num_vcs);
     arb->setPorts(num_ports,num_vcs);
+    arb->setActiveVCs(&active_vcs);
 
 
 }
@@ -36,6 +36,7 @@ namespace SST {
 namespace Merlin {
 
 class PortControlBase;
+class TreeSaturationDetector;
 
 class hr_router : public Router {
 
@@ -67,6 +68,15 @@ public:
         {"num_vns",            "Number of VNs.","2"},
         {"vn_remap",           "Array that specifies the vn remapping for each node in the systsm."},
         {"vn_remap_shm",       "Name of shared memory region for vn remapping.  If empty, no remapping is done", ""},
+        {"stats_summary",      "Set to true to add this router to a fixed size per rank summary (port utilization and stall histograms, "
+         "per VC stall cycles, hop latency histogram, totals) that is written once per rank at the end of simulation.  Independent of the statistics engine.", "false"},
+        {"stats_summary_file", "File for the per rank statistics summary, with .<rank> appended for multi-rank runs.  Empty writes to the simulation output.", ""},
+        {"tree_saturation",    "Set to true to detect tree saturation online.  Blocked flits are counted per destination in a small sketch and "
+         "the destinations blocked in several routers at once are written to a per rank log at the end of simulation.", "false"},
+        {"tree_saturation_window",      "Length of the detection window.", "1us"},
+        {"tree_saturation_threshold",   "Blocked flits per cycle, averaged over a window, for a destination to count as saturated in a router.", "1.0"},
+        {"tree_saturation_min_routers", "Only log episodes in which at least this many routers were saturated on the same destination in one window.", "2"},
+        {"tree_saturation_file",        "File for the tree saturation log, with .<rank> appended for multi-rank runs.  Empty writes to the simulation output.", ""},
         {"debug",              "Turn on debugging for router. Set to 1 for on, 0 for off.", "0"}
     )
 
@@ -76,7 +86,14 @@ public:
         { "output_port_stalls", "Time output port is stalled (in units of core timebase)", "time in stalls", 1},
         { "xbar_stalls",        "Count number of cycles the xbar is stalled", "cycles", 1},
         { "idle_time",          "Amount of time spent idle for a given port", "units of core timebase", 1},
-        { "width_adj_count",    "Number of times that link width was increased or decreased", "width adjustment count", 1}
+        { "width_adj_count",    "Number of times that link width was increased or decreased", "width adjustment count", 1},
+        { "credit_return_count", "Number of packets whose credits were returned by each credit event.  The sum is the packets drained from the input buffer", "packets", 1},
+        { "credit_event_count", "Number of credit events sent on link.  Less than the credit_return_count sum when portcontrol:credit_coalesce_threshold is set", "events", 1},
+        { "ecn_mark_count",     "Number of packets ECN marked on the way out of the port.  Only nonzero when portcontrol:ecn_threshold is set", "packets", 1},
+        { "reserved_bw",        "Bandwidth reserved on the output of the port by background flows during init", "Mb/s", 1},
+        { "event_pool_alloc",   "Router events that had to be allocated from the heap.  Counts are per simulation thread and reported by one router on each thread.", "events", 1},
+        { "event_pool_reuse",   "Router events that reused memory from the event pool.  Counts are per simulation thread and reported by one router on each thread.", "events", 1},
+        { "event_pool_max_free", "Most freed router events the event pool held for reuse at once.  Capped at 4096 per simulation thread and reported by one router on each thread.", "events", 1}
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -134,6 +151,16 @@ private:
 
     void init_vcs();
     Statistic<uint64_t>** xbar_stalls;
+    Statistic<uint64_t>* event_pool_alloc;
+    Statistic<uint64_t>* event_pool_reuse;
+    Statistic<uint64_t>* event_pool_max_free;
+
+    bool stat_summary;
+    std::string stat_summary_file;
+    uint64_t xbar_stall_count;
+
+    TreeSaturationDetector* tree_sat;
+    std::string tree_sat_file;
 
     Output& output;
 
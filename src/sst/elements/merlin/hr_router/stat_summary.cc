@@ -0,0 +1,153 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "hr_router/stat_summary.h"
+
+#include <sst/core/simulation.h>
+
+#include <fstream>
+#include <sstream>
+
+using namespace SST::Merlin;
+
+std::mutex RouterStatSummary::lock;
+RouterStatSummary::Data RouterStatSummary::total;
+int RouterStatSummary::num_routers = 0;
+int RouterStatSummary::num_finished = 0;
+
+static int fractionBin(double fraction, int bins)
+{
+    int bin = fraction * bins;
+    if ( bin < 0 ) return 0;
+    if ( bin >= bins ) return bins - 1;
+    return bin;
+}
+
+void
+SST::Merlin::writeRankRecord(const std::string& file, const std::string& record)
+{
+    if ( file.empty() ) {
+        Simulation::getSimulation()->getSimulationOutput().output("%s", record.c_str());
+        return;
+    }
+
+    const RankInfo& rank = Simulation::getSimulation()->getRank();
+    const RankInfo& num_ranks = Simulation::getSimulation()->getNumRanks();
+
+    std::string filename = file;
+    if ( num_ranks.rank > 1 ) filename += "." + std::to_string(rank.rank);
+    std::ofstream stream(filename.c_str());
+    stream << record;
+}
+
+void
+RouterStatSummary::Data::clear()
+{
+    ports = 0;
+    packets = 0;
+    bits = 0;
+    stall_cycles = 0;
+    xbar_stall_cycles = 0;
+    for ( int i = 0; i < fraction_bins; i++ ) {
+        utilization[i] = 0;
+        stalled[i] = 0;
+    }
+    for ( int i = 0; i < latency_bins; i++ ) hop_latency[i] = 0;
+    vc_stall_cycles.clear();
+}
+
+void
+RouterStatSummary::Data::merge(const Data& other)
+{
+    ports += other.ports;
+    packets += other.packets;
+    bits += other.bits;
+    stall_cycles += other.stall_cycles;
+    xbar_stall_cycles += other.xbar_stall_cycles;
+    for ( int i = 0; i < fraction_bins; i++ ) {
+        utilization[i] += other.utilization[i];
+        stalled[i] += other.stalled[i];
+    }
+    for ( int i = 0; i < latency_bins; i++ ) hop_latency[i] += other.hop_latency[i];
+    if ( vc_stall_cycles.size() < other.vc_stall_cycles.size() ) vc_stall_cycles.resize(other.vc_stall_cycles.size(), 0);
+    for ( size_t i = 0; i < other.vc_stall_cycles.size(); i++ ) vc_stall_cycles[i] += other.vc_stall_cycles[i];
+}
+
+void
+RouterStatSummary::addPort(double utilization, double stalled, uint64_t packets, uint64_t bits, uint64_t stall_cycles,
+                           const std::vector<uint64_t>& vc_stall_cycles)
+{
+    Data& data = local();
+    data.ports++;
+    data.packets += packets;
+    data.bits += bits;
+    data.stall_cycles += stall_cycles;
+    data.utilization[fractionBin(utilization, fraction_bins)]++;
+    data.stalled[fractionBin(stalled, fraction_bins)]++;
+    if ( data.vc_stall_cycles.size() < vc_stall_cycles.size() ) data.vc_stall_cycles.resize(vc_stall_cycles.size(), 0);
+    for ( size_t i = 0; i < vc_stall_cycles.size(); i++ ) data.vc_stall_cycles[i] += vc_stall_cycles[i];
+}
+
+void
+RouterStatSummary::routerFinished(const std::string& file)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    // Move everything this thread has accumulated so far into the
+    // rank total
+    total.merge(local());
+    local().clear();
+
+    num_finished++;
+    if ( num_finished == num_routers ) write(file);
+}
+
+void
+RouterStatSummary::write(const std::string& file)
+{
+    const RankInfo& rank = Simulation::getSimulation()->getRank();
+
+    std::stringstream out;
+    out << "merlin router summary: rank " << rank.rank << ", " << num_routers << " routers, "
+        << total.ports << " ports" << std::endl;
+    out << "  packets: " << total.packets << std::endl;
+    out << "  bits: " << total.bits << std::endl;
+    out << "  output_port_stall_cycles: " << total.stall_cycles << std::endl;
+    out << "  xbar_stall_cycles: " << total.xbar_stall_cycles << std::endl;
+
+    out << "  vc_stall_cycles:";
+    for ( size_t i = 0; i < total.vc_stall_cycles.size(); i++ ) out << " " << total.vc_stall_cycles[i];
+    out << std::endl;
+
+    out << "  port_utilization:";
+    for ( int i = 0; i < fraction_bins; i++ ) out << " " << total.utilization[i];
+    out << std::endl;
+
+    out << "  port_stalled:";
+    for ( int i = 0; i < fraction_bins; i++ ) out << " " << total.stalled[i];
+    out << std::endl;
+
+    // Trailing empty bins are left off
+    int last = latency_bins - 1;
+    while ( last > 0 && total.hop_latency[last] == 0 ) last--;
+    out << "  hop_latency_ns_log2:";
+    for ( int i = 0; i <= last; i++ ) out << " " << total.hop_latency[i];
+    out << std::endl;
+
+    writeRankRecord(file, out.str());
+}
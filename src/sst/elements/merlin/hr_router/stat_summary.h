@@ -0,0 +1,108 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_HR_ROUTER_STAT_SUMMARY_H
+#define COMPONENTS_MERLIN_HR_ROUTER_STAT_SUMMARY_H
+
+#include <sst/core/sst_types.h>
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+// Writes a per rank record to file (file.<rank> for multi-rank runs),
+// or to the simulation output if file is empty.
+void writeRankRecord(const std::string& file, const std::string& record);
+
+// Fixed size summary of router statistics for all the hr_routers in a
+// rank.  Used instead of the per port statistics when there are too
+// many routers for the statistics engine to keep up.  Data is
+// accumulated per thread, merged when each router finishes, and the
+// last router to finish on the rank writes a single record.
+class RouterStatSummary {
+public:
+    // Port utilization and stall time, in 10% bins
+    static const int fraction_bins = 10;
+    // Hop latency, input to output of one router.  Bin 0 is < 1 ns
+    // and bin i is [2^(i-1), 2^i) ns.  The last bin holds everything
+    // larger.
+    static const int latency_bins = 24;
+
+    static void addRouter() {
+        std::lock_guard<std::mutex> guard(lock);
+        num_routers++;
+    }
+
+    static inline void addHopLatency(SimTime_t ns) {
+        int bin = 0;
+        while ( ns != 0 && bin < latency_bins - 1 ) {
+            ns >>= 1;
+            bin++;
+        }
+        local().hop_latency[bin]++;
+    }
+
+    // utilization and stalled are the fraction of the simulated time
+    // the port was sending or had packets blocked waiting for credits.
+    // vc_stall_cycles is the part of the stall time each VC was
+    // waiting for credits.
+    static void addPort(double utilization, double stalled, uint64_t packets, uint64_t bits, uint64_t stall_cycles,
+                        const std::vector<uint64_t>& vc_stall_cycles);
+    static void addXbarStalls(uint64_t cycles) { local().xbar_stall_cycles += cycles; }
+
+    // Called once by each router after its ports have finished.  The
+    // record is written to file (file.<rank> for multi-rank runs), or
+    // to the simulation output if file is empty.
+    static void routerFinished(const std::string& file);
+
+private:
+    struct Data {
+        uint64_t ports;
+        uint64_t packets;
+        uint64_t bits;
+        uint64_t stall_cycles;
+        uint64_t xbar_stall_cycles;
+        uint64_t utilization[fraction_bins];
+        uint64_t stalled[fraction_bins];
+        uint64_t hop_latency[latency_bins];
+        // Summed over ports, sized to the largest VC count seen
+        std::vector<uint64_t> vc_stall_cycles;
+
+        Data() { clear(); }
+        void clear();
+        void merge(const Data& other);
+    };
+
+    static Data& local() {
+        static thread_local Data data;
+        return data;
+    }
+
+    static void write(const std::string& file);
+
+    static std::mutex lock;
+    static Data total;
+    static int num_routers;
+    static int num_finished;
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_HR_ROUTER_STAT_SUMMARY_H
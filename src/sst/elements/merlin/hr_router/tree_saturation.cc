@@ -0,0 +1,191 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "hr_router/tree_saturation.h"
+
+#include <sst/core/simulation.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <sstream>
+
+#include "merlin.h"
+#include "hr_router/stat_summary.h"
+
+using namespace SST::Merlin;
+
+std::mutex TreeSaturationDetector::lock;
+std::map<int,std::map<uint64_t,TreeSaturationDetector::Episode> > TreeSaturationDetector::episodes;
+SST::SimTime_t TreeSaturationDetector::window_ns = 0;
+double TreeSaturationDetector::threshold = 0.0;
+int TreeSaturationDetector::min_routers = 0;
+int TreeSaturationDetector::num_routers = 0;
+int TreeSaturationDetector::num_finished = 0;
+
+void
+TreeSaturationDetector::Episode::merge(const Episode& other)
+{
+    end = std::max(end, other.end);
+    flits += other.flits;
+    if ( root_router == -1 ) root_router = other.root_router;
+    routers.insert(other.routers.begin(), other.routers.end());
+    for ( auto& w : other.window_routers ) window_routers[w.first] += w.second;
+}
+
+TreeSaturationDetector::TreeSaturationDetector(int router_id, uint64_t window_cycles, double flits_per_cycle) :
+    router_id(router_id),
+    window_cycles(window_cycles == 0 ? 1 : window_cycles),
+    window_index(0),
+    dirty(true)
+{
+    window_end = this->window_cycles;
+    double flits = flits_per_cycle * this->window_cycles;
+    min_flits = flits < 1.0 ? 1 : (flits > UINT32_MAX ? UINT32_MAX : (uint32_t)flits);
+    clear();
+}
+
+void
+TreeSaturationDetector::clear()
+{
+    if ( !dirty ) return;
+    memset(sketch, 0, sizeof(sketch));
+    for ( int i = 0; i < num_candidates; i++ ) {
+        candidates[i].dest = -1;
+        candidates[i].estimate = 0;
+        candidates[i].root = false;
+    }
+    dirty = false;
+}
+
+void
+TreeSaturationDetector::endWindow(Cycle_t cycle)
+{
+    if ( dirty ) {
+        for ( int i = 0; i < num_candidates; i++ ) {
+            const Candidate& c = candidates[i];
+            if ( c.dest == -1 || c.estimate < min_flits ) continue;
+            addDetection(window_index, c.dest, router_id, c.estimate, c.root);
+        }
+        clear();
+    }
+
+    // Routers stop their clocks when idle, so whole windows can go by
+    // between calls
+    window_index = cycle / window_cycles;
+    window_end = (window_index + 1) * window_cycles;
+}
+
+void
+TreeSaturationDetector::addDetection(uint64_t window, int dest, int router, uint64_t flits, bool root)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    Episode detection;
+    detection.end = window;
+    detection.flits = flits;
+    detection.root_router = root ? router : -1;
+    detection.routers.insert(router);
+    detection.window_routers[window] = 1;
+
+    // Absorb the episodes that end right before or start right after
+    // this window.  Episodes never touch each other, so there are at
+    // most two.
+    std::map<uint64_t,Episode>& dest_episodes = episodes[dest];
+    uint64_t start = window;
+    auto next = dest_episodes.upper_bound(window + 1);
+    while ( next != dest_episodes.begin() ) {
+        auto prev = std::prev(next);
+        if ( prev->second.end + 1 < start ) break;
+        start = std::min(start, prev->first);
+        detection.merge(prev->second);
+        dest_episodes.erase(prev);
+    }
+    dest_episodes[start] = std::move(detection);
+}
+
+void
+TreeSaturationDetector::addRouter(SimTime_t window, double flits_per_cycle, int routers)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if ( num_routers != 0 && (window != window_ns || flits_per_cycle != threshold || routers != min_routers) ) {
+        merlin_abort.fatal(CALL_INFO, -1, "hr_router: tree_saturation_window, tree_saturation_threshold and "
+                           "tree_saturation_min_routers must be the same for all routers\n");
+    }
+    window_ns = window;
+    threshold = flits_per_cycle;
+    min_routers = routers;
+    num_routers++;
+}
+
+void
+TreeSaturationDetector::routerFinished(const std::string& file)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    num_finished++;
+    if ( num_finished == num_routers ) write(file);
+}
+
+// Prints a sorted list of router ids with runs collapsed, e.g. 3-8,12
+static std::string routerList(const std::set<int>& routers)
+{
+    std::stringstream out;
+    auto it = routers.begin();
+    while ( it != routers.end() ) {
+        int first = *it;
+        int last = first;
+        while ( ++it != routers.end() && *it == last + 1 ) last++;
+        if ( out.tellp() > 0 ) out << ",";
+        out << first;
+        if ( last != first ) out << "-" << last;
+    }
+    return out.str();
+}
+
+void
+TreeSaturationDetector::write(const std::string& file)
+{
+    const SST::RankInfo& rank = Simulation::getSimulation()->getRank();
+
+    std::stringstream out;
+    out << "merlin tree saturation log: rank " << rank.rank << ", " << num_routers << " routers, window "
+        << window_ns << " ns, threshold " << threshold << " blocked flits/cycle" << std::endl;
+
+    int count = 0;
+    for ( auto& dest : episodes ) {
+        for ( auto& run : dest.second ) {
+            const Episode& episode = run.second;
+            int peak = 0;
+            for ( auto& w : episode.window_routers ) peak = std::max(peak, w.second);
+            if ( peak < min_routers ) continue;
+
+            count++;
+            out << "  episode: dest " << dest.first << ", root router ";
+            if ( episode.root_router == -1 ) out << "unknown";
+            else out << episode.root_router;
+            out << ", " << episode.routers.size() << " routers (peak " << peak << " in one window)" << std::endl;
+            out << "    time: " << run.first * window_ns << "-" << (episode.end + 1) * window_ns << " ns, "
+                << episode.flits << " blocked flit-cycles" << std::endl;
+            out << "    routers: " << routerList(episode.routers) << std::endl;
+        }
+    }
+    out << "  episodes: " << count << std::endl;
+
+    writeRankRecord(file, out.str());
+}
@@ -0,0 +1,159 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_HR_ROUTER_TREE_SATURATION_H
+#define COMPONENTS_MERLIN_HR_ROUTER_TREE_SATURATION_H
+
+#include <sst/core/sst_types.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace SST {
+namespace Merlin {
+
+// Online tree saturation detector for hr_router.
+//
+// Every cycle, the router reports each VC head that cannot cross the
+// crossbar because its output VC is out of space.  The blocked flits
+// are counted per destination in a count-min sketch, and the
+// destinations with the largest estimates are kept in a small
+// candidate table.  At the end of each window, any candidate whose
+// estimate is at least threshold blocked flits per cycle is logged as
+// a detection for this router.
+//
+// Detections are merged into episodes as they are logged: runs of
+// consecutive windows in which the same destination was detected.
+// Routers close their windows at different times, so a detection can
+// also join two episodes.  The last router on the rank to finish
+// writes out the episodes that covered at least min_routers routers
+// in one window, with the root router and the affected routers.
+class TreeSaturationDetector {
+public:
+    static const int sketch_depth = 4;
+    static const int sketch_bits = 8;
+    static const int sketch_width = 1 << sketch_bits;
+    static const int num_candidates = 8;
+
+    TreeSaturationDetector(int router_id, uint64_t window_cycles, double flits_per_cycle);
+
+    // Called for a VC head that is blocked this cycle.  to_host is
+    // true if the head is waiting on a host port, which makes this
+    // router the root of the tree.
+    inline void addBlocked(int dest, int flits, bool to_host) {
+        uint32_t estimate = UINT32_MAX;
+        for ( int i = 0; i < sketch_depth; i++ ) {
+            uint32_t& count = sketch[i][hash(dest, i)];
+            count += flits;
+            if ( count < estimate ) estimate = count;
+        }
+        dirty = true;
+
+        int slot = -1;
+        int min_slot = 0;
+        for ( int i = 0; i < num_candidates; i++ ) {
+            if ( candidates[i].dest == dest ) {
+                slot = i;
+                break;
+            }
+            if ( candidates[i].estimate < candidates[min_slot].estimate ) min_slot = i;
+        }
+        if ( slot == -1 ) {
+            if ( estimate <= candidates[min_slot].estimate ) return;
+            slot = min_slot;
+            candidates[slot].dest = dest;
+            candidates[slot].root = false;
+        }
+        candidates[slot].estimate = estimate;
+        candidates[slot].root |= to_host;
+    }
+
+    // Closes the current window once cycle is past it
+    inline void tick(Cycle_t cycle) {
+        if ( cycle >= window_end ) endWindow(cycle);
+    }
+
+    // Closes the last window.  Called from the router's finish().
+    void finish(Cycle_t cycle) { endWindow(cycle); }
+
+    // Called once by each router that uses a detector.  The window
+    // length, threshold and min_routers are only used for the log and
+    // must be the same for all routers; anything else is fatal.
+    static void addRouter(SimTime_t window_ns, double threshold, int min_routers);
+
+    // Called once by each router at the end of simulation.  The last
+    // router on the rank writes the log to file (file.<rank> for
+    // multi-rank runs), or to the simulation output if file is empty.
+    static void routerFinished(const std::string& file);
+
+private:
+    struct Candidate {
+        int dest;
+        uint32_t estimate;
+        bool root;
+    };
+
+    struct Episode {
+        uint64_t end;
+        uint64_t flits;
+        int root_router;
+        std::set<int> routers;
+        // Number of routers that detected the destination in each window
+        std::map<uint64_t,int> window_routers;
+
+        void merge(const Episode& other);
+    };
+
+    int router_id;
+    uint64_t window_cycles;
+    uint64_t window_index;
+    Cycle_t window_end;
+    uint32_t min_flits;
+
+    bool dirty;
+    uint32_t sketch[sketch_depth][sketch_width];
+    Candidate candidates[num_candidates];
+
+    static inline int hash(int dest, int row) {
+        static const uint64_t seeds[sketch_depth] = {
+            0x9e3779b97f4a7c15ULL, 0xc2b2ae3d27d4eb4fULL, 0x165667b19e3779f9ULL, 0xff51afd7ed558ccdULL
+        };
+        return ((uint64_t)(uint32_t)dest + 1) * seeds[row] >> (64 - sketch_bits);
+    }
+
+    void clear();
+    void endWindow(Cycle_t cycle);
+
+    static void addDetection(uint64_t window, int dest, int router, uint64_t flits, bool root);
+    static void write(const std::string& file);
+
+    static std::mutex lock;
+    // Episodes for each destination, keyed by first window
+    static std::map<int,std::map<uint64_t,Episode> > episodes;
+    static SimTime_t window_ns;
+    static double threshold;
+    static int min_routers;
+    static int num_routers;
+    static int num_finished;
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_HR_ROUTER_TREE_SATURATION_H
@@ -22,6 +22,7 @@
 #include <sst/core/link.h>
 #include <sst/core/timeConverter.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "sst/elements/merlin/router.h"
@@ -50,21 +51,25 @@ private:
     int rr_port_shadow;
 #endif
 
-    typedef std::pair<uint16_t,uint16_t> priority_entry_t;
-    priority_entry_t* priority[2];
-    priority_entry_t* cur_list;
-    priority_entry_t* next_list;
+    // LRU order is kept as a priority key for each (port,vc) entry.
+    // Smaller keys are older and get first pick.  Entries that win
+    // arbitration get new keys larger than all others, in reverse
+    // order of winning, which is the same as moving them to the bottom
+    // of a priority list.  Entries that don't win keep their order.
+    std::vector<uint64_t> priority;
+    uint64_t next_priority;
 
-    int total_entries;
+    const ActiveVCSet* active_vcs;
 
-    internal_router_event** vc_heads;
-
-    // PortControl** ports;
+    // Scratch space reused every cycle
+    std::vector<std::pair<uint64_t,int> > candidates;
+    std::vector<int> granted;
 
 public:
 
     xbar_arb_lru(ComponentId_t cid, Params& param) :
-        XbarArbitration(cid)
+        XbarArbitration(cid),
+        active_vcs(NULL)
     {
     }
 
@@ -75,22 +80,21 @@ public:
         num_ports = num_ports_s;
         num_vcs = num_vcs_s;
 
-        total_entries = num_ports * num_vcs;
-
-        priority[0] = new priority_entry_t[total_entries];
-        priority[1] = new priority_entry_t[total_entries];
-        cur_list = priority[0];
-        next_list = priority[1];
+        int total_entries = num_ports * num_vcs;
 
-        int index = 0;
-        for ( int i = 0; i < num_ports; i++ ) {
-            for ( int j = 0; j < num_vcs; j++ ) {
-                cur_list[index++] = priority_entry_t(i,j);
-            }
+        // Initial order is by port, then VC
+        priority.resize(total_entries);
+        for ( int i = 0; i < total_entries; i++ ) {
+            priority[i] = i;
         }
+        next_priority = total_entries;
 
+        candidates.reserve(total_entries);
+        granted.reserve(num_ports);
+    }
 
-        vc_heads = new internal_router_event*[num_vcs];
+    void setActiveVCs(const ActiveVCSet* active) {
+        active_vcs = active;
     }
 
     // Naming convention is from point of view of the xbar.  So,
@@ -107,89 +111,55 @@ public:
 
         for ( int i = 0; i < num_ports; i++ ) progress_vc[i] = -1;
 
-        // std::cout << "---------" << std::endl;
-        // for ( int i = 0; i < total_entries; i++ ) {
-        //     std::cout << priority[cur_list][i].first << ", " << priority[cur_list][i].second << std::endl;
-        // }
-        // std::cout << "---------" << std::endl;
-
-        // Run through the priority list
-        // for ( priority_list_t::iterator it = priority.begin(); it != priority.end(); ) {
-        // int sat_index = total_entries - 1;
-        // int unsat_index = 0;
+        // Only occupied VCs can make progress, so only those need to be
+        // put in priority order
+        candidates.clear();
+        active_vcs->forEach([this](int port, int vc) {
+                int index = port * num_vcs + vc;
+                candidates.push_back(std::make_pair(priority[index], index));
+            });
+        std::sort(candidates.begin(), candidates.end());
 
-        priority_entry_t* sat_list = &next_list[total_entries-1];
-        priority_entry_t* unsat_list = next_list;
+        granted.clear();
+        for ( size_t i = 0; i < candidates.size(); i++ ) {
+            int index = candidates[i].second;
+            int port = index / num_vcs;
+            int vc = index % num_vcs;
 
-        for ( int i = 0; i < total_entries; i++ ) {
+            // if the output of this port is busy, nothing to do.
+            if ( in_port_busy[port] > 0 ) continue;
 
-            // const priority_entry_t& check = priority[cur_list][i];
-            const priority_entry_t& check = cur_list[i];
+            internal_router_event* src_event = ports[port]->getVCHeads()[vc];
 
-            /* std::cout << check.first << ", " << check.second << std::endl; */
+            // Have an event, see if it can be progressed
+            int next_port = src_event->getNextPort();
+            int next_vc = src_event->getVC();
 
-            int port = check.first;
-            int vc = check.second;
+            // We can progress if the next port's input is not
+            // busy and there are enough credits.
+            if ( out_port_busy[next_port] <= 0 &&
+                 ports[next_port]->spaceToSend(next_vc, src_event->getFlitCount()) ) {
 
-            // std::cout << check.first << ", " << check.second << std::endl;
+                // Tell the router what to move
+                progress_vc[port] = vc;
 
-            vc_heads = ports[port]->getVCHeads();
+                // Need to set the busy values
+                in_port_busy[port] = src_event->getFlitCount();
+                out_port_busy[next_port] = src_event->getFlitCount();
 
-            // if the output of this port is busy or if there is no
-            // event to be processed, nothing to do.
-            internal_router_event* src_event = vc_heads[vc];
-            if ( in_port_busy[port] <= 0 && src_event != NULL) {
-                // Have an event, see if it can be progressed
-                int next_port = src_event->getNextPort();
-                int next_vc = src_event->getVC();
-
-                // We can progress if the next port's input is not
-                // busy and there are enough credits.
-                if ( out_port_busy[next_port] <= 0 &&
-                     ports[next_port]->spaceToSend(next_vc, src_event->getFlitCount()) ) {
-
-                    // Tell the router what to move
-                    progress_vc[port] = vc;
-
-                    // Need to set the busy values
-                    in_port_busy[port] = src_event->getFlitCount();
-                    out_port_busy[next_port] = src_event->getFlitCount();
-
-
-                    // Copy data to new list
-                    // std::cout << "putting at bottom of list" << std::endl;
-                    // next_list[sat_index--] = check;
-                    *sat_list = check;
-                    --sat_list;
-                }
-                else {
-                    // std::cout << "putting at top of list" << std::endl;
-                    // next_list[unsat_index++] = check;
-                    *unsat_list = check;
-                    ++unsat_list;
-                    progress_vc[port] = -2;
-                }
+                granted.push_back(index);
             }
             else {
-                // std::cout << "putting at top of list" << std::endl;
-                // next_list[unsat_index++] = check;
-                *unsat_list = check;
-                ++unsat_list;
+                progress_vc[port] = -2;
             }
         }
 
-        // std::cout << "+++++++++" << std::endl;
-        // for ( int i = 0; i < total_entries; i++ ) {
-        //     std::cout << priority[next_list][i].first << ", " << priority[cur_list][i].second << std::endl;
-        // }
-        // std::cout << "+++++++++" << std::endl;
-
-        // cur_list ^= next_list;
-        // next_list ^= cur_list;
-        // cur_list ^= next_list;
-        priority_entry_t* tmp = cur_list;
-        cur_list = next_list;
-        next_list = tmp;
+        // Move the winners to the bottom of the priority order
+        int num_granted = granted.size();
+        for ( int i = 0; i < num_granted; i++ ) {
+            priority[granted[i]] = next_priority + (num_granted - 1 - i);
+        }
+        next_priority += num_granted;
         return;
     }
 
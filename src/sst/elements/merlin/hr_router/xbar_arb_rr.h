@@ -57,13 +57,14 @@ private:
 
     internal_router_event** vc_heads;
 
-    // PortControl** ports;
+    const ActiveVCSet* active_vcs;
 
 public:
 
     xbar_arb_rr(ComponentId_t cid, Params& params) :
         XbarArbitration(cid),
-        rr_vcs(NULL)
+        rr_vcs(NULL),
+        active_vcs(NULL)
     {
     }
 
@@ -84,7 +85,10 @@ public:
 #if VERIFY_DECLOCKING
         rr_port_shadow = 0;
 #endif
-        vc_heads = new internal_router_event*[num_vcs];
+    }
+
+    void setActiveVCs(const ActiveVCSet* active) {
+        active_vcs = active;
     }
 
     // Naming convention is from point of view of the xbar.  So,
@@ -111,34 +115,36 @@ public:
                 continue;
             }
 
-            // See what we should progress for this port
-            // for ( int vc = rr_vcs[port], vcount = 0; vcount < num_vcs; vc = (vc+1) % num_vcs, vcount++ ) {
-            for ( int vc = rr_vcs[port], vcount = 0; vcount < num_vcs; vc = ((vc != num_vcs-1) ? (vc+1) : 0), vcount++ ) {
+            // See what we should progress for this port.  Only occupied
+            // VCs are visited, starting at rr_vcs[port] and wrapping.
+            int vc = active_vcs->nextInPortWrap(port, rr_vcs[port]);
+            for ( int first_vc = vc; vc != -1; ) {
 
-                // If there is no event, move to next VC
                 internal_router_event* src_event = vc_heads[vc];
-                if ( src_event == NULL ) continue;
 
                 // Have an event, see if it can be progressed
                 int next_port = src_event->getNextPort();
 
-                // We can progress if the next port's input is not
-                // busy and there are enough credits.
-                if ( out_port_busy[next_port] > 0 ) continue;
-
                 // Need to see if the VC has enough credits
                 int next_vc = src_event->getVC();
 
-                // See if there is enough space
-                if ( !ports[next_port]->spaceToSend(next_vc, src_event->getFlitCount()) ) continue;
-
-                // Tell the router what to move
-                progress_vc[port] = vc;
-
-                // Need to set the busy values
-                in_port_busy[port] = src_event->getFlitCount();
-                out_port_busy[next_port] = src_event->getFlitCount();
-                break;  // Go to next port;
+                // We can progress if the next port's input is not
+                // busy and there is enough space.
+                if ( out_port_busy[next_port] <= 0 &&
+                     ports[next_port]->spaceToSend(next_vc, src_event->getFlitCount()) ) {
+
+                    // Tell the router what to move
+                    progress_vc[port] = vc;
+
+                    // Need to set the busy values
+                    in_port_busy[port] = src_event->getFlitCount();
+                    out_port_busy[next_port] = src_event->getFlitCount();
+                    break;  // Go to next port;
+                }
+
+                // Move to the next occupied VC
+                vc = active_vcs->nextInPortWrap(port, vc + 1);
+                if ( vc == first_vc ) break;
             }
             // Increemnt rr_vcs for next time
             rr_vcs[port] = (rr_vcs[port] + 1) % num_vcs;
@@ -0,0 +1,223 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "linkUtilization.h"
+
+#include <sst/core/unitAlgebra.h>
+
+#include <string.h>
+
+namespace SST {
+namespace Merlin {
+
+FILE* LinkUtilizationInspector::file = NULL;
+int LinkUtilizationInspector::file_refs = 0;
+SimTime_t LinkUtilizationInspector::file_window = 0;
+SST::Core::ThreadSafe::Spinlock LinkUtilizationInspector::file_lock;
+
+// Number of records to collect before writing them to the file
+#define LINK_UTIL_BUFFERED_RECORDS 1024
+
+LinkUtilizationInspector::LinkUtilizationInspector(ComponentId_t id, Params& params, const std::string& sub_id) :
+    SimpleNetwork::NetworkInspector(id),
+    router(-1),
+    port(-1)
+{
+    ps_tc = getTimeConverter("1ps");
+
+    UnitAlgebra window_ua = params.find<UnitAlgebra>("window", "1us");
+    if ( !window_ua.hasUnits("s") ) {
+        getSimulationOutput().fatal(CALL_INFO, -1, "LinkUtilizationInspector: window must be specified in s: %s\n",
+                                    window_ua.toStringBestSI().c_str());
+    }
+    window = (window_ua / UnitAlgebra("1ps")).getRoundedValue();
+    if ( window == 0 ) {
+        getSimulationOutput().fatal(CALL_INFO, -1, "LinkUtilizationInspector: window must be at least 1ps\n");
+    }
+    window_end = window;
+
+    std::string file_name = params.find<std::string>("output_file", "link_utilization.bin");
+    if ( Simulation::getSimulation()->getNumRanks().rank > 1 ) {
+        file_name = file_name + "-" + std::to_string(Simulation::getSimulation()->getRank().rank);
+    }
+
+    file_lock.lock();
+    if ( file == NULL ) {
+        file = fopen(file_name.c_str(), "wb");
+        if ( file == NULL ) {
+            file_lock.unlock();
+            getSimulationOutput().fatal(CALL_INFO, -1, "LinkUtilizationInspector: unable to open %s\n", file_name.c_str());
+        }
+        LinkUtilHeader header;
+        memcpy(header.magic, "MRLNUTIL", 8);
+        header.version = 1;
+        header.record_size = sizeof(LinkUtilRecord);
+        header.window = window;
+        fwrite(&header, sizeof(header), 1, file);
+        file_window = window;
+    }
+    else if ( file_window != window ) {
+        file_lock.unlock();
+        getSimulationOutput().fatal(CALL_INFO, -1, "LinkUtilizationInspector: all inspectors must use the same window\n");
+    }
+    file_refs++;
+    file_lock.unlock();
+}
+
+LinkUtilizationInspector::~LinkUtilizationInspector()
+{
+    file_lock.lock();
+    if ( --file_refs == 0 && file != NULL ) {
+        fclose(file);
+        file = NULL;
+    }
+    file_lock.unlock();
+}
+
+void
+LinkUtilizationInspector::initPort(int router_id, int port_number, int num_vcs)
+{
+    router = router_id;
+    port = port_number;
+
+    vc_state_t init;
+    memset(&init, 0, sizeof(init));
+    vcs.resize(num_vcs, init);
+}
+
+void
+LinkUtilizationInspector::inspectNetworkData(SimpleNetwork::Request* req)
+{
+    // All data comes in through the router side instrumentation,
+    // which knows the VC the packet was sent on
+}
+
+void
+LinkUtilizationInspector::packetSent(int vc, uint64_t bits)
+{
+    advance(getCurrentSimTime(ps_tc));
+    vcs[vc].bytes += bits / 8;
+}
+
+void
+LinkUtilizationInspector::queueChange(int vc, int flits)
+{
+    SimTime_t now = getCurrentSimTime(ps_tc);
+    advance(now);
+    vc_state_t& state = vcs[vc];
+    integrate(state, now);
+    state.occupancy += flits;
+    if ( state.occupancy > (int)state.max_occupancy ) state.max_occupancy = state.occupancy;
+}
+
+void
+LinkUtilizationInspector::setStalled(int vc, bool stalled)
+{
+    vc_state_t& state = vcs[vc];
+    if ( state.stalled == stalled ) return;
+    SimTime_t now = getCurrentSimTime(ps_tc);
+    advance(now);
+    integrate(state, now);
+    state.stalled = stalled;
+}
+
+void
+LinkUtilizationInspector::integrate(vc_state_t& state, SimTime_t now)
+{
+    SimTime_t elapsed = now - state.since;
+    if ( state.stalled ) state.stall_time += elapsed;
+    state.occupancy_time += (uint64_t)state.occupancy * elapsed;
+    state.since = now;
+}
+
+void
+LinkUtilizationInspector::advance(SimTime_t now)
+{
+    while ( now >= window_end ) {
+        closeWindow(window_end);
+
+        // Skip over windows where nothing happened
+        bool quiet = true;
+        for ( size_t i = 0; i < vcs.size(); i++ ) {
+            if ( vcs[i].occupancy != 0 || vcs[i].stalled ) {
+                quiet = false;
+                break;
+            }
+        }
+        if ( quiet ) {
+            window_end = (now / window + 1) * window;
+            for ( size_t i = 0; i < vcs.size(); i++ ) vcs[i].since = window_end - window;
+        }
+        else {
+            window_end += window;
+        }
+    }
+}
+
+void
+LinkUtilizationInspector::closeWindow(SimTime_t end)
+{
+    SimTime_t start = window_end - window;
+    for ( size_t i = 0; i < vcs.size(); i++ ) {
+        vc_state_t& state = vcs[i];
+        integrate(state, end);
+
+        if ( state.bytes != 0 || state.stall_time != 0 || state.occupancy_time != 0 || state.max_occupancy != 0 ) {
+            LinkUtilRecord rec;
+            rec.window_start = start;
+            rec.router = router;
+            rec.port = port;
+            rec.vc = i;
+            rec.bytes = state.bytes;
+            rec.stall_time = state.stall_time;
+            rec.avg_occupancy = end > start ? (float)state.occupancy_time / (end - start) : state.occupancy;
+            rec.max_occupancy = state.max_occupancy;
+            records.push_back(rec);
+        }
+
+        state.bytes = 0;
+        state.stall_time = 0;
+        state.occupancy_time = 0;
+        state.max_occupancy = state.occupancy;
+    }
+    if ( records.size() >= LINK_UTIL_BUFFERED_RECORDS ) flushRecords();
+}
+
+void
+LinkUtilizationInspector::flushRecords()
+{
+    if ( records.empty() ) return;
+    file_lock.lock();
+    fwrite(records.data(), sizeof(LinkUtilRecord), records.size(), file);
+    file_lock.unlock();
+    records.clear();
+}
+
+void
+LinkUtilizationInspector::finish()
+{
+    // Close out the partial window the simulation ended in
+    if ( !vcs.empty() ) {
+        SimTime_t now = getCurrentSimTime(ps_tc);
+        advance(now);
+        closeWindow(now);
+    }
+    flushRecords();
+}
+
+} // namespace Merlin
+} // namespace SST
@@ -0,0 +1,126 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_MERLIN_LINKUTILIZATION_H
+#define COMPONENTS_MERLIN_LINKUTILIZATION_H
+
+#include <sst/core/subcomponent.h>
+#include <sst/core/interfaces/simpleNetwork.h>
+#include <sst/core/threadsafe.h>
+#include <sst/core/timeConverter.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+namespace SST {
+using namespace SST::Interfaces;
+namespace Merlin {
+
+// Binary output of LinkUtilizationInspector.  All ports in a rank
+// write into the same file, in native byte order:
+//
+//   header:  LinkUtilHeader
+//   records: LinkUtilRecord, appended as windows close
+//
+// A record is only written for a port/VC that had any traffic, stall
+// or queued data in the window.  merlin/inspectors/link_util_to_csv.py
+// converts the file to CSV.
+struct LinkUtilHeader {
+    char magic[8];            // "MRLNUTIL"
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t window;          // Window length in ps
+};
+
+struct LinkUtilRecord {
+    uint64_t window_start;    // ps
+    uint32_t router;
+    uint16_t port;
+    uint16_t vc;
+    uint64_t bytes;           // Bytes sent
+    uint64_t stall_time;      // ps the VC had a packet but not enough credits to send it
+    float avg_occupancy;      // Time averaged output queue occupancy in flits
+    uint32_t max_occupancy;   // Maximum output queue occupancy in flits
+};
+
+class LinkUtilizationInspector : public SimpleNetwork::NetworkInspector {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        LinkUtilizationInspector,
+        "merlin",
+        "link_utilization_inspector",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Records per port, per VC bytes sent, credit stall time and output queue occupancy in fixed time windows to a binary file.  Load through hr_router's network_inspectors parameter and set its params on hr_router as portcontrol:inspector:<param>.",
+        SST::Interfaces::SimpleNetwork::NetworkInspector)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"output_file", "Name of the output file.  When running on more than one rank, -<rank> is appended.", "link_utilization.bin"},
+        {"window",      "Length of the time windows.  All inspectors in a simulation must use the same window.", "1us"}
+    )
+
+private:
+    struct vc_state_t {
+        uint64_t bytes;
+        SimTime_t stall_time;
+        // Integral of occupancy over time, in flit-ps
+        uint64_t occupancy_time;
+        uint32_t max_occupancy;
+        int occupancy;
+        bool stalled;
+        // Time the state was last integrated
+        SimTime_t since;
+    };
+
+    TimeConverter* ps_tc;
+    SimTime_t window;
+    SimTime_t window_end;
+
+    int router;
+    int port;
+    std::vector<vc_state_t> vcs;
+
+    std::vector<LinkUtilRecord> records;
+
+    void integrate(vc_state_t& state, SimTime_t now);
+    void advance(SimTime_t now);
+    void closeWindow(SimTime_t end);
+    void flushRecords();
+
+    // File shared by all the inspectors in the rank
+    static FILE* file;
+    static int file_refs;
+    static SimTime_t file_window;
+    static SST::Core::ThreadSafe::Spinlock file_lock;
+
+public:
+    LinkUtilizationInspector(ComponentId_t id, Params& params, const std::string& sub_id);
+    ~LinkUtilizationInspector();
+
+    void inspectNetworkData(SimpleNetwork::Request* req);
+    void finish();
+
+    // Router side instrumentation.  Called by PortControl.
+    void initPort(int router_id, int port_number, int num_vcs);
+    void packetSent(int vc, uint64_t bits);
+    void queueChange(int vc, int flits);
+    void setStalled(int vc, bool stalled);
+};
+
+} // namespace Merlin
+} // namespace SST
+#endif
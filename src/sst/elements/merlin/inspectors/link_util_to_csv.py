@@ -0,0 +1,84 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Converts the binary output of merlin.link_utilization_inspector to
+# CSV.  By default prints one line per record.  With --top N, prints
+# the N router ports with the most credit stall time, summed over VCs
+# and windows, which is usually enough to find the congested links.
+#
+# Usage: link_util_to_csv.py [-o out.csv] [--top N] file [file ...]
+#   Multiple files (one per rank) can be given and are merged.
+
+import argparse
+import struct
+import sys
+
+HEADER = struct.Struct("=8sIIQ")
+RECORD = struct.Struct("=QIHHQQfI")
+MAGIC = b"MRLNUTIL"
+
+def read_records(name):
+    with open(name, "rb") as f:
+        data = f.read()
+    if len(data) < HEADER.size:
+        sys.exit("%s: file too short"%name)
+    (magic, version, record_size, window) = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        sys.exit("%s: not a link utilization file"%name)
+    if version != 1 or record_size != RECORD.size:
+        sys.exit("%s: unsupported version %d (record size %d)"%(name, version, record_size))
+    records = []
+    # A truncated final record is ignored
+    for offset in range(HEADER.size, len(data) - RECORD.size + 1, RECORD.size):
+        records.append(RECORD.unpack_from(data, offset))
+    return (window, records)
+
+parser = argparse.ArgumentParser(description="Convert merlin link utilization files to CSV")
+parser.add_argument("files", nargs="+")
+parser.add_argument("-o", "--output", help="Write to file instead of stdout")
+parser.add_argument("--top", type=int, default=0, help="Only print the N ports with the most stall time")
+args = parser.parse_args()
+
+window = None
+records = []
+for name in args.files:
+    (w, r) = read_records(name)
+    if window is not None and w != window:
+        sys.exit("%s: window does not match the other files"%name)
+    window = w
+    records.extend(r)
+
+out = open(args.output, "w") if args.output else sys.stdout
+
+if args.top > 0:
+    ports = {}
+    for (start, router, port, vc, nbytes, stall, avg_occ, max_occ) in records:
+        entry = ports.setdefault((router, port), [0, 0, 0])
+        entry[0] += nbytes
+        entry[1] += stall
+        entry[2] = max(entry[2], max_occ)
+    out.write("router,port,bytes,stall_ps,max_occupancy\n")
+    ranked = sorted(ports.items(), key=lambda x: x[1][1], reverse=True)
+    for ((router, port), (nbytes, stall, max_occ)) in ranked[:args.top]:
+        out.write("%d,%d,%d,%d,%d\n"%(router, port, nbytes, stall, max_occ))
+else:
+    out.write("window_start_ps,router,port,vc,bytes,bandwidth_GBps,stall_ps,stall_fraction,avg_occupancy,max_occupancy\n")
+    records.sort(key=lambda r: (r[0], r[1], r[2], r[3]))
+    for (start, router, port, vc, nbytes, stall, avg_occ, max_occ) in records:
+        # bytes per ps * 1000 = GB/s
+        out.write("%d,%d,%d,%d,%d,%.3f,%d,%.4f,%.2f,%d\n"%(start, router, port, vc, nbytes,
+                                                           1000.0 * nbytes / window, stall,
+                                                           float(stall) / window, avg_occ, max_occ))
+
+if args.output:
+    out.close()
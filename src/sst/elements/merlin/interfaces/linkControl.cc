@@ -21,6 +21,9 @@
 #include <sst/core/simulation.h>
 #include <sst/core/sharedRegion.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include "merlin.h"
 
 namespace SST {
@@ -30,7 +33,9 @@ namespace Merlin {
 
 LinkControl::LinkControl(ComponentId_t cid, Params &params, int vns) :
     SST::Interfaces::SimpleNetwork(cid),
-    rtr_link(nullptr), output_timing(nullptr),
+    rtr_link(nullptr), output_timing(nullptr), cc_timing(nullptr),
+    flit_cycle(nullptr), cc_enable(false), cc_timer_armed(false),
+    throttle_active(false), throttle_start(0),
     req_vns(vns), used_vns(0), total_vns(0), vn_out_map(nullptr),
     vn_remap_out(nullptr), output_queues(nullptr), router_credits(nullptr),
     router_return_credits(nullptr), input_queues(nullptr),
@@ -140,12 +145,47 @@ LinkControl::LinkControl(ComponentId_t cid, Params &params, int vns) :
     }
 
 
+    // Congestion control
+    cc_enable = params.find<bool>("cc_enable",false);
+    if ( cc_enable ) {
+        params.find_array<int>("cc_vns",cc_vns);
+        for ( int vn : cc_vns ) {
+            if ( vn < 0 || vn >= req_vns ) {
+                merlin_abort.fatal(CALL_INFO,1,"LinkControl: cc_vns entry %d is out of range\n",vn);
+            }
+        }
+        cc_g = params.find<double>("cc_g",0.0625);
+        cc_min_rate = params.find<double>("cc_min_rate",0.01);
+        cc_rate_ai = params.find<double>("cc_rate_ai",0.05);
+        cc_recovery_steps = params.find<int>("cc_recovery_steps",5);
+        if ( cc_g <= 0.0 || cc_g > 1.0 ) {
+            merlin_abort.fatal(CALL_INFO,1,"LinkControl: cc_g must be in (0,1]\n");
+        }
+        if ( cc_min_rate <= 0.0 || cc_min_rate > 1.0 ) {
+            merlin_abort.fatal(CALL_INFO,1,"LinkControl: cc_min_rate must be in (0,1]\n");
+        }
+
+        std::string update_interval = params.find<std::string>("cc_update_interval","5us");
+        cc_timing = configureSelfLink(port_name + "_cc_timing", update_interval,
+                new Event::Handler<LinkControl>(this,&LinkControl::handle_cc_timer));
+
+        UnitAlgebra interval = params.find<UnitAlgebra>("cnp_interval","2us");
+        if ( !interval.hasUnits("s") ) {
+            merlin_abort.fatal(CALL_INFO,1,"LinkControl: cnp_interval must be specified in units of s\n");
+        }
+        cnp_interval = getTimeConverter(interval)->getFactor();
+    }
+
     
     // Register statistics
     packet_latency = registerStatistic<uint64_t>("packet_latency");
     send_bit_count = registerStatistic<uint64_t>("send_bit_count");
     output_port_stalls = registerStatistic<uint64_t>("output_port_stalls");
     idle_time = registerStatistic<uint64_t>("idle_time");
+    ecn_marked_packets = registerStatistic<uint64_t>("ecn_marked_packets");
+    cnp_sent = registerStatistic<uint64_t>("cnp_sent");
+    cnp_received = registerStatistic<uint64_t>("cnp_received");
+    throttle_time = registerStatistic<uint64_t>("throttle_time");
 }
 
 LinkControl::~LinkControl()
@@ -209,6 +249,7 @@ void LinkControl::init(unsigned int phase)
         UnitAlgebra link_clock = link_bw / flit_size_ua;
         TimeConverter* tc = getTimeConverter(link_clock);
         output_timing->setDefaultTimeBase(tc);
+        flit_cycle = tc;
         
         // Initialize links
         // Receive the endpoint ID from PortControl
@@ -298,6 +339,7 @@ void LinkControl::init(unsigned int phase)
         // Instance the output queues        
         int count = 0;
         vn_remap_out = new output_queue_bundle_t*[req_vns];
+        for ( int i = 0; i < req_vns; ++i ) vn_remap_out[i] = nullptr;
         output_queues = new output_queue_bundle_t[used_vns];
         for ( int i = 0; i < total_vns; ++i ) {
             if ( vn_count[i] > 0 ) {
@@ -314,6 +356,16 @@ void LinkControl::init(unsigned int phase)
             }
         }
 
+        // Mark the queues that are rate limited
+        if ( cc_enable ) {
+            for ( int i = 0; i < req_vns; ++i ) {
+                if ( vn_remap_out[i] == nullptr ) continue;
+                if ( cc_vns.empty() || std::find(cc_vns.begin(), cc_vns.end(), i) != cc_vns.end() ) {
+                    vn_remap_out[i]->cc = true;
+                }
+            }
+        }
+
         // Don't need this map anymore
         delete[] vn_out_map;
 
@@ -407,6 +459,10 @@ void LinkControl::finish(void)
             output_queues[i].queue.pop();
         }
     }
+    while ( !cnp_queue.empty() ) {
+        delete cnp_queue.front();
+        cnp_queue.pop();
+    }
 }
 
 
@@ -554,6 +610,22 @@ void LinkControl::handle_input(Event* ev)
         int vn = event->getLogicalVN();
         // event->request->vn = orig_vn;
 
+        // CNPs are consumed here, so return the credits right away
+        if ( event->isCNP() ) {
+            cnp_received->addData(1);
+            rtr_link->send(1,new credit_event(event->getRouteVN(),event->getSizeInFlits()));
+            if ( cc_enable && vn < req_vns && vn_remap_out[vn] != nullptr && vn_remap_out[vn]->cc ) {
+                reduceRate(vn_remap_out[vn]);
+            }
+            delete event;
+            return;
+        }
+
+        if ( event->getECN() ) {
+            ecn_marked_packets->addData(1);
+            if ( cc_enable ) sendCNP(event);
+        }
+
         input_queues[vn].push(event);
         if (is_idle) {
             idle_time->addData(Simulation::getSimulation()->getCurrentSimCycle() - idle_start);
@@ -592,12 +664,45 @@ void LinkControl::handle_output(Event* ev)
     bool found = false;
     RtrEvent* send_event = nullptr;
     have_packets = false;
+
+    // CNPs go out ahead of everything else
+    if ( !cnp_queue.empty() ) {
+        RtrEvent* cnp = cnp_queue.front();
+        int size = cnp->getSizeInFlits();
+        if ( router_credits[cnp->getRouteVN()] >= size ) {
+            cnp_queue.pop();
+            router_credits[cnp->getRouteVN()] -= size;
+            cnp->setInjectionTime(getCurrentSimTimeNano());
+            output_timing->send(size,nullptr);
+            if (is_idle){
+                idle_time->addData(Simulation::getSimulation()->getCurrentSimCycle() - idle_start);
+                is_idle = false;
+            }
+            rtr_link->send(cnp);
+            cnp_sent->addData(1);
+            return;
+        }
+        have_packets = true;
+    }
+
+    // With congestion control on, queues are skipped until their
+    // next allowed send time.  Times are in flit cycles.
+    double now = 0;
+    double next_allowed = 0;
+    bool throttled = false;
+    if ( cc_enable ) now = getCurrentSimTime(flit_cycle);
+
     for ( int i = curr_out_vn; i < used_vns; i++ ) {
         if ( output_queues[i].queue.empty() ) continue;
         have_packets = true;
         send_event = output_queues[i].queue.front();
         // Check to see if the needed VN has enough space
         if ( router_credits[output_queues[i].vn] < send_event->getSizeInFlits() ) continue;
+        if ( output_queues[i].cc && output_queues[i].next_send > now ) {
+            if ( !throttled || output_queues[i].next_send < next_allowed ) next_allowed = output_queues[i].next_send;
+            throttled = true;
+            continue;
+        }
         vn_to_send = i;
         output_queues[i].queue.pop();
         found = true;
@@ -611,6 +716,11 @@ void LinkControl::handle_output(Event* ev)
             send_event = output_queues[i].queue.front();
             // Check to see if the needed VN has enough space
             if ( router_credits[output_queues[i].vn] < send_event->getSizeInFlits() ) continue;
+            if ( output_queues[i].cc && output_queues[i].next_send > now ) {
+                if ( !throttled || output_queues[i].next_send < next_allowed ) next_allowed = output_queues[i].next_send;
+                throttled = true;
+                continue;
+            }
             vn_to_send = i;
             output_queues[i].queue.pop();
             found = true;
@@ -619,6 +729,11 @@ void LinkControl::handle_output(Event* ev)
     }
     // If we found an event to send, go ahead and send it
     if ( found ) {
+        if ( throttle_active ) {
+            throttle_time->addData(Simulation::getSimulation()->getCurrentSimCycle() - throttle_start);
+            throttle_active = false;
+        }
+
         // Need to return credits to the output buffer
         int size = send_event->getSizeInFlits();
         // outbuf_credits[vn_to_send] += size;
@@ -626,6 +741,12 @@ void LinkControl::handle_output(Event* ev)
 
         // Send an event to wake up again after this packet is sent.
         output_timing->send(size,nullptr);
+
+        // Space out the packets on this queue to match its rate
+        output_queue_bundle_t& bundle = output_queues[vn_to_send];
+        if ( bundle.cc ) {
+            bundle.next_send = std::max(bundle.next_send, now) + size / bundle.rate;
+        }
         
         curr_out_vn = vn_to_send + 1;
         if ( curr_out_vn == used_vns ) curr_out_vn = 0;
@@ -659,6 +780,20 @@ void LinkControl::handle_output(Event* ev)
             if ( !keep ) sendFunctor = nullptr;
         }
     }
+    else if ( throttled ) {
+        // Something could have been sent if not for the rate limit,
+        // so wake up when the first queue is allowed to send again
+        SimTime_t delay = std::max(1.0, std::ceil(next_allowed - now));
+        output_timing->send(delay,nullptr);
+        if ( !throttle_active ) {
+            throttle_start = Simulation::getSimulation()->getCurrentSimCycle();
+            throttle_active = true;
+        }
+		if (is_idle){
+            idle_time->addData(Simulation::getSimulation()->getCurrentSimCycle() - idle_start);
+            is_idle = false;
+        }
+    }
     else {
         // What do we do if there's nothing to send??  It could be
         // because everything is empty or because there's not
@@ -682,6 +817,87 @@ void LinkControl::handle_output(Event* ev)
     }
 }
 
+void LinkControl::sendCNP(RtrEvent* marked)
+{
+    // Limit the CNPs sent to each source
+    nid_t src = marked->getTrustedSrc();
+    SimTime_t now = Simulation::getSimulation()->getCurrentSimCycle();
+    auto it = last_cnp.find(src);
+    if ( it != last_cnp.end() && now - it->second < cnp_interval ) return;
+    last_cnp[src] = now;
+
+    // Send back on the VN the marked packet came in on, unless this
+    // side maps it somewhere else
+    int logical_vn = marked->getLogicalVN();
+    int route_vn = marked->getRouteVN();
+    if ( logical_vn < req_vns && vn_remap_out[logical_vn] != nullptr ) {
+        route_vn = vn_remap_out[logical_vn]->vn;
+    }
+
+    SimpleNetwork::Request* req = new SimpleNetwork::Request(src, id, flit_size, true, true);
+    req->vn = logical_vn;
+    RtrEvent* cnp = new RtrEvent(req,id,route_vn);
+    cnp->computeSizeInFlits(flit_size);
+    cnp->setCNP();
+    cnp_queue.push(cnp);
+
+    if ( waiting ) {
+        output_timing->send(1,nullptr);
+        waiting = false;
+    }
+}
+
+void LinkControl::reduceRate(output_queue_bundle_t* bundle)
+{
+    // DCQCN rate decrease
+    bundle->alpha = (1 - cc_g) * bundle->alpha + cc_g;
+    bundle->target_rate = bundle->rate;
+    bundle->rate = std::max(cc_min_rate, bundle->rate * (1 - bundle->alpha / 2));
+    bundle->recovery_step = 0;
+    bundle->cnp_seen = true;
+
+    if ( !cc_timer_armed ) {
+        cc_timing->send(1,nullptr);
+        cc_timer_armed = true;
+    }
+}
+
+void LinkControl::handle_cc_timer(Event* ev)
+{
+    // Intervals without a CNP decay alpha and raise the rate: fast
+    // recovery towards the target rate first, then additive increase
+    bool active = false;
+    for ( int i = 0; i < used_vns; i++ ) {
+        output_queue_bundle_t& bundle = output_queues[i];
+        if ( !bundle.cc ) continue;
+        if ( bundle.cnp_seen ) {
+            bundle.cnp_seen = false;
+            active = true;
+            continue;
+        }
+
+        bundle.alpha = (1 - cc_g) * bundle.alpha;
+        if ( bundle.rate < 1.0 ) {
+            if ( bundle.recovery_step < cc_recovery_steps ) {
+                bundle.recovery_step++;
+            }
+            else {
+                bundle.target_rate = std::min(1.0, bundle.target_rate + cc_rate_ai);
+            }
+            bundle.rate = (bundle.rate + bundle.target_rate) / 2;
+            if ( bundle.rate > 0.999 ) {
+                bundle.rate = 1.0;
+                bundle.target_rate = 1.0;
+            }
+        }
+        if ( bundle.rate < 1.0 ) active = true;
+    }
+
+    // Stop the timer once every queue is back to full rate
+    if ( active ) cc_timing->send(1,nullptr);
+    else cc_timer_armed = false;
+}
+
 
 } // namespace Merlin
 } // namespace SST
@@ -29,6 +29,8 @@
 #include "sst/elements/merlin/router.h"
 
 #include <queue>
+#include <unordered_map>
+#include <vector>
 
 namespace SST {
 
@@ -67,6 +69,14 @@ public:
         {"use_nid_remap",      "If true, will remap logical nids in job to physical ids", "false" },
         {"nid_map_name",       "Base name of shared region where my NID map will be located.  If empty, no NID map will be used.",""},
         {"vn_remap",           "Remap VNs onto/off of the network.  If empty, no vn remapping is done", "" },
+        {"cc_enable",          "Enable DCQCN style congestion control.  ECN marked packets are answered with congestion notification packets (CNPs), which throttle the injection rate of the sender.", "false" },
+        {"cc_vns",             "Array of VNs that are rate limited when cc_enable is set.  If empty, all VNs are rate limited.", "" },
+        {"cc_g",               "Gain used to update the congestion estimate (alpha) on each CNP and update interval.", "0.0625" },
+        {"cc_min_rate",        "Minimum injection rate, as a fraction of link bandwidth.", "0.01" },
+        {"cc_rate_ai",         "Additive increase of the target rate per update interval, as a fraction of link bandwidth.", "0.05" },
+        {"cc_recovery_steps",  "Number of fast recovery update intervals after a rate decrease before additive increase begins.", "5" },
+        {"cc_update_interval", "Interval between rate increase and alpha updates.", "5us" },
+        {"cnp_interval",       "Minimum time between CNPs sent to the same source.", "2us" },
 
     )
 
@@ -75,6 +85,10 @@ public:
         { "send_bit_count",     "Count number of bits sent on link", "bits", 1},
         { "output_port_stalls", "Time output port is stalled (in units of core timebase)", "time in stalls", 1},
         { "idle_time",          "Number of (in unites of core timebas) that port was idle", "time spent idle", 1},
+        { "ecn_marked_packets", "Number of received packets that were ECN marked", "packets", 1},
+        { "cnp_sent",           "Number of congestion notification packets sent", "packets", 1},
+        { "cnp_received",       "Number of congestion notification packets received", "packets", 1},
+        { "throttle_time",      "Time output port had packets and credits but was held back by the injection rate limit (in units of core timebase)", "time throttled", 1},
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -89,9 +103,26 @@ private:
         int vn;
         int credits;
 
+        // Congestion control state.  Rates are a fraction of the link
+        // bandwidth and next_send is in flit cycles.
+        bool cc;
+        double rate;
+        double target_rate;
+        double alpha;
+        int recovery_step;
+        bool cnp_seen;
+        double next_send;
+
         output_queue_bundle_t() :
             vn(-1),
-            credits(0)
+            credits(0),
+            cc(false),
+            rate(1.0),
+            target_rate(1.0),
+            alpha(1.0),
+            recovery_step(0),
+            cnp_seen(false),
+            next_send(0)
             {}
     };
 
@@ -101,6 +132,8 @@ private:
     // Self link for timing output.  This is how we manage bandwidth
     // usage
     Link* output_timing;
+    // Self link for congestion control rate updates
+    Link* cc_timing;
 
     // Perforamne paramters
     UnitAlgebra link_bw;
@@ -108,6 +141,26 @@ private:
     UnitAlgebra outbuf_size;
     int flit_size; // in bits
     UnitAlgebra flit_size_ua;
+    TimeConverter* flit_cycle;
+
+    // Congestion control parameters
+    bool cc_enable;
+    std::vector<int> cc_vns;
+    double cc_g;
+    double cc_min_rate;
+    double cc_rate_ai;
+    int cc_recovery_steps;
+    SimTime_t cnp_interval; // in core cycles
+    bool cc_timer_armed;
+
+    // CNPs waiting to go out.  They bypass the output queues and
+    // rate limiting.
+    network_queue_t cnp_queue;
+    // Last time a CNP was sent to each source
+    std::unordered_map<nid_t,SimTime_t> last_cnp;
+
+    bool throttle_active;
+    SimTime_t throttle_start;
 
     // Initialization events received from network
     std::deque<RtrEvent*> init_events;
@@ -181,6 +234,10 @@ private:
     Statistic<uint64_t>* send_bit_count;
     Statistic<uint64_t>* output_port_stalls;
     Statistic<uint64_t>* idle_time;
+    Statistic<uint64_t>* ecn_marked_packets;
+    Statistic<uint64_t>* cnp_sent;
+    Statistic<uint64_t>* cnp_received;
+    Statistic<uint64_t>* throttle_time;
 
     Output& output;
 
@@ -231,12 +288,20 @@ public:
     }
     inline const UnitAlgebra& getLinkBW() const { return link_bw; }
 
+    // Free space in the output buffer for vn, in bits.  Used by
+    // MultiRailLinkControl to pick the least loaded rail.
+    inline int getOutputSpace(int vn) const { return vn_remap_out[vn]->credits * flit_size; }
+
 
 private:
     bool network_initialized;
 
     void handle_input(Event* ev);
     void handle_output(Event* ev);
+    void handle_cc_timer(Event* ev);
+
+    void sendCNP(RtrEvent* marked);
+    void reduceRate(output_queue_bundle_t* bundle);
 
 
 };
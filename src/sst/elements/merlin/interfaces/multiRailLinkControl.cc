@@ -0,0 +1,318 @@
+// Copyright 2013-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "multiRailLinkControl.h"
+
+#include <sst/core/simulation.h>
+
+#include "merlin.h"
+#include "linkControl.h"
+
+namespace SST {
+using namespace Interfaces;
+
+namespace Merlin {
+
+MultiRailLinkControl::MultiRailLinkControl(ComponentId_t cid, Params &params, int vns) :
+    SimpleNetwork(cid),
+    vns(vns),
+    next_rail(0),
+    id(-1),
+    input_buf(nullptr),
+    receiveFunctor(nullptr),
+    sendFunctor(nullptr),
+    output(Simulation::getSimulation()->getSimulationOutput())
+{
+    std::string striping_str = params.find<std::string>("striping", "round_robin");
+    if ( striping_str == "round_robin" ) striping = ROUND_ROBIN;
+    else if ( striping_str == "flow_hash" ) striping = FLOW_HASH;
+    else if ( striping_str == "least_loaded" ) striping = LEAST_LOADED;
+    else {
+        merlin_abort.fatal(CALL_INFO,1,"MultiRailLinkControl: unknown striping policy: %s\n",striping_str.c_str());
+    }
+
+    reorder_window = params.find<uint32_t>("reorder_window", 0);
+    if ( reorder_window > 0 ) {
+        // Round up to a power of 2 so the ring can be indexed with a mask
+        uint32_t size = 1;
+        while ( size < reorder_window ) size <<= 1;
+        reorder_window = size;
+    }
+
+    // See if the rails were loaded as user subcomponents
+    SubComponentSlotInfo* rail_slots = getSubComponentSlotInfo("rail");
+    if ( rail_slots ) {
+        for ( int i = 0; i <= rail_slots->getMaxPopulatedSlotNumber(); i++ ) {
+            if ( !rail_slots->isPopulated(i) ) continue;
+            rails.push_back(rail_slots->create<SimpleNetwork>(i, ComponentInfo::SHARE_NONE, vns));
+        }
+    }
+
+    // Otherwise load them anonymously, each on its own port
+    if ( rails.empty() ) {
+        int num_rails = params.find<int>("num_rails", 2);
+        if ( num_rails < 1 ) {
+            merlin_abort.fatal(CALL_INFO,1,"MultiRailLinkControl: num_rails must be at least 1\n");
+        }
+        std::string networkIF = params.find<std::string>("networkIF", "merlin.linkcontrol");
+        Params childParams = params.find_prefix_params("networkIF:");
+
+        for ( int i = 0; i < num_rails; i++ ) {
+            childParams.insert("port_name", std::string("rail") + std::to_string(i));
+            rails.push_back(loadAnonymousSubComponent<SimpleNetwork>(networkIF, "rail", i,
+                                ComponentInfo::INSERT_STATS | ComponentInfo::SHARE_PORTS, childParams, vns));
+        }
+    }
+
+    for ( size_t i = 0; i < rails.size(); i++ ) {
+        if ( rails[i] == nullptr ) {
+            merlin_abort.fatal(CALL_INFO,1,"MultiRailLinkControl: unable to load network interface for rail %zu\n",i);
+        }
+        rail_packets.push_back(registerStatistic<uint64_t>("rail_packets", std::to_string(i)));
+    }
+    reorder_depth = registerStatistic<uint64_t>("reorder_depth");
+
+    if ( striping == LEAST_LOADED ) {
+        for ( SimpleNetwork* rail : rails ) {
+            LinkControl* lc = dynamic_cast<LinkControl*>(rail);
+            if ( lc == nullptr ) {
+                merlin_abort.fatal(CALL_INFO,1,"MultiRailLinkControl: least_loaded striping requires merlin.linkcontrol rails\n");
+            }
+            rail_lcs.push_back(lc);
+        }
+    }
+
+    input_buf = new request_queue_t[vns];
+}
+
+
+MultiRailLinkControl::~MultiRailLinkControl()
+{
+    delete [] input_buf;
+    for ( auto& entry : reorder_info ) delete entry.second;
+}
+
+void
+MultiRailLinkControl::setup()
+{
+    for ( size_t i = 0; i < rails.size(); i++ ) {
+        rails[i]->setup();
+        rails[i]->setNotifyOnSend(new SimpleNetwork::Handler<MultiRailLinkControl,int>(this,&MultiRailLinkControl::handle_send,i));
+    }
+}
+
+void
+MultiRailLinkControl::init(unsigned int phase)
+{
+    for ( size_t i = 0; i < rails.size(); i++ ) {
+        if ( phase == 0 ) {
+            rails[i]->setNotifyOnReceive(new SimpleNetwork::Handler<MultiRailLinkControl,int>(this,&MultiRailLinkControl::handle_receive,i));
+        }
+        rails[i]->init(phase);
+    }
+
+    if ( id == -1 && isNetworkInitialized() ) {
+        id = rails[0]->getEndpointID();
+        link_bw = rails[0]->getLinkBW();
+        for ( size_t i = 1; i < rails.size(); i++ ) {
+            if ( rails[i]->getEndpointID() != id ) {
+                merlin_abort.fatal(CALL_INFO,1,"MultiRailLinkControl: rail %zu has endpoint id %" PRIi64 ", but rail 0 has %" PRIi64
+                                   ".  All rails must number endpoints the same way.\n",
+                                   i, (int64_t)rails[i]->getEndpointID(), (int64_t)id);
+            }
+            link_bw += rails[i]->getLinkBW();
+        }
+    }
+}
+
+void
+MultiRailLinkControl::complete(unsigned int phase)
+{
+    for ( SimpleNetwork* rail : rails ) rail->complete(phase);
+}
+
+void
+MultiRailLinkControl::finish()
+{
+    for ( SimpleNetwork* rail : rails ) rail->finish();
+}
+
+
+int
+MultiRailLinkControl::selectRail(SimpleNetwork::Request* req, int vn)
+{
+    int num_rails = rails.size();
+    switch ( striping ) {
+    case ROUND_ROBIN:
+        for ( int i = 0; i < num_rails; i++ ) {
+            int rail = (next_rail + i) % num_rails;
+            if ( rails[rail]->spaceToSend(vn, req->size_in_bits) ) {
+                next_rail = (rail + 1) % num_rails;
+                return rail;
+            }
+        }
+        return -1;
+    case FLOW_HASH:
+    {
+        uint64_t key = (uint64_t)req->dest * vns + vn;
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        int rail = key % num_rails;
+        return rails[rail]->spaceToSend(vn, req->size_in_bits) ? rail : -1;
+    }
+    case LEAST_LOADED:
+    {
+        // Ties go round robin so idle rails share the load
+        int best = -1;
+        int best_space = 0;
+        for ( int i = 0; i < num_rails; i++ ) {
+            int rail = (next_rail + i) % num_rails;
+            int space = rail_lcs[rail]->getOutputSpace(vn);
+            if ( space >= (int)req->size_in_bits && (best == -1 || space > best_space) ) {
+                best = rail;
+                best_space = space;
+            }
+        }
+        if ( best != -1 ) next_rail = (best + 1) % num_rails;
+        return best;
+    }
+    }
+    return -1;
+}
+
+bool
+MultiRailLinkControl::send(SimpleNetwork::Request* req, int vn)
+{
+    if ( vn >= vns ) return false;
+    int rail = selectRail(req, vn);
+    if ( rail == -1 ) return false;
+
+    ReorderRequest* my_req = new ReorderRequest(req);
+    delete req;
+    my_req->seq = getReorderInfo(my_req->dest, vn)->send++;
+
+    rail_packets[rail]->addData(1);
+    return rails[rail]->send(my_req, vn);
+}
+
+// Returns true if any rail has space.  With flow_hash striping the
+// rail for a given destination may still be full.
+bool
+MultiRailLinkControl::spaceToSend(int vn, int bits)
+{
+    for ( SimpleNetwork* rail : rails ) {
+        if ( rail->spaceToSend(vn, bits) ) return true;
+    }
+    return false;
+}
+
+SST::Interfaces::SimpleNetwork::Request*
+MultiRailLinkControl::recv(int vn)
+{
+    if ( input_buf[vn].empty() ) return nullptr;
+
+    SimpleNetwork::Request* req = input_buf[vn].front();
+    input_buf[vn].pop();
+    return req;
+}
+
+
+// Untimed data all goes over the first rail
+void
+MultiRailLinkControl::sendUntimedData(SimpleNetwork::Request* req)
+{
+    rails[0]->sendUntimedData(req);
+}
+
+SST::Interfaces::SimpleNetwork::Request*
+MultiRailLinkControl::recvUntimedData()
+{
+    return rails[0]->recvUntimedData();
+}
+
+void
+MultiRailLinkControl::sendInitData(SimpleNetwork::Request* req)
+{
+    sendUntimedData(req);
+}
+
+SST::Interfaces::SimpleNetwork::Request*
+MultiRailLinkControl::recvInitData()
+{
+    return recvUntimedData();
+}
+
+
+bool
+MultiRailLinkControl::isNetworkInitialized() const
+{
+    for ( SimpleNetwork* rail : rails ) {
+        if ( !rail->isNetworkInitialized() ) return false;
+    }
+    return true;
+}
+
+bool
+MultiRailLinkControl::handle_receive(int vn, int rail)
+{
+    ReorderRequest* my_req = static_cast<ReorderRequest*>(rails[rail]->recv(vn));
+    ReorderInfo* info = getReorderInfo(my_req->src, vn);
+
+    reorder_depth->addData(my_req->seq - info->recv);
+
+    // Hold anything that is ahead of the expected sequence number
+    if ( my_req->seq != info->recv ) {
+        info->insert(my_req);
+        return true;
+    }
+
+    input_buf[vn].push(my_req);
+    info->recv++;
+    while ( (my_req = info->next()) != nullptr ) {
+        input_buf[vn].push(my_req);
+    }
+
+    if ( receiveFunctor != nullptr ) {
+        bool keep = (*receiveFunctor)(vn);
+        if ( !keep ) receiveFunctor = nullptr;
+    }
+    return true;
+}
+
+bool
+MultiRailLinkControl::handle_send(int vn, int rail)
+{
+    if ( sendFunctor != nullptr ) {
+        bool keep = (*sendFunctor)(vn);
+        if ( !keep ) sendFunctor = nullptr;
+    }
+    return true;
+}
+
+ReorderInfo*
+MultiRailLinkControl::getReorderInfo(nid_t nid, int vn)
+{
+    ReorderInfo*& info = reorder_info[(uint64_t)nid * vns + vn];
+    if ( info == nullptr ) info = new ReorderInfo(reorder_window);
+    return info;
+}
+
+
+} // namespace Merlin
+} // namespace SST
@@ -0,0 +1,157 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_MULTIRAILLINKCONTROL_H
+#define COMPONENTS_MERLIN_MULTIRAILLINKCONTROL_H
+
+#include <sst/core/subcomponent.h>
+#include <sst/core/unitAlgebra.h>
+
+#include <sst/core/interfaces/simpleNetwork.h>
+
+#include <sst/core/statapi/statbase.h>
+
+#include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/interfaces/reorderLinkControl.h"
+
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+
+class Component;
+
+namespace Merlin {
+
+class LinkControl;
+
+// SimpleNetwork that stripes traffic across several independent
+// networks (rails or planes).  Each rail has its own SimpleNetwork,
+// usually a LinkControl.  Requests are sequenced per destination and
+// VN and put back in order on receive.  All rails must number the
+// endpoints the same way, which is the case when they are built from
+// the same topology.
+class MultiRailLinkControl : public SST::Interfaces::SimpleNetwork {
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        MultiRailLinkControl,
+        "merlin",
+        "multirail",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Link Control module that stripes traffic across multiple independent networks and delivers it in order.",
+        SST::Interfaces::SimpleNetwork)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"num_rails",      "Number of rails.  Only used when the rails are not loaded into the rail slot.", "2"},
+        {"networkIF",      "SimpleNetwork subcomponent loaded for each rail when the rail slot is empty", "merlin.linkcontrol"},
+        {"striping",       "How packets are spread over the rails: round_robin (per packet), flow_hash (all packets to a destination "
+         "and VN use one rail) or least_loaded (rail with the most free output buffer space, needs merlin.linkcontrol rails)", "round_robin"},
+        {"reorder_window", "Number of sequence numbers per peer and VN held in a ring buffer, rounded up to a power of 2.  "
+         "Packets that arrive further ahead fall back to a heap.  0 keeps every out of order packet in a heap.", "0"}
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "rail_packets",   "Number of packets sent on each rail (subid is the rail number)", "packets", 1},
+        { "reorder_depth",  "Number of sequence numbers each received packet arrived ahead of the next expected one (0 for in order packets)", "packets", 1}
+    )
+
+    SST_ELI_DOCUMENT_PORTS(
+        {"rail%(num_rails)d", "Ports that connect to the routers of each rail when the rails are loaded anonymously", { "merlin.RtrEvent", "merlin.credit_event", "" } },
+    )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        {"rail", "Network interface for each rail", "SST::Interfaces::SimpleNetwork" }
+    )
+
+    typedef std::queue<SST::Interfaces::SimpleNetwork::Request*> request_queue_t;
+
+private:
+
+    enum striping_t { ROUND_ROBIN, FLOW_HASH, LEAST_LOADED };
+
+    int vns;
+    std::vector<SST::Interfaces::SimpleNetwork*> rails;
+    // Only filled in for least_loaded striping
+    std::vector<LinkControl*> rail_lcs;
+
+    striping_t striping;
+    int next_rail;
+
+    UnitAlgebra link_bw;
+    nid_t id;
+
+    // Sequence numbers are kept per (peer, VN) so held packets are
+    // always released into the VN they arrived on
+    uint32_t reorder_window;
+    std::unordered_map<uint64_t, ReorderInfo*> reorder_info;
+
+    // One input buffer per VN.  There are no output buffers, sends go
+    // directly to the rails.
+    request_queue_t* input_buf;
+
+    HandlerBase* receiveFunctor;
+    HandlerBase* sendFunctor;
+
+    std::vector<Statistic<uint64_t>*> rail_packets;
+    Statistic<uint64_t>* reorder_depth;
+
+    Output& output;
+
+public:
+    MultiRailLinkControl(ComponentId_t cid, Params &params, int vns);
+
+    ~MultiRailLinkControl();
+
+    void setup();
+    void init(unsigned int phase);
+    void complete(unsigned int phase);
+    void finish();
+
+    bool send(SST::Interfaces::SimpleNetwork::Request* req, int vn);
+    bool spaceToSend(int vn, int bits);
+    SST::Interfaces::SimpleNetwork::Request* recv(int vn);
+    bool requestToReceive( int vn ) { return !input_buf[vn].empty(); }
+
+    void sendInitData(SST::Interfaces::SimpleNetwork::Request* ev);
+    SST::Interfaces::SimpleNetwork::Request* recvInitData();
+
+    void sendUntimedData(SST::Interfaces::SimpleNetwork::Request* ev);
+    SST::Interfaces::SimpleNetwork::Request* recvUntimedData();
+
+    void setNotifyOnReceive(HandlerBase* functor) { receiveFunctor = functor; }
+    void setNotifyOnSend(HandlerBase* functor) { sendFunctor = functor; }
+
+    bool isNetworkInitialized() const;
+    nid_t getEndpointID() const { return id; }
+    const UnitAlgebra& getLinkBW() const { return link_bw; }
+
+private:
+
+    // Returns the rail to use for req, or -1 if no suitable rail has
+    // room
+    int selectRail(SST::Interfaces::SimpleNetwork::Request* req, int vn);
+
+    bool handle_receive(int vn, int rail);
+    bool handle_send(int vn, int rail);
+    ReorderInfo* getReorderInfo(nid_t nid, int vn);
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_MULTIRAILLINKCONTROL_H
@@ -19,6 +19,7 @@
 
 #include "output_arb_basic.h"
 #include "output_arb_qos_multi.h"
+#include "hr_router/stat_summary.h"
 
 #include <sst/core/sharedRegion.h>
 
@@ -60,6 +61,9 @@ PortControl::send(internal_router_event* ev, int vc)
 	// if ( xbar_in_credits[vc] < ev->getFlitCount() ) return false;
     
 	xbar_in_credits[vc] -= ev->getFlitCount();
+    for ( unsigned int i = 0; i < util_inspectors.size(); i++ ) {
+        util_inspectors[i]->queueChange(vc, ev->getFlitCount());
+    }
     if ( oql_track_port ) {
         int flits = ev->getFlitCount();
         for ( int i = 0; i < num_vcs; ++i ) {
@@ -112,7 +116,7 @@ PortControl::recv(int vc)
 	// Need to update vc_heads
 	if ( input_buf[vc].empty() ) {
 	    vc_heads[vc] = NULL;
-	    parent->dec_vcs_with_data();
+	    parent->dec_vcs_with_data(port_number, vc);
 	}
 	else {
 	    vc_heads[vc] = input_buf[vc].front();
@@ -121,12 +125,20 @@ PortControl::recv(int vc)
     int vc_return = topo->isHostPort(port_number) ? event->getCreditReturnVC() : vc;
 	// Figure out how many credits to return
 	port_ret_credits[vc_return] += event->getFlitCount();
+    port_ret_packets[vc_return]++;
 
 	// For now, we're just going to send the credits back to the
 	// other side.  The required BW to do this will not be taken
-	// into account.
-	port_link->send(1,new credit_event(vc_return,port_ret_credits[vc_return])); 
-	port_ret_credits[vc_return] = 0;
+	// into account.  If coalescing, hold the credits until enough
+	// have built up or until the timer flushes them.  Holding
+	// credits only delays the sender, and the timer bounds the delay.
+    if ( port_ret_credits[vc_return] >= credit_coalesce_threshold ) {
+        sendCredits(vc_return);
+    }
+    else if ( !credit_timer_armed ) {
+        credit_timing->send(1,NULL);
+        credit_timer_armed = true;
+    }
     
 #if TRACK
     if ( rtr_id == TRACK_ID && port_number == TRACK_PORT ) {
@@ -137,6 +149,50 @@ PortControl::recv(int vc)
     return event;
 }
 
+void
+PortControl::sendCredits(int vc)
+{
+	port_link->send(1,new credit_event(vc,port_ret_credits[vc]));
+	port_ret_credits[vc] = 0;
+    credit_return_count->addData(port_ret_packets[vc]);
+    port_ret_packets[vc] = 0;
+    credit_event_count->addData(1);
+}
+
+// A VC is stalled if it has a packet to send but not enough credits
+// for it.  Only sampled when the output arbitrates, so a stall ends
+// at the first arbitration after the credits arrive.
+void
+PortControl::updateUtilStalls()
+{
+    for ( int vc = 0; vc < num_vcs; vc++ ) {
+        bool stalled = !output_buf[vc].empty() && port_out_credits[vc] < output_buf[vc].front()->getFlitCount();
+        for ( unsigned int i = 0; i < util_inspectors.size(); i++ ) {
+            util_inspectors[i]->setStalled(vc, stalled);
+        }
+    }
+}
+
+// Port stall time for the statistics summary.  Also charged to each
+// VC that was waiting for credits when the port blocked.
+void
+PortControl::addSummaryStall(SimTime_t cycles)
+{
+    summary_stall_cycles += cycles;
+    for ( size_t vc = 0; vc < summary_vc_blocked.size(); vc++ ) {
+        if ( summary_vc_blocked[vc] ) summary_vc_stall_cycles[vc] += cycles;
+    }
+}
+
+void
+PortControl::handle_credit_timer(Event* ev)
+{
+    credit_timer_armed = false;
+    for ( int i = 0; i < num_vcs; i++ ) {
+        if ( port_ret_credits[i] > 0 ) sendCredits(i);
+    }
+}
+
 
 PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rtr_id, int port_number, Topology *topo) :
     PortInterface(cid),
@@ -150,7 +206,13 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     input_buf_count(NULL),
     output_buf_count(NULL),
     port_ret_credits(NULL),
+    port_ret_packets(NULL),
     port_out_credits(NULL),
+    credit_timing(NULL),
+    credit_coalesce_threshold(0),
+    ecn_threshold(-1),
+    output_buf_flits(0),
+    credit_timer_armed(false),
     idle_start(0),
 	sai_win_start(0),
 	sai_port_disabled(false),
@@ -161,6 +223,10 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     have_packets(false),
     start_block(0),
     parent(rif),
+    stat_summary(false),
+    summary_packets(0),
+    summary_bits(0),
+    summary_stall_cycles(0),
     output(Simulation::getSimulation()->getSimulationOutput())
 {
     // Process the parameters
@@ -185,6 +251,7 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     if ( link_bw.hasUnits("B/s") ) {
         link_bw *= UnitAlgebra("8b/B");
     }
+    reserved_bw = UnitAlgebra("0b/s");
     
     // Flit size
     flit_size = params.find<UnitAlgebra>("flit_size", found);
@@ -267,6 +334,26 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
         output_buf_size *= UnitAlgebra("8b");
     }
     
+    credit_coalesce_threshold = params.find<int>("credit_coalesce_threshold",0);
+    if ( credit_coalesce_threshold > 1 ) {
+        std::string interval = params.find<std::string>("credit_coalesce_interval","10ns");
+        credit_timing = configureSelfLink(link_port_name + "_credit_timing", interval,
+                                          new Event::Handler<PortControl>(this,&PortControl::handle_credit_timer));
+    }
+
+    ecn_threshold_size = params.find<UnitAlgebra>("ecn_threshold", found);
+    if ( found ) {
+        if ( !ecn_threshold_size.hasUnits("b") && !ecn_threshold_size.hasUnits("B") ) {
+            merlin_abort.fatal(CALL_INFO,-1,"PortControl: ecn_threshold must be specified in either "
+                               "bits (b) or bytes (B): %s\n",ecn_threshold_size.toStringBestSI().c_str());
+        }
+        if ( ecn_threshold_size.hasUnits("B") ) {
+            ecn_threshold_size *= UnitAlgebra("8b");
+        }
+        // Converted to flits in initVCs()
+        ecn_threshold = 0;
+    }
+
     std::string input_latency_timebase = params.find<std::string>("input_latency",found);
     if ( port_link && found ) {
         // std::cout << "Adding extra latency" << std::endl;
@@ -283,6 +370,12 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     output_port_stalls = registerStatistic<uint64_t>("output_port_stalls", port_name);
     idle_time = registerStatistic<uint64_t>("idle_time", port_name);
     width_adj_count = registerStatistic<uint64_t>("width_adj_count", port_name);
+    credit_return_count = registerStatistic<uint64_t>("credit_return_count", port_name);
+    credit_event_count = registerStatistic<uint64_t>("credit_event_count", port_name);
+    ecn_mark_count = registerStatistic<uint64_t>("ecn_mark_count", port_name);
+    reserved_bw_stat = registerStatistic<uint64_t>("reserved_bw", port_name);
+
+    stat_summary = params.find<bool>("stats_summary", false);
 
 	// set the SAI metrics to 0
 	stalled = 0;
@@ -301,15 +394,18 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     std::vector<std::string> inspector_names;
     params.find_array<std::string>("network_inspectors",inspector_names);
 
-    // Create any NetworkInspectors
+    // Create any NetworkInspectors.  They all share the inspector:
+    // prefixed params.
+    Params inspector_params = params.find_prefix_params("inspector:");
     for ( unsigned int i = 0; i < inspector_names.size(); i++ ) {
-        Params empty;
         SimpleNetwork::NetworkInspector* ni = loadAnonymousSubComponent<SimpleNetwork::NetworkInspector>
-            (inspector_names[i], "inspector_slot", i, ComponentInfo::INSERT_STATS, empty, port_name);
+            (inspector_names[i], "inspector_slot", i, ComponentInfo::INSERT_STATS, inspector_params, port_name);
         if ( ni == NULL ) {
             merlin_abort.fatal(CALL_INFO,1,"NetworkInspector: %s, not found.\n",inspector_names[i].c_str());
         }
-        network_inspectors.push_back(ni);
+        LinkUtilizationInspector* lui = dynamic_cast<LinkUtilizationInspector*>(ni);
+        if ( lui != NULL ) util_inspectors.push_back(lui);
+        else network_inspectors.push_back(ni);
     }
 
     dlink_thresh = params.find<float>("dlink_thresh",-1.0);
@@ -375,7 +471,13 @@ PortControl::initVCs(int vns, int* vcs_per_vn, internal_router_event** vc_heads_
     // Initialize credit arrays
     // xbar_in_credits = new int[vcs];
     port_ret_credits = new int[num_vcs];
+    port_ret_packets = new int[num_vcs];
     port_out_credits = new int[num_vcs];
+
+    if ( stat_summary ) {
+        summary_vc_stall_cycles.resize(num_vcs, 0);
+        summary_vc_blocked.resize(num_vcs, false);
+    }
     
     // Figure out how large the buffers are in flits
 
@@ -400,11 +502,23 @@ PortControl::initVCs(int vns, int* vcs_per_vn, internal_router_event** vc_heads_
     ibs /= flit_size;
     obs /= flit_size;
     
+    // Never hold more credits than the input buffer can return,
+    // otherwise a drained buffer would wait on the timer.
+    if ( credit_coalesce_threshold > ibs.getRoundedValue() ) {
+        credit_coalesce_threshold = ibs.getRoundedValue();
+    }
+
     for ( int i = 0; i < num_vcs; i++ ) {
         port_ret_credits[i] = ibs.getRoundedValue();
+        port_ret_packets[i] = 0;
         xbar_in_credits[i] = obs.getRoundedValue();
         port_out_credits[i] = 0;
     }
+
+    output_buf_flits = obs.getRoundedValue();
+    if ( ecn_threshold != -1 ) {
+        ecn_threshold = (ecn_threshold_size / flit_size).getRoundedValue();
+    }
     
     // // Copy the starting return tokens for the input buffers (this
     // // essentially sets the size of the buffer)
@@ -421,6 +535,10 @@ PortControl::initVCs(int vns, int* vcs_per_vn, internal_router_event** vc_heads_
     is_idle = true;
 
     output_arb->setVCs(num_vns, vcs_per_vn);
+
+    for ( unsigned int i = 0; i < util_inspectors.size(); i++ ) {
+        util_inspectors[i]->initPort(rtr_id, port_number, num_vcs);
+    }
 }
 
 PortControl::~PortControl() {
@@ -430,16 +548,25 @@ PortControl::~PortControl() {
     if ( output_buf_count != NULL ) delete [] output_buf_count;
     //if ( xbar_in_credits != NULL ) delete [] xbar_in_credits;
     if ( port_ret_credits != NULL ) delete [] port_ret_credits;
+    if ( port_ret_packets != NULL ) delete [] port_ret_packets;
     if ( port_out_credits != NULL ) delete [] port_out_credits;
     for ( unsigned int i = 0; i < network_inspectors.size(); i++ ) {
         delete network_inspectors[i];
     }
+    for ( unsigned int i = 0; i < util_inspectors.size(); i++ ) {
+        delete util_inspectors[i];
+    }
 }
 
 void
 PortControl::setup() {
     if ( !connected ) return;
 	if (dlink_thresh >= 0) dynlink_timing->send(1,NULL);
+    // Reservations from background flows were collected during init
+    if ( reserved_bw.getDoubleValue() > 0 ) {
+        output_timing->setDefaultTimeBase(getOutputTimeBase());
+    }
+    reserved_bw_stat->addData((reserved_bw / UnitAlgebra("1Mb/s")).getRoundedValue());
     while ( init_events.size() ) {
         delete init_events.front();
         init_events.pop_front();
@@ -457,6 +584,16 @@ PortControl::finish() {
         is_idle = false;
     }
 
+    if ( stat_summary ) {
+        double elapsed_ns = getCurrentSimTimeNano();
+        double cycles = Simulation::getSimulation()->getCurrentSimCycle();
+        double utilization = 0;
+        double stalled = 0;
+        if ( elapsed_ns > 0 ) utilization = summary_bits / (max_link_bw.getDoubleValue() * elapsed_ns * 1.0e-9);
+        if ( cycles > 0 ) stalled = summary_stall_cycles / cycles;
+        RouterStatSummary::addPort(utilization, stalled, summary_packets, summary_bits, summary_stall_cycles, summary_vc_stall_cycles);
+    }
+
     // Clean up all the events left in the queues.  This will help
     // track down real memory leaks as all this events won't be in the
     // way.
@@ -475,6 +612,9 @@ PortControl::finish() {
     for ( unsigned int i = 0; i < network_inspectors.size(); i++ ) {
         network_inspectors[i]->finish();
     }
+    for ( unsigned int i = 0; i < util_inspectors.size(); i++ ) {
+        util_inspectors[i]->finish();
+    }
 }
 
 
@@ -525,6 +665,9 @@ PortControl::init(unsigned int phase) {
         ev = port_link->recvInitData();
         init_ev = dynamic_cast<RtrInitEvent*>(ev);
         if ( link_bw > init_ev->ua_value ) link_bw = init_ev->ua_value;
+        // Dynamic link width may lower link_bw later, so keep the
+        // full width bandwidth for the statistics summary
+        max_link_bw = link_bw;
 
         // Initialize links (or rather, reset the TimeBase to get the
         // right BW).
@@ -808,6 +951,7 @@ PortControl::handle_input_n2r(Event* ev)
             // packets, we need to add stall time
             if ( have_packets) {
                 output_port_stalls->addData(Simulation::getSimulation()->getCurrentSimCycle() - start_block);
+                addSummaryStall(Simulation::getSimulation()->getCurrentSimCycle() - start_block);
             }
 	    }
 	}
@@ -821,6 +965,7 @@ PortControl::handle_input_n2r(Event* ev)
         int vn = event->getRouteVN();
         internal_router_event* rtr_event = topo->process_input(event);
         rtr_event->setCreditReturnVC(vn);
+        if ( stat_summary ) rtr_event->setArrivalTime(getCurrentSimTimeNano());
         int curr_vc = rtr_event->getVC();
 	    topo->route(port_number, rtr_event->getVC(), rtr_event);
 	    input_buf[curr_vc].push(rtr_event);
@@ -829,7 +974,7 @@ PortControl::handle_input_n2r(Event* ev)
 	    // If this becomes vc_head we need to put it into the vc_heads array
 	    if ( vc_heads[curr_vc] == NULL ) {
             vc_heads[curr_vc] = rtr_event;
-            parent->inc_vcs_with_data();
+            parent->inc_vcs_with_data(port_number, curr_vc);
 	    }
 	    
 	    if ( event->getTraceType() != SST::Interfaces::SimpleNetwork::Request::NONE ) {
@@ -896,6 +1041,7 @@ PortControl::handle_input_r2r(Event* ev)
             // packets, we need to add stall time
             if ( have_packets) {
                 output_port_stalls->addData(Simulation::getSimulation()->getCurrentSimCycle() - start_block);
+                addSummaryStall(Simulation::getSimulation()->getCurrentSimCycle() - start_block);
             }
 	    }
 	}
@@ -907,6 +1053,7 @@ PortControl::handle_input_r2r(Event* ev)
     {
 	    internal_router_event* event = static_cast<internal_router_event*>(ev);
 	    // Simply put the event into the right virtual network queue
+        if ( stat_summary ) event->setArrivalTime(getCurrentSimTimeNano());
         
 	    // Need to do the routing
 	    int curr_vc = event->getVC();
@@ -918,7 +1065,7 @@ PortControl::handle_input_r2r(Event* ev)
 	    // in the array) we need to put it into the vc_heads array
 	    if ( vc_heads[curr_vc] == NULL ) {
             vc_heads[curr_vc] = event;
-            parent->inc_vcs_with_data();
+            parent->inc_vcs_with_data(port_number, curr_vc);
 	    }
         // std::cout << "Got to here 3" << std::endl; 
 	    
@@ -996,6 +1143,14 @@ PortControl::handle_output(Event* ev) {
 	    // Need to return credits to the output buffer
 	    int size = send_event->getFlitCount();
 	    xbar_in_credits[vc_to_send] += size;
+
+        // Mark the packet if the queue it leaves behind is over the
+        // ECN threshold
+        if ( ecn_threshold != -1 && output_buf_flits - xbar_in_credits[vc_to_send] > ecn_threshold ) {
+            send_event->getEncapsulatedEvent()->setECN();
+            ecn_mark_count->addData(1);
+        }
+
         if ( !oql_track_remote ) {
             if ( oql_track_port ) {
                 for ( int i = 0; i < num_vcs; ++i ) {
@@ -1032,11 +1187,20 @@ PortControl::handle_output(Event* ev) {
 	    }
         send_bit_count->addData(send_event->getEncapsulatedEvent()->getSizeInBits());
         send_packet_count->addData(1);
+        if ( stat_summary ) {
+            summary_packets++;
+            summary_bits += send_event->getEncapsulatedEvent()->getSizeInBits();
+            RouterStatSummary::addHopLatency(getCurrentSimTimeNano() - send_event->getArrivalTime());
+        }
 
         // Send the request to all the registered NetworkInspectors
         for ( unsigned int i = 0; i < network_inspectors.size(); i++ ) {
             network_inspectors[i]->inspectNetworkData(send_event->inspectRequest());
         }
+        for ( unsigned int i = 0; i < util_inspectors.size(); i++ ) {
+            util_inspectors[i]->packetSent(vc_to_send, send_event->getEncapsulatedEvent()->getSizeInBits());
+            util_inspectors[i]->queueChange(vc_to_send, -size);
+        }
 
 	    if ( host_port ) {
             port_link->send(1,send_event->getEncapsulatedEvent()); 
@@ -1058,6 +1222,11 @@ PortControl::handle_output(Event* ev) {
 	    // to know that we got to this state.
         start_block = Simulation::getSimulation()->getCurrentSimCycle();
 	    waiting = true;
+        // Remember which VCs are waiting for credits so the stall can
+        // be charged to them in the statistics summary
+        for ( size_t vc = 0; vc < summary_vc_blocked.size(); vc++ ) {
+            summary_vc_blocked[vc] = !output_buf[vc].empty() && port_out_credits[vc] < output_buf[vc].front()->getFlitCount();
+        }
         // Begin counting the amount of time this port was idle
         if (!have_packets && !is_idle) {
             idle_start = Simulation::getSimulation()->getCurrentSimCycle();
@@ -1074,6 +1243,7 @@ PortControl::handle_output(Event* ev) {
 			output_timing->send(1,NULL); 
 		}
 	}
+    if ( !util_inspectors.empty() ) updateUtilStalls();
 #if TRACK
     if ( rtr_id == TRACK_ID && port_number == TRACK_PORT ) {
         printStatus(Simulation::getSimulation()->getSimulationOutput(),0,0);
@@ -1131,6 +1301,32 @@ PortControl::handleSAIWindow(Event* ev) {
 	sai_win_start = cur_time;
 }
 
+void
+PortControl::reserveBandwidth(const UnitAlgebra& bw)
+{
+    reserved_bw += bw;
+}
+
+TimeConverter*
+PortControl::getOutputTimeBase()
+{
+    UnitAlgebra available = link_bw;
+    if ( reserved_bw.getDoubleValue() > 0 ) {
+        available -= reserved_bw;
+        // Always leave some bandwidth so foreground traffic can make
+        // progress
+        UnitAlgebra min_bw = link_bw / 100;
+        if ( available < min_bw ) {
+            merlin_abort.output("PortControl: background flows reserve %s on router %d, port %d, "
+                                "which has only %s.  Leaving 1%% for other traffic.\n",
+                                reserved_bw.toStringBestSI().c_str(), rtr_id, port_number,
+                                link_bw.toStringBestSI().c_str());
+            available = min_bw;
+        }
+    }
+    return getTimeConverter(available / flit_size);
+}
+
 // If we are idle or stalled beyond some threshold,
 // we want to reduce the bandwidth of the outgoing traffic.
 // Each port monitors the amount of outgoing traffic.
@@ -1145,9 +1341,7 @@ PortControl::decreaseLinkWidth() {
     if ( cur_link_width == max_link_width ) {
         cur_link_width = cur_link_width/2;
         link_bw = link_bw/2;
-        UnitAlgebra link_clock = link_bw / flit_size;
-        TimeConverter* tc = getTimeConverter(link_clock);
-        output_timing->setDefaultTimeBase(tc);
+        output_timing->setDefaultTimeBase(getOutputTimeBase());
         width_adj_count->addData(1);
         // I need to add a delay before messages can transmit on the link
         disable_timing->send(1,NULL);
@@ -1172,9 +1366,7 @@ if ( cur_link_width < max_link_width )
 {
 	cur_link_width = max_link_width;
 	link_bw = link_bw*2;
-	UnitAlgebra link_clock = link_bw / flit_size;
-	TimeConverter* tc = getTimeConverter(link_clock);
-	output_timing->setDefaultTimeBase(tc);
+	output_timing->setDefaultTimeBase(getOutputTimeBase());
 	width_adj_count->addData(1);
 	// I need to add a delay before messages can transmit on the link
 	disable_timing->send(1,NULL);
@@ -31,6 +31,7 @@
 #include <cstring>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/inspectors/linkUtilization.h"
 
 using namespace SST;
 
@@ -63,13 +64,18 @@ public:
         {"input_buf_size",     "Size of input buffers specified in b or B (can include SI prefix)."},
         {"output_buf_size",    "Size of output buffers specified in b or B (can include SI prefix)."},
         {"network_inspectors", "Comma separated list of network inspectors to put on output ports.", ""},
+        {"inspector:*",        "Params passed to each network inspector, with the inspector: prefix removed.  Set on hr_router as portcontrol:inspector:<param>."},
         {"dlink_thresh",       ""},
         {"num_vns",            "Number of VNs set in router or python file (-1 if not set in the parent router)."},
         {"vn_remap_shm",       "Name of shared memory region for vn remapping.  If empty, no remapping is done", ""},
         {"vn_remap_shm_size",  "Size of shared memory region for vn remapping.  If empty, no remapping is done", "-1"},
         {"oql_track_port",     ""},
         {"oql_track_remote",   ""},
-        {"output_arb",         "Arbitration unit to be used for port output", "merlin.arb.output.basic"}
+        {"output_arb",         "Arbitration unit to be used for port output", "merlin.arb.output.basic"},
+        {"credit_coalesce_threshold", "Number of flits worth of credits to accumulate per VC before returning them to the sender.  0 or 1 returns credits for every packet.  Capped at the input buffer size.", "0"},
+        {"credit_coalesce_interval",  "Maximum time coalesced credits are held before being returned.  Only used if credit_coalesce_threshold > 1.", "10ns"},
+        {"ecn_threshold",      "Output queue occupancy per VC, in b or B, above which departing packets are ECN marked.  Empty disables marking.", ""},
+        {"stats_summary",      "Add this port to the per rank router statistics summary", "false"}
     )
 
     // SST_ELI_DOCUMENT_STATISTICS(
@@ -105,6 +111,20 @@ private:
 	// Self link for disabling a port temporarily
 	Link* disable_timing;
 
+    // Credit coalescing.  Credits are held in port_ret_credits until
+    // credit_coalesce_threshold flits have accumulated for a VC, or
+    // until credit_timing fires, which is at most
+    // credit_coalesce_interval after the first credit was held.
+    Link* credit_timing;
+    int credit_coalesce_threshold;
+    bool credit_timer_armed;
+
+    // ECN marking threshold and output buffer size, both in flits.
+    // ecn_threshold is -1 when marking is disabled.
+    UnitAlgebra ecn_threshold_size;
+    int ecn_threshold;
+    int output_buf_flits;
+
     std::deque<Event*> init_events;
 
     int rtr_id;
@@ -122,7 +142,11 @@ private:
 	UnitAlgebra link_width_transition_delay;
 
     UnitAlgebra link_bw;
+    // Negotiated link_bw at full link width
+    UnitAlgebra max_link_bw;
     UnitAlgebra flit_size;
+    // Bandwidth reserved for background flows, in b/s
+    UnitAlgebra reserved_bw;
     UnitAlgebra input_buf_size;
     UnitAlgebra output_buf_size;
 
@@ -177,6 +201,8 @@ private:
     int* xbar_in_credits;
 
     int* port_ret_credits;
+    // Packets drained since the last credit return, per VC
+    int* port_ret_packets;
     int* port_out_credits;
 
     // Represents the start of when a port was idle
@@ -210,6 +236,20 @@ private:
     Statistic<uint64_t>* output_port_stalls;
     Statistic<uint64_t>* idle_time;
     Statistic<uint64_t>* width_adj_count;
+    Statistic<uint64_t>* credit_return_count;
+    Statistic<uint64_t>* credit_event_count;
+    Statistic<uint64_t>* ecn_mark_count;
+    Statistic<uint64_t>* reserved_bw_stat;
+
+    // Totals for the per rank statistics summary
+    bool stat_summary;
+    uint64_t summary_packets;
+    uint64_t summary_bits;
+    uint64_t summary_stall_cycles;
+    // Stall cycles per VC, and the VCs that were waiting for credits
+    // when the port last blocked
+    std::vector<uint64_t> summary_vc_stall_cycles;
+    std::vector<bool> summary_vc_blocked;
 
 	// SAI Metrics (S+A+I=1) corresponds to
 	// sai_win_start to (sai_win_start + sai_win_length)
@@ -279,9 +319,17 @@ public:
 	bool decreaseLinkWidth();
 	bool increaseLinkWidth();
 
+    void reserveBandwidth(const UnitAlgebra& bw);
+
 private:
 
+    // Time base for output_timing: the link bandwidth left after the
+    // background flow reservations, in flits
+    TimeConverter* getOutputTimeBase();
+
     std::vector<SST::Interfaces::SimpleNetwork::NetworkInspector*> network_inspectors;
+    // Inspectors that also get the router side per VC data
+    std::vector<LinkUtilizationInspector*> util_inspectors;
 
     void dumpQueueState(port_queue_t& q, std::ostream& stream);
     void dumpQueueState(port_queue_t& q, Output& out);
@@ -291,6 +339,10 @@ private:
     void handle_output(Event* ev);
 	void handleSAIWindow(Event* ev);
 	void reenablePort(Event* ev);
+    void handle_credit_timer(Event* ev);
+    void sendCredits(int vc);
+    void updateUtilStalls();
+    void addSummaryStall(SimTime_t cycles);
 
 	uint64_t increaseActive();
 
@@ -32,6 +32,17 @@ ReorderLinkControl::ReorderLinkControl(ComponentId_t cid, Params &params, int vn
     receiveFunctor(NULL),
     vns(vns)
 {
+    reorder_window = params.find<uint32_t>("reorder_window", 0);
+    if ( reorder_window > 0 ) {
+        // Round up to a power of 2 so the ring can be indexed with a mask
+        uint32_t size = 1;
+        while ( size < reorder_window ) size <<= 1;
+        reorder_window = size;
+    }
+
+    reorder_depth = registerStatistic<uint64_t>("reorder_depth");
+    reorder_overflow = registerStatistic<uint64_t>("reorder_overflow");
+
     if ( isUser() ) {
         // Need to see if the network_if was loaded as a user subcomponent
         link_control = loadUserSubComponent<SimpleNetwork>("networkIF", ComponentInfo::SHARE_NONE, vns);
@@ -70,6 +81,8 @@ ReorderLinkControl::ReorderLinkControl(ComponentId_t cid, Params &params, int vn
 
 ReorderLinkControl::~ReorderLinkControl() {
     delete [] input_buf;
+    for ( auto& entry : reorder_info ) delete entry.second;
+    for ( ReorderInfo* info : dense_reorder_info ) delete info;
 }
 
 void
@@ -122,13 +135,7 @@ bool ReorderLinkControl::send(SimpleNetwork::Request* req, int vn) {
     delete req;
 
     // Need to put in the sequence number
-
-    // See if we already have reorder_info for this dest
-    if ( reorder_info.find(my_req->dest) == reorder_info.end() ) {
-        ReorderInfo* info = new ReorderInfo();
-        reorder_info[my_req->dest] = info;
-    }
-    ReorderInfo* info = reorder_info[my_req->dest];
+    ReorderInfo* info = getReorderInfo(my_req->dest);
     my_req->seq = info->send++;
 
     // // To test, just going to switch order
@@ -214,26 +221,19 @@ bool ReorderLinkControl::handle_event(int vn) {
 
     // std::cout << id << ": recieved packet with sequence number " << my_req->seq << std::endl;
 
-    if ( reorder_info.find(my_req->src) == reorder_info.end() ) {
-        ReorderInfo* info = new ReorderInfo();
-        reorder_info[my_req->src] = info;
-    }
+    ReorderInfo* info = getReorderInfo(my_req->src);
 
-    ReorderInfo* info = reorder_info[my_req->src];
+    reorder_depth->addData(my_req->seq - info->recv);
 
-    // See if this is the expected sequence number, if not, put it
-    // into the ReorderInfo.queue.
+    // See if this is the expected sequence number, if not, hold it in
+    // the ReorderInfo.
     if ( my_req->seq == info->recv ) {
         input_buf[vn].push(my_req);
         info->recv++;
         // Need to also see if we have any other fragments which are
         // now ready to be delivered
-        my_req = info->queue.top();
-        while ( my_req->seq == info->recv ) {
+        while ( (my_req = info->next()) != NULL ) {
             input_buf[vn].push(my_req);
-            info->queue.pop();
-            my_req = info->queue.top();
-            info->recv++;
         }
 
         // If there is a recv functor, need to notify parent
@@ -248,12 +248,27 @@ bool ReorderLinkControl::handle_event(int vn) {
 
     }
     else {
-        info->queue.push(my_req);
+        if ( !info->insert(my_req) && reorder_window > 0 ) reorder_overflow->addData(1);
     }
 
     return true;
 }
 
+ReorderInfo* ReorderLinkControl::getReorderInfo(SimpleNetwork::nid_t nid) {
+    if ( reorder_window > 0 ) {
+        if ( (size_t)nid >= dense_reorder_info.size() ) {
+            dense_reorder_info.resize(nid + 1, NULL);
+        }
+        ReorderInfo*& info = dense_reorder_info[nid];
+        if ( info == NULL ) info = new ReorderInfo(reorder_window);
+        return info;
+    }
+
+    ReorderInfo*& info = reorder_info[nid];
+    if ( info == NULL ) info = new ReorderInfo();
+    return info;
+}
+
 // bool ReorderLinkControl::handle_send(int vn) {
 //     if ( sendFunctor != NULL ) {
 //         bool keep = (*sendFunctor)(vn);
@@ -28,6 +28,7 @@
 
 #include <queue>
 #include <unordered_map>
+#include <vector>
 
 namespace SST {
 
@@ -93,9 +94,17 @@ struct ReorderInfo {
     uint32_t recv;
     ReorderRequest::PriorityQueue queue;
 
-    ReorderInfo() :
+    // Optional ring buffer of the next window.size() sequence
+    // numbers.  Requests that arrive further ahead than that go into
+    // queue.
+    std::vector<ReorderRequest*> window;
+    uint32_t mask;
+
+    ReorderInfo(uint32_t window_size = 0) :
         send(0),
-        recv(0)
+        recv(0),
+        window(window_size, NULL),
+        mask(window_size - 1)
     {
         // Put a dummy entry into queue to avoid checks for NULL later
         // on when looking for fragments to deliver.  This does mean
@@ -105,6 +114,41 @@ struct ReorderInfo {
         req->seq = 0xffffffff;
         queue.push(req);
     }
+
+    ~ReorderInfo() {
+        while ( !queue.empty() ) {
+            delete queue.top();
+            queue.pop();
+        }
+        for ( ReorderRequest* req : window ) delete req;
+    }
+
+    // Hold an out of order request.  Returns false if it did not fit
+    // in the window and was put in the queue.
+    bool insert(ReorderRequest* req) {
+        if ( req->seq - recv < window.size() ) {
+            window[req->seq & mask] = req;
+            return true;
+        }
+        queue.push(req);
+        return false;
+    }
+
+    // Returns the held request with sequence number recv and advances
+    // recv, or NULL if it hasn't arrived yet.
+    ReorderRequest* next() {
+        ReorderRequest* req = NULL;
+        if ( !window.empty() && window[recv & mask] != NULL ) {
+            req = window[recv & mask];
+            window[recv & mask] = NULL;
+        }
+        else if ( queue.top()->seq == recv ) {
+            req = queue.top();
+            queue.pop();
+        }
+        if ( req != NULL ) recv++;
+        return req;
+    }
 };
 
 // Version of LinkControl that will allow out of order receive, but
@@ -124,7 +168,14 @@ public:
 
     SST_ELI_DOCUMENT_PARAMS(
         {"rlc:networkIF","SimpleNetwork subcomponent to be used for connecting to network", "merlin.linkcontrol"},
-        {"networkIF","SimpleNetwork subcomponent to be used for connecting to network", "merlin.linkcontrol"}
+        {"networkIF","SimpleNetwork subcomponent to be used for connecting to network", "merlin.linkcontrol"},
+        {"reorder_window","Number of sequence numbers per peer held in a ring buffer, rounded up to a power of 2.  Peers are kept in an array indexed by endpoint id.  "
+         "Packets that arrive further ahead fall back to a heap.  0 keeps every out of order packet in a heap and peers in a hash map.", "0"}
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "reorder_depth",    "Number of sequence numbers each received packet arrived ahead of the next expected one (0 for in order packets)", "packets", 1},
+        { "reorder_overflow", "Number of out of order packets that did not fit in reorder_window and were put in the heap", "packets", 1}
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -147,6 +198,13 @@ private:
 
     std::unordered_map<SST::Interfaces::SimpleNetwork::nid_t, ReorderInfo*> reorder_info;
 
+    // Used instead of reorder_info when reorder_window is set
+    uint32_t reorder_window;
+    std::vector<ReorderInfo*> dense_reorder_info;
+
+    Statistic<uint64_t>* reorder_depth;
+    Statistic<uint64_t>* reorder_overflow;
+
     // One buffer for each virtual network.  At the NIC level, we just
     // provide a virtual channel abstraction.  Don't need output
     // buffers, sends will go directly to LinkControl.  Do need input
@@ -202,6 +260,7 @@ public:
 private:
 
     bool handle_event(int vn);
+    ReorderInfo* getReorderInfo(SST::Interfaces::SimpleNetwork::nid_t nid);
 };
 
 }
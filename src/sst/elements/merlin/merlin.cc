@@ -36,6 +36,8 @@
  */
 #include <sst/core/model/element_python.h>
 
+#include "pymodule.h"
+
 char pymerlin[] = {
 #include "pymerlin.inc"
     0x00};
@@ -78,6 +80,14 @@ public:
         primary_module->addSubModule("topology",pymerlin_topo_mesh,"topology/pymerlin-topo-mesh.py");
     }
 
+    void* load() override
+    {
+        void* module = SSTElementPythonModule::load();
+        // Link table generators used by the topologies' build()
+        if ( module != NULL ) genMerlinNativeModule(module);
+        return module;
+    }
+
     SST_ELI_REGISTER_PYTHON_MODULE(
         MerlinPyModule,
         "merlin",
@@ -20,6 +20,9 @@
 #include <sst/core/simulation.h>
 #include <sst/core/timeLord.h>
 
+#include <cmath>
+#include <inttypes.h>
+
 using namespace SST::Merlin;
 using namespace SST::Interfaces;
 
@@ -67,6 +70,10 @@ OfferedLoad::OfferedLoad(ComponentId_t cid, Params& params) :
     serialization_time = ((pkt_size / link_bw) / UnitAlgebra("1ps"));
     UnitAlgebra interval = serialization_time / offered_load[0];
     send_interval = interval.getRoundedValue();
+    serialization_ps = serialization_time.getRoundedValue();
+
+    saturation_threshold = params.find<double>("saturation_threshold",0.9);
+    output_file = params.find<std::string>("output_file","");
 
     // Load the specified SimpleNetwork object
 
@@ -105,7 +112,7 @@ OfferedLoad::OfferedLoad(ComponentId_t cid, Params& params) :
 
     pattern_params = new Params();
     // packetDestGen = static_cast<TargetGenerator*>(loadSubComponent(pattern, this, params));
-    pattern_params->insert(params.find_prefix_params("pattern"));
+    pattern_params->insert(params.find_prefix_params("pattern:"));
     pattern_params->insert("pattern_gen",pattern);
 
     UnitAlgebra warmup_time_ua = params.find<UnitAlgebra>("warmup_time","5us");
@@ -175,17 +182,61 @@ void OfferedLoad::finish()
         // }
 
 
-        // Now, write out a summary table with just the latencies
+        // Now, write out the latency versus throughput curve.
+        // Accepted load is the fraction of the link bandwidth
+        // delivered to each endpoint during the collect period,
+        // averaged over all endpoints.  A step is saturated if the
+        // network did not accept (most of) the offered load, or if the
+        // endpoints fell behind the offered injection rate (backup).
+        FILE* csv = NULL;
+        if ( !output_file.empty() ) {
+            csv = fopen(output_file.c_str(), "w");
+            if ( csv == NULL ) {
+                out.fatal(CALL_INFO, -1, "Unable to open output_file %s\n", output_file.c_str());
+            }
+            fprintf(csv, "offered_load,accepted_load,avg_latency_ps,min_latency_ps,max_latency_ps,stddev_latency_ps,packets,saturated\n");
+        }
 
-        out.output("%9s %9s\n","Offered","Average");
-        out.output("%9s %9s\n","Load ","Latency");
+        out.output("%9s %9s %15s %15s %15s\n","Offered","Accepted","Average","Min","Max");
+        out.output("%9s %9s %15s %15s %15s\n","Load ","Load ","Latency","Latency","Latency");
+        int saturated_at = -1;
         for ( auto ev : complete_event ) {
-            UnitAlgebra average = UnitAlgebra("1ps") * ev->sum / ev->count;
-            out.output("%9.2f %15s",offered_load[ev->generation],average.toStringBestSI().c_str());
-            if ( ev->backup > 0 ) out.output("*\n");
+            double offered = offered_load[ev->generation];
+            double accepted = (double)ev->count * serialization_ps / ((double)collect_time * num_peers);
+            bool saturated = ev->backup > 0 || accepted < saturation_threshold * offered;
+            if ( saturated && saturated_at == -1 ) saturated_at = ev->generation;
+
+            double mean = ev->count ? (double)ev->sum / ev->count : 0.0;
+            double variance = ev->count ? (double)ev->sum_of_squares / ev->count - mean * mean : 0.0;
+            double stddev = variance > 0.0 ? sqrt(variance) : 0.0;
+
+            UnitAlgebra average = UnitAlgebra("1ps") * (ev->count ? ev->sum / ev->count : 0);
+            UnitAlgebra min = UnitAlgebra("1ps") * (ev->count ? ev->min : 0);
+            UnitAlgebra max = UnitAlgebra("1ps") * ev->max;
+            out.output("%9.2f %9.3f %15s %15s %15s",offered,accepted,average.toStringBestSI().c_str(),
+                       min.toStringBestSI().c_str(),max.toStringBestSI().c_str());
+            if ( saturated ) out.output("*\n");
             else out.output("\n");
+
+            if ( csv ) {
+                fprintf(csv, "%f,%f,%f,%" PRIu64 ",%" PRIu64 ",%f,%" PRIu64 ",%d\n",offered,accepted,mean,
+                        ev->count ? ev->min : 0,ev->max,stddev,ev->count,saturated ? 1 : 0);
+            }
         }
         out.output("\n");
+        if ( saturated_at == -1 ) {
+            out.output("Saturation not reached\n");
+        }
+        else if ( saturated_at == 0 ) {
+            out.output("Saturated at the lowest offered load (%.2f)\n",offered_load[0]);
+        }
+        else {
+            out.output("Saturation point between offered load %.2f and %.2f\n",
+                       offered_load[saturated_at - 1],offered_load[saturated_at]);
+        }
+        out.output("\n");
+
+        if ( csv ) fclose(csv);
 
     }
 }
@@ -257,8 +308,9 @@ OfferedLoad::handle_receives(int vn)
     if ( req != NULL ) {
         SimTime_t current_time = getCurrentSimTime(base_tc);
         // Don't start counting until after warmup.  This is stored in
-        // start_time.
-        if ( start_time <= current_time ) {
+        // start_time.  Stop counting at the end of the collect period
+        // so the accepted load is measured over collect_time.
+        if ( start_time <= current_time && current_time < end_time ) {
 
             // Get the latency and add it to the complete_event)
             SimTime_t latency = current_time - ((offered_load_event*)req->inspectPayload())->start_time;
@@ -376,6 +428,7 @@ OfferedLoad::end_handler(Event* ev) {
         // Compute the new start_time for recording values (after the
         // warm up period)
         start_time = next_time + warmup_time;
+        end_time = start_time + collect_time;
 
         // Need to send the next event to end this round.  The total
         // time to the next ending is drain_time + warmup_time +
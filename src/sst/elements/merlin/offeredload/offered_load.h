@@ -131,10 +131,12 @@ public:
         {"buffer_size",      "Size of input and output buffers.","1kB"},
         {"packet_size",      "Packet size specified in either b or B (can include SI prefix).","32B"},
         {"pattern",          "Traffic pattern to use.","merlin.targetgen.uniform"},
-        {"offered_load",     "Load to be offered to network.  Valid range: 0 < offered_load <= 1.0."},
+        {"offered_load",     "Load to be offered to network.  Valid range: 0 < offered_load <= 1.0.  Can be an array of loads, e.g. [0.1, 0.2, 0.4], which are stepped through in order within one simulation, each with its own warmup, collect and drain period."},
         {"warmup_time",      "Time to wait before recording latencies","1us"},
         {"collect_time",     "Time to collect data after warmup","20us"},
         {"drain_time",       "Time to drain network before stating next round","50us"},
+        {"saturation_threshold", "A load step is considered saturated if the accepted load is less than this fraction of the offered load, or if the endpoints could not inject at the offered rate.","0.9"},
+        {"output_file",      "If set, endpoint 0 also writes the latency versus throughput curve to this file as CSV.",""},
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -155,6 +157,10 @@ private:
     Params* pattern_params;
 
     UnitAlgebra serialization_time;
+    SimTime_t serialization_ps;
+
+    double saturation_threshold;
+    std::string output_file;
 
     SimTime_t next_time;
     SimTime_t send_interval;
@@ -74,6 +74,10 @@ class TemplateBase(object):
             self._callbacks[key](key,value)
 
     def __getattr__(self,key):
+        # copy.deepcopy() (used by clone) looks up special methods
+        # before the instance variables exist
+        if key.startswith("__"):
+            raise AttributeError(key)
         if key in self._req_params or key in self._opt_params:
             try:
                 x = self._params[key]
@@ -160,7 +164,7 @@ class Topology(TemplateBase):
             self._prefix = "%s."%name
     def getNetworkName(self):
         if self._prefix:
-            return self._prefix[1:]
+            return self._prefix[:-1]
         return ""
     def getName(self):
         return "NoName"
@@ -192,7 +196,7 @@ class LinkControl(NetworkInterface):
     def __init__(self):
         NetworkInterface.__init__(self)
         self._defineRequiredParams(["link_bw","input_buf_size","output_buf_size"])
-        self._defineOptionalParams(["vn_remap","checkerboard","checkerboard_alg"])
+        self._defineOptionalParams(["vn_remap","checkerboard","checkerboard_alg","cc_enable","cc_vns","cc_g","cc_min_rate","cc_rate_ai","cc_recovery_steps","cc_update_interval","cnp_interval"])
 
     # returns subcomp, port_name
     def build(self,comp,slot,slot_num,job_id,job_size,logical_nid,use_nid_remap = False):
@@ -210,6 +214,7 @@ class ReorderLinkControl(NetworkInterface):
     def __init__(self):
         NetworkInterface.__init__(self)
         self._declareClassVariables(["network_interface"])
+        self._defineOptionalParams(["reorder_window"])
 
     def setNetworkInterface(self,interface):
         self.network_interface = interface
@@ -221,6 +226,27 @@ class ReorderLinkControl(NetworkInterface):
         return self.network_interface.build(sub,"networkIF",0,job_id,job_size,nid,use_nid_map)
 
 
+class MultiRailLinkControl(NetworkInterface):
+    def __init__(self):
+        NetworkInterface.__init__(self)
+        self._declareClassVariables(["network_interface","num_rails"])
+        self._defineOptionalParams(["striping","reorder_window"])
+        self.num_rails = 2
+
+    def setNetworkInterface(self,interface):
+        self.network_interface = interface
+
+    # Returns a list of subcomps and a list of port names, one per
+    # rail.  Use with System.setNumRails(), which builds one network
+    # per rail.
+    def build(self,comp,slot,slot_num,job_id,job_size,nid,use_nid_map = False):
+        sub = comp.setSubComponent(slot,"merlin.multirail",slot_num)
+        self._applyStatisticsSettings(sub)
+        sub.addParams(self._params)
+        rails = [self.network_interface.build(sub,"rail",i,job_id,job_size,nid,use_nid_map) for i in range(self.num_rails)]
+        return ([r[0] for r in rails], [r[1] for r in rails])
+
+
 
 
 # Base class that is used to build endpoints
@@ -236,11 +262,12 @@ class Buildable(TemplateBase):
 class Job(Buildable):
     def __init__(self,job_id,size):
         Buildable.__init__(self)
-        self._declareClassVariables(["statInterval","network_interface","job_id","_nid_map","size"])
+        self._declareClassVariables(["statInterval","network_interface","job_id","_nid_map","_logical_nids","size"])
         self.job_id = job_id
         self.size = size
         self.statInterval = "0"
         self._nid_map = None
+        self._logical_nids = None
 
     def getName(self):
         return "BaseJobClass"
@@ -248,6 +275,14 @@ class Job(Buildable):
     def getSize(self):
         return self.size
 
+    # Returns the logical id within the job for the given nid.  Uses a
+    # dict instead of _nid_map.index() so building large jobs is not
+    # quadratic in the job size.
+    def getLogicalNid(self, nid):
+        if self._logical_nids is None:
+            self._logical_nids = dict((x, i) for i, x in enumerate(self._nid_map))
+        return self._logical_nids[nid]
+
 
 
 class RouterTemplate(TemplateBase):
@@ -264,11 +299,31 @@ class hr_router(RouterTemplate):
     def __init__(self):
         RouterTemplate.__init__(self)
         self._defineRequiredParams(["link_bw","flit_size","xbar_bw","input_latency","output_latency","input_buf_size","output_buf_size"])
-        self._defineOptionalParams(["xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm"])
+        self._defineOptionalParams(["xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm","portcontrol:credit_coalesce_threshold","portcontrol:credit_coalesce_interval","portcontrol:ecn_threshold","stats_summary","stats_summary_file",
+                                    "tree_saturation","tree_saturation_window","tree_saturation_threshold","tree_saturation_min_routers","tree_saturation_file"])
+        self._declareClassVariables(["_stat_detail_routers"])
+
+    # Turns on the per rank router statistics summary.  Statistics
+    # enabled on this template are then only applied to the routers
+    # whose ids are in detail_routers (none if it is empty).
+    def enableStatSummary(self, detail_routers = [], summary_file = None):
+        self.stats_summary = True
+        self.stats_summary_file = summary_file
+        self._stat_detail_routers = set(detail_routers)
+
+    # Turns on the online tree saturation detector.  The episodes found
+    # are logged once per rank at the end of simulation.
+    def enableTreeSaturationDetector(self, window = "1us", threshold = 1.0, min_routers = 2, log_file = None):
+        self.tree_saturation = True
+        self.tree_saturation_window = window
+        self.tree_saturation_threshold = threshold
+        self.tree_saturation_min_routers = min_routers
+        self.tree_saturation_file = log_file
 
     def instanceRouter(self, name, radix, rtr_id):
         rtr = sst.Component(name, "merlin.hr_router")
-        self._applyStatisticsSettings(rtr)
+        if self._stat_detail_routers is None or rtr_id in self._stat_detail_routers:
+            self._applyStatisticsSettings(rtr)
         rtr.addParams(self._params)
         rtr.addParam("num_ports",radix)
         rtr.addParam("id",rtr_id)
@@ -282,6 +337,40 @@ class hr_router(RouterTemplate):
         self._params["portcontrol:arbitration:qos_settings"] = qos_settings
 
 
+class analytic_router(RouterTemplate):
+    def __init__(self):
+        RouterTemplate.__init__(self)
+        self._defineRequiredParams(["link_bw","flit_size"])
+        self._defineOptionalParams(["hop_latency","input_latency","output_latency","input_buf_size","utilization_window","max_utilization","num_vns"])
+
+    def instanceRouter(self, name, radix, rtr_id):
+        rtr = sst.Component(name, "merlin.analytic_router")
+        self._applyStatisticsSettings(rtr)
+        rtr.addParams(self._params)
+        rtr.addParam("num_ports",radix)
+        rtr.addParam("id",rtr_id)
+        return rtr
+
+    def getTopologySlotName(self):
+        return "topology"
+
+
+class route_bench(RouterTemplate):
+    def __init__(self):
+        RouterTemplate.__init__(self)
+        self._defineOptionalParams(["num_vns","flit_size","packet_size","samples_per_pair","max_hops","fatal_on_error"])
+
+    def instanceRouter(self, name, radix, rtr_id):
+        rtr = sst.Component(name, "merlin.route_bench")
+        rtr.addParams(self._params)
+        rtr.addParam("num_ports",radix)
+        rtr.addParam("id",rtr_id)
+        return rtr
+
+    def getTopologySlotName(self):
+        return "topology"
+
+
 class SystemEndpoint(Buildable):
     def __init__(self,system):
         Buildable.__init__(self)
@@ -292,11 +381,35 @@ class SystemEndpoint(Buildable):
     def build(self, nID, extraKeys):
         # Just get the proper job object for this nID and call build
         if self._system._endpoints[nID]:
-            return self._system._endpoints[nID].build(nID, extraKeys)
+            ret = self._system._endpoints[nID].build(nID, extraKeys)
+            if isinstance(ret[1], list):
+                raise RuntimeError("Endpoint %d has a multi-rail network interface, use System.setNumRails()"%nID)
+            return ret
         else:
             return (None, None)
 
 
+class MultiRailSystemEndpoint(Buildable):
+    def __init__(self,system,rail,built):
+        Buildable.__init__(self)
+        self._declareClassVariables(["_system","_rail","_built"])
+        self._system = system
+        self._rail = rail
+        # Shared between the rails so each endpoint is only built once
+        self._built = built
+
+    def build(self, nID, extraKeys):
+        if not self._system._endpoints[nID]:
+            return (None, None)
+        if nID not in self._built:
+            (subs, port_names) = self._system._endpoints[nID].build(nID, extraKeys)
+            if not isinstance(port_names, list) or len(port_names) != self._system._num_rails:
+                raise RuntimeError("Endpoint %d needs a MultiRailLinkControl with %d rails"%(nID, self._system._num_rails))
+            self._built[nID] = (subs, port_names)
+        (subs, port_names) = self._built[nID]
+        return (subs[self._rail], port_names[self._rail])
+
+
 class System:
 
     # Functions used to allocated endpoints to jobs
@@ -309,8 +422,7 @@ class System:
         
     def __init__(self):
         self._topology = None
-        #self.num_rails = 0
-        #self.multirail_mode = None
+        self._num_rails = 1
         self._allocation_block_size = 1
         self._available_nodes = None
         self._num_nodes = None
@@ -321,14 +433,30 @@ class System:
 
     # Build the system
     def build(self):
-        system_ep = SystemEndpoint(self)
-        self._topology.build(system_ep)
-
-    #def setNumRails(self,num_rails):
-    #    self.num_rails = num_rails
+        if self._num_rails == 1:
+            system_ep = SystemEndpoint(self)
+            self._topology.build(system_ep)
+            return
+
+        # One copy of the topology per rail, each with its own
+        # network name so component and link names don't collide
+        topos = [self._topology] + [self._topology.clone() for i in range(1, self._num_rails)]
+        base_name = self._topology.getNetworkName()
+        built = dict()
+        for rail in range(self._num_rails):
+            if base_name:
+                topos[rail].setNetworkName("%s.rail%d"%(base_name,rail))
+            else:
+                topos[rail].setNetworkName("rail%d"%rail)
+            topos[rail].build(MultiRailSystemEndpoint(self,rail,built))
 
-    #def setMultiRailMode(self,mode):
-    #    self.multirail_mode = mode
+    # Builds num_rails identical networks.  Endpoints need a
+    # MultiRailLinkControl network interface with the same number of
+    # rails.
+    def setNumRails(self,num_rails):
+        if num_rails < 1:
+            raise ValueError("num_rails must be at least 1")
+        self._num_rails = num_rails
 
     def setTopology(self,topology, allocation_block_size = 1):
         self._topology = topology
@@ -361,6 +489,7 @@ class System:
             self._endpoints[i] = job
 
         job._nid_map = nid_map
+        job._logical_nids = None
 
 
 
@@ -34,7 +34,7 @@ class TestJob(Job):
         nic.addParams(self._params)
         nic.addParams(extraKeys)
         # Get the logical node id
-        id = self._nid_map.index(nID)
+        id = self.getLogicalNid(nID)
         nic.addParam("id", id)
 
         #  Add the linkcontrol
@@ -43,12 +43,37 @@ class TestJob(Job):
         return (networkif,port_name)
 
 
+class BackgroundTrafficJob(Job):
+    def __init__(self,job_id,size):
+        Job.__init__(self,job_id,size)
+        self._defineRequiredParams(["offered_load","pattern","num_peers"])
+        self.num_peers = size
+        self._defineOptionalParams(["message_size","mode","flow_samples",
+                                    "pattern:shape","pattern:hosts_per_router","pattern:hosts_per_group","pattern:shift","pattern:random_in_group",
+                                    "pattern:min","pattern:max"])
+
+    def getName(self):
+        return "BackgroundTrafficJob"
+
+    def build(self, nID, extraKeys):
+        nic = sst.Component("background_traffic.%d"%nID, "merlin.background_traffic")
+        self._applyStatisticsSettings(nic)
+        nic.addParams(self._params)
+        nic.addParams(extraKeys)
+        id = self.getLogicalNid(nID)
+
+        #  Add the linkcontrol
+        networkif, port_name = self.network_interface.build(nic,"networkIF",0,self.job_id,self.size,id,True)
+
+        return (networkif,port_name)
+
+
 class OfferedLoadJob(Job):
     def __init__(self,job_id,size):
         Job.__init__(self,job_id,size)
         self._defineRequiredParams(["offered_load","pattern","num_peers","message_size","link_bw"])
         self.num_peers = size
-        self._defineOptionalParams(["warmup_time","collect_time","drain_time"])
+        self._defineOptionalParams(["warmup_time","collect_time","drain_time","saturation_threshold","output_file"])
 
     def getName(self):
         return "Offered Load Job"
@@ -58,7 +83,7 @@ class OfferedLoadJob(Job):
         self._applyStatisticsSettings(nic)
         nic.addParams(self._params)
         nic.addParams(extraKeys)
-        id = self._nid_map.index(nID)
+        id = self.getLogicalNid(nID)
         nic.addParam("id", id)
 
         return (networkif, portname)
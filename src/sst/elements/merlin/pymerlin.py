@@ -49,16 +49,25 @@ class Params(dict):
 _params = Params()
 debug = 0
 
+# Optional PortControl parameters passed through to the routers
+_portcontrol_keys = ["portcontrol:output_arb","portcontrol:arbitration:qos_settings","portcontrol:arbitration:arb_vns","portcontrol:arbitration:arb_vcs","portcontrol:credit_coalesce_threshold","portcontrol:credit_coalesce_interval","portcontrol:ecn_threshold"]
+
 class Topo(object):
     def __init__(self):
         self.topoKeys = []
         self.topoOptKeys = []
         self.bundleEndpoints = True
+        self.bundleGroups = False
         def epFunc(epID):
             return None
         self._getEndPoint = epFunc
     def keepEndPointsWithRouter(self):
         self.bundleEndpoints = False
+    # Marks links inside a router group as no-cut so the partitioner
+    # keeps each group on one rank.  Only used by topoDragonFly and
+    # topoDragonFly2.
+    def keepGroupsTogether(self):
+        self.bundleGroups = True
     def getName(self):
         return "NoName"
     def prepParams(self):
@@ -76,14 +85,19 @@ class Topo(object):
     def findRouterById(self,rtr_id):
         return sst.findComponentByName(self.getRouterNameForId(rtr_id))
     def _instanceRouter(self,rtr_id,rtr_type):
-        return sst.Component(self.getRouterNameForId(rtr_id),rtr_type)
+        # router_type can be used to swap in a different router model
+        rtr_type = _params.get("router_type",rtr_type)
+        rtr = sst.Component(self.getRouterNameForId(rtr_id),rtr_type)
+        if rtr_type == "merlin.analytic_router":
+            rtr.addParams(_params.subset([], ["hop_latency","utilization_window","max_utilization"]))
+        return rtr
 
 
 class topoSimple(Topo):
     def __init__(self):
         Topo.__init__(self)
         self.topoKeys.extend(["topology", "debug", "num_ports", "flit_size", "link_bw", "xbar_bw","input_latency","output_latency","input_buf_size","output_buf_size"])
-        self.topoOptKeys.extend(["xbar_arb","num_vns","vn_remap","vn_remap_shm","portcontrol:output_arb","portcontrol:arbitration:qos_settings","portcontrol:arbitration:arb_vns","portcontrol:arbitration:arb_vcs"])
+        self.topoOptKeys.extend(["xbar_arb","num_vns","vn_remap","vn_remap_shm"] + _portcontrol_keys)
     def getName(self):
         return "Simple"
     def prepParams(self):
@@ -119,7 +133,7 @@ class topoTorus(Topo):
     def __init__(self):
         Topo.__init__(self)
         self.topoKeys.extend(["topology", "debug", "num_ports", "flit_size", "link_bw", "xbar_bw", "torus:shape", "torus:width", "torus:local_ports","input_latency","output_latency","input_buf_size","output_buf_size"])
-        self.topoOptKeys.extend(["xbar_arb","num_vns","vn_remap","vn_remap_shm","portcontrol:output_arb","portcontrol:arbitration:qos_settings","portcontrol:arbitration:arb_vns","portcontrol:arbitration:arb_vcs"])
+        self.topoOptKeys.extend(["xbar_arb","num_vns","vn_remap","vn_remap_shm"] + _portcontrol_keys)
     def getName(self):
         return "Torus"
     def prepParams(self):
@@ -199,7 +213,7 @@ class topoTorus(Topo):
                 links[name] = sst.Link(name)
             return links[name]
 
-        swap_keys = [("torus:shape","shape"),("torus:width","width"),("torus:local_ports","local_ports")]
+        swap_keys = [("torus:shape","shape"),("torus:width","width"),("torus:local_ports","local_ports"),("torus:table_routing","table_routing")]
 
         _topo_params = _params.subsetWithRename(swap_keys);
 
@@ -249,7 +263,7 @@ class topoMesh(Topo):
     def __init__(self):
         Topo.__init__(self)
         self.topoKeys = ["topology", "debug", "num_ports", "flit_size", "link_bw", "xbar_bw", "mesh:shape", "mesh:width", "mesh:local_ports","input_latency","output_latency","input_buf_size","output_buf_size"]
-        self.topoOptKeys = ["xbar_arb","num_vns","vn_remap","vn_remap_shm","portcontrol:output_arb","portcontrol:arbitration:qos_settings","portcontrol:arbitration:arb_vns","portcontrol:arbitration:arb_vcs"]
+        self.topoOptKeys = ["xbar_arb","num_vns","vn_remap","vn_remap_shm"] + _portcontrol_keys
     def getName(self):
         return "Mesh"
     def prepParams(self):
@@ -384,7 +398,7 @@ class topoHyperX(Topo):
     def __init__(self):
         Topo.__init__(self)
         self.topoKeys = ["topology", "debug", "num_ports", "flit_size", "link_bw", "xbar_bw", "hyperx:shape", "hyperx:width", "hyperx:local_ports","input_latency","output_latency","input_buf_size","output_buf_size"]
-        self.topoOptKeys = ["xbar_arb","num_vns","vn_remap","vn_remap_shm","portcontrol:output_arb","portcontrol:arbitration:qos_settings","portcontrol:arbitration:arb_vns","portcontrol:arbitration:arb_vcs"]
+        self.topoOptKeys = ["xbar_arb","num_vns","vn_remap","vn_remap_shm"] + _portcontrol_keys
     def getName(self):
         return "HyperX"
     def prepParams(self):
@@ -469,7 +483,7 @@ class topoHyperX(Topo):
             #print("Getting link with name: %s"%name)
             return links[name]
 
-        swap_keys = [("hyperx:shape","shape"),("hyperx:width","width"),("hyperx:local_ports","local_ports"),("hyperx:algorithm","algorithm")]
+        swap_keys = [("hyperx:shape","shape"),("hyperx:width","width"),("hyperx:local_ports","local_ports"),("hyperx:algorithm","algorithm"),("hyperx:ugal_bias","ugal_bias"),("hyperx:table_routing","table_routing")]
 
         _topo_params = _params.subsetWithRename(swap_keys);
 
@@ -523,7 +537,7 @@ class topoFatTree(Topo):
     def __init__(self):
         Topo.__init__(self)
         self.topoKeys = ["topology", "debug", "flit_size", "link_bw", "xbar_bw","input_latency","output_latency","input_buf_size","output_buf_size", "fattree:shape"]
-        self.topoOptKeys = ["xbar_arb", "fattree:routing_alg", "fattree:adaptive_threshold","num_vns","vn_remap","vn_remap_shm","portcontrol:output_arb","portcontrol:arbitration:qos_settings","portcontrol:arbitration:arb_vns","portcontrol:arbitration:arb_vcs"]
+        self.topoOptKeys = ["xbar_arb", "fattree:routing_alg", "fattree:adaptive_threshold","num_vns","vn_remap","vn_remap_shm"] + _portcontrol_keys
         self.nicKeys = ["link_bw"]
         self.ups = []
         self.downs = []
@@ -692,7 +706,7 @@ class topoFatTree(Topo):
     def build(self):
 #        print("build()")
 
-        swap_keys = [("fattree:shape","shape"),("fattree:algorithm","algorithm"),("fattree:adaptive_threshold","adaptive_threshold")]
+        swap_keys = [("fattree:shape","shape"),("fattree:algorithm","algorithm"),("fattree:routing_alg","routing_alg"),("fattree:adaptive_threshold","adaptive_threshold"),("fattree:table_routing","table_routing"),("fattree:share_routing_table","share_routing_table")]
 
         self._topo_params = _params.subsetWithRename(swap_keys);
 
@@ -753,7 +767,7 @@ class topoDragonFly(Topo):
     def __init__(self):
         Topo.__init__(self)
         self.topoKeys = ["topology", "debug", "num_ports", "flit_size", "link_bw", "xbar_bw", "dragonfly:hosts_per_router", "dragonfly:routers_per_group", "dragonfly:intergroup_per_router", "dragonfly:num_groups","dragonfly:intergroup_links","input_latency","output_latency","input_buf_size","output_buf_size","dragonfly:global_route_mode"]
-        self.topoOptKeys = ["xbar_arb","link_bw:host","link_bw:group","link_bw:global","input_latency:host","input_latency:group","input_latency:global","output_latency:host","output_latency:group","output_latency:global","input_buf_size:host","input_buf_size:group","input_buf_size:global","output_buf_size:host","output_buf_size:group","output_buf_size:global","num_vns","vn_remap","vn_remap_shm","portcontrol:output_arb","portcontrol:arbitration:qos_settings","portcontrol:arbitration:arb_vns","portcontrol:arbitration:arb_vcs"]
+        self.topoOptKeys = ["xbar_arb","link_bw:host","link_bw:group","link_bw:global","input_latency:host","input_latency:group","input_latency:global","output_latency:host","output_latency:group","output_latency:global","input_buf_size:host","input_buf_size:group","input_buf_size:global","output_buf_size:host","output_buf_size:group","output_buf_size:global","num_vns","vn_remap","vn_remap_shm"] + _portcontrol_keys
         self.global_link_map = None
         self.global_routes = "absolute"
 
@@ -881,7 +895,7 @@ class topoDragonFly(Topo):
 
         #########################
 
-        swap_keys = [("dragonfly:hosts_per_router","hosts_per_router"),("dragonfly:routers_per_group","routers_per_group"),("dragonfly:intergroup_links","intergroup_links"),("dragonfly:num_groups","num_groups"),("dragonfly:intergroup_per_router","intergroup_per_router"),("dragonfly:algorithm","algorithm"),("dragonfly:global_route_mode","global_route_mode"),("dragonfly:adaptive_threshold","adaptive_threshold")]
+        swap_keys = [("dragonfly:hosts_per_router","hosts_per_router"),("dragonfly:routers_per_group","routers_per_group"),("dragonfly:intergroup_links","intergroup_links"),("dragonfly:num_groups","num_groups"),("dragonfly:intergroup_per_router","intergroup_per_router"),("dragonfly:algorithm","algorithm"),("dragonfly:global_route_mode","global_route_mode"),("dragonfly:adaptive_threshold","adaptive_threshold"),("dragonfly:table_routing","table_routing")]
 
         _topo_params = _params.subsetWithRename(swap_keys);
 
@@ -910,7 +924,7 @@ class topoDragonFly(Topo):
                     ep = self._getEndPoint(nic_num).build(nic_num, {})
                     if ep:
                         link = sst.Link("link:g%dr%dh%d"%(g, r, p))
-                        if self.bundleEndpoints:
+                        if self.bundleEndpoints or self.bundleGroups:
                             link.setNoCut()
                         link.connect(ep, (rtr, "port%d"%port, _params["link_lat"]) )
                     nic_num = nic_num + 1
@@ -920,13 +934,16 @@ class topoDragonFly(Topo):
                     if p != r:
                         src = min(p,r)
                         dst = max(p,r)
-                        rtr.addLink(getLink("link:g%dr%dr%d"%(g, src, dst)), "port%d"%port, _params["link_lat"])
+                        link = getLink("link:g%dr%dr%d"%(g, src, dst))
+                        if self.bundleGroups:
+                            link.setNoCut()
+                        rtr.addLink(link, "port%d"%port, _params["link_lat"])
                         port = port + 1
 
                 for p in range(_params["dragonfly:intergroup_per_router"]):
                     link = getGlobalLink(g,r,p)
                     if link is not None:
-                        rtr.addLink(link,"port%d"%port, _params["link_lat"])
+                        rtr.addLink(link,"port%d"%port, _params.get("global_link_lat", _params["link_lat"]))
                     port = port +1
 
                 router_num = router_num +1
@@ -1016,7 +1033,7 @@ class topoDragonFly2(Topo):
     def __init__(self):
         Topo.__init__(self)
         self.topoKeys = ["topology", "debug", "num_ports", "flit_size", "link_bw", "xbar_bw", "dragonfly:hosts_per_router", "dragonfly:routers_per_group", "dragonfly:intergroup_per_router", "dragonfly:num_groups","dragonfly:intergroup_links","input_latency","output_latency","input_buf_size","output_buf_size","dragonfly:global_route_mode"]
-        self.topoOptKeys = ["xbar_arb","link_bw:host","link_bw:group","link_bw:global","input_latency:host","input_latency:group","input_latency:global","output_latency:host","output_latency:group","output_latency:global","input_buf_size:host","input_buf_size:group","input_buf_size:global","output_buf_size:host","output_buf_size:group","output_buf_size:global","num_vns","vn_remap","vn_remap_shm","portcontrol:output_arb","portcontrol:arbitration:qos_settings","portcontrol:arbitration:arb_vns","portcontrol:arbitration:arb_vcs"]
+        self.topoOptKeys = ["xbar_arb","link_bw:host","link_bw:group","link_bw:global","input_latency:host","input_latency:group","input_latency:global","output_latency:host","output_latency:group","output_latency:global","input_buf_size:host","input_buf_size:group","input_buf_size:global","output_buf_size:host","output_buf_size:group","output_buf_size:global","num_vns","vn_remap","vn_remap_shm"] + _portcontrol_keys
         self.global_link_map = None
         self.global_routes = "absolute"
 
@@ -1143,7 +1160,7 @@ class topoDragonFly2(Topo):
         #_topo_params["global_route_mode"] = _params["dragonfly:global_route_mode"]
         #_topo_params["adaptive_threshold"] = _params["dragonfly:adaptive_threshold"]
 
-        swap_keys = [("dragonfly:hosts_per_router","hosts_per_router"),("dragonfly:routers_per_group","routers_per_group"),("dragonfly:intergroup_links","intergroup_links"),("dragonfly:num_groups","num_groups"),("dragonfly:intergroup_per_router","intergroup_per_router"),("dragonfly:algorithm","algorithm"),("dragonfly:global_route_mode","global_route_mode"),("dragonfly:adaptive_threshold","adaptive_threshold")]
+        swap_keys = [("dragonfly:hosts_per_router","hosts_per_router"),("dragonfly:routers_per_group","routers_per_group"),("dragonfly:intergroup_links","intergroup_links"),("dragonfly:num_groups","num_groups"),("dragonfly:intergroup_per_router","intergroup_per_router"),("dragonfly:algorithm","algorithm"),("dragonfly:global_route_mode","global_route_mode"),("dragonfly:adaptive_threshold","adaptive_threshold"),("dragonfly:table_routing","table_routing")]
 
         _topo_params = _params.subsetWithRename(swap_keys);
 
@@ -1172,7 +1189,7 @@ class topoDragonFly2(Topo):
                     ep = self._getEndPoint(nic_num).build(nic_num, {})
                     if ep:
                         link = sst.Link("link:g%dr%dh%d"%(g, r, p))
-                        if self.bundleEndpoints:
+                        if self.bundleEndpoints or self.bundleGroups:
                             link.setNoCut()
                         link.connect(ep, (rtr, "port%d"%port, _params["link_lat"]) )
                     nic_num = nic_num + 1
@@ -1182,13 +1199,16 @@ class topoDragonFly2(Topo):
                     if p != r:
                         src = min(p,r)
                         dst = max(p,r)
-                        rtr.addLink(getLink("link:g%dr%dr%d"%(g, src, dst)), "port%d"%port, _params["link_lat"])
+                        link = getLink("link:g%dr%dr%d"%(g, src, dst))
+                        if self.bundleGroups:
+                            link.setNoCut()
+                        rtr.addLink(link, "port%d"%port, _params["link_lat"])
                         port = port + 1
 
                 for p in range(_params["dragonfly:intergroup_per_router"]):
                     link = getGlobalLink(g,r,p)
                     if link is not None:
-                        rtr.addLink(link,"port%d"%port, _params["link_lat"])
+                        rtr.addLink(link,"port%d"%port, _params.get("global_link_lat", _params["link_lat"]))
                     port = port +1
 
                 router_num = router_num +1
@@ -1350,7 +1370,9 @@ class OfferedLoadEndPoint(EndPoint):
         #self.enableAllStats = False;
         #self.statInterval = "0"
         self.epKeys.extend(["offered_load", "num_peers", "link_bw", "message_size", "buffer_size", "pattern"])
-        self.epOptKeys.extend(["linkcontrol"])
+        self.epOptKeys.extend(["linkcontrol", "warmup_time", "collect_time", "drain_time", "saturation_threshold", "output_file",
+                               "pattern:min", "pattern:max", "pattern:shape", "pattern:hosts_per_router", "pattern:hosts_per_group",
+                               "pattern:shift", "pattern:random_in_group"])
 
     def getName(self):
         return "Offered Load End Point"
@@ -17,6 +17,7 @@
 #include <Python.h>
 
 #include "pymodule.h"
+#include "topology/linkTables.h"
 
 static char pymerlin[] = {
 #include "pymerlin.inc"
@@ -30,3 +31,183 @@ void* genMerlinPyModule(void)
     return PyImport_ExecCodeModule("sst.merlin", code);
 }
 
+
+
+/*
+  sst.merlin.native: helpers implemented in C/C++ that the python
+  topology builders use when constructing large networks.
+*/
+
+#if PY_MAJOR_VERSION >= 3
+#define MERLIN_PYSTRING_FROMSTRING PyUnicode_FromString
+#else
+#define MERLIN_PYSTRING_FROMSTRING PyString_FromString
+#endif
+
+/* Converts a python sequence of ints into a malloc'd array */
+static int* intArrayFromSequence(PyObject* seq, Py_ssize_t* len)
+{
+    PyObject* fast = PySequence_Fast(seq, "expected a sequence of integers");
+    if ( fast == NULL ) return NULL;
+
+    *len = PySequence_Fast_GET_SIZE(fast);
+    int* array = (int*)PyMem_Malloc((*len + 1) * sizeof(int));
+    if ( array == NULL ) {
+        Py_DECREF(fast);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    for ( Py_ssize_t i = 0; i < *len; i++ ) {
+        long value = PyLong_AsLong(PySequence_Fast_GET_ITEM(fast, i));
+        if ( value == -1 && PyErr_Occurred() ) {
+            PyMem_Free(array);
+            Py_DECREF(fast);
+            return NULL;
+        }
+        array[i] = (int)value;
+    }
+    Py_DECREF(fast);
+    return array;
+}
+
+/*
+  Converts a link table into the python tuple (names, connections),
+  where names is the list of link names and connections[router] is a
+  list of (port, link_index) tuples.
+*/
+static PyObject* linkTableToPython(MerlinLinkTable* table)
+{
+    if ( table == NULL ) {
+        PyErr_SetString(PyExc_ValueError, merlinLinkTableError());
+        return NULL;
+    }
+
+    int num_links = merlinLinkTableNumLinks(table);
+    int num_routers = merlinLinkTableNumRouters(table);
+    PyObject* names = PyList_New(num_links);
+    PyObject* conns = PyList_New(num_routers);
+    if ( names == NULL || conns == NULL ) goto error;
+
+    for ( int i = 0; i < num_links; i++ ) {
+        PyObject* name = MERLIN_PYSTRING_FROMSTRING(merlinLinkTableLinkName(table, i));
+        if ( name == NULL ) goto error;
+        PyList_SET_ITEM(names, i, name);
+    }
+
+    for ( int r = 0; r < num_routers; r++ ) {
+        int count = merlinLinkTableNumConnections(table, r);
+        PyObject* list = PyList_New(count);
+        if ( list == NULL ) goto error;
+        PyList_SET_ITEM(conns, r, list);
+        for ( int i = 0; i < count; i++ ) {
+            int port, link;
+            merlinLinkTableConnection(table, r, i, &port, &link);
+            PyObject* conn = Py_BuildValue("(ii)", port, link);
+            if ( conn == NULL ) goto error;
+            PyList_SET_ITEM(list, i, conn);
+        }
+    }
+
+    merlinFreeLinkTable(table);
+    return Py_BuildValue("(NN)", names, conns);
+
+error:
+    Py_XDECREF(names);
+    Py_XDECREF(conns);
+    merlinFreeLinkTable(table);
+    return NULL;
+}
+
+static PyObject* dragonflyLinks(PyObject* self, PyObject* args)
+{
+    const char* prefix;
+    int hosts_per_router, routers_per_group, intergroup_per_router, num_groups, relative;
+    PyObject* glm_obj;
+
+    if ( !PyArg_ParseTuple(args, "siiiiOi", &prefix, &hosts_per_router, &routers_per_group,
+                           &intergroup_per_router, &num_groups, &glm_obj, &relative) ) {
+        return NULL;
+    }
+
+    Py_ssize_t glm_len;
+    int* glm = intArrayFromSequence(glm_obj, &glm_len);
+    if ( glm == NULL ) return NULL;
+    if ( glm_len != (Py_ssize_t)intergroup_per_router * routers_per_group ) {
+        PyMem_Free(glm);
+        PyErr_SetString(PyExc_ValueError, "global_link_map must have intergroup_per_router * routers_per_group entries");
+        return NULL;
+    }
+
+    MerlinLinkTable* table = merlinDragonflyLinkTable(prefix, hosts_per_router, routers_per_group,
+                                                      intergroup_per_router, num_groups, glm, relative);
+    PyMem_Free(glm);
+    return linkTableToPython(table);
+}
+
+static PyObject* fattreeLinks(PyObject* self, PyObject* args)
+{
+    const char* prefix;
+    PyObject* downs_obj;
+    PyObject* ups_obj;
+
+    if ( !PyArg_ParseTuple(args, "sOO", &prefix, &downs_obj, &ups_obj) ) return NULL;
+
+    Py_ssize_t num_downs, num_ups;
+    int* downs = intArrayFromSequence(downs_obj, &num_downs);
+    if ( downs == NULL ) return NULL;
+    int* ups = intArrayFromSequence(ups_obj, &num_ups);
+    if ( ups == NULL ) {
+        PyMem_Free(downs);
+        return NULL;
+    }
+
+    MerlinLinkTable* table = NULL;
+    if ( num_ups + 1 != num_downs ) {
+        PyErr_SetString(PyExc_ValueError, "fat tree shape must have one more down than up entry");
+    }
+    else {
+        table = merlinFattreeLinkTable(prefix, (int)num_downs, downs, ups);
+    }
+    PyMem_Free(downs);
+    PyMem_Free(ups);
+    if ( table == NULL && PyErr_Occurred() ) return NULL;
+    return linkTableToPython(table);
+}
+
+static PyMethodDef nativeMethods[] = {
+    { "dragonfly_links", dragonflyLinks, METH_VARARGS,
+      "dragonfly_links(prefix, hosts_per_router, routers_per_group, intergroup_per_router, num_groups, global_link_map, relative)"
+      " -> (link_names, connections)" },
+    { "fattree_links", fattreeLinks, METH_VARARGS,
+      "fattree_links(prefix, downs, ups) -> (link_names, connections)" },
+    { NULL, NULL, 0, NULL }
+};
+
+#if PY_MAJOR_VERSION >= 3
+static struct PyModuleDef nativeModuleDef = {
+    PyModuleDef_HEAD_INIT,
+    "sst.merlin.native",
+    "Native helpers for the merlin python topologies",
+    -1,
+    nativeMethods
+};
+#endif
+
+void* genMerlinNativeModule(void* parent)
+{
+#if PY_MAJOR_VERSION >= 3
+    PyObject* module = PyModule_Create(&nativeModuleDef);
+#else
+    PyObject* module = Py_InitModule("sst.merlin.native", nativeMethods);
+    Py_XINCREF(module);
+#endif
+    if ( module == NULL ) return NULL;
+
+    // Register the module so "from sst.merlin.native import ..." works
+    if ( PyDict_SetItemString(PyImport_GetModuleDict(), "sst.merlin.native", module) < 0 ||
+         (parent != NULL && PyModule_AddObject((PyObject*)parent, "native", module) < 0) ) {
+        Py_DECREF(module);
+        return NULL;
+    }
+    return module;
+}
@@ -25,6 +25,9 @@ extern "C" {
 
 void* genMerlinPyModule(void);
 
+// Adds the sst.merlin.native module to the loaded sst.merlin module
+void* genMerlinNativeModule(void* parent);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,7 +27,11 @@
 #include <sst/core/unitAlgebra.h>
 #include <sst/core/interfaces/simpleNetwork.h>
 
+#include "activeVCSet.h"
+
 #include <queue>
+#include <vector>
+#include <stdint.h>
 
 namespace SST {
 namespace Merlin {
@@ -37,7 +41,7 @@ namespace Merlin {
 const int INIT_BROADCAST_ADDR = -1;
 
 class TopologyEvent;
-    
+
 class Router : public Component {
 private:
     bool requestNotifyOnEvent;
@@ -53,6 +57,7 @@ protected:
     { requestNotifyOnEvent = state; }
 
     int vcs_with_data;
+    ActiveVCSet active_vcs;
     
 public:
 
@@ -68,8 +73,8 @@ public:
    
     virtual void notifyEvent() {}
 
-    inline void inc_vcs_with_data() { vcs_with_data++; }
-    inline void dec_vcs_with_data() { vcs_with_data--; }
+    inline void inc_vcs_with_data(int port, int vc) { vcs_with_data++; active_vcs.set(port, vc); }
+    inline void dec_vcs_with_data(int port, int vc) { vcs_with_data--; active_vcs.clear(port, vc); }
     inline int get_vcs_with_data() { return vcs_with_data; }
 
     virtual int const* getOutputBufferCredits() = 0;
@@ -80,11 +85,92 @@ public:
 #define MERLIN_ENABLE_TRACE
 
 
+// Recycling allocator for the router events.  Every packet allocates
+// an RtrEvent, an internal_router_event at each ingress router and a
+// credit_event per hop, so freed events are kept on per-thread free
+// lists (by size, in 16 byte classes) and handed back out instead of
+// going to the heap.  Memory freed on a different thread than it was
+// allocated on moves to that thread's lists.  Traffic that only flows
+// one way between threads would grow the receiving thread's lists
+// forever, so each thread holds at most max_free_blocks blocks and
+// anything freed past that goes back to the heap.
+class RtrEventPool {
+public:
+    static inline void* allocate(size_t size) {
+        size_t bucket = getBucket(size);
+        if ( bucket >= num_buckets ) return ::operator new(size);
+
+        ThreadPool& p = pool();
+        std::vector<void*>& list = p.free_list[bucket];
+        if ( !list.empty() ) {
+            void* ptr = list.back();
+            list.pop_back();
+            p.held--;
+            p.reuses++;
+            return ptr;
+        }
+        p.allocs++;
+        return ::operator new((bucket + 1) * granularity);
+    }
+
+    static inline void release(void* ptr, size_t size) {
+        size_t bucket = getBucket(size);
+        ThreadPool& p = pool();
+        if ( bucket >= num_buckets || p.held >= max_free_blocks ) {
+            ::operator delete(ptr);
+            return;
+        }
+        p.free_list[bucket].push_back(ptr);
+        if ( ++p.held > p.max_held ) p.max_held = p.held;
+    }
+
+    // Counts for the calling thread
+    static uint64_t getAllocCount() { return pool().allocs; }
+    static uint64_t getReuseCount() { return pool().reuses; }
+    static uint64_t getMaxHeldCount() { return pool().max_held; }
+
+    static const size_t max_free_blocks = 4096;
+
+private:
+    static const size_t granularity = 16;
+    static const size_t num_buckets = 32;
+
+    struct ThreadPool {
+        std::vector<void*> free_list[num_buckets];
+        size_t held;
+        size_t max_held;
+        uint64_t allocs;
+        uint64_t reuses;
+
+        ThreadPool() : held(0), max_held(0), allocs(0), reuses(0) {}
+        ~ThreadPool() {
+            for ( size_t i = 0; i < num_buckets; ++i ) {
+                for ( void* ptr : free_list[i] ) ::operator delete(ptr);
+            }
+        }
+    };
+
+    static inline size_t getBucket(size_t size) { return (size - 1) / granularity; }
+
+    static inline ThreadPool& pool() {
+        static thread_local ThreadPool p;
+        return p;
+    }
+};
+
+
 class BaseRtrEvent : public Event {
 
 public:
     enum RtrEventType {CREDIT, PACKET, INTERNAL, TOPOLOGY, INITIALIZATION};
 
+    // All router events (including the topology specific
+    // internal_router_events) come from the recycling pool.  Sized
+    // delete gets the size of the dynamic type since Event has a
+    // virtual destructor.
+    static void* operator new(std::size_t size) { return RtrEventPool::allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { RtrEventPool::release(ptr, size); }
+
     inline RtrEventType getType() const { return type; }
 
     void serialize_order(SST::Core::Serialization::serializer &ser)  override {
@@ -114,7 +200,9 @@ public:
     
     RtrEvent() :
         BaseRtrEvent(BaseRtrEvent::PACKET),
-        injectionTime(0)
+        injectionTime(0),
+        ecn(false),
+        cnp(false)
     {}
 
     RtrEvent(SST::Interfaces::SimpleNetwork::Request* req, SST::Interfaces::SimpleNetwork::nid_t trusted_src, int route_vn) :
@@ -122,7 +210,9 @@ public:
         request(req),
         trusted_src(trusted_src),
         route_vn(route_vn),
-        injectionTime(0)
+        injectionTime(0),
+        ecn(false),
+        cnp(false)
     {}
 
     
@@ -158,6 +248,15 @@ public:
         request = nullptr;
         return ret;
     }
+
+    // Congestion marking.  Routers set ecn on packets that leave a
+    // congested output queue.  cnp marks the congestion notification
+    // packets LinkControl sends back to the source, which are
+    // consumed by the source's LinkControl.
+    inline void setECN() { ecn = true; }
+    inline bool getECN() const { return ecn; }
+    inline void setCNP() { cnp = true; }
+    inline bool isCNP() const { return cnp; }
     
     virtual void print(const std::string& header, Output &out) const  override {
         out.output("%s RtrEvent to be delivered at %" PRIu64 " with priority %d. src = %lld (logical: %lld), dest = %lld\n",
@@ -172,6 +271,8 @@ public:
         ser & route_vn;
         ser & size_in_flits;
         ser & injectionTime;
+        ser & ecn;
+        ser & cnp;
     }
     
 private:
@@ -181,6 +282,8 @@ private:
     int route_vn;
     SimTime_t injectionTime;
     int size_in_flits;
+    bool ecn;
+    bool cnp;
 
     ImplementSerializable(SST::Merlin::RtrEvent)
     
@@ -285,21 +388,59 @@ private:
     ImplementSerializable(SST::Merlin::RtrInitEvent)
 };
 
+// Payload of the untimed requests merlin.background_traffic sends in
+// flow mode.  Instead of carrying background packets, routers reserve
+// bw on every output port the request is routed through during init.
+class BackgroundFlowEvent : public Event {
+public:
+    UnitAlgebra bw;
+
+    BackgroundFlowEvent() :
+        Event()
+    {}
+
+    BackgroundFlowEvent(const UnitAlgebra& bw) :
+        Event(),
+        bw(bw)
+    {}
+
+    virtual BackgroundFlowEvent* clone(void)  override {
+        return new BackgroundFlowEvent(*this);
+    }
+
+    virtual void print(const std::string& header, Output &out) const  override {
+        out.output("%s BackgroundFlowEvent reserving %s\n", header.c_str(), bw.toStringBestSI().c_str());
+    }
+
+    void serialize_order(SST::Core::Serialization::serializer &ser)  override {
+        Event::serialize_order(ser);
+        ser & bw;
+    }
+
+private:
+    ImplementSerializable(SST::Merlin::BackgroundFlowEvent)
+};
+
 class internal_router_event : public BaseRtrEvent {
     int next_port;
     int next_vc;
     int vc;
     int credit_return_vc;
     RtrEvent* encap_ev;
+    // Time (ns) the event arrived at the current router.  Only set
+    // when the router keeps a statistics summary.
+    SimTime_t arrival_time;
 
 public:
     internal_router_event() :
-        BaseRtrEvent(BaseRtrEvent::INTERNAL)
+        BaseRtrEvent(BaseRtrEvent::INTERNAL),
+        arrival_time(0)
     {
         encap_ev = NULL;
     }
     internal_router_event(RtrEvent* ev) :
-        BaseRtrEvent(BaseRtrEvent::INTERNAL)
+        BaseRtrEvent(BaseRtrEvent::INTERNAL),
+        arrival_time(0)
     {encap_ev = ev;}
 
     virtual ~internal_router_event() {
@@ -323,6 +464,9 @@ public:
     inline void setVC(int vc_in) {vc = vc_in; return;}
     inline int getVC() {return vc;}
 
+    inline void setArrivalTime(SimTime_t time) {arrival_time = time;}
+    inline SimTime_t getArrivalTime() const {return arrival_time;}
+
     // inline void setVN(int vn) {encap_ev->setVN(vn); return;}
     inline int getVN() {return encap_ev->route_vn;}
 
@@ -352,6 +496,7 @@ public:
         ser & vc;
         ser & credit_return_vc;
         ser & encap_ev;
+        ser & arrival_time;
     }
     
 private:
@@ -456,6 +601,11 @@ public:
 	virtual bool decreaseLinkWidth() = 0;
 	virtual bool increaseLinkWidth() = 0; 
 
+    // Reserves bw of the output link for background flows.  The
+    // reservations are collected during init and subtracted from the
+    // link bandwidth in setup.
+    virtual void reserveBandwidth(const UnitAlgebra& bw) {}
+
 
     class OutputArbitration : public SubComponent {
     public:
@@ -493,6 +643,9 @@ public:
     virtual void arbitrate(PortInterface** ports, int* port_busy, int* out_port_busy, int* progress_vc) = 0;
 #endif
     virtual void setPorts(int num_ports, int num_vcs) = 0;
+    // Called after setPorts() with the router's occupied VC bitmap.
+    // Arbiters may use it to skip empty VCs.
+    virtual void setActiveVCs(const ActiveVCSet* active) {}
     virtual bool isOkayToPauseClock() { return true; }
     virtual void reportSkippedCycles(Cycle_t cycles) {};
     virtual void dumpState(std::ostream& stream) {};
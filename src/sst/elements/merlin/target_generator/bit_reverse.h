@@ -0,0 +1,78 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_MERLIN_TARGET_GENERATOR_BIT_REVERSE_H
+#define COMPONENTS_MERLIN_TARGET_GENERATOR_BIT_REVERSE_H
+
+#include <sst/elements/merlin/target_generator/target_generator.h>
+
+#include <sst/core/output.h>
+
+namespace SST {
+namespace Merlin {
+
+
+class BitReverseDist : public TargetGenerator {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        BitReverseDist,
+        "merlin",
+        "targetgen.bit_reverse",
+        SST_ELI_ELEMENT_VERSION(0,0,1),
+        "Generates a bit reverse pattern.  The destination is the id with its address bits in reverse order.  num_peers must be a power of two.",
+        SST::Merlin::TargetGenerator)
+
+    SST_ELI_DOCUMENT_PARAMS(
+    )
+
+    int dest;
+
+public:
+
+    BitReverseDist(ComponentId_t cid, Params &params, int id, int num_peers) :
+        TargetGenerator(cid)
+    {
+        if ( num_peers <= 0 || (num_peers & (num_peers - 1)) != 0 ) {
+            Output::getDefaultObject().fatal(CALL_INFO, -1, "targetgen.bit_reverse: num_peers (%d) must be a power of two\n", num_peers);
+        }
+        initialize(id, num_peers);
+    }
+
+    ~BitReverseDist() {
+    }
+
+    void initialize(int id, int num_peers) {
+        dest = 0;
+        for ( int bit = 1; bit < num_peers; bit <<= 1 ) {
+            dest = (dest << 1) | ((id & bit) ? 1 : 0);
+        }
+    }
+
+    int getNextValue(void) {
+        return dest;
+    }
+
+    void seed(uint32_t val) {
+    }
+};
+
+} //namespace Merlin
+} //namespace SST
+
+#endif
@@ -0,0 +1,99 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_MERLIN_TARGET_GENERATOR_GROUP_SHIFT_H
+#define COMPONENTS_MERLIN_TARGET_GENERATOR_GROUP_SHIFT_H
+
+#include <sst/elements/merlin/target_generator/target_generator.h>
+
+#include <sst/core/output.h>
+#include <sst/core/rng/mersenne.h>
+
+namespace SST {
+namespace Merlin {
+
+
+class GroupShiftDist : public TargetGenerator {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        GroupShiftDist,
+        "merlin",
+        "targetgen.group_shift",
+        SST_ELI_ELEMENT_VERSION(0,0,1),
+        "Generates the adversarial dragonfly pattern where every endpoint in group g sends to group (g + shift) mod num_groups.  The endpoint within the destination group is chosen at random.",
+        SST::Merlin::TargetGenerator)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"hosts_per_group", "Number of endpoints in each group (hosts_per_router * routers_per_group for dragonfly)."},
+        {"shift",           "Number of groups to shift by.","1"},
+        {"random_in_group", "If false, send to the endpoint with the same offset in the destination group instead of a random one.","true"}
+    )
+
+    MersenneRNG* gen;
+
+    int hosts_per_group;
+    int shift;
+    bool random_in_group;
+    int group_base;
+
+public:
+
+    GroupShiftDist(ComponentId_t cid, Params &params, int id, int num_peers) :
+        TargetGenerator(cid),
+        gen(NULL)
+    {
+        hosts_per_group = params.find<int>("hosts_per_group",-1);
+        if ( hosts_per_group <= 0 || num_peers % hosts_per_group != 0 ) {
+            Output::getDefaultObject().fatal(CALL_INFO, -1, "targetgen.group_shift: hosts_per_group must be set and divide num_peers (%d)\n", num_peers);
+        }
+        shift = params.find<int>("shift",1);
+        random_in_group = params.find<bool>("random_in_group",true);
+        initialize(id, num_peers);
+    }
+
+    ~GroupShiftDist() {
+        delete gen;
+    }
+
+    void initialize(int id, int num_peers) {
+        int num_groups = num_peers / hosts_per_group;
+        int dest_group = (id / hosts_per_group + shift) % num_groups;
+        if ( dest_group < 0 ) dest_group += num_groups;
+        group_base = dest_group * hosts_per_group;
+        if ( !random_in_group ) group_base += id % hosts_per_group;
+
+        delete gen;
+        gen = new MersenneRNG(id);
+    }
+
+    int getNextValue(void) {
+        if ( !random_in_group ) return group_base;
+        return group_base + gen->generateNextUInt32() % hosts_per_group;
+    }
+
+    void seed(uint32_t val) {
+        delete gen;
+        gen = new MersenneRNG((unsigned int) val);
+    }
+};
+
+} //namespace Merlin
+} //namespace SST
+
+#endif
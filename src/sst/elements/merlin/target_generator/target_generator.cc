@@ -18,6 +18,10 @@
 
 #include <sst/elements/merlin/target_generator/uniform.h>
 #include <sst/elements/merlin/target_generator/bit_complement.h>
+#include <sst/elements/merlin/target_generator/bit_reverse.h>
+#include <sst/elements/merlin/target_generator/group_shift.h>
+#include <sst/elements/merlin/target_generator/tornado.h>
+#include <sst/elements/merlin/target_generator/transpose.h>
 
 namespace SST {
 namespace Merlin {
@@ -0,0 +1,109 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_MERLIN_TARGET_GENERATOR_TORNADO_H
+#define COMPONENTS_MERLIN_TARGET_GENERATOR_TORNADO_H
+
+#include <sst/elements/merlin/target_generator/target_generator.h>
+
+#include <sst/core/output.h>
+
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+
+class TornadoDist : public TargetGenerator {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        TornadoDist,
+        "merlin",
+        "targetgen.tornado",
+        SST_ELI_ELEMENT_VERSION(0,0,1),
+        "Generates a tornado pattern.  In each dimension of the router grid, sends to the router ceil(k/2) - 1 positions away, where k is the size of the dimension.",
+        SST::Merlin::TargetGenerator)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"shape",            "Shape of the router grid, for example 4x4x2.  Defaults to a single dimension with one router per hosts_per_router endpoints.",""},
+        {"hosts_per_router", "Number of endpoints attached to each router.","1"}
+    )
+
+    std::vector<int> dims;
+    int hosts_per_router;
+    int dest;
+
+public:
+
+    TornadoDist(ComponentId_t cid, Params &params, int id, int num_peers) :
+        TargetGenerator(cid)
+    {
+        hosts_per_router = params.find<int>("hosts_per_router",1);
+        std::string shape = params.find<std::string>("shape","");
+        if ( shape.empty() ) {
+            dims.push_back(num_peers / hosts_per_router);
+        }
+        else {
+            size_t start = 0;
+            size_t end;
+            do {
+                end = shape.find('x',start);
+                dims.push_back(std::stoi(shape.substr(start,end - start)));
+                start = end + 1;
+            } while ( end != std::string::npos );
+        }
+
+        int routers = 1;
+        for ( int d : dims ) routers *= d;
+        if ( routers * hosts_per_router != num_peers ) {
+            Output::getDefaultObject().fatal(CALL_INFO, -1, "targetgen.tornado: shape and hosts_per_router do not match num_peers (%d)\n", num_peers);
+        }
+
+        initialize(id, num_peers);
+    }
+
+    ~TornadoDist() {
+    }
+
+    void initialize(int id, int num_peers) {
+        int router = id / hosts_per_router;
+        int dest_router = 0;
+        int mult = 1;
+        for ( int d : dims ) {
+            int loc = router % d;
+            router /= d;
+            dest_router += ((loc + (d + 1) / 2 - 1) % d) * mult;
+            mult *= d;
+        }
+        dest = dest_router * hosts_per_router + id % hosts_per_router;
+    }
+
+    int getNextValue(void) {
+        return dest;
+    }
+
+    void seed(uint32_t val) {
+    }
+};
+
+} //namespace Merlin
+} //namespace SST
+
+#endif
@@ -0,0 +1,80 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_MERLIN_TARGET_GENERATOR_TRANSPOSE_H
+#define COMPONENTS_MERLIN_TARGET_GENERATOR_TRANSPOSE_H
+
+#include <sst/elements/merlin/target_generator/target_generator.h>
+
+#include <sst/core/output.h>
+
+namespace SST {
+namespace Merlin {
+
+
+class TransposeDist : public TargetGenerator {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        TransposeDist,
+        "merlin",
+        "targetgen.transpose",
+        SST_ELI_ELEMENT_VERSION(0,0,1),
+        "Generates a matrix transpose pattern.  The id is split into a row (high half of the address bits) and a column (low half), and the destination swaps them.  num_peers must be a power of two with an even number of address bits.",
+        SST::Merlin::TargetGenerator)
+
+    SST_ELI_DOCUMENT_PARAMS(
+    )
+
+    int dest;
+
+public:
+
+    TransposeDist(ComponentId_t cid, Params &params, int id, int num_peers) :
+        TargetGenerator(cid)
+    {
+        int bits = 0;
+        while ( (1 << bits) < num_peers ) bits++;
+        if ( (1 << bits) != num_peers || (bits % 2) != 0 ) {
+            Output::getDefaultObject().fatal(CALL_INFO, -1, "targetgen.transpose: num_peers (%d) must be a power of four\n", num_peers);
+        }
+        initialize(id, num_peers);
+    }
+
+    ~TransposeDist() {
+    }
+
+    void initialize(int id, int num_peers) {
+        int half = 0;
+        while ( (1 << (2 * half)) < num_peers ) half++;
+        int mask = (1 << half) - 1;
+        dest = ((id & mask) << half) | ((id >> half) & mask);
+    }
+
+    int getNextValue(void) {
+        return dest;
+    }
+
+    void seed(uint32_t val) {
+    }
+};
+
+} //namespace Merlin
+} //namespace SST
+
+#endif
@@ -0,0 +1,422 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include "sst/elements/merlin/test/route_bench/route_bench.h"
+
+#include <sst/core/params.h>
+#include <sst/core/simulation.h>
+#include <sst/core/unitAlgebra.h>
+#include <sst/core/interfaces/simpleNetwork.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+
+#include "merlin.h"
+
+using namespace SST::Merlin;
+using namespace SST::Interfaces;
+
+std::vector<route_bench*> route_bench::routers;
+int route_bench::routers_registered = 0;
+int route_bench::routers_setup = 0;
+
+// Converts sizes specified in bytes to bits
+static int toBits(const std::string& value)
+{
+    UnitAlgebra ua(value);
+    if ( ua.hasUnits("B") ) {
+        ua *= UnitAlgebra("8b/B");
+    }
+    return ua.getRoundedValue();
+}
+
+// Returns the channels on a cycle in the graph, or an empty vector if
+// the graph is acyclic.  Edges must be sorted.
+static std::vector<int> findCycle(int num_nodes, const std::vector<std::pair<int,int> >& edges)
+{
+    // Compressed adjacency lists
+    std::vector<size_t> start(num_nodes + 1, 0);
+    for ( size_t i = 0; i < edges.size(); i++ ) start[edges[i].first + 1]++;
+    for ( int i = 0; i < num_nodes; i++ ) start[i + 1] += start[i];
+
+    // 0 = not visited, 1 = on the DFS stack, 2 = done
+    std::vector<char> state(num_nodes, 0);
+    // Node and index of the next edge to follow
+    std::vector<std::pair<int,size_t> > stack;
+
+    for ( int root = 0; root < num_nodes; root++ ) {
+        if ( state[root] != 0 ) continue;
+        state[root] = 1;
+        stack.push_back(std::make_pair(root, start[root]));
+
+        while ( !stack.empty() ) {
+            int node = stack.back().first;
+            size_t edge = stack.back().second;
+            if ( edge == start[node + 1] ) {
+                state[node] = 2;
+                stack.pop_back();
+                continue;
+            }
+            stack.back().second++;
+
+            int next = edges[edge].second;
+            if ( state[next] == 1 ) {
+                // Back edge, the cycle is the stack from next up
+                std::vector<int> cycle;
+                size_t i = stack.size();
+                while ( stack[--i].first != next );
+                for ( ; i < stack.size(); i++ ) cycle.push_back(stack[i].first);
+                return cycle;
+            }
+            if ( state[next] == 0 ) {
+                state[next] = 1;
+                stack.push_back(std::make_pair(next, start[next]));
+            }
+        }
+    }
+    return std::vector<int>();
+}
+
+
+route_bench::~route_bench()
+{
+    delete [] output_credits;
+    delete [] output_queue_lengths;
+    delete topo;
+}
+
+route_bench::route_bench(ComponentId_t cid, Params& params) :
+    Router(cid),
+    output(Simulation::getSimulation()->getSimulationOutput())
+{
+    if ( Simulation::getSimulation()->getNumRanks().rank > 1 ||
+         Simulation::getSimulation()->getNumRanks().thread > 1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "route_bench only supports serial runs\n");
+    }
+
+    id = params.find<int>("id",-1);
+    if ( id == -1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "route_bench requires id to be specified\n");
+    }
+
+    num_ports = params.find<int>("num_ports",-1);
+    if ( num_ports == -1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "route_bench requires num_ports to be specified\n");
+    }
+
+    topo = loadUserSubComponent<SST::Merlin::Topology>
+        ("topology", ComponentInfo::SHARE_NONE, num_ports, id);
+
+    if ( !topo ) {
+        merlin_abort.fatal(CALL_INFO_LONG, 1, "route_bench requires topology to be specified in input file\n");
+    }
+
+    num_vns = params.find<int>("num_vns",1);
+    num_vcs = topo->computeNumVCs(num_vns);
+
+    flit_size = toBits(params.find<std::string>("flit_size","8B"));
+    size_in_bits = toBits(params.find<std::string>("packet_size","64B"));
+    if ( flit_size <= 0 || size_in_bits <= 0 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "route_bench: flit_size and packet_size must be greater than zero\n");
+    }
+
+    samples_per_pair = params.find<int>("samples_per_pair",1);
+    max_hops = params.find<int>("max_hops",0);
+    fatal_on_error = params.find<bool>("fatal_on_error",false);
+
+    links.resize(num_ports);
+    remote.assign(num_ports, remote_t(-1,-1));
+    for ( int i = 0; i < num_ports; i++ ) {
+        std::string port_name = "port" + std::to_string(i);
+        if ( topo->isHostPort(i) ) {
+            if ( isPortConnected(port_name) ) {
+                merlin_abort.fatal(CALL_INFO, -1, "route_bench: host port %d of router %d is connected.  "
+                                   "Build the system without any jobs.\n", i, id);
+            }
+            links[i] = NULL;
+            continue;
+        }
+        links[i] = configureLink(port_name, "1ns", new Event::Handler<route_bench>(this,&route_bench::handle_input));
+    }
+
+    // Every output is always empty
+    output_credits = new int[num_ports * num_vcs];
+    output_queue_lengths = new int[num_ports * num_vcs];
+    for ( int i = 0; i < num_ports * num_vcs; i++ ) {
+        output_credits[i] = size_in_bits / flit_size + 1;
+        output_queue_lengths[i] = 0;
+    }
+    topo->setOutputBufferCreditArray(output_credits, num_vcs);
+    topo->setOutputQueueLengthsArray(output_queue_lengths, num_vcs);
+
+    if ( (int)routers.size() <= id ) routers.resize(id + 1, NULL);
+    if ( routers[id] != NULL ) {
+        merlin_abort.fatal(CALL_INFO, -1, "route_bench: found two routers with id %d.  Only one network is supported.\n", id);
+    }
+    routers[id] = this;
+    routers_registered++;
+}
+
+
+void
+route_bench::init(unsigned int phase)
+{
+    for ( int i = 0; i < num_ports; i++ ) {
+        if ( links[i] == NULL ) continue;
+
+        RtrInitEvent* init_ev;
+        if ( phase == 0 ) {
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REPORT_ID;
+            init_ev->int_value = id;
+            links[i]->sendInitData(init_ev);
+
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REPORT_PORT;
+            init_ev->int_value = i;
+            links[i]->sendInitData(init_ev);
+        }
+        else if ( phase == 1 ) {
+            init_ev = static_cast<RtrInitEvent*>(links[i]->recvInitData());
+            remote[i].first = init_ev->int_value;
+            delete init_ev;
+
+            init_ev = static_cast<RtrInitEvent*>(links[i]->recvInitData());
+            remote[i].second = init_ev->int_value;
+            delete init_ev;
+        }
+    }
+}
+
+
+void
+route_bench::setup()
+{
+    // The shared regions used by some topologies are only ready once
+    // init is over, so the benchmark waits until everyone is set up
+    if ( ++routers_setup == routers_registered ) runBenchmark();
+}
+
+
+void
+route_bench::runBenchmark()
+{
+    int num_routers = routers.size();
+
+    // Number all the ports in the network and find the endpoints
+    std::vector<int> port_base(num_routers + 1, 0);
+    std::vector<remote_t> hosts;
+    for ( int r = 0; r < num_routers; r++ ) {
+        if ( routers[r] == NULL ) {
+            merlin_abort.fatal(CALL_INFO, -1, "route_bench: router ids must be contiguous, router %d is missing\n", r);
+        }
+        if ( routers[r]->num_vcs != num_vcs ) {
+            merlin_abort.fatal(CALL_INFO, -1, "route_bench: all routers must use the same number of VCs\n");
+        }
+        port_base[r + 1] = port_base[r] + routers[r]->num_ports;
+
+        Topology* t = routers[r]->topo;
+        for ( int p = 0; p < routers[r]->num_ports; p++ ) {
+            if ( !t->isHostPort(p) ) continue;
+            int ep = t->getEndpointID(p);
+            if ( ep < 0 ) continue;
+            if ( (int)hosts.size() <= ep ) hosts.resize(ep + 1, remote_t(-1,-1));
+            hosts[ep] = remote_t(r,p);
+        }
+    }
+    int num_endpoints = hosts.size();
+    int num_channels = port_base[num_routers] * num_vcs;
+    int hop_limit = max_hops > 0 ? max_hops : 2 * num_routers;
+
+    output.output("route_bench: %d routers, %d endpoints, %d VNs, %d VCs per port\n",
+                  num_routers, num_endpoints, num_vns, num_vcs);
+
+    // Describes a channel for the error and cycle reports
+    auto channelName = [&](int channel) {
+        int global_port = channel / num_vcs;
+        int r = std::upper_bound(port_base.begin(), port_base.end(), global_port) - port_base.begin() - 1;
+        return "router " + std::to_string(r) + " port " + std::to_string(global_port - port_base[r]) +
+            " vc " + std::to_string(channel % num_vcs);
+    };
+
+    bool errors = false;
+    for ( int vn = 0; vn < num_vns; vn++ ) {
+        uint64_t packets = 0;
+        uint64_t routes = 0;
+        uint64_t misroutes = 0;
+        uint64_t livelocks = 0;
+        std::vector<uint64_t> path_lengths;
+        std::vector<uint64_t> link_load(port_base[num_routers], 0);
+        std::vector<std::pair<int,int> > dependencies;
+
+        auto reportError = [&](const char* what, int src, int dst, int rtr) {
+            if ( misroutes + livelocks <= 10 ) {
+                output.output("  ERROR: %s for packet from %d to %d at router %d\n", what, src, dst, rtr);
+            }
+        };
+
+        output.output("VN %d:\n", vn);
+        auto start = std::chrono::steady_clock::now();
+        for ( int src = 0; src < num_endpoints; src++ ) {
+            if ( hosts[src].first == -1 ) continue;
+            for ( int dst = 0; dst < num_endpoints; dst++ ) {
+                if ( dst == src || hosts[dst].first == -1 ) continue;
+                for ( int s = 0; s < samples_per_pair; s++ ) {
+                    SimpleNetwork::Request* req = new SimpleNetwork::Request(dst, src, size_in_bits, true, true);
+                    req->vn = vn;
+                    RtrEvent* rtr_ev = new RtrEvent(req, src, vn);
+                    rtr_ev->computeSizeInFlits(flit_size);
+
+                    int rtr = hosts[src].first;
+                    int port = hosts[src].second;
+                    internal_router_event* ev = routers[rtr]->topo->process_input(rtr_ev);
+                    ev->setCreditReturnVC(vn);
+                    packets++;
+
+                    // Same sequence of calls hr_router makes for the
+                    // head of an input buffer
+                    int in_channel = -1;
+                    int hops = 0;
+                    while ( true ) {
+                        route_bench* router = routers[rtr];
+                        int vc = ev->getVC();
+                        router->topo->route(port, vc, ev);
+                        router->topo->reroute(port, vc, ev);
+                        routes++;
+
+                        int out_port = ev->getNextPort();
+                        int out_vc = ev->getVC();
+                        if ( out_port < 0 || out_port >= router->num_ports || out_vc < 0 || out_vc >= num_vcs ) {
+                            misroutes++;
+                            reportError("invalid port or VC", src, dst, rtr);
+                            break;
+                        }
+
+                        if ( router->topo->isHostPort(out_port) ) {
+                            if ( router->topo->getEndpointID(out_port) != dst ) {
+                                misroutes++;
+                                reportError("delivered to the wrong endpoint", src, dst, rtr);
+                            }
+                            else {
+                                if ( (int)path_lengths.size() <= hops ) path_lengths.resize(hops + 1, 0);
+                                path_lengths[hops]++;
+                            }
+                            break;
+                        }
+
+                        const remote_t& next = router->remote[out_port];
+                        if ( next.first == -1 ) {
+                            misroutes++;
+                            reportError("routed to an unconnected port", src, dst, rtr);
+                            break;
+                        }
+
+                        int global_port = port_base[rtr] + out_port;
+                        int out_channel = global_port * num_vcs + out_vc;
+                        if ( in_channel != -1 ) dependencies.push_back(std::make_pair(in_channel, out_channel));
+                        in_channel = out_channel;
+                        link_load[global_port]++;
+
+                        if ( ++hops > hop_limit ) {
+                            livelocks++;
+                            reportError("hop limit exceeded", src, dst, rtr);
+                            break;
+                        }
+                        rtr = next.first;
+                        port = next.second;
+                    }
+                    delete ev;
+                }
+            }
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        output.output("  packets routed: %" PRIu64 ", route() calls: %" PRIu64 " in %.3f s (%.3g routes/s)\n",
+                      packets, routes, elapsed, elapsed > 0.0 ? routes / elapsed : 0.0);
+
+        // Path lengths in router to router hops
+        uint64_t delivered = 0;
+        uint64_t total_hops = 0;
+        for ( size_t h = 0; h < path_lengths.size(); h++ ) {
+            delivered += path_lengths[h];
+            total_hops += h * path_lengths[h];
+        }
+        output.output("  path length (router to router hops): mean %.3f\n",
+                      delivered ? (double)total_hops / delivered : 0.0);
+        for ( size_t h = 0; h < path_lengths.size(); h++ ) {
+            if ( path_lengths[h] == 0 ) continue;
+            output.output("    %2zu hops: %" PRIu64 " (%.2f%%)\n", h, path_lengths[h], 100.0 * path_lengths[h] / delivered);
+        }
+
+        // Load on the router to router links
+        int num_links = 0;
+        uint64_t min_load = UINT64_MAX;
+        uint64_t max_load = 0;
+        int max_port = -1;
+        double sum = 0.0;
+        double sum_sq = 0.0;
+        for ( int r = 0; r < num_routers; r++ ) {
+            for ( int p = 0; p < routers[r]->num_ports; p++ ) {
+                if ( routers[r]->remote[p].first == -1 ) continue;
+                uint64_t load = link_load[port_base[r] + p];
+                num_links++;
+                sum += load;
+                sum_sq += (double)load * load;
+                if ( load < min_load ) min_load = load;
+                if ( load > max_load ) {
+                    max_load = load;
+                    max_port = port_base[r] + p;
+                }
+            }
+        }
+        if ( num_links > 0 ) {
+            double mean = sum / num_links;
+            double stddev = std::sqrt(std::max(0.0, sum_sq / num_links - mean * mean));
+            output.output("  link load (packets per link, %d links): min %" PRIu64 ", mean %.1f, max %" PRIu64 ", stddev %.1f, max/mean %.3f\n",
+                          num_links, min_load, mean, max_load, stddev, mean > 0.0 ? max_load / mean : 0.0);
+            if ( max_port != -1 ) {
+                output.output("    busiest link: %s\n", channelName(max_port * num_vcs).c_str());
+            }
+        }
+
+        // Deadlock freedom: the channel dependency graph must not have
+        // any cycles
+        std::sort(dependencies.begin(), dependencies.end());
+        dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+        std::vector<int> cycle = findCycle(num_channels, dependencies);
+        if ( cycle.empty() ) {
+            output.output("  channel dependency graph: %zu dependencies, acyclic (deadlock free)\n", dependencies.size());
+        }
+        else {
+            output.output("  channel dependency graph: %zu dependencies, CYCLE of %zu channels found (not deadlock free):\n",
+                          dependencies.size(), cycle.size());
+            for ( size_t i = 0; i < cycle.size(); i++ ) {
+                output.output("    %s\n", channelName(cycle[i]).c_str());
+            }
+        }
+
+        if ( misroutes || livelocks ) {
+            output.output("  errors: %" PRIu64 " misrouted, %" PRIu64 " over the hop limit\n", misroutes, livelocks);
+        }
+        if ( misroutes || livelocks || !cycle.empty() ) errors = true;
+    }
+
+    if ( errors && fatal_on_error ) {
+        merlin_abort.fatal(CALL_INFO, 1, "route_bench: routing errors found\n");
+    }
+}
@@ -0,0 +1,146 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TEST_ROUTE_BENCH_H
+#define COMPONENTS_MERLIN_TEST_ROUTE_BENCH_H
+
+#include <sst/core/component.h>
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/output.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "sst/elements/merlin/router.h"
+
+namespace SST {
+namespace Merlin {
+
+/*
+ * Routing benchmark.
+ *
+ * Used as the router template in place of hr_router.  Each instance
+ * loads the topology subcomponent exactly like hr_router and learns
+ * which router and port sits on the other end of each router to
+ * router link during init.  Host ports are left unconnected (build the
+ * system without any jobs).
+ *
+ * Nothing is simulated.  In setup(), the last route_bench to be set up
+ * walks a packet from every endpoint to every other endpoint by
+ * calling process_input() on the source router and route()/reroute()
+ * at each hop, then reports:
+ *
+ *   - routes/sec (hops routed per second of wall clock time)
+ *   - the distribution of path lengths in router hops
+ *   - the number of packets crossing each router to router link
+ *     under uniform all-to-all traffic
+ *   - whether the channel dependency graph (a channel is an output
+ *     port and VC) of each VN is acyclic, i.e. whether the routing
+ *     function is deadlock free
+ *
+ * Output buffer credits handed to the topology are always full, so
+ * adaptive algorithms see an idle network.  Randomized algorithms
+ * (e.g. valiant) are sampled samples_per_pair times per pair.
+ *
+ * All routers need to be in the same process, so only serial runs
+ * are supported.
+ */
+class route_bench : public Router {
+
+public:
+
+    SST_ELI_REGISTER_COMPONENT(
+        route_bench,
+        "merlin",
+        "route_bench",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Router stand-in that benchmarks a topology's routing function and checks it for deadlock.  Nothing is simulated.",
+        COMPONENT_CATEGORY_NETWORK)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"id",               "ID of the router."},
+        {"num_ports",        "Number of ports that the router has"},
+        {"num_vns",          "Number of VNs to route and check.","1"},
+        {"flit_size",        "Flit size specified in either b or B (can include SI prefix).", "8B"},
+        {"packet_size",      "Size of the packets that are routed, specified in either b or B (can include SI prefix).", "64B"},
+        {"samples_per_pair", "Number of packets routed for each source/destination pair and VN.", "1"},
+        {"max_hops",         "Packets that have not reached their destination after this many hops are reported as livelocked.  "
+                             "0 uses twice the number of routers.", "0"},
+        {"fatal_on_error",   "Abort if a misroute, livelock or dependency cycle is found.", "false"}
+    )
+
+    SST_ELI_DOCUMENT_PORTS(
+        {"port%(num_ports)d",  "Ports which connect to other routers.  Host ports must be left unconnected.", { "merlin.RtrEvent", "merlin.internal_router_event" } }
+    )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        {"topology", "Topology object to control routing", "SST::Merlin::Topology" }
+    )
+
+private:
+
+    // Router id and port on the other end of each port, (-1,-1) for
+    // host and unconnected ports
+    typedef std::pair<int,int> remote_t;
+
+    int id;
+    int num_ports;
+    int num_vns;
+    int num_vcs;
+    int size_in_bits;
+    int flit_size;
+    int samples_per_pair;
+    int max_hops;
+    bool fatal_on_error;
+
+    Topology* topo;
+    std::vector<Link*> links;
+    std::vector<remote_t> remote;
+
+    int* output_credits;
+    int* output_queue_lengths;
+
+    Output& output;
+
+    // All route_bench instances in the simulation, indexed by id
+    static std::vector<route_bench*> routers;
+    static int routers_registered;
+    static int routers_setup;
+
+    void handle_input(Event* ev) {delete ev;}
+    void runBenchmark();
+
+public:
+    route_bench(ComponentId_t cid, Params& params);
+    ~route_bench();
+
+    void init(unsigned int phase);
+    void setup();
+    void finish() {}
+
+    int const* getOutputBufferCredits() {return output_credits;}
+
+    // There is no network, so topology events go nowhere
+    void sendTopologyEvent(int port, TopologyEvent* ev) {delete ev;}
+    void recvTopologyEvent(int port, TopologyEvent* ev) {topo->recvTopologyEvent(port,ev);}
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_TEST_ROUTE_BENCH_H
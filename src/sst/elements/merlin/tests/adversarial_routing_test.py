@@ -0,0 +1,91 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Adaptive routing under traffic that defeats the deterministic routes.
+# Every endpoint streams packets to one partner with merlin.pt2pt_test.
+#
+# hyperx: 4x4 routers, 4 endpoints each.  Every endpoint sends to the
+#   same slot on the next router in x, so each x link carries 4 streams
+#   on the minimal path while all other links stay idle.
+# fattree: 4,4:4,4:8.  Endpoint 16a + 4b + i sends to
+#   16((a + 4) % 8) + 4i + b, a permutation where all 4 streams of an
+#   edge router have the same destination mod 4 and so share one up
+#   port on the deterministic route.
+#
+# Usage: sst adversarial_routing_test.py --model-options="<topology> <algorithm>"
+#   hyperx:  UGAL (default) or DOR
+#   fattree: load_balanced (default) or deterministic
+#
+# Run the adaptive and the deterministic algorithm and compare with
+# checkAdversarialRouting.py, which requires the adaptive run to reach
+# a higher total bandwidth:
+#   sst adversarial_routing_test.py --model-options="hyperx UGAL" > ugal.out
+#   sst adversarial_routing_test.py --model-options="hyperx DOR" > dor.out
+#   python checkAdversarialRouting.py ugal.out dor.out 64
+
+import sys
+import sst
+from sst.merlin import *
+
+topology = "hyperx"
+if len(sys.argv) > 1: topology = sys.argv[1]
+
+sst.merlin._params["link_bw"] = "4GB/s"
+sst.merlin._params["link_lat"] = "20ns"
+sst.merlin._params["flit_size"] = "8B"
+sst.merlin._params["xbar_bw"] = "4GB/s"
+sst.merlin._params["input_latency"] = "20ns"
+sst.merlin._params["output_latency"] = "20ns"
+sst.merlin._params["input_buf_size"] = "4kB"
+sst.merlin._params["output_buf_size"] = "4kB"
+sst.merlin._params["xbar_arb"] = "merlin.xbar_arb_lru"
+
+src = []
+dest = []
+if topology == "hyperx":
+    topo = topoHyperX()
+    sst.merlin._params["hyperx:shape"] = "4x4"
+    sst.merlin._params["hyperx:width"] = "1x1"
+    sst.merlin._params["hyperx:local_ports"] = "4"
+    sst.merlin._params["hyperx:algorithm"] = sys.argv[2] if len(sys.argv) > 2 else "UGAL"
+    # Router id is x + 4y
+    for y in range(4):
+        for x in range(4):
+            for i in range(4):
+                src.append(16 * y + 4 * x + i)
+                dest.append(16 * y + 4 * ((x + 1) % 4) + i)
+elif topology == "fattree":
+    topo = topoFatTree()
+    sst.merlin._params["fattree:shape"] = "4,4:4,4:8"
+    sst.merlin._params["fattree:routing_alg"] = sys.argv[2] if len(sys.argv) > 2 else "load_balanced"
+    for a in range(8):
+        for b in range(4):
+            for i in range(4):
+                src.append(16 * a + 4 * b + i)
+                dest.append(16 * ((a + 4) % 8) + 4 * i + b)
+else:
+    print("Unknown topology: %s"%topology)
+    sst.exit()
+
+sst.merlin._params["packet_size"] = "64B"
+sst.merlin._params["packets_to_send"] = 500
+sst.merlin._params["buffer_size"] = "4kB"
+sst.merlin._params["src"] = src
+sst.merlin._params["dest"] = dest
+
+endPoint = Pt2ptEndPoint()
+
+topo.prepParams()
+endPoint.prepParams()
+topo.setEndPoint(endPoint)
+topo.build()
@@ -0,0 +1,81 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# 4x4 torus driven by trafficgen.  Used by analytic_router_validate.py
+# to compare merlin.analytic_router against merlin.hr_router.  This file
+# only writes statistics; run analytic_router_validate.py to check them.
+#
+# Usage: sst analytic_router_trafficgen.py --model-options="<router> <pattern> <stats file>"
+#   router:  merlin.hr_router or merlin.analytic_router
+#   pattern: trafficgen PacketDest pattern (Uniform, HotSpot, Normal, Binomial)
+
+import sys
+import sst
+
+router = "merlin.analytic_router"
+pattern = "Uniform"
+stats_file = "./TestOutput.csv"
+if len(sys.argv) > 1: router = sys.argv[1]
+if len(sys.argv) > 2: pattern = sys.argv[2]
+if len(sys.argv) > 3: stats_file = sys.argv[3]
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputCSV", {"filepath" : stats_file, "separator" : "," } )
+
+from sst.merlin import *
+
+sst.merlin._params["router_type"] = router
+sst.merlin._params["flit_size"] = "16B"
+sst.merlin._params["link_bw"] = "4.0GB/s"
+sst.merlin._params["xbar_bw"] = "4.0GB/s"
+sst.merlin._params["input_latency"] = "20ns"
+sst.merlin._params["output_latency"] = "20ns"
+sst.merlin._params["input_buf_size"] = "4.0KB"
+sst.merlin._params["output_buf_size"] = "4.0KB"
+sst.merlin._params["link_lat"] = "20ns"
+
+merlintorusparams = {}
+merlintorusparams["num_dims"]=2
+merlintorusparams["torus:shape"]="4x4"
+merlintorusparams["torus:width"]="1x1"
+merlintorusparams["torus:local_ports"]=1
+sst.merlin._params.update(merlintorusparams)
+topo = topoTorus()
+topo.prepParams()
+
+sst.merlin._params["PacketDest:pattern"] = pattern
+sst.merlin._params["PacketDest:HotSpot:target"] = "0"
+sst.merlin._params["PacketDest:HotSpot:targetProbability"] = "0.2"
+sst.merlin._params["PacketDest:Normal:Mean"] = "8.0"
+sst.merlin._params["PacketDest:Normal:Sigma"] = "4.0"
+sst.merlin._params["PacketDest:Binomial:Mean"] = "8.0"
+sst.merlin._params["PacketDest:Binomial:Sigma"] = "0.5"
+sst.merlin._params["PacketSize:pattern"] = "Uniform"
+sst.merlin._params["PacketSize:RangeMin"] = "16.0B"
+sst.merlin._params["PacketSize:RangeMax"] = "256.0B"
+# Required by pymerlin
+sst.merlin._params["packet_size"] = "0KB"
+sst.merlin._params["PacketDelay:pattern"] = "Uniform"
+sst.merlin._params["PacketDelay:RangeMin"] = "50.0ns"
+sst.merlin._params["PacketDelay:RangeMax"] = "150.0ns"
+# Required by pymerlin
+sst.merlin._params["message_rate"] = "1GHz"
+sst.merlin._params["packets_to_send"] = 2000
+
+endPoint = TrafficGenEndPoint()
+endPoint.prepParams()
+
+topo.setEndPoint(endPoint)
+topo.build()
+
+sst.enableAllStatisticsForAllComponents({"type":"sst.AccumulatorStatistic","rate":"0ns"})
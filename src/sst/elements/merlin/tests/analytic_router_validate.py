@@ -0,0 +1,96 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Validates merlin.analytic_router against merlin.hr_router.  Runs
+# analytic_router_trafficgen.py with both routers for each trafficgen
+# destination pattern and compares the mean packet latency reported
+# by the endpoints' LinkControl.  Exits non-zero if a run fails, if
+# either router delivers fewer than 95% of the packets sent, or if any
+# pattern's latency differs by more than the tolerance.
+#
+# Usage: analytic_router_validate.py [tolerance] [sst binary]
+
+import csv
+import os
+import subprocess
+import sys
+import tempfile
+
+patterns = ["Uniform", "HotSpot", "Normal", "Binomial"]
+routers = ["merlin.hr_router", "merlin.analytic_router"]
+
+tolerance = 0.25
+sst_bin = "sst"
+if len(sys.argv) > 1: tolerance = float(sys.argv[1])
+if len(sys.argv) > 2: sst_bin = sys.argv[2]
+
+config = os.path.join(os.path.dirname(os.path.abspath(__file__)), "analytic_router_trafficgen.py")
+
+# 4x4 torus, 2000 packets per endpoint (see analytic_router_trafficgen.py).
+# The run ends once every endpoint has sent, so a few packets can still
+# be in flight.
+packets_sent = 16 * 2000
+min_delivered = 0.95
+
+# Returns (mean latency, packets received)
+def mean_latency(stats_file):
+    total = 0
+    count = 0
+    with open(stats_file) as f:
+        reader = csv.reader(f)
+        header = [h.strip() for h in next(reader)]
+        name_col = header.index("StatisticName")
+        sum_col = header.index("Sum.u64")
+        count_col = header.index("Count.u64")
+        for row in reader:
+            if row[name_col].strip() != "packet_latency": continue
+            total += int(row[sum_col])
+            count += int(row[count_col])
+    if count == 0:
+        return (None, 0)
+    return (float(total) / count, count)
+
+def run(router, pattern, workdir):
+    stats_file = os.path.join(workdir, "%s_%s.csv"%(router.split(".")[-1], pattern))
+    ret = subprocess.call([sst_bin, config, "--model-options=%s %s %s"%(router, pattern, stats_file)],
+                          stdout=subprocess.DEVNULL)
+    if ret != 0 or not os.path.exists(stats_file):
+        print("%-10s %s run failed (exit %d)"%(pattern, router, ret))
+        return (None, 0)
+    return mean_latency(stats_file)
+
+failed = False
+workdir = tempfile.mkdtemp()
+print("%-10s %14s %14s %8s"%("pattern", "hr_router(ns)", "analytic(ns)", "error"))
+for pattern in patterns:
+    ((hr, hr_count), (analytic, analytic_count)) = [run(r, pattern, workdir) for r in routers]
+    if hr is None or analytic is None:
+        print("%-10s no packet_latency statistics found"%pattern)
+        failed = True
+        continue
+    short = False
+    for (router, count) in zip(routers, (hr_count, analytic_count)):
+        if count < min_delivered * packets_sent:
+            print("%-10s %s delivered %d of %d packets FAIL"%(pattern, router, count, packets_sent))
+            short = True
+    if short:
+        failed = True
+        continue
+    error = abs(analytic - hr) / hr
+    status = "ok"
+    if error > tolerance:
+        status = "FAIL"
+        failed = True
+    print("%-10s %14.1f %14.1f %7.1f%% %s"%(pattern, hr, analytic, error * 100.0, status))
+
+sys.exit(1 if failed else 0)
@@ -0,0 +1,65 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Background flows reserve bandwidth in the routers.
+#
+# Four background_traffic endpoints in flow mode on a single router,
+# each sending half of its link bandwidth to its bit complement
+# (0 <-> 3, 1 <-> 2).  Every sample of the pattern picks the same
+# destination, so each endpoint reserves 0.5 * 4GB/s = 16000 Mb/s on
+# the router port of its peer during init.  No packets are sent.
+#
+# Only reserved_bw is enabled.  Check the output with:
+#   sst background_flow_test.py > out
+#   python checkBackgroundFlow.py out 4 16000
+
+import sst
+
+num_peers = 4
+
+rtr = sst.Component("rtr", "merlin.hr_router")
+rtr.addParams({
+    "id" : 0,
+    "num_ports" : num_peers,
+    "link_bw" : "4GB/s",
+    "xbar_bw" : "4GB/s",
+    "flit_size" : "8B",
+    "input_latency" : "10ns",
+    "output_latency" : "10ns",
+    "input_buf_size" : "1KB",
+    "output_buf_size" : "1KB",
+})
+rtr.setSubComponent("topology", "merlin.singlerouter")
+rtr.enableStatistics(["reserved_bw"], {"type": "sst.AccumulatorStatistic"})
+
+for i in range(num_peers):
+    nic = sst.Component("nic%d"%i, "merlin.background_traffic")
+    nic.addParams({
+        "num_peers" : num_peers,
+        "offered_load" : 0.5,
+        "mode" : "flow",
+        "pattern" : "merlin.targetgen.bit_complement",
+        "packet_size" : "64B",
+    })
+    networkif = nic.setSubComponent("networkIF", "merlin.linkcontrol")
+    networkif.addParams({
+        "link_bw" : "4GB/s",
+        "input_buf_size" : "1KB",
+        "output_buf_size" : "1KB",
+    })
+
+    link = sst.Link("nic%d_link"%i)
+    link.connect( (networkif, "rtr_port", "10ns"), (rtr, "port%d"%i, "10ns") )
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
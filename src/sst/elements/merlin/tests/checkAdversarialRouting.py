@@ -0,0 +1,72 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Compares an adaptive and a deterministic run of adversarial_routing_test.py
+#   usage: checkAdversarialRouting.py <adaptive output> <deterministic output> <streams> [min speedup]
+# Both runs must report every stream.  The total bandwidth of the
+# adaptive run must be at least min speedup (default 1.5) times that of
+# the deterministic run.  Exits non-zero if a check fails.
+
+import re
+import sys
+
+streamPattern = re.compile('\AFor src = ([0-9]+) and dest = ([0-9]+):')
+bwPattern = re.compile('\A  Bandwidth: ([0-9.e+-]+) ?([kMGTP]?)b/s')
+prefixes = { "" : 1.0, "k" : 1e3, "M" : 1e6, "G" : 1e9, "T" : 1e12, "P" : 1e15 }
+
+if len(sys.argv) < 4 or len(sys.argv) > 5:
+    sys.stderr.write("usage: %s <adaptive output> <deterministic output> <streams> [min speedup]\n" % sys.argv[0])
+    sys.exit(2)
+
+streams = int(sys.argv[3])
+minSpeedup = float(sys.argv[4]) if len(sys.argv) > 4 else 1.5
+
+errors = 0
+def fail(msg):
+    global errors
+    sys.stderr.write("FAIL: %s\n" % msg)
+    errors = errors + 1
+
+# Returns {(src, dest): bandwidth in b/s}
+def readStreams(fileName):
+    bw = dict()
+    stream = None
+    with open(fileName) as f:
+        for line in f:
+            streamMatch = streamPattern.match(line)
+            if streamMatch:
+                stream = (int(streamMatch.group(1)), int(streamMatch.group(2)))
+                continue
+            bwMatch = bwPattern.match(line)
+            if bwMatch and stream:
+                bw[stream] = float(bwMatch.group(1)) * prefixes[bwMatch.group(2)]
+                stream = None
+    if len(bw) != streams:
+        fail("%s reports %d streams, expected %d" % (fileName, len(bw), streams))
+    return bw
+
+adaptive = readStreams(sys.argv[1])
+deterministic = readStreams(sys.argv[2])
+
+if sorted(adaptive.keys()) != sorted(deterministic.keys()):
+    fail("the two runs report different streams")
+
+adaptiveTotal = sum(adaptive.values())
+deterministicTotal = sum(deterministic.values())
+if deterministicTotal == 0 or adaptiveTotal < minSpeedup * deterministicTotal:
+    fail("adaptive total bandwidth %.3f Gb/s is not %.2f times the deterministic %.3f Gb/s" %
+         (adaptiveTotal / 1e9, minSpeedup, deterministicTotal / 1e9))
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Adaptive total bandwidth %.3f Gb/s, deterministic %.3f Gb/s\n" % (adaptiveTotal / 1e9, deterministicTotal / 1e9))
@@ -0,0 +1,54 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Checks the reserved_bw statistics printed by background_flow_test.py
+#   usage: checkBackgroundFlow.py <sst output> <ports> <reserved Mb/s>
+# Router ports 0 to <ports>-1 must each have recorded one reserved_bw
+# sample of <reserved Mb/s>.  Exits non-zero if a check fails.
+
+import re
+import sys
+
+statPattern = re.compile('\A (.+)\.reserved_bw\.port([0-9]+) : Accumulator : Sum.u64 = ([0-9]+); SumSQ.u64 = [0-9]+; Count.u64 = ([0-9]+);')
+
+if len(sys.argv) != 4:
+    sys.stderr.write("usage: %s <sst output> <ports> <reserved Mb/s>\n" % sys.argv[0])
+    sys.exit(2)
+
+numPorts = int(sys.argv[2])
+reserved = int(sys.argv[3])
+
+# {port: (sum, count)}
+ports = dict()
+with open(sys.argv[1]) as f:
+    for line in f:
+        statMatch = statPattern.match(line)
+        if statMatch:
+            ports[int(statMatch.group(2))] = (int(statMatch.group(3)), int(statMatch.group(4)))
+
+errors = 0
+def check(cond, msg):
+    global errors
+    if not cond:
+        sys.stderr.write("FAIL: %s\n" % msg)
+        errors = errors + 1
+
+check(sorted(ports.keys()) == list(range(numPorts)), "reserved_bw is reported for ports %s, expected 0-%d" % (sorted(ports.keys()), numPorts - 1))
+for port in sorted(ports.keys()):
+    (total, count) = ports[port]
+    check(count == 1, "port %d has %d reserved_bw samples, expected 1" % (port, count))
+    check(total == reserved * count, "port %d reserved %d Mb/s, expected %d" % (port, total, reserved))
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Checked %d ports reserving %d Mb/s each\n" % (len(ports), reserved))
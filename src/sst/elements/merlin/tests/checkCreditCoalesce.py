@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Checks the credit statistics printed by credit_coalesce_test.py
+#   usage: checkCreditCoalesce.py <sst output> <packets sent>
+# On every router port, each credit event must be one credit_return_count
+# sample.  Across the router, the credit_return_count sum must be the
+# packets sent and credit_event_count must be smaller.  Exits non-zero
+# if a check fails.
+
+import re
+import sys
+
+statPattern = re.compile('\A (.+)\.(credit_return_count|credit_event_count)\.([^ .]+) : Accumulator : Sum.u64 = ([0-9]+); SumSQ.u64 = [0-9]+; Count.u64 = ([0-9]+);')
+
+if len(sys.argv) != 3:
+    sys.stderr.write("usage: %s <sst output> <packets sent>\n" % sys.argv[0])
+    sys.exit(2)
+
+packets = int(sys.argv[2])
+
+# {(router, port): {stat: (sum, count)}}
+ports = dict()
+with open(sys.argv[1]) as f:
+    for line in f:
+        statMatch = statPattern.match(line)
+        if statMatch:
+            key = (statMatch.group(1), statMatch.group(3))
+            ports.setdefault(key, dict())[statMatch.group(2)] = (int(statMatch.group(4)), int(statMatch.group(5)))
+
+errors = 0
+def check(cond, msg):
+    global errors
+    if not cond:
+        sys.stderr.write("FAIL: %s\n" % msg)
+        errors = errors + 1
+
+check(ports, "no credit statistics in %s" % sys.argv[1])
+
+returned = 0
+events = 0
+for (router, port) in sorted(ports.keys()):
+    stats = ports[(router, port)]
+    if "credit_return_count" not in stats or "credit_event_count" not in stats:
+        check(False, "%s.%s is missing a credit statistic" % (router, port))
+        continue
+    (returnSum, returnCount) = stats["credit_return_count"]
+    (eventSum, eventCount) = stats["credit_event_count"]
+    check(eventSum == returnCount, "%s.%s sent %d credit events but recorded %d credit returns" % (router, port, eventSum, returnCount))
+    returned = returned + returnSum
+    events = events + eventSum
+
+check(returned == packets, "credits were returned for %d packets, %d were sent" % (returned, packets))
+check(events < returned, "%d credit events for %d packets, credits were not coalesced" % (events, returned))
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Checked %d credit events returning %d packets\n" % (events, returned))
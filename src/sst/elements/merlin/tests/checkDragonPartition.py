@@ -0,0 +1,86 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Checks a parallel run of dragon_partition_test.py
+#   usage: checkDragonPartition.py <sst output> <partition file> <routers per group> <hosts per router> <messages per peer>
+# The partition file is the one written by sst --output-partition.
+# Every router (rtr.<id>) and test_nic (testNic.<nid>) of a group must
+# be on the same rank, and every NIC must have received all of its
+# packets.  Exits non-zero if a check fails.
+
+import re
+import sys
+
+receivedPattern = re.compile('NIC ([0-9]+) received all packets \(total of ([0-9]+)\)')
+rankPattern = re.compile('\ARank: *([0-9]+)')
+componentPattern = re.compile('\A +(rtr|testNic)\.([0-9]+) ')
+
+if len(sys.argv) != 6:
+    sys.stderr.write("usage: %s <sst output> <partition file> <routers per group> <hosts per router> <messages per peer>\n" % sys.argv[0])
+    sys.exit(2)
+
+routersPerGroup = int(sys.argv[3])
+hostsPerRouter = int(sys.argv[4])
+messages = int(sys.argv[5])
+
+received = dict()
+with open(sys.argv[1]) as f:
+    for line in f:
+        receivedMatch = receivedPattern.search(line)
+        if receivedMatch:
+            received[int(receivedMatch.group(1))] = int(receivedMatch.group(2))
+
+# {group: set of ranks}
+groupRanks = dict()
+routers = 0
+nics = 0
+rank = None
+with open(sys.argv[2]) as f:
+    for line in f:
+        rankMatch = rankPattern.match(line)
+        if rankMatch:
+            rank = int(rankMatch.group(1))
+            continue
+        componentMatch = componentPattern.match(line)
+        if componentMatch and rank is not None:
+            index = int(componentMatch.group(2))
+            if componentMatch.group(1) == "rtr":
+                group = index // routersPerGroup
+                routers = routers + 1
+            else:
+                group = index // (routersPerGroup * hostsPerRouter)
+                nics = nics + 1
+            groupRanks.setdefault(group, set()).add(rank)
+
+errors = 0
+def check(cond, msg):
+    global errors
+    if not cond:
+        sys.stderr.write("FAIL: %s\n" % msg)
+        errors = errors + 1
+
+check(routers > 0 and nics == routers * hostsPerRouter,
+      "%s lists %d routers and %d NICs" % (sys.argv[2], routers, nics))
+for group in sorted(groupRanks.keys()):
+    check(len(groupRanks[group]) == 1, "group %d is split over ranks %s" % (group, sorted(groupRanks[group])))
+
+check(sorted(received.keys()) == list(range(nics)), "%d of %d NICs received all of their packets" % (len(received), nics))
+for nic in sorted(received.keys()):
+    check(received[nic] == nics * messages, "NIC %d received %d packets, expected %d" % (nic, received[nic], nics * messages))
+
+if errors:
+    sys.exit(1)
+ranks = set()
+for r in groupRanks.values():
+    ranks |= r
+sys.stderr.write("Checked %d groups on %d ranks\n" % (len(groupRanks), len(ranks)))
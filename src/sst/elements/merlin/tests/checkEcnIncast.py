@@ -0,0 +1,86 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Checks the ECN and CNP statistics printed by ecn_incast_test.py
+#   usage: checkEcnIncast.py <sst output> <senders> <packets per sender>
+# How many packets get marked depends on the crossbar timing, so the
+# counts are checked against each other rather than exact values:
+#   - only the router port to the receiver (port <senders>) marks, and
+#     it marks at least half of the packets
+#   - the receiver sees every marked packet and no sender sees any
+#   - the receiver sends between 1 and <senders> CNPs (at most one per
+#     source with the long cnp_interval), each sender receives at most
+#     one and the CNPs received add up to the CNPs sent
+# Exits non-zero if a check fails.
+
+import re
+import sys
+
+# The component name is followed by the subcomponent path, if any, which
+# is left out of the keys: nic4:networkIF.cnp_sent is nic4.cnp_sent
+statPattern = re.compile('\A ([A-Za-z0-9_]+)[^ ]*?\.(ecn_mark_count|ecn_marked_packets|cnp_sent|cnp_received)(\.[^ ]+)? : Accumulator : Sum.u64 = ([0-9]+);')
+
+if len(sys.argv) != 4:
+    sys.stderr.write("usage: %s <sst output> <senders> <packets per sender>\n" % sys.argv[0])
+    sys.exit(2)
+
+senders = int(sys.argv[2])
+packets = int(sys.argv[3])
+
+stats = dict()
+with open(sys.argv[1]) as f:
+    for line in f:
+        statMatch = statPattern.match(line)
+        if statMatch:
+            stats[statMatch.group(1) + "." + statMatch.group(2) + (statMatch.group(3) or "")] = int(statMatch.group(4))
+
+def stat(name):
+    if name not in stats:
+        sys.stderr.write("FAIL: statistic %s is missing from %s\n" % (name, sys.argv[1]))
+        sys.exit(1)
+    return stats[name]
+
+errors = 0
+def check(cond, msg):
+    global errors
+    if not cond:
+        sys.stderr.write("FAIL: %s\n" % msg)
+        errors = errors + 1
+
+receiver = "nic%d" % senders
+
+for port in range(senders):
+    check(stat("rtr.ecn_mark_count.port%d" % port) == 0, "router port %d to a sender marked packets" % port)
+marks = stat("rtr.ecn_mark_count.port%d" % senders)
+check(2 * marks >= senders * packets and marks <= senders * packets,
+      "router port %d marked %d of %d packets" % (senders, marks, senders * packets))
+
+check(stat(receiver + ".ecn_marked_packets") == marks,
+      "the receiver saw %d marked packets, the router marked %d" % (stat(receiver + ".ecn_marked_packets"), marks))
+check(stat(receiver + ".cnp_received") == 0, "the receiver received CNPs")
+
+cnpSent = stat(receiver + ".cnp_sent")
+check(1 <= cnpSent <= senders, "the receiver sent %d CNPs to %d senders" % (cnpSent, senders))
+
+cnpReceived = 0
+for nic in range(senders):
+    sender = "nic%d" % nic
+    check(stat(sender + ".ecn_marked_packets") == 0, "sender %d saw marked packets" % nic)
+    check(stat(sender + ".cnp_sent") == 0, "sender %d sent CNPs" % nic)
+    check(stat(sender + ".cnp_received") <= 1, "sender %d received %d CNPs" % (nic, stat(sender + ".cnp_received")))
+    cnpReceived = cnpReceived + stat(sender + ".cnp_received")
+check(cnpReceived == cnpSent, "the senders received %d CNPs, the receiver sent %d" % (cnpReceived, cnpSent))
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Checked %d marked packets and %d CNPs\n" % (marks, cnpSent))
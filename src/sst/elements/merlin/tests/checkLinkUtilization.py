@@ -0,0 +1,78 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Checks the link utilization file written by link_utilization_test.py,
+# converted with ../inspectors/link_util_to_csv.py
+#   usage: checkLinkUtilization.py <link utilization file> <packets sent>
+# Router port 2 must have sent 64B for every packet, no window may go
+# over the 1GB/s link bandwidth, port 2's output queue must have been
+# occupied and the --top 1 summary must name port 2.  Exits non-zero if
+# a check fails.
+
+import os
+import subprocess
+import sys
+
+if len(sys.argv) != 3:
+    sys.stderr.write("usage: %s <link utilization file> <packets sent>\n" % sys.argv[0])
+    sys.exit(2)
+
+packets = int(sys.argv[2])
+converter = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "inspectors", "link_util_to_csv.py")
+
+errors = 0
+def check(cond, msg):
+    global errors
+    if not cond:
+        sys.stderr.write("FAIL: %s\n" % msg)
+        errors = errors + 1
+
+def convert(args):
+    proc = subprocess.Popen([sys.executable, converter] + args + [sys.argv[1]],
+                            stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+    out, err = proc.communicate()
+    if proc.returncode != 0:
+        sys.stderr.write("FAIL: link_util_to_csv.py %s failed: %s\n" % (" ".join(args), err.strip()))
+        sys.exit(1)
+    lines = out.splitlines()
+    header = lines[0].split(",")
+    return [dict(zip(header, line.split(","))) for line in lines[1:]]
+
+records = convert([])
+check(len(records) > 0, "no records in %s" % sys.argv[1])
+
+port2Bytes = 0
+port2MaxOccupancy = 0
+for rec in records:
+    start = int(rec["window_start_ps"])
+    check(rec["router"] == "0", "record for router %s" % rec["router"])
+    check(float(rec["bandwidth_GBps"]) <= 1.001,
+          "router 0 port %s VC %s sent %s GB/s in the window at %d ps" % (rec["port"], rec["vc"], rec["bandwidth_GBps"], start))
+    if rec["port"] == "2":
+        port2Bytes += int(rec["bytes"])
+        port2MaxOccupancy = max(port2MaxOccupancy, int(rec["max_occupancy"]))
+    else:
+        check(int(rec["bytes"]) == 0, "router 0 port %s sent %s bytes" % (rec["port"], rec["bytes"]))
+
+check(port2Bytes == packets * 64, "router 0 port 2 sent %d bytes, expected %d" % (port2Bytes, packets * 64))
+check(port2MaxOccupancy > 0, "router 0 port 2's output queue was never occupied")
+
+top = convert(["--top", "1"])
+check(len(top) == 1, "--top 1 printed %d ports" % len(top))
+if top:
+    check(top[0]["port"] == "2", "--top 1 named port %s, expected port 2" % top[0]["port"])
+    check(int(top[0]["bytes"]) == port2Bytes, "--top 1 has %s bytes for port 2, the records add up to %d" % (top[0]["bytes"], port2Bytes))
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Checked %d records, %d bytes sent on router 0 port 2\n" % (len(records), port2Bytes))
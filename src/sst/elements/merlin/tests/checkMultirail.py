@@ -0,0 +1,78 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Checks the output of multirail_test.py
+#   usage: checkMultirail.py <sst output> <nics> <messages per peer> <rails> [striping]
+# Every NIC must receive all of its packets, the rail_packets statistics
+# must add up to the packets sent and every rail must carry traffic.
+# With round_robin striping (the default), every NIC must also put at
+# least half of its fair share on each rail.  Exits non-zero if a check
+# fails.
+
+import re
+import sys
+
+receivedPattern = re.compile('NIC ([0-9]+) received all packets \(total of ([0-9]+)\)')
+statPattern = re.compile('\A testNic\.([0-9]+)[^ ]*?\.rail_packets\.([0-9]+) : Accumulator : Sum.u64 = ([0-9]+);')
+
+if len(sys.argv) not in (5, 6):
+    sys.stderr.write("usage: %s <sst output> <nics> <messages per peer> <rails> [striping]\n" % sys.argv[0])
+    sys.exit(2)
+
+nics = int(sys.argv[2])
+messages = int(sys.argv[3])
+rails = int(sys.argv[4])
+striping = sys.argv[5] if len(sys.argv) == 6 else "round_robin"
+
+# Every NIC sends messages to each peer, itself included
+perNic = nics * messages
+
+received = dict()
+# {(nic, rail): packets}
+railPackets = dict()
+with open(sys.argv[1]) as f:
+    for line in f:
+        receivedMatch = receivedPattern.search(line)
+        if receivedMatch:
+            received[int(receivedMatch.group(1))] = int(receivedMatch.group(2))
+        statMatch = statPattern.match(line)
+        if statMatch:
+            railPackets[(int(statMatch.group(1)), int(statMatch.group(2)))] = int(statMatch.group(3))
+
+errors = 0
+def check(cond, msg):
+    global errors
+    if not cond:
+        sys.stderr.write("FAIL: %s\n" % msg)
+        errors = errors + 1
+
+check(sorted(received.keys()) == list(range(nics)), "%d of %d NICs received all of their packets" % (len(received), nics))
+for nic in sorted(received.keys()):
+    check(received[nic] == perNic, "NIC %d received %d packets, expected %d" % (nic, received[nic], perNic))
+
+check(sorted(railPackets.keys()) == [(nic, rail) for nic in range(nics) for rail in range(rails)],
+      "rail_packets is not reported for every NIC and rail")
+check(sum(railPackets.values()) == nics * perNic,
+      "rail_packets adds up to %d packets, %d were sent" % (sum(railPackets.values()), nics * perNic))
+
+for rail in range(rails):
+    onRail = sum(count for ((nic, r), count) in railPackets.items() if r == rail)
+    check(onRail > 0, "rail %d carried no packets" % rail)
+    if striping == "round_robin":
+        for nic in range(nics):
+            count = railPackets.get((nic, rail), 0)
+            check(2 * rails * count >= perNic, "NIC %d sent only %d of %d packets on rail %d" % (nic, count, perNic, rail))
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Checked %d packets over %d rails\n" % (nics * perNic, rails))
@@ -0,0 +1,69 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Checks the latency versus offered load curve written by
+# offered_load_sweep.py
+#   usage: checkOfferedLoad.py <csv file> [saturated load]
+# The offered loads must increase, every step must deliver packets with
+# min <= average <= max latency, unsaturated steps must accept close to
+# their offered load and the lowest step must not be saturated.  If a
+# saturated load is given, every step at or above it must be saturated.
+# Exits non-zero if a check fails.
+
+import csv
+import sys
+
+if len(sys.argv) not in (2, 3):
+    sys.stderr.write("usage: %s <csv file> [saturated load]\n" % sys.argv[0])
+    sys.exit(2)
+
+saturatedLoad = float(sys.argv[2]) if len(sys.argv) == 3 else None
+
+errors = 0
+def check(cond, msg):
+    global errors
+    if not cond:
+        sys.stderr.write("FAIL: %s\n" % msg)
+        errors = errors + 1
+
+with open(sys.argv[1]) as f:
+    steps = list(csv.DictReader(f))
+
+check(len(steps) > 0, "no load steps in %s" % sys.argv[1])
+
+previous = None
+for step in steps:
+    offered = float(step["offered_load"])
+    accepted = float(step["accepted_load"])
+    average = float(step["avg_latency_ps"])
+    saturated = step["saturated"] == "1"
+
+    check(previous is None or offered > previous, "offered load %.2f follows %s" % (offered, previous))
+    previous = offered
+    check(int(step["packets"]) > 0, "no packets delivered at offered load %.2f" % offered)
+    check(int(step["min_latency_ps"]) <= average <= int(step["max_latency_ps"]),
+          "latency at offered load %.2f is not min <= average <= max" % offered)
+    # The accepted load is measured over the collect window, so it can
+    # be a little over the offered load
+    if not saturated:
+        check(0.9 * offered <= accepted <= 1.1 * offered,
+              "unsaturated offered load %.2f accepted %.3f" % (offered, accepted))
+    if saturatedLoad is not None and offered >= saturatedLoad:
+        check(saturated, "offered load %.2f is not saturated" % offered)
+
+if steps:
+    check(steps[0]["saturated"] == "0", "the lowest offered load %s is saturated" % steps[0]["offered_load"])
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Checked %d load steps\n" % len(steps))
@@ -0,0 +1,73 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Checks the output of reorder_window_test.py
+#   usage: checkReorderWindow.py <sst output> <nics> <packets per nic>
+# Every NIC must receive all of its packets with none out of order,
+# reorder_depth must have one sample per packet and some packets must
+# have overflowed the reorder window into the heap.  Exits non-zero if
+# a check fails.
+
+import re
+import sys
+
+receivedPattern = re.compile('([0-9]+) Received all packets \(total of ([0-9]+)\)')
+outOfOrderPattern = re.compile('Nic ([0-9]+) had ([0-9]+) out of order packets')
+statPattern = re.compile('\A (.+)\.(reorder_depth|reorder_overflow)(\.[^ ]*)? : Accumulator : Sum.u64 = ([0-9]+); SumSQ.u64 = [0-9]+; Count.u64 = ([0-9]+);')
+
+if len(sys.argv) != 4:
+    sys.stderr.write("usage: %s <sst output> <nics> <packets per nic>\n" % sys.argv[0])
+    sys.exit(2)
+
+nics = int(sys.argv[2])
+packets = int(sys.argv[3])
+
+received = dict()
+outOfOrder = dict()
+# {stat: [sum, count]}
+stats = {"reorder_depth": [0, 0], "reorder_overflow": [0, 0]}
+with open(sys.argv[1]) as f:
+    for line in f:
+        receivedMatch = receivedPattern.search(line)
+        if receivedMatch:
+            received[int(receivedMatch.group(1))] = int(receivedMatch.group(2))
+        outOfOrderMatch = outOfOrderPattern.search(line)
+        if outOfOrderMatch:
+            outOfOrder[int(outOfOrderMatch.group(1))] = int(outOfOrderMatch.group(2))
+        statMatch = statPattern.match(line)
+        if statMatch:
+            stats[statMatch.group(2)][0] += int(statMatch.group(4))
+            stats[statMatch.group(2)][1] += int(statMatch.group(5))
+
+errors = 0
+def check(cond, msg):
+    global errors
+    if not cond:
+        sys.stderr.write("FAIL: %s\n" % msg)
+        errors = errors + 1
+
+check(sorted(received.keys()) == list(range(nics)), "%d of %d NICs received all of their packets" % (len(received), nics))
+for nic in sorted(received.keys()):
+    check(received[nic] == packets, "NIC %d received %d packets, expected %d" % (nic, received[nic], packets))
+for nic in sorted(outOfOrder.keys()):
+    check(False, "NIC %d had %d out of order packets" % (nic, outOfOrder[nic]))
+
+(depthSum, depthCount) = stats["reorder_depth"]
+(overflowSum, overflowCount) = stats["reorder_overflow"]
+check(depthCount == nics * packets, "reorder_depth has %d samples for %d packets" % (depthCount, nics * packets))
+check(depthSum > 0, "no packet arrived out of order")
+check(overflowSum > 0, "no packet overflowed the reorder window")
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Checked %d packets, %d overflowed the reorder window\n" % (depthCount, overflowSum))
@@ -0,0 +1,88 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Checks the router statistics summary written by stat_summary_test.py
+#   usage: checkStatSummary.py <sst output> <routers> <ports> <packets> <packet size in B>
+# The record must count the routers, ports, packets and bits sent, and
+# nothing may stall.  Each histogram must have one entry per port (or
+# per packet for hop latency).  The exact latency bins depend on the
+# crossbar timing, so they are only required to be under 64 ns, and
+# both ports must be in the lowest utilization bin.  Exits non-zero if
+# a check fails.
+
+import re
+import sys
+
+headerPattern = re.compile('\Amerlin router summary: rank ([0-9]+), ([0-9]+) routers, ([0-9]+) ports\Z')
+fieldPattern = re.compile('\A  ([a-z_0-9]+):((?: [0-9]+)*)\Z')
+
+if len(sys.argv) != 6:
+    sys.stderr.write("usage: %s <sst output> <routers> <ports> <packets> <packet size in B>\n" % sys.argv[0])
+    sys.exit(2)
+
+routers = int(sys.argv[2])
+ports = int(sys.argv[3])
+packets = int(sys.argv[4])
+packetBits = int(sys.argv[5]) * 8
+
+header = None
+fields = dict()
+with open(sys.argv[1]) as f:
+    for line in f:
+        line = line.rstrip("\n")
+        headerMatch = headerPattern.match(line)
+        if headerMatch:
+            header = tuple(int(x) for x in headerMatch.groups())
+            continue
+        fieldMatch = fieldPattern.match(line)
+        if header and fieldMatch:
+            fields[fieldMatch.group(1)] = [int(x) for x in fieldMatch.group(2).split()]
+
+errors = 0
+def check(cond, msg):
+    global errors
+    if not cond:
+        sys.stderr.write("FAIL: %s\n" % msg)
+        errors = errors + 1
+
+def field(name):
+    if name not in fields:
+        sys.stderr.write("FAIL: %s is missing from the summary\n" % name)
+        sys.exit(1)
+    return fields[name]
+
+if header is None:
+    sys.stderr.write("FAIL: no router summary in %s\n" % sys.argv[1])
+    sys.exit(1)
+
+check(header[1:] == (routers, ports), "summary has %d routers and %d ports, expected %d and %d" % (header[1], header[2], routers, ports))
+check(field("packets") == [packets], "summary has %s packets, expected %d" % (field("packets"), packets))
+check(field("bits") == [packets * packetBits], "summary has %s bits, expected %d" % (field("bits"), packets * packetBits))
+check(field("output_port_stall_cycles") == [0], "output ports stalled for %s cycles" % field("output_port_stall_cycles"))
+check(field("xbar_stall_cycles") == [0], "the crossbar stalled for %s cycles" % field("xbar_stall_cycles"))
+check(len(field("vc_stall_cycles")) > 0 and not any(field("vc_stall_cycles")),
+      "per VC stall cycles are %s" % field("vc_stall_cycles"))
+
+utilization = field("port_utilization")
+stalled = field("port_stalled")
+check(len(utilization) == 10 and utilization[0] == ports, "port_utilization is %s" % utilization)
+check(len(stalled) == 10 and stalled[0] == ports, "port_stalled is %s" % stalled)
+
+# Bin i is [2^(i-1), 2^i) ns, so bins 0-6 are under 64 ns
+latency = field("hop_latency_ns_log2")
+check(sum(latency) == packets, "hop_latency_ns_log2 has %d entries for %d packets" % (sum(latency), packets))
+check(len(latency) <= 7, "hop latency reached bin %d: %s" % (len(latency) - 1, latency))
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Checked the summary of %d routers and %d ports\n" % (routers, ports))
@@ -0,0 +1,110 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Checks the tree saturation log written by tree_saturation_test.py
+#   usage: checkTreeSaturation.py <sst output> <routers> <dest> <root router>
+# Only <dest> receives traffic, so every episode must be for <dest> and
+# rooted at <root router>, and at least one of them must have spread to
+# all the routers.  Whether the backlog is logged as one episode or
+# breaks up into several depends on the crossbar timing, so only the
+# episode count line is required to match the episodes listed.  Exits
+# non-zero if a check fails.
+
+import re
+import sys
+
+headerPattern = re.compile('\Amerlin tree saturation log: rank ([0-9]+), ([0-9]+) routers, window ([0-9]+) ns, threshold ([0-9]+) blocked flits/cycle\Z')
+episodePattern = re.compile('\A  episode: dest ([0-9]+), root router ([0-9]+|unknown), ([0-9]+) routers \(peak ([0-9]+) in one window\)\Z')
+timePattern = re.compile('\A    time: ([0-9]+)-([0-9]+) ns, ([0-9]+) blocked flit-cycles\Z')
+routersPattern = re.compile('\A    routers: ([0-9,-]+)\Z')
+countPattern = re.compile('\A  episodes: ([0-9]+)\Z')
+
+if len(sys.argv) != 5:
+    sys.stderr.write("usage: %s <sst output> <routers> <dest> <root router>\n" % sys.argv[0])
+    sys.exit(2)
+
+routers = int(sys.argv[2])
+dest = int(sys.argv[3])
+root = sys.argv[4]
+
+errors = 0
+def check(cond, msg):
+    global errors
+    if not cond:
+        sys.stderr.write("FAIL: %s\n" % msg)
+        errors = errors + 1
+
+# Expands a router list such as 3-8,12
+def routerSet(text):
+    result = set()
+    for part in text.split(","):
+        ends = part.split("-")
+        result.update(range(int(ends[0]), int(ends[-1]) + 1))
+    return result
+
+header = None
+episodes = []
+count = None
+with open(sys.argv[1]) as f:
+    for line in f:
+        line = line.rstrip("\n")
+        headerMatch = headerPattern.match(line)
+        if headerMatch:
+            header = tuple(int(x) for x in headerMatch.groups())
+            continue
+        if header is None or count is not None:
+            continue
+        episodeMatch = episodePattern.match(line)
+        if episodeMatch:
+            episodes.append({ "dest" : int(episodeMatch.group(1)), "root" : episodeMatch.group(2),
+                              "size" : int(episodeMatch.group(3)), "peak" : int(episodeMatch.group(4)) })
+            continue
+        timeMatch = timePattern.match(line)
+        if timeMatch and episodes:
+            episodes[-1]["time"] = (int(timeMatch.group(1)), int(timeMatch.group(2)))
+            episodes[-1]["flits"] = int(timeMatch.group(3))
+            continue
+        routersMatch = routersPattern.match(line)
+        if routersMatch and episodes:
+            episodes[-1]["routers"] = routerSet(routersMatch.group(1))
+            continue
+        countMatch = countPattern.match(line)
+        if countMatch:
+            count = int(countMatch.group(1))
+
+if header is None:
+    sys.stderr.write("FAIL: no tree saturation log in %s\n" % sys.argv[1])
+    sys.exit(1)
+
+check(header[1] == routers, "log has %d routers, expected %d" % (header[1], routers))
+check(count is not None, "log has no episode count")
+check(count is None or count == len(episodes), "log counts %s episodes but lists %d" % (count, len(episodes)))
+check(len(episodes) > 0, "no tree saturation episodes were logged")
+
+allRouters = set(range(routers))
+for i, episode in enumerate(episodes):
+    name = "episode %d" % i
+    check(episode["dest"] == dest, "%s is for dest %d, expected %d" % (name, episode["dest"], dest))
+    check(episode["root"] == root, "%s is rooted at router %s, expected %s" % (name, episode["root"], root))
+    check("time" in episode and episode["time"][0] < episode["time"][1], "%s has no time range" % name)
+    check(episode.get("flits", 0) > 0, "%s has no blocked flit-cycles" % name)
+    check("routers" in episode and len(episode["routers"]) == episode["size"] and episode["routers"] <= allRouters,
+          "%s lists routers %s for %d routers" % (name, sorted(episode.get("routers", [])), episode["size"]))
+    check(episode["peak"] <= episode["size"], "%s peaks at %d of %d routers" % (name, episode["peak"], episode["size"]))
+
+check(any(episode.get("routers") == allRouters for episode in episodes),
+      "no episode spread to all %d routers" % routers)
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Checked %d tree saturation episodes for dest %d\n" % (len(episodes), dest))
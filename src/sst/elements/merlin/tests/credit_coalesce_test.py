@@ -0,0 +1,66 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Credit coalescing in PortControl.
+#
+# NIC 0 streams 2-flit packets to NIC 1 through a single router whose
+# ports hold returned credits until 16 flits (8 packets) have built up.
+# The flush interval is long compared to the time to drain 8 packets,
+# so nearly every credit event returns 8 packets' worth and
+# credit_event_count stays well below the credit_return_count sum.
+#
+# Check the output with:
+#   sst credit_coalesce_test.py > out
+#   python checkCreditCoalesce.py out 1000
+
+import sst
+
+packets = 1000
+
+rtr = sst.Component("rtr", "merlin.hr_router")
+rtr.addParams({
+    "id" : 0,
+    "num_ports" : 2,
+    "link_bw" : "1GB/s",
+    "xbar_bw" : "1GB/s",
+    "flit_size" : "8B",
+    "input_latency" : "10ns",
+    "output_latency" : "10ns",
+    "input_buf_size" : "1KiB",
+    "output_buf_size" : "1KiB",
+    "portcontrol:credit_coalesce_threshold" : 16,
+    "portcontrol:credit_coalesce_interval" : "1us",
+})
+rtr.setSubComponent("topology", "merlin.singlerouter")
+rtr.enableStatistics(["credit_return_count", "credit_event_count"], {"type": "sst.AccumulatorStatistic"})
+
+for i in range(2):
+    nic = sst.Component("nic%d"%i, "merlin.pt2pt_test")
+    nic.addParams({
+        "packet_size" : "16B",
+        "packets_to_send" : packets,
+        "src" : [0],
+        "dest" : [1],
+    })
+    networkif = nic.setSubComponent("networkIF", "merlin.linkcontrol")
+    networkif.addParams({
+        "link_bw" : "1GB/s",
+        "input_buf_size" : "1KiB",
+        "output_buf_size" : "1KiB",
+    })
+
+    link = sst.Link("nic%d_link"%i)
+    link.connect( (networkif, "rtr_port", "10ns"), (rtr, "port%d"%i, "10ns") )
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
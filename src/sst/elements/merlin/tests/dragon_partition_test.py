@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# 64 group dragonfly built so that a parallel run keeps each group on
+# one rank.  Host and intra-group links are no-cut, and global links
+# get a longer latency, which becomes the lookahead between ranks.
+#
+# Usage: mpirun -np <ranks> sst dragon_partition_test.py --model-options="[global_link_latency]"
+#   global_link_latency: latency of the global links (default 100ns)
+#
+# Check that no group was split and that all packets arrived with:
+#   mpirun -np 4 sst --output-partition=partition.txt dragon_partition_test.py > out
+#   python checkDragonPartition.py out partition.txt 8 4 10
+
+import sys
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.topology import *
+
+global_latency = "100ns"
+if len(sys.argv) > 1: global_latency = sys.argv[1]
+
+topo = topoDragonFly()
+topo.hosts_per_router = 4
+topo.routers_per_group = 8
+topo.intergroup_links = 1
+topo.num_groups = 64
+topo.algorithm = "minimal"
+topo.link_latency = "20ns"
+topo.global_link_latency = global_latency
+topo.keep_groups_together = True
+
+router = hr_router()
+router.link_bw = "4GB/s"
+router.flit_size = "8B"
+router.xbar_bw = "4GB/s"
+router.input_latency = "20ns"
+router.output_latency = "20ns"
+router.input_buf_size = "4kB"
+router.output_buf_size = "4kB"
+topo.setRouterTemplate(router)
+
+networkif = LinkControl()
+networkif.link_bw = "4GB/s"
+networkif.input_buf_size = "4kB"
+networkif.output_buf_size = "4kB"
+
+job = TestJob(0, topo.getNumNodes())
+job.num_messages = 10
+job.message_size = "64B"
+job.network_interface = networkif
+
+system = System()
+system.setTopology(topo)
+system.allocateNodes(job, "linear")
+
+system.build()
@@ -0,0 +1,75 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# ECN marking and congestion notification on a 4:1 incast.
+#
+# NICs 0-3 each stream packets to NIC 4 through a single router whose
+# crossbar is eight times faster than its links, so the router output
+# to NIC 4 is the only bottleneck.  With an ECN threshold of 0B, every
+# packet that leaves anything behind in that output buffer is marked.
+# The arrival rate is four times the drain rate, so nearly every packet
+# is marked; the exact count depends on the crossbar timing.  NIC 4
+# answers the first marked packet from each source with a CNP, and the
+# long cnp_interval suppresses any more.
+#
+# Only ecn_mark_count on the router and the NIC ECN/CNP counts are
+# enabled.  Check the output with:
+#   sst ecn_incast_test.py > out
+#   python checkEcnIncast.py out 4 50
+
+import sst
+
+num_senders = 4
+packets = 50
+
+rtr = sst.Component("rtr", "merlin.hr_router")
+rtr.addParams({
+    "id" : 0,
+    "num_ports" : num_senders + 1,
+    "link_bw" : "1GB/s",
+    "xbar_bw" : "8GB/s",
+    "flit_size" : "8B",
+    "input_latency" : "10ns",
+    "output_latency" : "10ns",
+    "input_buf_size" : "1KiB",
+    "output_buf_size" : "1KiB",
+    "portcontrol:ecn_threshold" : "0B",
+})
+rtr.setSubComponent("topology", "merlin.singlerouter")
+rtr.enableStatistics(["ecn_mark_count"], {"type": "sst.AccumulatorStatistic"})
+
+for i in range(num_senders + 1):
+    nic = sst.Component("nic%d"%i, "merlin.pt2pt_test")
+    nic.addParams({
+        "packet_size" : "128B",
+        "packets_to_send" : packets,
+        "buffer_size" : "1KiB",
+        "src" : list(range(num_senders)),
+        "dest" : [num_senders] * num_senders,
+    })
+    networkif = nic.setSubComponent("networkIF", "merlin.linkcontrol")
+    networkif.addParams({
+        "link_bw" : "1GB/s",
+        "input_buf_size" : "1KiB",
+        "output_buf_size" : "1KiB",
+        "cc_enable" : True,
+        "cnp_interval" : "1s",
+    })
+    networkif.enableStatistics(["ecn_marked_packets", "cnp_sent", "cnp_received"],
+                               {"type": "sst.AccumulatorStatistic"})
+
+    link = sst.Link("nic%d_link"%i)
+    link.connect( (networkif, "rtr_port", "10ns"), (rtr, "port%d"%i, "10ns") )
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
@@ -0,0 +1,62 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# merlin.link_utilization_inspector on a single router.
+#
+# NICs 0 and 1 both stream packets to NIC 2, so the router's port 2 is
+# offered twice its link bandwidth and its output queue fills.  The
+# inspector writes link_utilization_test.bin (1us windows) to the
+# current directory.
+#
+# Run and check the file, through link_util_to_csv.py, with:
+#   sst link_utilization_test.py
+#   python checkLinkUtilization.py link_utilization_test.bin 2000
+
+import sst
+
+packets = 1000
+
+rtr = sst.Component("rtr", "merlin.hr_router")
+rtr.addParams({
+    "id" : 0,
+    "num_ports" : 3,
+    "link_bw" : "1GB/s",
+    "xbar_bw" : "2GB/s",
+    "flit_size" : "8B",
+    "input_latency" : "10ns",
+    "output_latency" : "10ns",
+    "input_buf_size" : "1KiB",
+    "output_buf_size" : "1KiB",
+    "network_inspectors" : "merlin.link_utilization_inspector",
+    "portcontrol:inspector:output_file" : "link_utilization_test.bin",
+    "portcontrol:inspector:window" : "1us",
+})
+rtr.setSubComponent("topology", "merlin.singlerouter")
+
+for i in range(3):
+    nic = sst.Component("nic%d"%i, "merlin.pt2pt_test")
+    nic.addParams({
+        "packet_size" : "64B",
+        "packets_to_send" : packets,
+        "src" : [0, 1],
+        "dest" : [2, 2],
+    })
+    networkif = nic.setSubComponent("networkIF", "merlin.linkcontrol")
+    networkif.addParams({
+        "link_bw" : "1GB/s",
+        "input_buf_size" : "1KiB",
+        "output_buf_size" : "1KiB",
+    })
+
+    link = sst.Link("nic%d_link"%i)
+    link.connect( (networkif, "rtr_port", "10ns"), (rtr, "port%d"%i, "10ns") )
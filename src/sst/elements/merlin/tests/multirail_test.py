@@ -0,0 +1,80 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# 72 node dragonfly built once per rail, with every test_nic striping
+# its traffic over all of the rails through merlin.multirail.
+# Comparing run times for 1, 2 and 4 rails shows how bandwidth scales
+# with extra planes.
+#
+# Usage: sst multirail_test.py --model-options="[rails] [striping]"
+#   rails:    number of rails (default 2)
+#   striping: round_robin, flow_hash or least_loaded (default round_robin)
+#
+# Check the output with:
+#   sst multirail_test.py --model-options="2 round_robin" > out
+#   python checkMultirail.py out 72 200 2 round_robin
+
+import sys
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.topology import *
+
+rails = 2
+striping = "round_robin"
+if len(sys.argv) > 1: rails = int(sys.argv[1])
+if len(sys.argv) > 2: striping = sys.argv[2]
+
+topo = topoDragonFly()
+topo.hosts_per_router = 2
+topo.routers_per_group = 4
+topo.intergroup_links = 1
+topo.num_groups = 9
+topo.algorithm = "minimal"
+topo.link_latency = "20ns"
+
+router = hr_router()
+router.link_bw = "4GB/s"
+router.flit_size = "8B"
+router.xbar_bw = "4GB/s"
+router.input_latency = "20ns"
+router.output_latency = "20ns"
+router.input_buf_size = "4kB"
+router.output_buf_size = "4kB"
+topo.setRouterTemplate(router)
+
+linkcontrol = LinkControl()
+linkcontrol.link_bw = "4GB/s"
+linkcontrol.input_buf_size = "4kB"
+linkcontrol.output_buf_size = "4kB"
+
+networkif = MultiRailLinkControl()
+networkif.num_rails = rails
+networkif.striping = striping
+networkif.setNetworkInterface(linkcontrol)
+networkif.enableStatistics(["rail_packets"], {"type": "sst.AccumulatorStatistic"})
+
+system = System()
+system.setTopology(topo)
+system.setNumRails(rails)
+
+test = TestJob(0, topo.getNumNodes())
+test.num_messages = 200
+test.message_size = "256B"
+test.network_interface = networkif
+system.allocateNodes(test, "linear")
+
+system.build()
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
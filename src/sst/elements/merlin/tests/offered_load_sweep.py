@@ -0,0 +1,71 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Latency versus offered load sweep for a 72 node dragonfly in a
+# single simulation.  Endpoint 0 prints the curve and the saturation
+# point at the end of the run, and writes it to offered_load_sweep.csv.
+#
+# Usage: sst offered_load_sweep.py --model-options="[pattern] [algorithm]"
+#   pattern:   uniform, group_shift, tornado, bit_complement (default group_shift)
+#   algorithm: dragonfly routing algorithm (default minimal)
+#
+# Check the curve with:
+#   python checkOfferedLoad.py offered_load_sweep.csv [saturated load]
+# With group_shift and minimal routing, the 8 hosts of a group share the
+# one global link to the next group, so every load from 0.2 up must be
+# saturated:
+#   python checkOfferedLoad.py offered_load_sweep.csv 0.2
+
+import sys
+import sst
+from sst.merlin import *
+
+pattern = "group_shift"
+algorithm = "minimal"
+if len(sys.argv) > 1: pattern = sys.argv[1]
+if len(sys.argv) > 2: algorithm = sys.argv[2]
+
+topo = topoDragonFly2()
+endPoint = OfferedLoadEndPoint()
+
+sst.merlin._params["dragonfly:hosts_per_router"] = "2"
+sst.merlin._params["dragonfly:routers_per_group"] = "4"
+sst.merlin._params["dragonfly:intergroup_links"] = "1"
+sst.merlin._params["dragonfly:num_groups"] = "9"
+sst.merlin._params["dragonfly:algorithm"] = algorithm
+
+sst.merlin._params["link_bw"] = "4GB/s"
+sst.merlin._params["link_lat"] = "20ns"
+sst.merlin._params["flit_size"] = "8B"
+sst.merlin._params["xbar_bw"] = "4GB/s"
+sst.merlin._params["input_latency"] = "20ns"
+sst.merlin._params["output_latency"] = "20ns"
+sst.merlin._params["input_buf_size"] = "4kB"
+sst.merlin._params["output_buf_size"] = "4kB"
+sst.merlin._params["xbar_arb"] = "merlin.xbar_arb_lru"
+
+sst.merlin._params["offered_load"] = "[0.05, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.8]"
+sst.merlin._params["message_size"] = "64B"
+sst.merlin._params["buffer_size"] = "4kB"
+sst.merlin._params["pattern"] = "merlin.targetgen.%s"%pattern
+sst.merlin._params["pattern:hosts_per_group"] = 8
+sst.merlin._params["pattern:hosts_per_router"] = 2
+sst.merlin._params["warmup_time"] = "2us"
+sst.merlin._params["collect_time"] = "10us"
+sst.merlin._params["drain_time"] = "10us"
+sst.merlin._params["output_file"] = "offered_load_sweep.csv"
+
+topo.prepParams()
+endPoint.prepParams()
+topo.setEndPoint(endPoint)
+topo.build()
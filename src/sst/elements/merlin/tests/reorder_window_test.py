@@ -0,0 +1,73 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# ReorderLinkControl with a reorder_window too small for the network.
+#
+# Every NIC of a 72 node dragonfly sends to the NIC in the same place in
+# the next group.  Valiant routing sends each packet through a random
+# intermediate group, so packets often arrive more than 2 sequence
+# numbers ahead and overflow the window into the heap.  The shift NICs
+# count packets delivered out of order, which must stay 0.
+#
+# Check the output with:
+#   sst reorder_window_test.py > out
+#   python checkReorderWindow.py out 72 500
+
+import sst
+from sst.merlin import *
+
+class ReorderShiftEndPoint(ShiftEndPoint):
+    def build(self, nID, extraKeys):
+        (nic, port_name, latency) = ShiftEndPoint.build(self, nID, extraKeys)
+        reorder = nic.setSubComponent("networkIF", "merlin.reorderlinkcontrol")
+        reorder.addParam("reorder_window", 2)
+        reorder.enableStatistics(["reorder_depth", "reorder_overflow"], {"type": "sst.AccumulatorStatistic"})
+        networkif = reorder.setSubComponent("networkIF", "merlin.linkcontrol")
+        networkif.addParams({
+            "link_bw" : sst.merlin._params["link_bw"],
+            "input_buf_size" : "1kB",
+            "output_buf_size" : "1kB",
+        })
+        return (networkif, "rtr_port", latency)
+
+topo = topoDragonFly2()
+endPoint = ReorderShiftEndPoint()
+
+sst.merlin._params["dragonfly:hosts_per_router"] = "2"
+sst.merlin._params["dragonfly:routers_per_group"] = "4"
+sst.merlin._params["dragonfly:intergroup_links"] = "1"
+sst.merlin._params["dragonfly:num_groups"] = "9"
+sst.merlin._params["dragonfly:algorithm"] = "valiant"
+
+sst.merlin._params["link_bw"] = "4GB/s"
+sst.merlin._params["link_lat"] = "20ns"
+sst.merlin._params["flit_size"] = "8B"
+sst.merlin._params["xbar_bw"] = "4GB/s"
+sst.merlin._params["input_latency"] = "20ns"
+sst.merlin._params["output_latency"] = "20ns"
+sst.merlin._params["input_buf_size"] = "4kB"
+sst.merlin._params["output_buf_size"] = "4kB"
+sst.merlin._params["xbar_arb"] = "merlin.xbar_arb_lru"
+
+sst.merlin._params["num_peers"] = 72
+sst.merlin._params["shift"] = 8
+sst.merlin._params["packets_to_send"] = 500
+sst.merlin._params["packet_size"] = "64B"
+
+topo.prepParams()
+endPoint.prepParams()
+topo.setEndPoint(endPoint)
+topo.build()
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
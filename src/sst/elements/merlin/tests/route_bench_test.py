@@ -0,0 +1,78 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Benchmarks a topology's routing function with merlin.route_bench.
+# Every endpoint routes a packet to every other endpoint without any
+# simulation, then routes/sec, the path length distribution, the link
+# load under uniform all-to-all traffic and the result of the channel
+# dependency cycle check for each VN are printed.  The run fails with
+# a non-zero exit if a packet is misrouted, goes over the hop limit or
+# the channel dependency graph of a VN has a cycle.
+#
+# Usage: sst route_bench_test.py --model-options="[topology] [algorithm]"
+#   topology:  dragonfly, fattree, torus, mesh or hyperx (default dragonfly)
+#   algorithm: routing algorithm for dragonfly and hyperx (default
+#              minimal for dragonfly and DOR for hyperx)
+
+import sys
+import sst
+from sst.merlin.base import *
+from sst.merlin.topology import *
+
+topology = "dragonfly"
+algorithm = None
+if len(sys.argv) > 1: topology = sys.argv[1]
+if len(sys.argv) > 2: algorithm = sys.argv[2]
+
+if topology == "dragonfly":
+    topo = topoDragonFly()
+    topo.hosts_per_router = 4
+    topo.routers_per_group = 8
+    topo.intergroup_links = 4
+    topo.num_groups = 16
+    topo.algorithm = algorithm if algorithm else "minimal"
+elif topology == "fattree":
+    topo = topoFatTree()
+    topo.shape = "8,8:8,8:16"
+elif topology == "torus":
+    topo = topoTorus()
+    topo.shape = "8x8x8"
+    topo.width = "1x1x1"
+    topo.local_ports = 1
+elif topology == "mesh":
+    topo = topoMesh()
+    topo.shape = "8x8x8"
+    topo.width = "1x1x1"
+    topo.local_ports = 1
+elif topology == "hyperx":
+    topo = topoHyperX()
+    topo.shape = "8x8"
+    topo.width = "1x1"
+    topo.local_ports = 8
+    if algorithm: topo.algorithm = algorithm
+else:
+    print("Unknown topology: %s"%topology)
+    sst.exit()
+
+topo.link_latency = "20ns"
+
+router = route_bench()
+router.num_vns = 2
+router.samples_per_pair = 1
+router.fatal_on_error = True
+topo.setRouterTemplate(router)
+
+# No jobs, so the host ports are left unconnected
+system = System()
+system.setTopology(topo)
+system.build()
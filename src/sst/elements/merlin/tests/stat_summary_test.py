@@ -0,0 +1,63 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Per rank router statistics summary.
+#
+# NIC 0 sends packets to NIC 1 through a single router with the
+# summary turned on, and the record is written to the simulation
+# output.  The crossbar is eight times faster than the links, so every
+# packet crosses the router in one flit time plus a few crossbar
+# cycles (well under 64 ns) and nothing ever stalls.  The 10us links
+# stretch the run so that both ports fall in the lowest utilization
+# bin.
+#
+# Check the summary record with:
+#   sst stat_summary_test.py > out
+#   python checkStatSummary.py out 1 2 10 64
+
+import sst
+
+packets = 10
+
+rtr = sst.Component("rtr", "merlin.hr_router")
+rtr.addParams({
+    "id" : 0,
+    "num_ports" : 2,
+    "link_bw" : "1GB/s",
+    "xbar_bw" : "8GB/s",
+    "flit_size" : "8B",
+    "input_latency" : "10ns",
+    "output_latency" : "10ns",
+    "input_buf_size" : "1KiB",
+    "output_buf_size" : "1KiB",
+    "stats_summary" : True,
+})
+rtr.setSubComponent("topology", "merlin.singlerouter")
+
+for i in range(2):
+    nic = sst.Component("nic%d"%i, "merlin.pt2pt_test")
+    nic.addParams({
+        "packet_size" : "64B",
+        "packets_to_send" : packets,
+        "src" : [0],
+        "dest" : [1],
+    })
+    networkif = nic.setSubComponent("networkIF", "merlin.linkcontrol")
+    networkif.addParams({
+        "link_bw" : "1GB/s",
+        "input_buf_size" : "1KiB",
+        "output_buf_size" : "1KiB",
+    })
+
+    link = sst.Link("nic%d_link"%i)
+    link.connect( (networkif, "rtr_port", "10us"), (rtr, "port%d"%i, "10us") )
@@ -0,0 +1,189 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Checks ActiveVCSet against a linear scan of a per-VC occupied flag,
+ * which is what hr_router and its arbiters did before the bitmap.
+ * Run by 'make check'. Exits non-zero on the first difference.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <utility>
+#include <vector>
+
+#include "../activeVCSet.h"
+
+using namespace SST::Merlin;
+
+typedef std::vector<std::vector<bool> > Occupied; // [port][vc]
+
+static int linearNext(const Occupied& occ, int port, int vc) {
+    for ( ; vc < (int)occ[port].size(); vc++ ) {
+        if ( occ[port][vc] ) return vc;
+    }
+    return -1;
+}
+
+static bool compare(const ActiveVCSet& set, const Occupied& occ, const char* test) {
+    int num_ports = occ.size();
+    int num_vcs = occ[0].size();
+
+    for ( int port = 0; port < num_ports; port++ ) {
+        for ( int vc = 0; vc <= num_vcs; vc++ ) {
+            int expected = linearNext(occ, port, vc);
+            if ( set.nextInPort(port, vc) != expected ) {
+                fprintf(stderr, "%s: %d VCs, nextInPort(%d, %d) returned %d, expected %d\n",
+                        test, num_vcs, port, vc, set.nextInPort(port, vc), expected);
+                return false;
+            }
+            if ( expected == -1 ) expected = linearNext(occ, port, 0);
+            if ( set.nextInPortWrap(port, vc) != expected ) {
+                fprintf(stderr, "%s: %d VCs, nextInPortWrap(%d, %d) returned %d, expected %d\n",
+                        test, num_vcs, port, vc, set.nextInPortWrap(port, vc), expected);
+                return false;
+            }
+        }
+    }
+
+    std::vector<std::pair<int,int> > seen;
+    std::vector<std::pair<int,int> > expected;
+    set.forEach([&seen](int port, int vc) { seen.push_back(std::make_pair(port, vc)); });
+    for ( int port = 0; port < num_ports; port++ ) {
+        for ( int vc = 0; vc < num_vcs; vc++ ) {
+            if ( occ[port][vc] ) expected.push_back(std::make_pair(port, vc));
+        }
+    }
+    if ( seen != expected ) {
+        fprintf(stderr, "%s: %d VCs, forEach visited %zu VCs, not the %zu occupied VCs in port then VC order\n",
+                test, num_vcs, seen.size(), expected.size());
+        return false;
+    }
+    return true;
+}
+
+/* Each port picks the first occupied VC at or after its round robin
+   VC that can make progress, wrapping.  The reference is the loop
+   xbar_arb_rr used before the bitmap, the other is its current loop. */
+static bool compareRoundRobin(const ActiveVCSet& set, const Occupied& occ, const Occupied& can_progress, const char* test) {
+    int num_ports = occ.size();
+    int num_vcs = occ[0].size();
+
+    for ( int port = 0; port < num_ports; port++ ) {
+        for ( int rr_vc = 0; rr_vc < num_vcs; rr_vc++ ) {
+            int expected = -1;
+            for ( int vc = rr_vc, vcount = 0; vcount < num_vcs; vc = (vc + 1) % num_vcs, vcount++ ) {
+                if ( occ[port][vc] && can_progress[port][vc] ) {
+                    expected = vc;
+                    break;
+                }
+            }
+
+            int picked = -1;
+            int vc = set.nextInPortWrap(port, rr_vc);
+            for ( int first_vc = vc; vc != -1; ) {
+                if ( can_progress[port][vc] ) {
+                    picked = vc;
+                    break;
+                }
+                vc = set.nextInPortWrap(port, vc + 1);
+                if ( vc == first_vc ) break;
+            }
+
+            if ( picked != expected ) {
+                fprintf(stderr, "%s: %d VCs, port %d starting at VC %d picked VC %d, expected %d\n",
+                        test, num_vcs, port, rr_vc, picked, expected);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Random set and clear, checked after every few changes */
+static bool testRandom(int num_ports, int num_vcs, unsigned seed) {
+    const char* test = "random";
+    ActiveVCSet set;
+    set.init(num_ports, num_vcs);
+    Occupied occ(num_ports, std::vector<bool>(num_vcs, false));
+    Occupied can_progress(num_ports, std::vector<bool>(num_vcs, false));
+    srand(seed);
+
+    if ( !compare(set, occ, test) ) return false;
+    for ( int step = 0; step < 2000; step++ ) {
+        // Vary how full the ports are over the run
+        int fill = (step / 200) % 4;
+        int port = rand() % num_ports;
+        int vc = rand() % num_vcs;
+        if ( rand() % 4 < fill ) {
+            set.set(port, vc);
+            occ[port][vc] = true;
+        }
+        else {
+            set.clear(port, vc);
+            occ[port][vc] = false;
+        }
+        can_progress[port][vc] = rand() % 3 == 0;
+
+        if ( step % 16 == 0 ) {
+            if ( !compare(set, occ, test) ) return false;
+            if ( !compareRoundRobin(set, occ, can_progress, test) ) return false;
+        }
+    }
+    return compare(set, occ, test) && compareRoundRobin(set, occ, can_progress, test);
+}
+
+/* First and last VC of each word, on every port */
+static bool testEdges(int num_ports, int num_vcs) {
+    const char* test = "edges";
+    ActiveVCSet set;
+    set.init(num_ports, num_vcs);
+    Occupied occ(num_ports, std::vector<bool>(num_vcs, false));
+    Occupied can_progress(num_ports, std::vector<bool>(num_vcs, true));
+
+    for ( int port = 0; port < num_ports; port++ ) {
+        for ( int vc = 0; vc < num_vcs; vc++ ) {
+            if ( vc % 64 != 0 && vc % 64 != 63 && vc != num_vcs - 1 ) continue;
+            set.set(port, vc);
+            occ[port][vc] = true;
+            if ( !compare(set, occ, test) || !compareRoundRobin(set, occ, can_progress, test) ) return false;
+        }
+    }
+    for ( int port = num_ports - 1; port >= 0; port-- ) {
+        for ( int vc = 0; vc < num_vcs; vc++ ) {
+            if ( !occ[port][vc] ) continue;
+            set.clear(port, vc);
+            occ[port][vc] = false;
+            if ( !compare(set, occ, test) || !compareRoundRobin(set, occ, can_progress, test) ) return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    int vcs[] = { 1, 2, 3, 8, 63, 64, 65, 127, 128, 130 };
+    bool pass = true;
+    for ( size_t i = 0; pass && i < sizeof(vcs) / sizeof(vcs[0]); i++ ) {
+        pass = testEdges(5, vcs[i]) && testRandom(5, vcs[i], i + 1);
+    }
+
+    if ( !pass ) {
+        fprintf(stderr, "ActiveVCSet test FAILED\n");
+        return 1;
+    }
+    printf("ActiveVCSet test passed\n");
+    return 0;
+}
@@ -0,0 +1,128 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Times construction of a large dragonfly or fat tree through the
+# sst.merlin python topologies.  Prints the time spent in the python
+# build (components, subcomponents and links) and the time per
+# endpoint, which should stay roughly flat as the size grows.
+#
+# With the C++ link tables, the table is also built by the topology's
+# pure python _linkTable() and the run fails if the two differ, so a
+# small run doubles as a check:
+#   sst --run-mode=init topo_build_benchmark.py --model-options="dragonfly 1000"
+#   sst --run-mode=init topo_build_benchmark.py --model-options="fattree 1000"
+#
+# Usage: sst --run-mode=init topo_build_benchmark.py --model-options="[topology] [endpoints] [tables]"
+#   topology:  dragonfly or fattree (default dragonfly)
+#   endpoints: minimum number of endpoints (default 100000)
+#   tables:    native to use the C++ link tables, python to force the
+#              pure python fallback (default native)
+
+import sys
+import time
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.topology import *
+
+topology = "dragonfly"
+target = 100000
+tables = "native"
+if len(sys.argv) > 1: topology = sys.argv[1]
+if len(sys.argv) > 2: target = int(sys.argv[2])
+if len(sys.argv) > 3: tables = sys.argv[3]
+
+if tables == "python":
+    # Makes the import in the topologies' build() fail
+    sys.modules["sst.merlin.native"] = None
+
+if topology == "dragonfly":
+    # Balanced dragonfly: a hosts per router, 2a routers per group,
+    # a global links per router and a full set of groups
+    a = 1
+    while a * 2 * a * (2 * a * a + 1) < target: a += 1
+    topo = topoDragonFly()
+    topo.hosts_per_router = a
+    topo.routers_per_group = 2 * a
+    topo.intergroup_links = 1
+    topo.num_groups = 2 * a * a + 1
+    num_routers = topo.routers_per_group * topo.num_groups
+elif topology == "fattree":
+    # Three level fat tree built from radix k routers
+    k = 2
+    while k * k * k // 4 < target: k += 2
+    topo = topoFatTree()
+    topo.shape = "%d,%d:%d,%d:%d"%(k // 2, k // 2, k // 2, k // 2, k)
+    num_routers = k * k + k * k // 4
+else:
+    print("Unknown topology: %s"%topology)
+    sst.exit()
+
+topo.link_latency = "20ns"
+
+router = hr_router()
+router.link_bw = "4GB/s"
+router.flit_size = "8B"
+router.xbar_bw = "4GB/s"
+router.input_latency = "20ns"
+router.output_latency = "20ns"
+router.input_buf_size = "4kB"
+router.output_buf_size = "4kB"
+topo.setRouterTemplate(router)
+
+num_nodes = topo.getNumNodes()
+
+job = TestJob(0, num_nodes)
+job.num_messages = 1
+job.message_size = "8B"
+
+networkif = LinkControl()
+networkif.link_bw = "4GB/s"
+networkif.input_buf_size = "4kB"
+networkif.output_buf_size = "4kB"
+job.network_interface = networkif
+
+system = System()
+system.setTopology(topo)
+system.allocateNodes(job, "linear")
+
+start = time.time()
+system.build()
+elapsed = time.time() - start
+
+print("%s (%s link tables): %d endpoints, %d routers"%(topo.getName(), tables, num_nodes, num_routers))
+print("  build time: %.2f s (%.1f us per endpoint)"%(elapsed, elapsed * 1.0e6 / num_nodes))
+
+# The C++ and python link tables must connect every router port to the
+# same link.  The two number the links in a different order, so the
+# tables are compared by link name.
+def portsByName(table):
+    (link_names, router_links) = table
+    return [sorted((port, link_names[link]) for (port, link) in conns) for conns in router_links]
+
+if tables == "native":
+    from sst.merlin.native import dragonfly_links, fattree_links
+    start = time.time()
+    if topology == "dragonfly":
+        igpr = len(topo.global_link_map) // topo.routers_per_group
+        native_table = dragonfly_links(topo._prefix, topo.hosts_per_router, topo.routers_per_group, igpr, topo.num_groups,
+                                       topo.global_link_map, topo.global_routes == "relative")
+        python_table = topo._linkTable(igpr)
+    else:
+        native_table = fattree_links(topo._prefix, topo._downs, topo._ups)
+        python_table = topo._linkTable()
+    print("  link table check: %.2f s"%(time.time() - start))
+    if len(native_table[0]) != len(python_table[0]) or portsByName(native_table) != portsByName(python_table):
+        print("FAIL: the C++ and python link tables differ")
+        sst.exit()
+    print("  C++ and python link tables match (%d links)"%len(native_table[0]))
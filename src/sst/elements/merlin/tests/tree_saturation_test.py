@@ -0,0 +1,74 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Tree saturation detection on an incast in a 1-D mesh.
+#
+# Three routers in a line with two NICs each.  NICs 0-4 all stream
+# packets to NIC 5 on router 2, so the host port to NIC 5 is the root
+# of the tree and the congestion backs up through router 1 into
+# router 0.  For as long as the backlog lasts, all three routers see
+# blocked heads for destination 5 in every window, which the detector
+# logs as one episode rooted at router 2.
+#
+# The log is written to the simulation output.  Check it with:
+#   sst tree_saturation_test.py > out
+#   python checkTreeSaturation.py out 3 5 2
+
+import sst
+
+num_routers = 3
+local_ports = 2
+num_nics = num_routers * local_ports
+packets = 100
+
+rtrs = []
+for i in range(num_routers):
+    rtr = sst.Component("rtr%d"%i, "merlin.hr_router")
+    rtr.addParams({
+        "id" : i,
+        "num_ports" : 2 + local_ports,
+        "link_bw" : "4GB/s",
+        "xbar_bw" : "4GB/s",
+        "flit_size" : "8B",
+        "input_latency" : "10ns",
+        "output_latency" : "10ns",
+        "input_buf_size" : "1KiB",
+        "output_buf_size" : "1KiB",
+        "tree_saturation" : True,
+        "tree_saturation_window" : "1us",
+    })
+    topo = rtr.setSubComponent("topology", "merlin.mesh")
+    topo.addParams({
+        "shape" : str(num_routers),
+        "width" : "1",
+        "local_ports" : local_ports,
+    })
+    rtrs.append(rtr)
+
+for i in range(num_routers - 1):
+    link = sst.Link("rtr_link%d"%i)
+    link.connect( (rtrs[i], "port0", "20ns"), (rtrs[i+1], "port1", "20ns") )
+
+for i in range(num_nics):
+    nic = sst.Component("nic%d"%i, "merlin.pt2pt_test")
+    nic.addParams({
+        "link_bw" : "4GB/s",
+        "packet_size" : "64B",
+        "packets_to_send" : packets,
+        "buffer_size" : "1KiB",
+        "src" : list(range(num_nics - 1)),
+        "dest" : [num_nics - 1] * (num_nics - 1),
+    })
+
+    link = sst.Link("nic%d_link"%i)
+    link.connect( (nic, "rtr", "10ns"), (rtrs[i // local_ports], "port%d"%(2 + i % local_ports), "10ns") )
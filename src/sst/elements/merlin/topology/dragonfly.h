@@ -25,6 +25,7 @@
 #include <sst/core/rng/sstrng.h>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/topology/routingTable.h"
 
 
 
@@ -98,6 +99,7 @@ public:
         {"adaptive_threshold",    "Threshold to use when make adaptive routing decisions.", "2.0"},
         {"global_link_map",       "Array specifying connectivity of global links in each dragonfly group."},
         {"global_route_mode",     "Mode for intepreting global link map [absolute (default) | relative].","absolute"},
+        {"table_routing",         "Look up the output port for each (group, global slice) pair from a table built on first use instead of translating it through the global link map for every packet.  Valiant's choice of intermediate group still uses arithmetic on every packet.", "false"},
     )
 
     /* Assumed connectivity of each router:
@@ -137,6 +139,12 @@ public:
     enum global_route_mode_t { ABSOLUTE, RELATIVE };
     global_route_mode_t global_route_mode;
 
+    // Output port to reach group/slice, indexed by group * n + slice.
+    // Built on first use since group_to_global_port is only complete
+    // once the shared region has been merged.
+    bool table_routing;
+    RoutingTable<uint16_t> group_port_table;
+
 public:
     struct dgnflyAddr {
         uint32_t group;
@@ -169,6 +177,8 @@ private:
     uint32_t router_to_group(uint32_t group);
     uint32_t port_for_router(uint32_t router);
     uint32_t port_for_group(uint32_t group, uint32_t global_slice, int id = -1);
+    uint32_t compute_port_for_group(uint32_t group, uint32_t global_slice);
+    void build_group_port_table();
 
 };
 
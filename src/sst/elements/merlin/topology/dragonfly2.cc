@@ -149,6 +149,8 @@ topo_dragonfly2::topo_dragonfly2(ComponentId_t cid, Params &p, int num_ports, in
 
     rng = new RNG::XORShiftRNG(rtr_id+1);
 
+    table_routing = p.find<bool>("table_routing", false);
+
     output.verbose(CALL_INFO, 1, 1, "%u:%u:  ID: %u   Params:  p = %u  a = %u  k = %u  h = %u  g = %u\n",
             group_id, router_id, rtr_id, params.p, params.a, params.k, params.h, params.g);
 }
@@ -162,6 +164,7 @@ topo_dragonfly2::~topo_dragonfly2()
 void topo_dragonfly2::route(int port, int vc, internal_router_event* ev)
 {
     topo_dragonfly2_event *td_ev = static_cast<topo_dragonfly2_event*>(ev);
+    if ( table_routing && !group_port_table.isInitialized() ) build_group_port_table();
 
     // Break this up by port type
     uint32_t next_port = 0;
@@ -243,6 +246,7 @@ void topo_dragonfly2::route(int port, int vc, internal_router_event* ev)
 void topo_dragonfly2::reroute(int port, int vc, internal_router_event* ev)
 {
     if ( algorithm != ADAPTIVE_LOCAL ) return;
+    if ( table_routing && !group_port_table.isInitialized() ) build_group_port_table();
 
     // For now, we make the adaptive routing decision only at the
     // input to the network and at the input to a group for adaptively
@@ -568,6 +572,30 @@ uint32_t topo_dragonfly2::router_to_group(uint32_t group)
 
 /* returns local router port if group can't be reached from this router */
 uint32_t topo_dragonfly2::port_for_group(uint32_t group, uint32_t slice, int id)
+{
+    // Table is not used during init, where it can't be built yet
+    if ( group_port_table.isInitialized() ) {
+        return group_port_table[group * params.n + slice];
+    }
+    return compute_port_for_group(group, slice);
+}
+
+
+void topo_dragonfly2::build_group_port_table()
+{
+    group_port_table.init(params.g * params.n);
+    for ( uint32_t group = 0; group < params.g; group++ ) {
+        for ( uint32_t slice = 0; slice < params.n; slice++ ) {
+            // Entries for our own group are never used
+            uint32_t port = group == group_id ? 0 : compute_port_for_group(group, slice);
+            group_port_table.set(group * params.n + slice, port);
+        }
+    }
+    group_port_table.publish();
+}
+
+
+uint32_t topo_dragonfly2::compute_port_for_group(uint32_t group, uint32_t slice)
 {
     // Look up global port to use
     switch ( global_route_mode ) {
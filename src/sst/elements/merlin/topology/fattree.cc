@@ -65,7 +65,10 @@ topo_fattree::topo_fattree(ComponentId_t cid, Params& params, int num_ports, int
     id(rtr_id),
     num_ports(num_ports),
     num_vcs(-1),
-    allow_adaptive(false)
+    output_queue_lengths(NULL),
+    thresholds(NULL),
+    allow_adaptive(false),
+    load_balanced(false)
 {
     string shape = params.find<std::string>("shape");
 
@@ -73,6 +76,9 @@ topo_fattree::topo_fattree(ComponentId_t cid, Params& params, int num_ports, int
     if ( routing_alg == "adaptive" ) {
         allow_adaptive = true;
     }
+    else if ( routing_alg == "load_balanced" ) {
+        load_balanced = true;
+    }
 
     adaptive_threshold = params.find<double>("adaptive_threshold", 0.5);
     // std::cout << "routing_alg: " << routing_alg << std::endl;
@@ -136,6 +142,26 @@ topo_fattree::topo_fattree(ComponentId_t cid, Params& params, int num_ports, int
 
     low_host = level_group * rid;
     high_host = low_host + rid - 1;
+
+    table_routing = params.find<bool>("table_routing", false);
+    if ( table_routing ) {
+        // Routes only depend on the level and the level group, so all
+        // routers in a group can use the same table
+        std::string key;
+        if ( params.find<bool>("share_routing_table", true) ) {
+            key = "fattree_route_table:" + shape + ":" + std::to_string(rtr_level) + ":" + std::to_string(level_group);
+        }
+        port_table.init(total_hosts, key);
+        for ( int dest = 0; dest < total_hosts; dest++ ) {
+            if ( dest >= low_host && dest <= high_host ) {
+                port_table.set(dest, (dest - low_host) / down_route_factor);
+            }
+            else {
+                port_table.set(dest, down_ports + ((dest/down_route_factor) % up_ports));
+            }
+        }
+        port_table.publish();
+    }
     
     // cout << "low host = " << low_host << ", high host = " << high_host <<
     //     ", down_route_factor = " << down_route_factor << endl;
@@ -153,10 +179,15 @@ topo_fattree::topo_fattree(ComponentId_t cid, Params& params, int num_ports, int
 
 topo_fattree::~topo_fattree()
 {
+    delete [] thresholds;
 }
 
 void topo_fattree::route(int port, int vc, internal_router_event* ev)  {
     int dest = ev->getDest();
+    if ( table_routing ) {
+        ev->setNextPort(port_table[dest]);
+        return;
+    }
     // Down routes
     if ( dest >= low_host && dest <= high_host ) {
         ev->setNextPort((dest - low_host) / down_route_factor);
@@ -177,13 +208,33 @@ void topo_fattree::reroute(int port, int vc, internal_router_event* ev)
     }
     // Up routes can be adaptive, so things can change from the normal path
     else {
+        // Every up port leads to a router that can reach the
+        // destination, so each hop can pick the up port with the
+        // shortest output queue.  Start the search at the
+        // deterministic port so that ties (e.g. an idle network) keep
+        // the deterministic spreading of destinations across ports.
+        if ( load_balanced ) {
+            int next_port = ev->getNextPort();
+            int best_port = next_port;
+            int best = output_queue_lengths[next_port*num_vcs + vc];
+            for ( int i = 1; i < up_ports && best > 0; i++ ) {
+                int p = down_ports + ((next_port - down_ports + i) % up_ports);
+                int weight = output_queue_lengths[p*num_vcs + vc];
+                if ( weight < best ) {
+                    best = weight;
+                    best_port = p;
+                }
+            }
+            ev->setNextPort(best_port);
+            return;
+        }
+
         // If we're not adaptive, then we're already routed
         if ( !allow_adaptive ) return;
 
         // If the port we're supposed to be going to has a buffer with
         // fewer credits than the threshold, adaptively route
         int next_port = ev->getNextPort();
-        int vc = ev->getVC();
         int index  = next_port*num_vcs + vc;
         if ( outputCredits[index] >= thresholds[index] ) return;
         
@@ -326,3 +377,8 @@ void topo_fattree::setOutputBufferCreditArray(int const* array, int vcs) {
         }
         
 }
+
+void topo_fattree::setOutputQueueLengthsArray(int const* array, int vcs) {
+    num_vcs = vcs;
+    output_queue_lengths = array;
+}
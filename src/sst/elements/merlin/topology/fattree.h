@@ -24,6 +24,7 @@
 #include <sst/core/params.h>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/topology/routingTable.h"
 
 namespace SST {
 namespace Merlin {
@@ -42,12 +43,14 @@ public:
 
     SST_ELI_DOCUMENT_PARAMS(
         {"fattree:shape",               "Shape of the fattree"},
-        {"fattree:routing_alg",         "Routing algorithm to use. [deterministic | adaptive]","deterministic"},
+        {"fattree:routing_alg",         "Routing algorithm to use. [deterministic | adaptive | load_balanced]","deterministic"},
         {"fattree:adaptive_threshold",  "Threshold used to determine if a packet will adaptively route."},
 
         {"shape",               "Shape of the fattree"},
-        {"routing_alg",         "Routing algorithm to use. [deterministic | adaptive]","deterministic"},
-        {"adaptive_threshold",  "Threshold used to determine if a packet will adaptively route."}
+        {"routing_alg",         "Routing algorithm to use. [deterministic | adaptive | load_balanced]  load_balanced sends every up route out the up port with the shortest output queue.","deterministic"},
+        {"adaptive_threshold",  "Threshold used to determine if a packet will adaptively route."},
+        {"table_routing",       "Route using a destination to port table computed at construction.", "false"},
+        {"share_routing_table", "When table_routing is enabled, keep one copy of the table for all routers in the same level and group.  The table is stored in a SharedRegion.", "true"}
     )
 
 
@@ -69,10 +72,16 @@ private:
     int num_vcs;
 
     int const* outputCredits;
+    int const* output_queue_lengths;
     int* thresholds;
     bool allow_adaptive;
+    bool load_balanced;
     double adaptive_threshold;
 
+    // Deterministic output port indexed by destination endpoint
+    bool table_routing;
+    RoutingTable<int> port_table;
+
     void parseShape(const std::string &shape, int *downs, int *ups) const;
 
 
@@ -92,6 +101,7 @@ public:
     virtual PortState getPortState(int port) const;
 
     virtual void setOutputBufferCreditArray(int const* array, int vcs);
+    virtual void setOutputQueueLengthsArray(int const* array, int vcs);
 
     virtual int computeNumVCs(int vns) {return vns;}
 
@@ -106,10 +106,16 @@ topo_hyperx::topo_hyperx(ComponentId_t cid, Params& params, int num_ports, int r
         algorithm = MINA;
         vcs_per_vn = dimensions;
     }
+    else if ( !route_algo.compare("UGAL") ) {
+        algorithm = UGAL;
+        vcs_per_vn = 2;
+    }
     else {
         output.fatal(CALL_INFO,-1,"Unknown routing mode specified: %s\n",route_algo.c_str());
     }
 
+    ugal_bias = params.find<int>("ugal_bias", 0);
+
     rng = new RNG::XORShiftRNG(router_id+1);
     rng_func = new RNGFunc(rng);
     
@@ -118,6 +124,28 @@ topo_hyperx::topo_hyperx(ComponentId_t cid, Params& params, int num_ports, int r
         total_routers *= dim_size[i];
     }
 
+    table_routing = false;
+    table_offset = NULL;
+    if ( params.find<bool>("table_routing", false) ) {
+        table_offset = new int[dimensions];
+        int entries = 0;
+        for ( int dim = 0; dim < dimensions; ++dim ) {
+            table_offset[dim] = entries;
+            entries += dim_size[dim];
+        }
+
+        // Fill in using the arithmetic version, then switch over
+        port_table.init(entries);
+        for ( int dim = 0; dim < dimensions; ++dim ) {
+            for ( int coord = 0; coord < dim_size[dim]; ++coord ) {
+                // Entry for our own coordinate is never used
+                port_table.set(table_offset[dim] + coord, coord == id_loc[dim] ? -1 : minimal_port(dim, coord));
+            }
+        }
+        port_table.publish();
+        table_routing = true;
+    }
+
     
     
 }
@@ -128,6 +156,7 @@ topo_hyperx::~topo_hyperx()
     delete [] dim_size;
     delete [] dim_width;
     delete [] port_start;
+    delete [] table_offset;
 }
 
 void
@@ -170,6 +199,10 @@ void topo_hyperx::reroute(int port, int vc, internal_router_event* ev)
     else if ( algorithm == VDAL ) {
         return routeVDAL(port,vc,tt_ev);
     }
+
+    else if ( algorithm == UGAL ) {
+        return routeUGAL(port,vc,tt_ev);
+    }
     
     // Look for opportunities to adaptively route
 
@@ -186,7 +219,7 @@ topo_hyperx::process_input(RtrEvent* ev)
     topo_hyperx_event* tt_ev = new topo_hyperx_event(dimensions);
     tt_ev->setEncapsulatedEvent(ev);
     tt_ev->setVC(vcs_per_vn * tt_ev->getVN());
-    if ( algorithm == VALIANT ) {
+    if ( algorithm == VALIANT || algorithm == UGAL ) {
         int mid;
         do {
             mid = rng->generateNextUInt32() % total_routers;
@@ -384,10 +417,8 @@ topo_hyperx::routeDORBase(int* dest_loc) {
     for ( int dim = 0 ; dim < dimensions ; ++dim ) {
         // Find first unaligned dimension and route to align it
         if ( dest_loc[dim] != id_loc[dim] ) {
-            // Get offset to the first unaligned dimension
-            int offset = dest_loc[dim] - ((dest_loc[dim] > id_loc[dim]) ? 1 : 0);
-            offset *= dim_width[dim];
-            return std::make_pair(dim,port_start[dim] + offset);
+            // Get the first port in the first unaligned dimension
+            return std::make_pair(dim,minimal_port(dim,dest_loc[dim]));
         }
     }
     return std::make_pair(-1,-1);
@@ -437,7 +468,7 @@ topo_hyperx::routeDORND(int port, int vc, topo_hyperx_event* ev) {
 }
 
 void
-topo_hyperx::routeValiant(int port, int vc, topo_hyperx_event* ev) {
+topo_hyperx::routeValiant(int port, int vc, topo_hyperx_event* ev, int first_port) {
     // first we do a minimal route to the valiant router, then do
     // minimal route to dest.
     int next_vc = vc;
@@ -450,7 +481,7 @@ topo_hyperx::routeValiant(int port, int vc, topo_hyperx_event* ev) {
             next_vc = vc + 1;
         }
         else {
-            int p = choose_multipath(next_port.second,dim_width[next_port.first]);
+            int p = first_port != -1 ? first_port : choose_multipath(next_port.second,dim_width[next_port.first]);
             ev->setNextPort(p);
             ev->setVC(next_vc);
             return;
@@ -465,12 +496,52 @@ topo_hyperx::routeValiant(int port, int vc, topo_hyperx_event* ev) {
         ev->setVC(vc);
         return;
     }
-    int p = choose_multipath(next_port.second,dim_width[next_port.first]);
+    int p = first_port != -1 ? first_port : choose_multipath(next_port.second,dim_width[next_port.first]);
     ev->setNextPort(p);
     ev->setVC(next_vc);
     return;
 }
 
+void
+topo_hyperx::routeUGAL(int port, int vc, topo_hyperx_event* ev) {
+    // The choice between the minimal path and the valiant path
+    // through the intermediate router picked in process_input() is
+    // made once, at the source router.  Each path is weighted by the
+    // occupancy of its first output queue times its hop count.  After
+    // that the packet is routed like valiant, with minimally routed
+    // packets marked as already past their intermediate router so
+    // they stay on the first VC.  The port weighed for the chosen path
+    // is the one the packet takes.
+    int first_port = -1;
+    if ( port >= local_port_start ) {
+        std::pair<int,int> min_route = routeDORBase(ev->dest_loc);
+        if ( min_route.first == -1 ) {
+            ev->val_route_dest = true;
+        }
+        else {
+            int min_port = choose_multipath(min_route.second,dim_width[min_route.first]);
+            int min_weight = output_queue_lengths[min_port * num_vcs + vc] * hops(id_loc, ev->dest_loc);
+
+            std::pair<int,int> val_route = routeDORBase(ev->val_loc);
+            if ( val_route.first == -1 ) {
+                // This router is the intermediate, so both paths are
+                // the minimal one
+                ev->val_route_dest = true;
+                first_port = min_port;
+            }
+            else {
+                int val_port = choose_multipath(val_route.second,dim_width[val_route.first]);
+                int val_weight = output_queue_lengths[val_port * num_vcs + vc] *
+                    (hops(id_loc, ev->val_loc) + hops(ev->val_loc, ev->dest_loc)) + ugal_bias;
+
+                ev->val_route_dest = min_weight <= val_weight;
+                first_port = ev->val_route_dest ? min_port : val_port;
+            }
+        }
+    }
+    routeValiant(port,vc,ev,first_port);
+}
+
 void
 topo_hyperx::routeDOAL(int port, int vc, topo_hyperx_event* ev) {
     // We still have to go in dimension order, but we can adaptively
@@ -491,15 +562,14 @@ topo_hyperx::routeDOAL(int port, int vc, topo_hyperx_event* ev) {
             // adaptively routed, if so, then we have to go direct for
             // this dimension
             if ( (vc & 0x1) == 1 ) {
-                // Get offset in the dimension
-                int offset = ev->dest_loc[dim] - ((ev->dest_loc[dim] > id_loc[dim]) ? 1 : 0);
-                offset *= dim_width[dim];
+                // Get first minimal port in the dimension
+                int offset = minimal_port(dim, ev->dest_loc[dim]);
                 
                 // Choose the least loaded route to the next router
                 int min = 0x7FFFFFFF;
                 int min_port;
                 
-                for ( int p = port_start[dim] + offset; p < port_start[dim] + offset + dim_width[dim]; ++p ) {
+                for ( int p = offset; p < offset + dim_width[dim]; ++p ) {
                     int weight = output_queue_lengths[p * num_vcs + vc];
                     if ( weight < min ) {
                         min = weight;
@@ -521,17 +591,10 @@ topo_hyperx::routeDOAL(int port, int vc, topo_hyperx_event* ev) {
                 int min_port = 0;
                 int min_weight = 0x7fffffff;
                 int min_vc = vc;
+                // Starting port for the minimal link(s)
+                int offset = minimal_port(dim, ev->dest_loc[dim]);
                 for ( int curr_port = port_start[dim]; curr_port < port_start[dim] + ((dim_size[dim] - 1) * dim_width[dim]); ++curr_port  ) {
                     // See if this is a minimal route
-                    
-                    // Compute the base offset in this dimension for
-                    // the minimal route (this is essentially what the
-                    // offset would be if the width in this dimension
-                    // is 1).
-                    int offset = ev->dest_loc[dim] - ((ev->dest_loc[dim] > id_loc[dim]) ? 1 : 0);
-                    
-                    // Now get the actual starting port for the minimal link(s)
-                    offset = port_start[dim] + ( offset * dim_width[dim]);
                     if ( curr_port >= offset && curr_port < offset + dim_width[dim] ) {
                         // This is a minimal route.  We would use VC 0
                         // in the VN, which is the VC the packet came
@@ -589,8 +652,7 @@ topo_hyperx::routeMINA(int port, int vc, topo_hyperx_event* ev) {
         if ( ev->dest_loc[dim] == id_loc[dim] ) continue;
 
         // Find the minimum weight, minimally-routed port
-        int offset = ev->dest_loc[dim] - ((ev->dest_loc[dim] > id_loc[dim]) ? 1 : 0);
-        offset = port_start[dim] + (offset * dim_width[dim]);
+        int offset = minimal_port(dim, ev->dest_loc[dim]);
 
         for ( int i = offset; i < offset + dim_width[dim]; ++i ) {
             int weight = output_queue_lengths[(i * num_vcs) + start_vc + 1];
@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/topology/routingTable.h"
 
 namespace SST {
 namespace Merlin {
@@ -159,11 +160,14 @@ public:
         {"hyperx:width",        "Number of links between routers in each dimension, specified in same manner as for shape.  For example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"hyperx:local_ports",  "Number of endpoints attached to each router."},
         {"hyperx:algorithm",    "Routing algorithm to use.", "DOR"},
+        {"hyperx:ugal_bias",    "Flits added to the cost of the non-minimal path when using UGAL routing.", "0"},
 
         {"shape",        "Shape of the mesh specified as the number of routers in each dimension, where each dimension is separated by a colon.  For example, 4x4x2x2.  Any number of dimensions is supported."},
         {"width",        "Number of links between routers in each dimension, specified in same manner as for shape.  For example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"local_ports",  "Number of endpoints attached to each router."},
-        {"algorithm",    "Routing algorithm to use.", "DOR"}
+        {"algorithm",    "Routing algorithm to use. [DOR | DOR-ND | MIN-A | valiant | DOAL | VDAL | UGAL]", "DOR"},
+        {"ugal_bias",    "Flits added to the cost of the non-minimal path when using UGAL routing.", "0"},
+        {"table_routing", "Look up the first minimal port in each dimension from a table computed at construction instead of computing it for every packet.  VDAL's scan of the non-minimal ports and valiant's choice of intermediate router still use arithmetic on every packet.", "false"}
     )
 
     enum RouteAlgo {
@@ -172,7 +176,8 @@ public:
         MINA,
         VALIANT,
         DOAL,
-        VDAL
+        VDAL,
+        UGAL
     };
 
 private:
@@ -195,9 +200,16 @@ private:
     int vcs_per_vn;
 
     RouteAlgo algorithm;
+    int ugal_bias;
     RNG::SSTRandom* rng;
     RNGFunc* rng_func;
 
+    // Table routing: first minimal port for each destination
+    // coordinate, indexed by table_offset[dim] + dest_loc[dim]
+    bool table_routing;
+    int* table_offset;
+    RoutingTable<int> port_table;
+
 public:
     topo_hyperx(ComponentId_t cid, Params& params, int num_ports, int rtr_id);
     ~topo_hyperx();
@@ -225,13 +237,31 @@ private:
     int get_dest_router(int dest_id) const;
     int get_dest_local_port(int dest_id) const;
 
+    inline int minimal_port(int dim, int dest_coord) const {
+        if ( table_routing ) return port_table[table_offset[dim] + dest_coord];
+        int offset = dest_coord - ((dest_coord > id_loc[dim]) ? 1 : 0);
+        return port_start[dim] + (offset * dim_width[dim]);
+    }
+
+    inline int hops(const int* from, const int* to) const {
+        int count = 0;
+        for ( int dim = 0; dim < dimensions; ++dim ) {
+            if ( from[dim] != to[dim] ) count++;
+        }
+        return count;
+    }
+
     std::pair<int,int> routeDORBase(int* dest_loc);
     void routeDOR(int port, int vc, topo_hyperx_event* ev);
     void routeDORND(int port, int vc, topo_hyperx_event* ev);
     void routeMINA(int port, int vc, topo_hyperx_event* ev);
     void routeDOAL(int port, int vc, topo_hyperx_event* ev);
     void routeVDAL(int port, int vc, topo_hyperx_event* ev);
-    void routeValiant(int port, int vc, topo_hyperx_event* ev);
+    // first_port, if not -1, is the output port already chosen for
+    // the next hop (used by UGAL so the port it weighed is the one
+    // taken)
+    void routeValiant(int port, int vc, topo_hyperx_event* ev, int first_port = -1);
+    void routeUGAL(int port, int vc, topo_hyperx_event* ev);
 };
 
 }
@@ -0,0 +1,304 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "linkTables.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct MerlinLinkTable {
+    // All link names, NUL separated, indexed through name_offsets
+    std::vector<char> names;
+    std::vector<size_t> name_offsets;
+
+    // Connections sorted by router, indexed through router_offsets
+    std::vector<size_t> router_offsets;
+    std::vector<int> ports;
+    std::vector<int> links;
+
+    int addLink(const char* name) {
+        name_offsets.push_back(names.size());
+        while ( *name ) names.push_back(*name++);
+        names.push_back('\0');
+        return name_offsets.size() - 1;
+    }
+};
+
+namespace {
+
+std::string last_error;
+
+struct Connection {
+    int router;
+    int port;
+    int link;
+};
+
+MerlinLinkTable*
+fail(MerlinLinkTable* table, const std::string& msg)
+{
+    delete table;
+    last_error = msg;
+    return NULL;
+}
+
+// Sorts the connections by router (counting sort, so construction
+// stays linear) and checks that every link has exactly two ends.
+MerlinLinkTable*
+finalize(MerlinLinkTable* table, int num_routers, const std::vector<Connection>& conns)
+{
+    std::vector<uint8_t> ends(table->name_offsets.size(), 0);
+    table->router_offsets.assign(num_routers + 1, 0);
+    for ( const Connection& c : conns ) {
+        table->router_offsets[c.router + 1]++;
+        ends[c.link]++;
+    }
+    for ( size_t i = 0; i < ends.size(); i++ ) {
+        if ( ends[i] != 2 ) {
+            return fail(table, std::string("link ") + &table->names[table->name_offsets[i]] +
+                        " does not have exactly two ends");
+        }
+    }
+    for ( int i = 0; i < num_routers; i++ ) {
+        table->router_offsets[i + 1] += table->router_offsets[i];
+    }
+
+    std::vector<size_t> next(table->router_offsets.begin(), table->router_offsets.end() - 1);
+    table->ports.resize(conns.size());
+    table->links.resize(conns.size());
+    for ( const Connection& c : conns ) {
+        size_t index = next[c.router]++;
+        table->ports[index] = c.port;
+        table->links[index] = c.link;
+    }
+    last_error.clear();
+    return table;
+}
+
+}
+
+extern "C" {
+
+MerlinLinkTable*
+merlinDragonflyLinkTable(const char* prefix, int hosts_per_router, int routers_per_group,
+                         int intergroup_per_router, int num_groups,
+                         const int* global_link_map, int relative)
+{
+    MerlinLinkTable* table = new MerlinLinkTable();
+    if ( hosts_per_router < 0 || routers_per_group < 1 || intergroup_per_router < 0 || num_groups < 1 ) {
+        return fail(table, "invalid dragonfly shape");
+    }
+
+    const int rpg = routers_per_group;
+    const int igpr = intergroup_per_router;
+    const int ng = num_groups - 1; // don't count my group
+    const int num_routers = rpg * num_groups;
+    const int intra_links = rpg * (rpg - 1) / 2;
+
+    std::vector<Connection> conns;
+    conns.reserve((size_t)num_routers * (rpg - 1 + igpr));
+
+    char name[256];
+
+    // Intra group links are all used, so they are numbered directly
+    // from (group, src, dst)
+    for ( int g = 0; g < num_groups; g++ ) {
+        for ( int src = 0; src < rpg; src++ ) {
+            for ( int dst = src + 1; dst < rpg; dst++ ) {
+                snprintf(name, sizeof(name), "%slink:g%dr%dr%d", prefix, g, src, dst);
+                table->addLink(name);
+            }
+        }
+    }
+
+    // Global links are numbered in the order they are first seen
+    std::unordered_map<uint64_t,int> global_links;
+    global_links.reserve((size_t)num_routers * igpr / 2 + 1);
+
+    for ( int g = 0; g < num_groups; g++ ) {
+        for ( int r = 0; r < rpg; r++ ) {
+            int router = g * rpg + r;
+            int port = hosts_per_router;
+
+            for ( int p = 0; p < rpg; p++ ) {
+                if ( p == r ) continue;
+                int src = p < r ? p : r;
+                int dst = p < r ? r : p;
+                int index = g * intra_links + src * rpg - src * (src + 1) / 2 + (dst - src - 1);
+                conns.push_back({router, port, index});
+                port++;
+            }
+
+            for ( int p = 0; p < igpr; p++, port++ ) {
+                int raw_dest = global_link_map[r * igpr + p];
+                if ( raw_dest == -1 ) continue;
+                if ( raw_dest < 0 || ng == 0 ) {
+                    return fail(table, "invalid entry in global_link_map: " + std::to_string(raw_dest));
+                }
+
+                int link_num = raw_dest / ng;
+                int dest_grp = raw_dest - link_num * ng;
+                if ( relative ) {
+                    dest_grp = (dest_grp + g + 1) % (ng + 1);
+                }
+                else if ( dest_grp >= g ) {
+                    dest_grp++;
+                }
+
+                int src = dest_grp < g ? dest_grp : g;
+                int dst = dest_grp < g ? g : dest_grp;
+                uint64_t key = ((uint64_t)(src * num_groups + dst) << 32) | (uint32_t)link_num;
+                auto it = global_links.find(key);
+                int index;
+                if ( it == global_links.end() ) {
+                    snprintf(name, sizeof(name), "%sglobal_link:g%dg%dr%d", prefix, src, dst, link_num);
+                    index = table->addLink(name);
+                    global_links[key] = index;
+                }
+                else {
+                    index = it->second;
+                }
+                conns.push_back({router, port, index});
+            }
+        }
+    }
+
+    return finalize(table, num_routers, conns);
+}
+
+
+MerlinLinkTable*
+merlinFattreeLinkTable(const char* prefix, int num_levels, const int* downs, const int* ups)
+{
+    MerlinLinkTable* table = new MerlinLinkTable();
+    if ( num_levels < 2 ) {
+        return fail(table, "fat tree link table needs at least two levels");
+    }
+
+    // Same shape computations as the python topology and merlin.fattree
+    int64_t total_hosts = 1;
+    for ( int i = 0; i < num_levels; i++ ) {
+        if ( downs[i] < 1 || (i < num_levels - 1 && ups[i] < 1) ) {
+            return fail(table, "invalid fat tree shape");
+        }
+        total_hosts *= downs[i];
+    }
+
+    std::vector<int64_t> routers_per_level(num_levels);
+    std::vector<int64_t> groups_per_level(num_levels, 1);
+    std::vector<int64_t> start_ids(num_levels, 0);
+
+    routers_per_level[0] = total_hosts / downs[0];
+    groups_per_level[0] = routers_per_level[0];
+    for ( int i = 1; i < num_levels; i++ ) {
+        routers_per_level[i] = routers_per_level[i-1] * ups[i-1] / downs[i];
+        start_ids[i] = start_ids[i-1] + routers_per_level[i-1];
+    }
+    for ( int i = 1; i < num_levels - 1; i++ ) {
+        groups_per_level[i] = groups_per_level[i-1] / downs[i];
+    }
+
+    int64_t num_routers = start_ids[num_levels-1] + routers_per_level[num_levels-1];
+    if ( num_routers > INT32_MAX ) {
+        return fail(table, "fat tree has too many routers");
+    }
+
+    std::vector<Connection> conns;
+    conns.reserve(2 * (size_t)(num_routers - routers_per_level[0]) * downs[1]);
+
+    char name[256];
+
+    // Every link is the down link of a router in level > 0.  Down
+    // port j of the routers in group G goes to group G * downs + j of
+    // the level below, where router i's link lands on router
+    // i % routers_in_group, in the up port after the previous ones.
+    for ( int level = num_levels - 1; level > 0; level-- ) {
+        int64_t rig = routers_per_level[level] / groups_per_level[level];
+        int64_t child_rig = routers_per_level[level-1] / groups_per_level[level-1];
+        if ( rig == 0 || child_rig == 0 || (rig + child_rig - 1) / child_rig > ups[level-1] ) {
+            return fail(table, "fat tree shape is not consistent at level " + std::to_string(level));
+        }
+
+        for ( int64_t group = 0; group < groups_per_level[level]; group++ ) {
+            for ( int64_t i = 0; i < rig; i++ ) {
+                int router = start_ids[level] + group * rig + i;
+                for ( int j = 0; j < downs[level]; j++ ) {
+                    snprintf(name, sizeof(name), "%slink_l%d_g%lld_r%lld_p%d", prefix, level, (long long)group, (long long)i, j);
+                    int link = table->addLink(name);
+                    conns.push_back({router, j, link});
+
+                    int64_t child_group = group * downs[level] + j;
+                    int child = start_ids[level-1] + child_group * child_rig + i % child_rig;
+                    conns.push_back({child, (int)(downs[level-1] + i / child_rig), link});
+                }
+            }
+        }
+    }
+
+    return finalize(table, num_routers, conns);
+}
+
+
+const char*
+merlinLinkTableError(void)
+{
+    return last_error.empty() ? NULL : last_error.c_str();
+}
+
+int
+merlinLinkTableNumLinks(const MerlinLinkTable* table)
+{
+    return table->name_offsets.size();
+}
+
+const char*
+merlinLinkTableLinkName(const MerlinLinkTable* table, int link)
+{
+    return &table->names[table->name_offsets[link]];
+}
+
+int
+merlinLinkTableNumRouters(const MerlinLinkTable* table)
+{
+    return table->router_offsets.size() - 1;
+}
+
+int
+merlinLinkTableNumConnections(const MerlinLinkTable* table, int router)
+{
+    return table->router_offsets[router + 1] - table->router_offsets[router];
+}
+
+void
+merlinLinkTableConnection(const MerlinLinkTable* table, int router, int index, int* port, int* link)
+{
+    size_t offset = table->router_offsets[router] + index;
+    *port = table->ports[offset];
+    *link = table->links[offset];
+}
+
+void
+merlinFreeLinkTable(MerlinLinkTable* table)
+{
+    delete table;
+}
+
+}
@@ -0,0 +1,74 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TOPOLOGY_LINKTABLES_H
+#define COMPONENTS_MERLIN_TOPOLOGY_LINKTABLES_H
+
+/*
+  Precomputed router-to-router link tables used by the python
+  topology builders (see pymodule.c).  A table holds the name of every
+  link in the network and, for each router, the list of (port, link)
+  pairs that connect it to other routers.  Host ports are not
+  included, the python code creates those as it builds the endpoints.
+
+  Link names match the ones the pure python builders generate, so
+  configurations that look up links by name work with either path.
+  All names start with prefix (the network name set on the python
+  topology), so several networks can be built in one configuration.
+
+  The interface is plain C so it can be called from pymodule.c.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct MerlinLinkTable MerlinLinkTable;
+
+/*
+  Dragonfly link table.  global_link_map has
+  intergroup_per_router * routers_per_group entries (-1 for an unused
+  port).  relative is non-zero for relative global routes.  Router ids
+  are group * routers_per_group + router.
+*/
+MerlinLinkTable* merlinDragonflyLinkTable(const char* prefix, int hosts_per_router, int routers_per_group,
+                                          int intergroup_per_router, int num_groups,
+                                          const int* global_link_map, int relative);
+
+/*
+  Fat tree link table.  downs has num_levels entries and ups has
+  num_levels - 1.  Router ids are assigned level by level, starting
+  with the edge routers, as in merlin.fattree.
+*/
+MerlinLinkTable* merlinFattreeLinkTable(const char* prefix, int num_levels, const int* downs, const int* ups);
+
+/* Returns NULL if the last table construction succeeded */
+const char* merlinLinkTableError(void);
+
+int merlinLinkTableNumLinks(const MerlinLinkTable* table);
+const char* merlinLinkTableLinkName(const MerlinLinkTable* table, int link);
+int merlinLinkTableNumRouters(const MerlinLinkTable* table);
+int merlinLinkTableNumConnections(const MerlinLinkTable* table, int router);
+void merlinLinkTableConnection(const MerlinLinkTable* table, int router, int index, int* port, int* link);
+
+void merlinFreeLinkTable(MerlinLinkTable* table);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // COMPONENTS_MERLIN_TOPOLOGY_LINKTABLES_H
@@ -22,10 +22,16 @@ class topoDragonFly(Topology):
 
     def __init__(self):
         Topology.__init__(self)
-        self._declareClassVariables(["link_latency","host_link_latency","global_link_map"])
+        self._declareClassVariables(["link_latency","host_link_latency","global_link_latency","global_link_map","keep_groups_together"])
         self._defineRequiredParams(["hosts_per_router","routers_per_group","intergroup_links","num_groups"])
-        self._defineOptionalParams(["algorithm","adaptive_threshold","global_routes"])
+        self._defineOptionalParams(["algorithm","adaptive_threshold","global_routes","table_routing"])
         self.global_routes = "absolute"
+        # When True, host and intra-group links are marked no-cut so
+        # the partitioner keeps each group (routers and endpoints) on
+        # one rank and only global links cross ranks.  Setting
+        # global_link_latency higher than link_latency then raises the
+        # lookahead between ranks.
+        self.keep_groups_together = False
 
     def getName(self):
         return "Dragonfly"
@@ -57,11 +63,74 @@ class topoDragonFly(Topology):
     
     def findRouterByLocation(self,group,rtr):
         return sst.findComponentByName(self.getRouterNameForLocation(group,rtr))
+
+    def getGroupForRouter(self,rtr_id):
+        return rtr_id // self.routers_per_group
+
+    def getGroupForNode(self,nid):
+        return nid // (self.routers_per_group * self.hosts_per_router)
     
         
+    # Pure python version of sst.merlin.native.dragonfly_links
+    def _linkTable(self, igpr):
+        rpg = self.routers_per_group
+        ng = self.num_groups - 1 # don't count my group
+
+        link_names = []
+        link_index = dict()
+        router_links = []
+
+        def getLink(name):
+            if name not in link_index:
+                link_index[name] = len(link_names)
+                link_names.append(name)
+            return link_index[name]
+
+        for g in range(self.num_groups):
+            for r in range(rpg):
+                conns = []
+                port = self.hosts_per_router
+                for p in range(rpg):
+                    if p != r:
+                        src = min(p,r)
+                        dst = max(p,r)
+                        conns.append((port, getLink("%slink:g%dr%dr%d"%(self._prefix, g, src, dst))))
+                        port = port + 1
+
+                # p is port number relative to start of global ports
+                for p in range(igpr):
+                    # Look into global link map to get the dest group
+                    # and link number to that group
+                    raw_dest = self.global_link_map[r * igpr + p];
+                    if raw_dest != -1:
+                        # Turn raw_dest into dest_grp and link_num
+                        link_num = raw_dest // ng;
+                        dest_grp = raw_dest - link_num * ng
+
+                        if ( self.global_routes == "absolute" ):
+                            # Compute dest group ignoring my own group id, for a
+                            # dest_grp >= g, we need to add 1 to get the right group
+                            if dest_grp >= g:
+                                dest_grp = dest_grp + 1
+                        elif ( self.global_routes == "relative"):
+                            # For relative, add current group to dest_grp + 1 and
+                            # do modulo of num_groups to get actual group
+                            dest_grp = (dest_grp + g + 1) % (ng+1)
+
+                        src = min(dest_grp, g)
+                        dest = max(dest_grp, g)
+                        conns.append((port, getLink("%sglobal_link:g%dg%dr%d"%(self._prefix,src,dest,link_num))))
+                    port = port + 1
+
+                router_links.append(conns)
+
+        return (link_names, router_links)
+
     def build(self, endpoint):
         if self.host_link_latency is None:
             self.host_link_latency = self.link_latency
+        if self.global_link_latency is None:
+            self.global_link_latency = self.link_latency
 
         num_peers = self.hosts_per_router * self.routers_per_group * self.num_groups
 
@@ -74,17 +143,7 @@ class topoDragonFly(Topology):
         num_ports = self.routers_per_group - 1 + self.hosts_per_router + intergroup_per_router
 
 
-        links = dict()
-
-        #####################
-        def getLink(name):
-            if name not in links:
-                links[name] = sst.Link(name)
-            return links[name]
-        #####################
-
         rpg = self.routers_per_group
-        ng = self.num_groups - 1 # don't count my group
         igpr = intergroup_per_router
 
         if self.global_link_map is None:
@@ -109,42 +168,21 @@ class topoDragonFly(Topology):
 
         # End set global link map with default
 
-
-        # g is group number
-        # r is router number with group
-        # p is port number relative to start of global ports
-
-        def getGlobalLink(g, r, p):
-            # Look into global link map to get the dest group and link
-            # number to that group
-            raw_dest = self.global_link_map[r * igpr + p];
-            if raw_dest == -1:
-                return None
-
-            # Turn raw_dest into dest_grp and link_num
-            link_num = raw_dest // ng;
-            dest_grp = raw_dest - link_num * ng
-
-            if ( self.global_routes == "absolute" ):
-                # Compute dest group ignoring my own group id, for a
-                # dest_grp >= g, we need to add 1 to get the right group
-                if dest_grp >= g:
-                    dest_grp = dest_grp + 1
-            elif ( self.global_routes == "relative"):
-                # For relative, add current group to dest_grp + 1 and
-                # do modulo of num_groups to get actual group
-                dest_grp = (dest_grp + g + 1) % (ng+1)
-            #else:
-                # should never happen
-
-            src = min(dest_grp, g)
-            dest = max(dest_grp, g)
-
-            #getLink("link:g%dg%dr%d"%(g, src, dst)), "port%d"%port, self.params["link_lat"])
-            return getLink("%sglobal_link:g%dg%dr%d"%(self._prefix,src,dest,link_num))
-
-        #########################
-
+        # Get the router to router links.  link_names has the name of
+        # every link and router_links[rtr_id] is a list of (port,
+        # link_index) pairs.  The table is generated in C++ when the
+        # native module is available.
+        try:
+            from sst.merlin.native import dragonfly_links
+            (link_names, router_links) = dragonfly_links(self._prefix, self.hosts_per_router, rpg, igpr, self.num_groups,
+                                                         self.global_link_map, self.global_routes == "relative")
+        except ImportError:
+            (link_names, router_links) = self._linkTable(igpr)
+
+        links = [sst.Link(name) for name in link_names]
+        port_names = ["port%d"%p for p in range(num_ports)]
+        # Ports at or above this are global ports
+        first_global = self.hosts_per_router + rpg - 1
 
         router_num = 0
         nic_num = 0
@@ -171,24 +209,21 @@ class topoDragonFly(Topology):
                     #(nic, port_name) = endpoint.build(nic_num, {"num_peers":num_peers})
                     (nic, port_name) = endpoint.build(nic_num, {})
                     if nic:
-                        link = sst.Link("link:g%dr%dh%d"%(g, r, p))
+                        link = sst.Link("%slink:g%dr%dh%d"%(self._prefix, g, r, p))
+                        if self.keep_groups_together:
+                            link.setNoCut()
                         #network_interface.build(nic,slot,0,link,self.host_link_latency)
-                        link.connect( (nic, port_name, self.host_link_latency), (rtr, "port%d"%port, self.host_link_latency) )
+                        link.connect( (nic, port_name, self.host_link_latency), (rtr, port_names[port], self.host_link_latency) )
                         #rtr.addLink(link,"port%d"%port,self.host_link_latency)
                     nic_num = nic_num + 1
                     port = port + 1
 
-                for p in range(self.routers_per_group):
-                    if p != r:
-                        src = min(p,r)
-                        dst = max(p,r)
-                        rtr.addLink(getLink("link:g%dr%dr%d"%(g, src, dst)), "port%d"%port, self.link_latency)
-                        port = port + 1
-
-                for p in range(igpr):
-                    link = getGlobalLink(g,r,p)
-                    if link is not None:
-                        rtr.addLink(link,"port%d"%port, self.link_latency)
-                    port = port +1
+                for (p, l) in router_links[router_num]:
+                    if p >= first_global:
+                        rtr.addLink(links[l], port_names[p], self.global_link_latency)
+                    else:
+                        if self.keep_groups_together:
+                            links[l].setNoCut()
+                        rtr.addLink(links[l], port_names[p], self.link_latency)
 
                 router_num = router_num + 1
@@ -27,7 +27,7 @@ class topoFatTree(Topology):
                                      "_groups_per_level","_ups","_downs","_routers_per_level","_groups_per_level","_start_ids",
                                      "_total_hosts"])
         self._defineRequiredParams(["shape"])
-        self._defineOptionalParams(["routing_alg","adaptive_threshold"])        
+        self._defineOptionalParams(["routing_alg","adaptive_threshold","table_routing","share_routing_table"])        
         self._setCallbackOnWrite("shape",self._shape_callback)
 
 
@@ -113,110 +113,77 @@ class topoFatTree(Topology):
     
     
     
+    # Pure python version of sst.merlin.native.fattree_links
+    def _linkTable(self):
+        num_levels = len(self._downs)
+        link_names = []
+        router_links = [ [] for index in range(self._start_ids[-1] + self._routers_per_level[-1]) ]
+
+        # Every link is a down link of a router above level 0.  Down
+        # port j of the routers in a group goes to group (group *
+        # downs + j) of the level below, where router i's link lands
+        # on router i % routers_in_group, in the up port after the
+        # previous ones.
+        for level in range(num_levels - 1, 0, -1):
+            rig = self._routers_per_level[level] // self._groups_per_level[level]
+            child_rig = self._routers_per_level[level-1] // self._groups_per_level[level-1]
+            for group in range(self._groups_per_level[level]):
+                for i in range(rig):
+                    rtr_id = self._start_ids[level] + group * rig + i
+                    for j in range(self._downs[level]):
+                        link = len(link_names)
+                        link_names.append("%slink_l%d_g%d_r%d_p%d"%(self._prefix,level,group,i,j))
+                        router_links[rtr_id].append((j, link))
+
+                        child_group = group * self._downs[level] + j
+                        child = self._start_ids[level-1] + child_group * child_rig + i % child_rig
+                        router_links[child].append((self._downs[level-1] + i // child_rig, link))
+
+        return (link_names, router_links)
+
     def build(self, endpoint):
 
         if not self.host_link_latency:
             self.host_link_latency = self.link_latency
         
-        #Recursive function to build levels
-        def fattree_rb(self, level, group, links):
-            id = self._start_ids[level] + group * (self._routers_per_level[level]//self._groups_per_level[level])
-
-
-            host_links = []
-            if level == 0:
-                # create all the nodes
-                for i in range(self._downs[0]):
-                    node_id = id * self._downs[0] + i
-                    #print("group: %d, id: %d, node_id: %d"%(group, id, node_id))
-                    (ep, port_name) = endpoint.build(node_id, {})
-                    if ep:
-                        hlink = sst.Link("hostlink_%d"%node_id)
-                        if self.bundleEndpoints:
-                           hlink.setNoCut()
-                        ep.addLink(hlink, port_name, self.host_link_latency)
-                        host_links.append(hlink)
-
-                # Create the edge router
-                rtr_id = id
-                rtr = self._instanceRouter(self._ups[0] + self._downs[0], rtr_id)
-                
-                topology = rtr.setSubComponent(self._router_template.getTopologySlotName(),"merlin.fattree")
-                self._applyStatisticsSettings(topology)
-                topology.addParams(self._params)
-                # Add links
-                for l in range(len(host_links)):
-                    rtr.addLink(host_links[l],"port%d"%l, self.link_latency)
-                for l in range(len(links)):
-                    rtr.addLink(links[l],"port%d"%(l+self._downs[0]), self.link_latency)
-                return
-
-            rtrs_in_group = self._routers_per_level[level] // self._groups_per_level[level]
-            # Create the down links for the routers
-            rtr_links = [ [] for index in range(rtrs_in_group) ]
-            for i in range(rtrs_in_group):
-                for j in range(downs[level]):
-                    rtr_links[i].append(sst.Link("link_l%d_g%d_r%d_p%d"%(level,group,i,j)));
-
-            # Now create group links to pass to lower level groups from router down links
-            group_links = [ [] for index in range(self._downs[level]) ]
-            for i in range(self._downs[level]):
-                for j in range(rtrs_in_group):
-                    group_links[i].append(rtr_links[j][i])
-
-            for i in range(downs[level]):
-                fattree_rb(self,level-1,group*self._downs[level]+i,group_links[i])
-
-            # Create the routers in this level.
-            # Start by adding up links to rtr_links
-            for i in range(len(links)):
-                rtr_links[i % rtrs_in_group].append(links[i])
-
-            for i in range(rtrs_in_group):
-                rtr_id = id + i
-                rtr = self._instanceRouter(self._ups[level] + self._downs[level], rtr_id)
-
-                topology = rtr.setSubComponent(self._router_template.getTopologySlotName(),"merlin.fattree")
-                self._applyStatisticsSettings(topology)
-                topology.addParams(self._params)
-                # Add links
-                for l in range(len(rtr_links[i])):
-                    rtr.addLink(rtr_links[i][l],"port%d"%l, self.link_latency)
-        #  End recursive function
-
-        level = len(self._ups)
         if self._ups: # True for all cases except for single level
-            #  Create the router links
-            rtrs_in_group = self._routers_per_level[level] // self._groups_per_level[level]
-
-            # Create the down links for the routers
-            rtr_links = [ [] for index in range(rtrs_in_group) ]
-            for i in range(rtrs_in_group):
-                for j in range(self._downs[level]):
-                    rtr_links[i].append(sst.Link("link_l%d_g0_r%d_p%d"%(level,i,j)));
-
-            # Now create group links to pass to lower level groups from router down links
-            group_links = [ [] for index in range(self._downs[level]) ]
-            for i in range(self._downs[level]):
-                for j in range(rtrs_in_group):
-                    group_links[i].append(rtr_links[j][i])
-
-
-            for i in range(self._downs[len(self._ups)]):
-                fattree_rb(self,level-1,i,group_links[i])
-
-            # Create the routers in this level
-            radix = self._downs[level]
-            for i in range(self._routers_per_level[level]):
-                rtr_id = self._start_ids[len(self._ups)] + i
-                rtr = self._instanceRouter(radix,rtr_id);
-
-                topology = rtr.setSubComponent(self._router_template.getTopologySlotName(),"merlin.fattree",0)
-                self._applyStatisticsSettings(topology)
-                topology.addParams(self._params)
-
-                for l in range(len(rtr_links[i])):
-                    rtr.addLink(rtr_links[i][l], "port%d"%l, self.link_latency)
+            # Get the router to router links.  link_names has the name
+            # of every link and router_links[rtr_id] is a list of
+            # (port, link_index) pairs.  The table is generated in C++
+            # when the native module is available.
+            try:
+                from sst.merlin.native import fattree_links
+                (link_names, router_links) = fattree_links(self._prefix, self._downs, self._ups)
+            except ImportError:
+                (link_names, router_links) = self._linkTable()
+
+            links = [sst.Link(name) for name in link_names]
+            # The top level has no up ports
+            radix = [self._downs[l] + self._ups[l] for l in range(len(self._ups))] + [self._downs[-1]]
+            port_names = ["port%d"%p for p in range(max(radix))]
+
+            for level in range(len(self._downs)):
+                for rtr_id in range(self._start_ids[level], self._start_ids[level] + self._routers_per_level[level]):
+                    rtr = self._instanceRouter(radix[level], rtr_id)
+
+                    topology = rtr.setSubComponent(self._router_template.getTopologySlotName(),"merlin.fattree",0)
+                    self._applyStatisticsSettings(topology)
+                    topology.addParams(self._params)
+
+                    if level == 0:
+                        # create all the nodes
+                        for i in range(self._downs[0]):
+                            node_id = rtr_id * self._downs[0] + i
+                            (ep, port_name) = endpoint.build(node_id, {})
+                            if ep:
+                                hlink = sst.Link("%shostlink_%d"%(self._prefix,node_id))
+                                if self.bundleEndpoints:
+                                    hlink.setNoCut()
+                                ep.addLink(hlink, port_name, self.host_link_latency)
+                                rtr.addLink(hlink, port_names[i], self.link_latency)
+
+                    for (p, l) in router_links[rtr_id]:
+                        rtr.addLink(links[l], port_names[p], self.link_latency)
 
         else: # Single level case
             # create all the nodes
@@ -26,7 +26,7 @@ class topoHyperX(Topology):
         Topology.__init__(self)
         self._declareClassVariables(["link_latency","host_link_latency","bundleEndpoints","_num_dims","_dim_size","_dim_width"])
         self._defineRequiredParams(["shape", "width", "local_ports"])
-        self._defineOptionalParams(["algorithm"])
+        self._defineOptionalParams(["algorithm","ugal_bias","table_routing"])
         self._setCallbackOnWrite("shape",self._shape_callback)
         self._setCallbackOnWrite("width",self._shape_callback)
 
@@ -127,9 +127,9 @@ class topoHyperX(Topology):
         def getLink(name1, name2, num):
             # Sort name1 and name2 so order doesn't matter
             if str(name1) < str(name2):
-                name = "link.%s:%s:%d"%(name1, name2, num)
+                name = "%slink.%s:%s:%d"%(self._prefix, name1, name2, num)
             else:
-                name = "link.%s:%s:%d"%(name2, name1, num)
+                name = "%slink.%s:%s:%d"%(self._prefix, name2, name1, num)
             if name not in links:
                 links[name] = sst.Link(name)
             #print("Getting link with name: %s"%name)
@@ -170,7 +170,7 @@ class topoHyperX(Topology):
                 nodeID = local_ports * i + n
                 (ep, port_name) = endpoint.build(nodeID, {})
                 if ep:
-                    nicLink = sst.Link("nic.%d:%d"%(i, n))
+                    nicLink = sst.Link("%snic.%d:%d"%(self._prefix, i, n))
                     if self.bundleEndpoints:
                        nicLink.setNoCut()
                     nicLink.connect( (ep, port_name, self.host_link_latency), (rtr, "port%d"%port, self.host_link_latency) )
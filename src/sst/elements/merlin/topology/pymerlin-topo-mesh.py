@@ -125,7 +125,7 @@ class _topoMeshBase(Topology):
         
         links = dict()
         def getLink(leftName, rightName, num):
-            name = "link.%s:%s:%d"%(leftName, rightName, num)
+            name = "%slink.%s:%s:%d"%(self._prefix, leftName, rightName, num)
             if name not in links:
                 links[name] = sst.Link(name)
             return links[name]
@@ -170,7 +170,7 @@ class _topoMeshBase(Topology):
                 nodeID = local_ports * i + n
                 (ep, port_name) = endpoint.build(nodeID, {})
                 if ep:
-                    nicLink = sst.Link("nic.%d:%d"%(i, n))
+                    nicLink = sst.Link("%snic.%d:%d"%(self._prefix, i, n))
                     if self.bundleEndpoints:
                        nicLink.setNoCut()
                     nicLink.connect( (ep, port_name, self.host_link_latency), (rtr, "port%d"%port, self.host_link_latency) )
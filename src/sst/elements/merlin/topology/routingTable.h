@@ -0,0 +1,85 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TOPOLOGY_ROUTINGTABLE_H
+#define COMPONENTS_MERLIN_TOPOLOGY_ROUTINGTABLE_H
+
+#include <sst/core/sharedRegion.h>
+#include <sst/core/simulation.h>
+
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+// Destination indexed lookup table used by the table_routing mode of
+// the topologies.  The table is filled in once when the topology is
+// constructed so that routing a packet is a single indexed load.
+//
+// If a shared key is given, the table lives in a SharedRegion.  Every
+// router that uses the same key must fill in identical contents; the
+// routers in a rank then use a single copy of the table.
+template <typename T>
+class RoutingTable {
+private:
+    std::vector<T> local;
+    const T* data;
+    SharedRegion* region;
+    size_t entries;
+
+public:
+    RoutingTable() :
+        data(NULL),
+        region(NULL),
+        entries(0)
+    {}
+
+    void init(size_t num_entries, const std::string& shared_key = "") {
+        entries = num_entries;
+        if ( shared_key.empty() ) {
+            local.resize(entries);
+            data = local.data();
+        }
+        else {
+            region = Simulation::getSharedRegionManager()->
+                getGlobalSharedRegion(shared_key, entries * sizeof(T), new SharedRegionMerger());
+            data = region->getPtr<const T*>();
+        }
+    }
+
+    void set(size_t index, const T& value) {
+        if ( region ) region->modifyArray(index, value);
+        else local[index] = value;
+    }
+
+    // Call once all entries have been set
+    void publish() {
+        if ( region ) region->publish();
+    }
+
+    bool isInitialized() const { return data != NULL; }
+    size_t size() const { return entries; }
+
+    inline const T& operator[](size_t index) const { return data[index]; }
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_TOPOLOGY_ROUTINGTABLE_H
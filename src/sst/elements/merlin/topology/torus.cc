@@ -81,6 +81,10 @@ topo_torus::topo_torus(ComponentId_t cid, Params& params, int num_ports, int rtr
 
     id_loc = new int[dimensions];
     idToLocation(router_id, id_loc);
+
+    table_routing = params.find<bool>("table_routing", false);
+    table_offset = NULL;
+    if ( table_routing ) build_port_table();
 }
 
 topo_torus::~topo_torus()
@@ -89,6 +93,7 @@ topo_torus::~topo_torus()
     delete [] dim_size;
     delete [] dim_width;
     delete [] port_start;
+    delete [] table_offset;
 }
 
 void
@@ -103,21 +108,9 @@ topo_torus::route(int port, int vc, internal_router_event* ev)
         for ( int dim = tt_ev->routing_dim ; dim < dimensions ; dim++ ) {
             if ( tt_ev->dest_loc[dim] != id_loc[dim] ) {
 
-                int dist_neg = id_loc[dim] - tt_ev->dest_loc[dim];
-                if ( dist_neg < 0 ) dist_neg += dim_size[dim];
-                int dist_pos = tt_ev->dest_loc[dim] - id_loc[dim];
-                if ( dist_pos < 0 ) dist_pos += dim_size[dim];
-
-                int go_pos = (dist_pos <= dist_neg);
-
-
-                output.verbose(CALL_INFO, 1, 1, " %d to %d:  Dist Neg: %d, Dist Pos: %d\n",
-                        id_loc[dim], tt_ev->dest_loc[dim], dist_neg, dist_pos);
-
-                int p = choose_multipath(
-                        port_start[dim][(go_pos) ? 0 : 1],
-                        dim_width[dim],
-                        (go_pos)? dist_pos : dist_neg);
+                int p;
+                if ( table_routing ) p = port_table[table_offset[dim] + tt_ev->dest_loc[dim]];
+                else p = compute_port(dim, tt_ev->dest_loc[dim]);
 
                 tt_ev->setNextPort(p);
 
@@ -139,6 +132,52 @@ topo_torus::route(int port, int vc, internal_router_event* ev)
 }
 
 
+int
+topo_torus::compute_port(int dim, int dest_coord)
+{
+    int dist_neg = id_loc[dim] - dest_coord;
+    if ( dist_neg < 0 ) dist_neg += dim_size[dim];
+    int dist_pos = dest_coord - id_loc[dim];
+    if ( dist_pos < 0 ) dist_pos += dim_size[dim];
+
+    int go_pos = (dist_pos <= dist_neg);
+
+
+    output.verbose(CALL_INFO, 1, 1, " %d to %d:  Dist Neg: %d, Dist Pos: %d\n",
+            id_loc[dim], dest_coord, dist_neg, dist_pos);
+
+    return choose_multipath(
+            port_start[dim][(go_pos) ? 0 : 1],
+            dim_width[dim],
+            (go_pos)? dist_pos : dist_neg);
+}
+
+
+void
+topo_torus::build_port_table()
+{
+    // Table only depends on this router's coordinates, so it is
+    // sized by the sum of the dimension sizes rather than by the
+    // number of routers.
+    table_offset = new int[dimensions];
+    int entries = 0;
+    for ( int dim = 0 ; dim < dimensions ; dim++ ) {
+        table_offset[dim] = entries;
+        entries += dim_size[dim];
+    }
+
+    port_table.init(entries);
+    for ( int dim = 0 ; dim < dimensions ; dim++ ) {
+        for ( int coord = 0 ; coord < dim_size[dim] ; coord++ ) {
+            // Entry for our own coordinate is never used
+            if ( coord == id_loc[dim] ) port_table.set(table_offset[dim] + coord, -1);
+            else port_table.set(table_offset[dim] + coord, compute_port(dim, coord));
+        }
+    }
+    port_table.publish();
+}
+
+
 
 internal_router_event*
 topo_torus::process_input(RtrEvent* ev)
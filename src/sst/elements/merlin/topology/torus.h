@@ -26,6 +26,7 @@
 #include <string.h>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/topology/routingTable.h"
 
 namespace SST {
 namespace Merlin {
@@ -88,6 +89,7 @@ public:
         {"shape",        "Shape of the torus specified as the number of routers in each dimension, where each dimension is separated by an x.  For example, 4x4x2x2.  Any number of dimensions is supported."},
         {"width",        "Number of links between routers in each dimension, specified in same manner as for shape.  For example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"local_ports",  "Number of endpoints attached to each router."},
+        {"table_routing", "Route using per-dimension port tables computed at construction instead of computing distances for every packet.", "false"},
     )
 
 
@@ -104,6 +106,12 @@ private:
     int num_local_ports;
     int local_port_start;
 
+    // Table routing: output port for each destination coordinate,
+    // indexed by table_offset[dim] + dest_loc[dim]
+    bool table_routing;
+    int* table_offset;
+    RoutingTable<int> port_table;
+
 public:
     topo_torus(ComponentId_t cid, Params& params, int num_ports, int rtr_id);
     ~topo_torus();
@@ -126,6 +134,8 @@ private:
     void parseDimString(const std::string &shape, int *output) const;
     int get_dest_router(int dest_id) const;
     int get_dest_local_port(int dest_id) const;
+    int compute_port(int dim, int dest_coord);
+    void build_port_table();
 
 };
 
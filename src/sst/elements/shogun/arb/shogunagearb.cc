@@ -0,0 +1,81 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "shogun_event.h"
+#include "shogunagearb.h"
+#include "shogun_stat_bundle.h"
+
+using namespace SST::Shogun;
+
+ShogunAgeArbitrator::ShogunAgeArbitrator()
+    : lastStart(0)
+{
+}
+
+ShogunAgeArbitrator::~ShogunAgeArbitrator() {}
+
+void ShogunAgeArbitrator::moveEvents(const int num_events,
+                                     const int port_count,
+                                     ShogunQueue<ShogunEvent*>** inputQueues,
+                                     int32_t output_slots,
+                                     ShogunEvent*** outputEvents,
+                                     uint64_t cycle ) {
+
+    output->verbose(CALL_INFO, 4, 0, "BEGIN: Arbitration --------------------------------------------------\n");
+
+    if (static_cast<int>(inputMoves.size()) != port_count) {
+        inputMoves.assign(port_count, 0);
+    }
+
+    for (int port = activeInputs->next(0); port != -1; port = activeInputs->next(port + 1)) {
+        inputMoves[port] = 0;
+        heads.emplace(inputQueues[port]->peek()->getArrivalCycle(), (port - lastStart + port_count) % port_count, port);
+    }
+
+    int32_t moved_count = 0;
+
+    // Oldest head first.  A head whose output is full blocks its input
+    // for the rest of the cycle, since slots are not freed until the
+    // outputs are emitted.
+    while (!heads.empty()) {
+        const int port = std::get<2>(heads.top());
+        heads.pop();
+
+        ShogunEvent* pendingEv = inputQueues[port]->peek();
+        const int32_t k = freeSlot(outputEvents, output_slots, pendingEv->getDestination());
+
+        if (k == -1) {
+            output->verbose(CALL_INFO, 4, 0, "  -> port %d blocked, output %d full\n", port, pendingEv->getDestination());
+            continue;
+        }
+
+        output->verbose(CALL_INFO, 4, 0, "  -> moving event from: %d to: %d (arrived %" PRIu64 ")\n",
+            port, pendingEv->getDestination(), pendingEv->getArrivalCycle());
+        moveHead(inputQueues, port, outputEvents, k);
+        inputMoves[port]++;
+        moved_count++;
+
+        if (!inputQueues[port]->empty() && (num_events == -1 || inputMoves[port] < num_events)) {
+            heads.emplace(inputQueues[port]->peek()->getArrivalCycle(), (port - lastStart + port_count) % port_count, port);
+        }
+    }
+
+    lastStart = (lastStart + 1) % port_count;
+
+    bundle->getPacketsMoved()->addData(moved_count);
+    output->verbose(CALL_INFO, 4, 0, "END: Arbitration ----------------------------------------------------\n");
+}
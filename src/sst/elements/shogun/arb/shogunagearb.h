@@ -0,0 +1,58 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SHOGUN_AGE_ARB_H
+#define _H_SHOGUN_AGE_ARB_H
+
+#include <functional>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+#include "shogun_event.h"
+#include "shogunarb.h"
+
+namespace SST {
+namespace Shogun {
+
+    // Oldest first arbitration.  Head events are moved in order of the
+    // cycle they arrived at the crossbar, so no event can be starved by
+    // a steady stream from other ports.  Ties are broken round robin.
+    class ShogunAgeArbitrator : public ShogunArbitrator {
+
+    public:
+        ShogunAgeArbitrator();
+        ~ShogunAgeArbitrator();
+
+        void moveEvents(const int num_events,
+                        const int port_count,
+                        ShogunQueue<ShogunEvent*>** inputQueues,
+                        int32_t output_slots,
+                        ShogunEvent*** outputEvents,
+                        uint64_t cycle ) override;
+
+    private:
+        int lastStart;
+
+        // (arrival cycle, round robin order, port)
+        typedef std::tuple<uint64_t, int, int> head_t;
+        std::priority_queue<head_t, std::vector<head_t>, std::greater<head_t>> heads;
+        std::vector<int32_t> inputMoves;
+    };
+
+}
+}
+
+#endif
@@ -17,6 +17,7 @@
 #define _H_SHOGUN_ARB_H
 
 #include "shogun_event.h"
+#include "shogun_port_mask.h"
 #include "shogun_q.h"
 
 using namespace SST::Shogun;
@@ -29,7 +30,11 @@ namespace Shogun {
     class ShogunArbitrator {
 
     public:
-        ShogunArbitrator() {}
+        ShogunArbitrator()
+            : activeInputs(nullptr)
+            , activeOutputs(nullptr)
+        {
+        }
         virtual ~ShogunArbitrator() {}
 
     virtual void moveEvents(const int num_events,
@@ -50,9 +55,45 @@ namespace Shogun {
             bundle = b;
         }
 
+        // Input ports with queued events and output ports with pending
+        // events.  Arbitrators only visit the input ports in inputs and
+        // keep both masks up to date as they move events.
+        void setActivePorts(ShogunPortMask* inputs, ShogunPortMask* outputs)
+        {
+            activeInputs = inputs;
+            activeOutputs = outputs;
+        }
+
     protected:
         SST::Output* output;
         ShogunStatisticsBundle* bundle;
+        ShogunPortMask* activeInputs;
+        ShogunPortMask* activeOutputs;
+
+        // Returns a free output slot for dest, or -1 if all are full
+        int32_t freeSlot(ShogunEvent*** outputEvents, int32_t output_slots, const int dest) const
+        {
+            for (int32_t k = 0; k < output_slots; ++k) {
+                if (outputEvents[dest][k] == nullptr) {
+                    return k;
+                }
+            }
+            return -1;
+        }
+
+        // Moves the head of the input queue for port into slot of its
+        // destination and updates the active port masks
+        void moveHead(ShogunQueue<ShogunEvent*>** inputQueues, const int port,
+                      ShogunEvent*** outputEvents, const int32_t slot)
+        {
+            ShogunEvent* ev = inputQueues[port]->pop();
+            outputEvents[ev->getDestination()][slot] = ev;
+            activeOutputs->set(ev->getDestination());
+
+            if (inputQueues[port]->empty()) {
+                activeInputs->clear(port);
+            }
+        }
     };
 
 }
@@ -0,0 +1,112 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <algorithm>
+
+#include "shogun_event.h"
+#include "shogunisliparb.h"
+#include "shogun_stat_bundle.h"
+
+using namespace SST::Shogun;
+
+ShogunISLIPArbitrator::ShogunISLIPArbitrator(const int iterations)
+    : iterations(iterations)
+{
+}
+
+ShogunISLIPArbitrator::~ShogunISLIPArbitrator() {}
+
+void ShogunISLIPArbitrator::moveEvents(const int num_events,
+                                       const int port_count,
+                                       ShogunQueue<ShogunEvent*>** inputQueues,
+                                       int32_t output_slots,
+                                       ShogunEvent*** outputEvents,
+                                       uint64_t cycle ) {
+
+    output->verbose(CALL_INFO, 4, 0, "BEGIN: Arbitration --------------------------------------------------\n");
+
+    if (static_cast<int>(grantPointer.size()) != port_count) {
+        grantPointer.assign(port_count, 0);
+        inputMoves.assign(port_count, 0);
+        requests.resize(port_count);
+    }
+
+    candidates.clear();
+    for (int port = activeInputs->next(0); port != -1; port = activeInputs->next(port + 1)) {
+        candidates.push_back(port);
+        inputMoves[port] = 0;
+    }
+
+    int32_t moved_count = 0;
+
+    for (int iter = 0; iter < iterations; ++iter) {
+        // Request: every input with events left to move this cycle asks for
+        // the destination of its head, unless that output is already full
+        requestedOutputs.clear();
+        for (int port : candidates) {
+            if (inputQueues[port]->empty() || (num_events != -1 && inputMoves[port] >= num_events)) {
+                continue;
+            }
+
+            const int dest = inputQueues[port]->peek()->getDestination();
+            if (freeSlot(outputEvents, output_slots, dest) == -1) {
+                continue;
+            }
+
+            if (requests[dest].empty()) {
+                requestedOutputs.push_back(dest);
+            }
+            requests[dest].push_back(port);
+        }
+
+        output->verbose(CALL_INFO, 4, 0, "-> iteration %d: %zu outputs requested\n", iter, requestedOutputs.size());
+
+        if (requestedOutputs.empty()) {
+            break;
+        }
+
+        // Grant and accept: each output hands its free slots to requesters
+        // starting at its grant pointer
+        for (int dest : requestedOutputs) {
+            std::vector<int>& req = requests[dest];
+            const size_t start = std::lower_bound(req.begin(), req.end(), grantPointer[dest]) - req.begin();
+
+            for (size_t n = 0; n < req.size(); ++n) {
+                const int port = req[(start + n) % req.size()];
+                const int32_t k = freeSlot(outputEvents, output_slots, dest);
+
+                if (k == -1) {
+                    break;
+                }
+
+                output->verbose(CALL_INFO, 4, 0, "  -> output %d grants input %d slot %" PRIi32 "\n", dest, port, k);
+                moveHead(inputQueues, port, outputEvents, k);
+                inputMoves[port]++;
+                moved_count++;
+
+                if (iter == 0) {
+                    grantPointer[dest] = (port + 1) % port_count;
+                }
+            }
+
+            req.clear();
+        }
+    }
+
+    bundle->getPacketsMoved()->addData(moved_count);
+    output->verbose(CALL_INFO, 4, 0, "END: Arbitration ----------------------------------------------------\n");
+}
@@ -0,0 +1,63 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SHOGUN_ISLIP_ARB_H
+#define _H_SHOGUN_ISLIP_ARB_H
+
+#include <vector>
+
+#include "shogun_event.h"
+#include "shogunarb.h"
+
+namespace SST {
+namespace Shogun {
+
+    // iSLIP style arbitration.  Each iteration, every input requests
+    // the destination of its head event, every requested output grants
+    // its free slots to requesters in round robin order starting at
+    // its grant pointer, and the grants are accepted.  Input queues are
+    // FIFO, so an input only ever requests one output and accepting is
+    // trivial.  Grant pointers move one past the last granted input,
+    // but only for grants made in the first iteration.  Later
+    // iterations pick up the next head of inputs that are allowed to
+    // move more than one event per cycle.
+    class ShogunISLIPArbitrator : public ShogunArbitrator {
+
+    public:
+        ShogunISLIPArbitrator(const int iterations);
+        ~ShogunISLIPArbitrator();
+
+        void moveEvents(const int num_events,
+                        const int port_count,
+                        ShogunQueue<ShogunEvent*>** inputQueues,
+                        int32_t output_slots,
+                        ShogunEvent*** outputEvents,
+                        uint64_t cycle ) override;
+
+    private:
+        const int iterations;
+
+        std::vector<int> grantPointer;
+        std::vector<int32_t> inputMoves;
+        // Requesting inputs for each output, in port order
+        std::vector<std::vector<int>> requests;
+        std::vector<int> requestedOutputs;
+        std::vector<int> candidates;
+    };
+
+}
+}
+
+#endif
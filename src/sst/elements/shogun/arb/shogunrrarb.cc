@@ -38,53 +38,46 @@ void ShogunRoundRobinArbitrator::moveEvents(const int num_events,
     output->verbose(CALL_INFO, 4, 0, "BEGIN: Arbitration --------------------------------------------------\n");
     output->verbose(CALL_INFO, 4, 0, "-> start: %" PRIi32 "\n", lastStart);
 
-    int32_t currentPort = lastStart;
     int32_t moved_count = 0;
 
-    // RR, so iterate through the ports one at a time and process num_events from the queue
-    for (int32_t i = 0; i < port_count; ++i) {
-        auto nextQ = inputQueues[currentPort];
-        output->verbose(CALL_INFO, 4, 0, "-> processing port: %" PRIi32 ", event-count: %" PRIi32 " out of %" PRIi32 "\n", currentPort,
-                        nextQ->count(), num_events);
-
-        //Want to send num_events for each port
-        int32_t j = 0;
-        while (j < num_events || num_events == -1 ) {
-            if (inputQueues[currentPort]->empty()) {
-                output->verbose(CALL_INFO, 4, 0, "  (%" PRIi32 ")-> input queue empty...\n", j);
-                break;
-            } else {
+    // RR, so iterate through the ports one at a time starting at lastStart and process
+    // num_events from the queue.  Ports with empty queues have nothing to do, so only the
+    // active ports are visited.
+    for (int32_t pass = 0; pass < 2; ++pass) {
+        const int32_t endPort = (pass == 0) ? port_count : lastStart;
+
+        for (int32_t currentPort = activeInputs->next(pass == 0 ? lastStart : 0);
+             currentPort != -1 && currentPort < endPort;
+             currentPort = activeInputs->next(currentPort + 1)) {
+
+            auto nextQ = inputQueues[currentPort];
+            output->verbose(CALL_INFO, 4, 0, "-> processing port: %" PRIi32 ", event-count: %" PRIi32 " out of %" PRIi32 "\n", currentPort,
+                            nextQ->count(), num_events);
+
+            //Want to send num_events for each port
+            int32_t j = 0;
+            while (j < num_events || num_events == -1 ) {
+                if (inputQueues[currentPort]->empty()) {
+                    output->verbose(CALL_INFO, 4, 0, "  (%" PRIi32 ")-> input queue empty...\n", j);
+                    break;
+                }
 
                 ShogunEvent* pendingEv = inputQueues[currentPort]->peek();
+                const int32_t k = freeSlot(outputEvents, output_slots, pendingEv->getDestination());
 
-                int32_t k = 0;
-                while (k < output_slots) {
-                    output->verbose(CALL_INFO, 4, 0, "  (%" PRIi32 ")-> attempting send from: %" PRIi32 " to: %" PRIi32 ", remote status: %s\n",
-                        j, pendingEv->getSource(), pendingEv->getDestination(),
-                        outputEvents[pendingEv->getDestination()][k] == nullptr ? "empty" : "full");
-
-                    if (outputEvents[pendingEv->getDestination()][k] == nullptr) {
-                        output->verbose(CALL_INFO, 4, 0, "  (%" PRIi32 ")-> moving event to remote queue\n", j);
-                        pendingEv = inputQueues[currentPort]->pop();
-                        outputEvents[pendingEv->getDestination()][k] = pendingEv;
-                        moved_count++;
-
-                        break;
-                    }
-
-                    ++k;
-                }
-
-                if ( k == output_slots ) {
+                if ( k == -1 ) {
                    output->verbose(CALL_INFO, 4, 0, "  (%" PRIi32 ")-> output queue full...\n", j);
                    break;
                 }
-            }
 
-            ++j;
+                output->verbose(CALL_INFO, 4, 0, "  (%" PRIi32 ")-> moving event from: %" PRIi32 " to: %" PRIi32 " slot: %" PRIi32 "\n",
+                    j, pendingEv->getSource(), pendingEv->getDestination(), k);
+                moveHead(inputQueues, currentPort, outputEvents, k);
+                moved_count++;
+
+                ++j;
+            }
         }
-        // Increment to next port in sequence
-        currentPort = nextPort(port_count, currentPort);
     }
 
     lastStart = nextPort(port_count, lastStart);
@@ -19,6 +19,8 @@
 #include <sst/core/output.h>
 #include <sst/core/unitAlgebra.h>
 
+#include "arb/shogunagearb.h"
+#include "arb/shogunisliparb.h"
 #include "arb/shogunrrarb.h"
 #include "shogun.h"
 #include "shogun_credit_event.h"
@@ -43,13 +45,30 @@ ShogunComponent::ShogunComponent(ComponentId_t id, Params& params)
     previousCycle = 0;
     pending_events = 0;
 
-    arb = new ShogunRoundRobinArbitrator();
-
     const int32_t verbosity = params.find<uint32_t>("verbose", 0);
 
     char prefix[256];
     sprintf(prefix, "[t=@t][%s]: ", getName().c_str());
     output = new SST::Output(prefix, verbosity, 0, Output::STDOUT);
+
+    const std::string arbitration = params.find<std::string>("arbitration", "roundrobin");
+
+    if (arbitration == "roundrobin") {
+        arb = new ShogunRoundRobinArbitrator();
+    } else if (arbitration == "islip") {
+        const int iterations = params.find<int>("islip_iterations", 4);
+
+        if (iterations <= 0) {
+            output->fatal(CALL_INFO, -1, "Error: islip_iterations must be at least 1.\n");
+        }
+
+        arb = new ShogunISLIPArbitrator(iterations);
+    } else if (arbitration == "age") {
+        arb = new ShogunAgeArbitrator();
+    } else {
+        output->fatal(CALL_INFO, -1, "Error: unknown arbitration scheme: %s\n", arbitration.c_str());
+    }
+
     arb->setOutput(output);
 
     port_count = params.find<int32_t>("port_count", -1);
@@ -107,6 +126,10 @@ ShogunComponent::ShogunComponent(ComponentId_t id, Params& params)
     eventCycles = registerStatistic<uint64_t>("cycles_events");
 
     arb->setStatisticsBundle(stats);
+
+    activeInputs.resize(port_count);
+    activeOutputs.resize(port_count);
+    arb->setActivePorts(&activeInputs, &activeOutputs);
     clearOutputs();
 }
 
@@ -214,8 +237,10 @@ void ShogunComponent::emitOutputs()
 {
     output->verbose(CALL_INFO, 4, 0, "BEGIN: emitOutputs -----------------------------------------------\n");
 
-    for (int32_t i = 0; i < port_count; ++i) {
+    // Only ports the arbitrator has moved events to have anything to send
+    for (int32_t i = activeOutputs.next(0); i != -1; i = activeOutputs.next(i + 1)) {
         output->verbose(CALL_INFO, 4, 0, "-> Processing port %" PRIi32 ":\n", i);
+        bool still_pending = false;
 
         for (uint32_t j = 0; j < output_message_slots; ++j) {
             if( nullptr != pendingOutputs[i][j] ) {
@@ -233,9 +258,14 @@ void ShogunComponent::emitOutputs()
                     pending_events--;
                 } else {
                     output->verbose(CALL_INFO, 4, 0, "    -> no free slots, event send disabled for this round (slots: %" PRIi32 ")\n", remote_output_slots[i]);
+                    still_pending = true;
                 }
             }
         }
+
+        if (!still_pending) {
+            activeOutputs.clear(i);
+        }
     }
 
     output->verbose(CALL_INFO, 4, 0, "END: emitOutputs -------------------------------------------------\n");
@@ -250,6 +280,8 @@ void ShogunComponent::clearOutputs()
 
         remote_output_slots[i] = inputQueues[i]->capacity();
     }
+
+    activeOutputs.resize(port_count);
 }
 
 void ShogunComponent::clearInputs()
@@ -257,10 +289,17 @@ void ShogunComponent::clearInputs()
     for (int32_t i = 0; i < port_count; ++i) {
         inputQueues[i]->clear();
     }
+
+    activeInputs.resize(port_count);
 }
 
 void ShogunComponent::printStatus()
 {
+    // Avoid walking every port each cycle when the report would not be printed
+    if (output->getVerboseLevel() < 4) {
+        return;
+    }
+
     output->verbose(CALL_INFO, 4, 0, "BEGIN: processing x-bar inputs -----------------------------------------------\n");
     output->verbose(CALL_INFO, 4, 0, "BEGIN X-BAR STATUS REPORT ====================================================\n");
 
@@ -295,7 +334,9 @@ void ShogunComponent::handleIncoming(SST::Event* event)
             src_port,
             incomingShogunEv->getPayload()->dest);
 
+        incomingShogunEv->setArrivalCycle(getCurrentSimTime(tc));
         inputQueues[src_port]->push(incomingShogunEv);
+        activeInputs.set(src_port);
         pending_events++;
         stats->getInputPacketCount(src_port)->addData(1);
 
@@ -23,6 +23,7 @@
 
 #include "arb/shogunarb.h"
 #include "shogun_event.h"
+#include "shogun_port_mask.h"
 #include "shogun_q.h"
 
 namespace SST {
@@ -45,7 +46,8 @@ public:
     SST_ELI_DOCUMENT_PARAMS(
         { "verbose",                "Level of output verbosity, higher is more output, 0 is no output", 0 },
         { "port_count",             "Number of ports on the Crossbar", "0" },
-        { "arbitration",            "Select the arbitration scheme", "roundrobin" },
+        { "arbitration",            "Select the arbitration scheme: roundrobin, islip (iterative request/grant/accept) or age (oldest event first)", "roundrobin" },
+        { "islip_iterations",       "Number of request/grant/accept iterations per cycle for islip arbitration", "4" },
         { "clock",                  "Clock Frequency for the crossbar", "1.0GHz" },
         { "queue_slots",            "Depth of input queue", "64" },
         { "in_msg_per_cycle",       "Number of messages injested per cycle; -1 is unlimited", "1" },
@@ -110,6 +112,11 @@ private:
     int32_t* remote_output_slots;
     ShogunArbitrator* arb;
 
+    // Ports with queued inputs and pending outputs, so each cycle only
+    // visits the ports that have work
+    ShogunPortMask activeInputs;
+    ShogunPortMask activeOutputs;
+
     SST::Output* output;
     Statistic<uint64_t>* zeroEventCycles;
     Statistic<uint64_t>* eventCycles;
@@ -32,6 +32,7 @@ namespace Shogun {
         {
             src = -1;
             req = nullptr;
+            arrival = 0;
         }
 
         ShogunEvent(int dst, int source)
@@ -39,6 +40,7 @@ namespace Shogun {
             , src(source)
         {
             req = nullptr;
+            arrival = 0;
         }
 
         ShogunEvent()
@@ -46,6 +48,7 @@ namespace Shogun {
             , src(-1)
         {
             req = nullptr;
+            arrival = 0;
         }
 
         ~ShogunEvent()
@@ -78,6 +81,18 @@ namespace Shogun {
             src = source;
         }
 
+        // Crossbar cycle the event entered its input queue, used by
+        // age based arbitration
+        uint64_t getArrivalCycle() const
+        {
+            return arrival;
+        }
+
+        void setArrivalCycle(uint64_t cycle)
+        {
+            arrival = cycle;
+        }
+
         SimpleNetwork::Request* getPayload()
         {
             return req;
@@ -99,6 +114,7 @@ namespace Shogun {
             ser& dest;
             ser& src;
             ser& req;
+            ser& arrival;
         }
 
         ImplementSerializable(SST::Shogun::ShogunEvent);
@@ -107,6 +123,7 @@ namespace Shogun {
         int dest;
         int src;
         SimpleNetwork::Request* req;
+        uint64_t arrival;
     };
 
 }
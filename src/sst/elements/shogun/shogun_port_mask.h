@@ -0,0 +1,115 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SHOGUN_PORT_MASK
+#define _H_SHOGUN_PORT_MASK
+
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace Shogun {
+
+    // Bit vector of ports used to track which ports have work so the
+    // crossbar only visits those ports each cycle.  Iteration is in
+    // port order, which keeps arbitration results identical to a full
+    // scan.
+    class ShogunPortMask {
+
+    public:
+        ShogunPortMask()
+            : port_count(0)
+            , set_count(0)
+        {
+        }
+
+        void resize(const int ports)
+        {
+            port_count = ports;
+            words.assign((ports + 63) / 64, 0);
+            set_count = 0;
+        }
+
+        void set(const int port)
+        {
+            uint64_t bit = UINT64_C(1) << (port % 64);
+            if (!(words[port / 64] & bit)) {
+                words[port / 64] |= bit;
+                set_count++;
+            }
+        }
+
+        void clear(const int port)
+        {
+            uint64_t bit = UINT64_C(1) << (port % 64);
+            if (words[port / 64] & bit) {
+                words[port / 64] &= ~bit;
+                set_count--;
+            }
+        }
+
+        bool test(const int port) const
+        {
+            return (words[port / 64] >> (port % 64)) & 1;
+        }
+
+        bool empty() const
+        {
+            return set_count == 0;
+        }
+
+        int count() const
+        {
+            return set_count;
+        }
+
+        // Returns the first set port >= port, or -1 if there is none
+        int next(const int port) const
+        {
+            if (port >= port_count) {
+                return -1;
+            }
+
+            size_t w = port / 64;
+            uint64_t bits = words[w] & (~UINT64_C(0) << (port % 64));
+
+            while (bits == 0) {
+                if (++w == words.size()) {
+                    return -1;
+                }
+                bits = words[w];
+            }
+
+            return w * 64 + __builtin_ctzll(bits);
+        }
+
+        // Returns the first set port at or after port, wrapping around
+        // to port 0, or -1 if no port is set
+        int nextWrapped(const int port) const
+        {
+            int found = next(port);
+            return found == -1 ? next(0) : found;
+        }
+
+    private:
+        int port_count;
+        int set_count;
+        std::vector<uint64_t> words;
+    };
+
+}
+}
+
+#endif
@@ -0,0 +1,60 @@
+#!/usr/bin/env python
+
+# Checks the output of xbar_scaling_test.py
+#   usage: checkXbarScaling.py <sst output> <ports> <messages per peer>
+# Every test_nic must receive a message from every endpoint, none may
+# report missing init messages, and the crossbar's packets_moved sum
+# must be the number of messages sent.  cycles_events must be non-zero.
+# Exits non-zero if a check fails.
+
+import re
+import sys
+
+receivedPattern = re.compile('NIC ([0-9]+) received all packets \(total of ([0-9]+)\)')
+missingPattern = re.compile('NIC ([0-9]+) didn\'t receive all')
+statPattern = re.compile('\A xbar\.(packets_moved|cycles_events) : Accumulator : Sum.u64 = ([0-9]+);')
+
+if len(sys.argv) != 4:
+    sys.stderr.write("usage: %s <sst output> <ports> <messages per peer>\n" % sys.argv[0])
+    sys.exit(2)
+
+ports = int(sys.argv[2])
+messages = int(sys.argv[3])
+
+received = dict()
+missing = set()
+stats = dict()
+with open(sys.argv[1]) as f:
+    for line in f:
+        receivedMatch = receivedPattern.search(line)
+        if receivedMatch:
+            received[int(receivedMatch.group(1))] = int(receivedMatch.group(2))
+        missingMatch = missingPattern.search(line)
+        if missingMatch:
+            missing.add(int(missingMatch.group(1)))
+        statMatch = statPattern.match(line)
+        if statMatch:
+            stats[statMatch.group(1)] = int(statMatch.group(2))
+
+errors = 0
+def check(cond, msg):
+    global errors
+    if not cond:
+        sys.stderr.write("FAIL: %s\n" % msg)
+        errors = errors + 1
+
+check(sorted(received.keys()) == list(range(ports)), "%d of %d NICs received all of their packets" % (len(received), ports))
+for nic in sorted(received.keys()):
+    check(received[nic] == ports * messages, "NIC %d received %d packets, expected %d" % (nic, received[nic], ports * messages))
+for nic in sorted(missing):
+    check(False, "NIC %d did not receive all of its init messages" % nic)
+
+for name in ("packets_moved", "cycles_events"):
+    check(name in stats, "statistic xbar.%s is missing from %s" % (name, sys.argv[1]))
+check(stats.get("packets_moved") == ports * ports * messages,
+      "the crossbar moved %s packets, %d were sent" % (stats.get("packets_moved"), ports * ports * messages))
+check(stats.get("cycles_events", 0) > 0, "the crossbar never had events to process")
+
+if errors:
+    sys.exit(1)
+sys.stderr.write("Checked %d packets through %d ports\n" % (ports * ports * messages, ports))
@@ -0,0 +1,48 @@
+import sst
+import sys
+
+# Large shogun crossbar driven by merlin test_nic endpoints.  Every
+# endpoint sends num_messages to every other endpoint.
+#
+# Usage: sst xbar_scaling_test.py --model-options="[ports] [arbitration]"
+#   ports:       number of crossbar ports (default 256)
+#   arbitration: roundrobin, islip or age (default roundrobin)
+#
+# Check the output with:
+#   sst xbar_scaling_test.py --model-options="256 islip" > out
+#   python checkXbarScaling.py out 256 4
+
+ports = 256
+arbitration = "roundrobin"
+if len(sys.argv) > 1: ports = int(sys.argv[1])
+if len(sys.argv) > 2: arbitration = sys.argv[2]
+
+xbar = sst.Component("xbar", "shogun.ShogunXBar")
+xbar.addParams({
+   "verbose" : "0",
+   "clock" : "1GHz",
+   "queue_slots" : "8",
+   "in_msg_per_cycle" : "1",
+   "out_msg_per_cycle" : "1",
+   "arbitration" : arbitration,
+   "islip_iterations" : "4",
+   "port_count" : ports,
+})
+
+for i in range(ports):
+   nic = sst.Component("nic_%d"%i, "merlin.test_nic")
+   nic.addParams({
+      "id" : i,
+      "num_peers" : ports,
+      "num_messages" : 4,
+      "message_size" : "64B",
+   })
+   nic_if = nic.setSubComponent("networkIF", "shogun.ShogunNIC")
+
+   link = sst.Link("nic_xbar_link_%d"%i)
+   link.connect((nic_if, "port", "100ps"), (xbar, "port%d"%i, "100ps"))
+   link.setNoCut()
+
+sst.setStatisticLoadLevel(4)
+sst.setStatisticOutput("sst.statOutputConsole")
+sst.enableStatisticsForComponentName("xbar", ["packets_moved", "cycles_events", "cycles_zero_events"], {"type":"sst.AccumulatorStatistic"})